@@ -9,9 +9,11 @@ void BaseEventManager::FilterEvents()
 	if(ShowPreviousFrameEvents() && !_forAutoRefresh) {
 		int offset = GetScanlineOffset();
 		uint32_t key = (_snapshotScanline << 16) + _snapshotCycle;
-		for(DebugEventInfo& evt : _snapshotPrevFrame) {
-			uint32_t evtKey = ((evt.Scanline + offset) << 16) + evt.Cycle;
+		DebugEventStore* store = _snapshotPrevFrame.Store;
+		for(uint32_t i = 0; i < _snapshotPrevFrame.Count; i++) {
+			uint32_t evtKey = ((store->GetScanline(i) + offset) << 16) + store->GetCycle(i);
 			if(evtKey > key) {
+				DebugEventInfo evt = store->Get(i);
 				EventViewerCategoryCfg eventCfg = GetEventConfig(evt);
 				if(eventCfg.Visible) {
 					_sentEvents.push_back(evt);
@@ -21,7 +23,8 @@ void BaseEventManager::FilterEvents()
 		}
 	}
 
-	for(DebugEventInfo& evt : _snapshotCurrentFrame) {
+	for(uint32_t i = 0; i < _snapshotCurrentFrame.Count; i++) {
+		DebugEventInfo evt = _snapshotCurrentFrame.Store->Get(i);
 		EventViewerCategoryCfg eventCfg = GetEventConfig(evt);
 		if(eventCfg.Visible) {
 			_sentEvents.push_back(evt);
@@ -77,10 +80,62 @@ uint32_t BaseEventManager::GetEventCount()
 	return (uint32_t)_sentEvents.size();
 }
 
+BaseEventManager::~BaseEventManager()
+{
+	StopEventLog();
+}
+
 void BaseEventManager::ClearFrameEvents()
 {
-	_prevDebugEvents = _debugEvents;
-	_debugEvents.clear();
+	if(_eventLog) {
+		_eventLog->WriteFrame(_frameCount, _eventStores[_currentStore], _eventStores[_currentStore].GetCount());
+	}
+	_frameCount++;
+	StartNewFrame();
+}
+
+void BaseEventManager::ResetEvents()
+{
+	//Twice to clear both the current and previous frames
+	StartNewFrame();
+	StartNewFrame();
+}
+
+void BaseEventManager::StartNewFrame()
+{
+	//The current frame becomes the previous frame, and the new frame uses a store that no snapshot refers to
+	int next = 0;
+	while(next == _currentStore || &_eventStores[next] == _snapshotCurrentFrame.Store || &_eventStores[next] == _snapshotPrevFrame.Store) {
+		next++;
+	}
+	_prevStore = _currentStore;
+	_currentStore = next;
+	_eventStores[_currentStore].Clear();
+	OnFrameStart();
+}
+
+void BaseEventManager::TakeFrameSnapshot()
+{
+	_snapshotCurrentFrame = { &_eventStores[_currentStore], _eventStores[_currentStore].GetCount() };
+	_snapshotPrevFrame = { &_eventStores[_prevStore], _eventStores[_prevStore].GetCount() };
+}
+
+bool BaseEventManager::StartEventLog(string path)
+{
+	unique_ptr<DebugEventLog> log(new DebugEventLog());
+	if(!log->Open(path)) {
+		return false;
+	}
+	_eventLog = std::move(log);
+	return true;
+}
+
+void BaseEventManager::StopEventLog()
+{
+	if(_eventLog) {
+		_eventLog->WriteFrame(_frameCount, _eventStores[_currentStore], _eventStores[_currentStore].GetCount());
+		_eventLog.reset();
+	}
 }
 
 void BaseEventManager::GetDisplayBuffer(uint32_t* buffer, uint32_t bufferSize)
@@ -2,34 +2,9 @@
 #include "pch.h"
 #include "Debugger/DebugTypes.h"
 #include "Shared/SettingTypes.h"
+#include "Debugger/DebugEventStore.h"
+#include "Debugger/DebugEventLog.h"
 #include "Utilities/SimpleLock.h"
-#include "SNES/DmaControllerTypes.h"
-
-enum class EventFlags
-{
-	PreviousFrame = 1 << 0,
-	RegFirstWrite = 1 << 1,
-	RegSecondWrite = 1 << 2,
-	WithTargetMemory = 1 << 3,
-	SmsVdpPaletteWrite = 1 << 4,
-	ReadWriteOp = 1 << 5,
-};
-
-struct DebugEventInfo
-{
-	MemoryOperationInfo Operation;
-	DebugEventType Type;
-	uint32_t ProgramCounter;
-	int16_t Scanline;
-	uint16_t Cycle;
-	int16_t BreakpointId = -1;
-	int8_t DmaChannel = -1;
-	DmaChannelConfig DmaChannelInfo;
-	uint32_t Flags;
-	int32_t RegisterId = -1;
-	MemoryOperationInfo TargetMemory;
-	uint32_t Color = 0;
-};
 
 struct EventViewerCategoryCfg
 {
@@ -44,12 +19,18 @@ struct BaseEventViewerConfig
 class BaseEventManager
 {
 protected:
-	vector<DebugEventInfo> _debugEvents;
-	vector<DebugEventInfo> _prevDebugEvents;
+	//Frames rotate between the stores: the current frame, the previous one, and up to 2 more kept alive by the last snapshot
+	static constexpr int EventStoreCount = 4;
+	DebugEventStore _eventStores[EventStoreCount];
+	int _currentStore = 0;
+	int _prevStore = 1;
+	uint32_t _frameCount = 0;
+	unique_ptr<DebugEventLog> _eventLog;
+
 	vector<DebugEventInfo> _sentEvents;
 
-	vector<DebugEventInfo> _snapshotCurrentFrame;
-	vector<DebugEventInfo> _snapshotPrevFrame;
+	DebugEventFrameView _snapshotCurrentFrame;
+	DebugEventFrameView _snapshotPrevFrame;
 	int16_t _snapshotScanline = -1;
 	int16_t _snapshotScanlineOffset = 0;
 	uint16_t _snapshotCycle = 0;
@@ -58,6 +39,18 @@ protected:
 
 	virtual bool ShowPreviousFrameEvents() = 0;
 
+	//Called when the current frame's store is emptied, to add the events every frame starts with
+	virtual void OnFrameStart() {}
+	void StartNewFrame();
+
+	__forceinline void AddDebugEvent(DebugEventInfo& evt)
+	{
+		_eventStores[_currentStore].Add(evt);
+	}
+
+	//Must be called while the emulation is paused, the snapshot doesn't copy the events
+	void TakeFrameSnapshot();
+
 	void FilterEvents();
 	void DrawDot(uint32_t x, uint32_t y, uint32_t color, bool drawBackground, uint32_t* buffer);
 	virtual int GetScanlineOffset() { return 0; }
@@ -70,7 +63,7 @@ protected:
 	void DrawEvent(DebugEventInfo& evt, bool drawBackground, uint32_t* buffer);
 
 public:
-	virtual ~BaseEventManager() {}
+	virtual ~BaseEventManager();
 
 	virtual void SetConfiguration(BaseEventViewerConfig& config) = 0;
 
@@ -79,7 +72,17 @@ public:
 
 	void GetEvents(DebugEventInfo* eventArray, uint32_t& maxEventCount);
 	uint32_t GetEventCount();
-	virtual void ClearFrameEvents();
+	//End of frame: logs the frame's events and starts a new frame
+	void ClearFrameEvents();
+
+	//Console reset: discards the current and previous frames, without logging them or counting a new frame
+	void ResetEvents();
+
+	//Writes the events of every frame to a binary file (see DebugEventLog), until StopEventLog is called or the event manager is destroyed
+	bool StartEventLog(string path);
+
+	//Writes the current, unfinished, frame and closes the log
+	void StopEventLog();
 
 	virtual EventViewerCategoryCfg GetEventConfig(DebugEventInfo& evt) = 0;
 
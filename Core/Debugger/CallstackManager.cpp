@@ -8,21 +8,43 @@
 CallstackManager::CallstackManager(Debugger* debugger, IDebugger* cpuDebugger)
 {
 	_debugger = debugger;
-	_profiler.reset(new Profiler(debugger, cpuDebugger));
+	_version = 0;
+	_profiler.reset(new Profiler(debugger, cpuDebugger, this));
 }
 
 CallstackManager::~CallstackManager()
 {
 }
 
+void CallstackManager::BeginUpdate()
+{
+	_version.store(_version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+void CallstackManager::EndUpdate()
+{
+	_version.store(_version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
 void CallstackManager::Push(AddressInfo &src, uint32_t srcAddr, AddressInfo& dest, uint32_t destAddr, AddressInfo& ret, uint32_t returnAddress, uint32_t returnStackPointer, StackFrameFlags flags)
 {
-	if(_callstack.size() >= 511) {
-		//Ensure callstack stays below 512 entries - games can use various tricks that could keep making the callstack grow
-		_callstack.pop_front();
+	BeginUpdate();
+	InternalPush(src, srcAddr, dest, destAddr, ret, returnAddress, returnStackPointer, flags);
+	EndUpdate();
+}
+
+void CallstackManager::InternalPush(AddressInfo& src, uint32_t srcAddr, AddressInfo& dest, uint32_t destAddr, AddressInfo& ret, uint32_t returnAddress, uint32_t returnStackPointer, StackFrameFlags flags)
+{
+	if(_size == MaxFrames) {
+		//Drop the oldest frame
+		_returnAddrCount[GetReturnHash(_frames[_head].Return)]--;
+		_head = (_head + 1) & FrameMask;
+		_size--;
 	}
 
-	StackFrameInfo stackFrame;
+	uint32_t index = (_head + _size) & FrameMask;
+	StackFrameInfo& stackFrame = _frames[index];
 	stackFrame.Source = srcAddr;
 	stackFrame.AbsSource = src;
 	stackFrame.Target = destAddr;
@@ -30,81 +52,119 @@ void CallstackManager::Push(AddressInfo &src, uint32_t srcAddr, AddressInfo& des
 	stackFrame.Return = returnAddress;
 	stackFrame.ReturnStackPointer = returnStackPointer;
 	stackFrame.AbsReturn = ret;
-
 	stackFrame.Flags = flags;
 
-	_callstack.push_back(stackFrame);
-	_profiler->StackFunction(dest, flags);
+	_returnAddrCount[GetReturnHash(returnAddress)]++;
+	_size++;
+
+	_profiler->StackFunction(dest, flags, _profilerFrames[index]);
+}
+
+void CallstackManager::InternalPop()
+{
+	uint32_t index = (_head + _size - 1) & FrameMask;
+
+	//The profiler updates the inclusive cycles of the frames on the stack before the frame is removed
+	_profiler->UnstackFunction(_profilerFrames[index]);
+
+	_returnAddrCount[GetReturnHash(_frames[index].Return)]--;
+	_size--;
+}
+
+int32_t CallstackManager::FindReturnAddr(uint32_t destAddr)
+{
+	for(int32_t i = (int32_t)_size - 1; i >= 0; i--) {
+		if(_frames[(_head + i) & FrameMask].Return == destAddr) {
+			return i;
+		}
+	}
+	return -1;
 }
 
 void CallstackManager::Pop(AddressInfo& dest, uint32_t destAddress, uint32_t stackPointer)
 {
-	if(_callstack.empty()) {
+	if(_size == 0) {
 		return;
 	}
 
-	StackFrameInfo prevFrame = _callstack.back();
-	_callstack.pop_back();
-	_profiler->UnstackFunction();
+	BeginUpdate();
+
+	StackFrameInfo prevFrame = GetTopFrame();
+	InternalPop();
 
 	uint32_t returnAddr = prevFrame.Return;
 
-	if(!_callstack.empty() && destAddress != returnAddr) {
+	if(_size > 0 && destAddress != returnAddr) {
 		//Mismatch, try to find a matching address higher in the stack
-		bool foundMatch = false;
-		for(int i = (int)_callstack.size() - 1; i >= 0; i--) {
-			if(destAddress == _callstack[i].Return) {
-				//Found a matching stack frame, unstack until that point
-				foundMatch = true;
-				for(int j = (int)_callstack.size() - i - 1; j >= 0; j--) {
-					_callstack.pop_back();
-					_profiler->UnstackFunction();
-				}
-				break;
+		int32_t match = _returnAddrCount[GetReturnHash(destAddress)] ? FindReturnAddr(destAddress) : -1;
+		if(match >= 0) {
+			//Found a matching stack frame, unstack until that point
+			while(_size > (uint32_t)match) {
+				InternalPop();
 			}
-		}
-
-		if(!foundMatch) {
+		} else {
 			//Couldn't find a matching frame
 			//If the new stack pointer doesn't match the last frame, push a new frame for it
 			//Otherwise, presume that the code has returned to the last function on the stack
 			//This can happen in some patterns, e.g if putting call parameters after the JSR
 			//call, and manipulating the stack upon return to return to the code after the
 			//parameters.
-			if(_callstack.back().ReturnStackPointer != stackPointer) {
-				Push(prevFrame.AbsReturn, returnAddr, dest, destAddress, prevFrame.AbsReturn, returnAddr, stackPointer, StackFrameFlags::None);
+			if(GetTopFrame().ReturnStackPointer != stackPointer) {
+				InternalPush(prevFrame.AbsReturn, returnAddr, dest, destAddress, prevFrame.AbsReturn, returnAddr, stackPointer, StackFrameFlags::None);
 			}
 		}
 	}
+
+	EndUpdate();
 }
 
-void CallstackManager::GetCallstack(StackFrameInfo* callstackArray, uint32_t &callstackSize)
+void CallstackManager::GetCallstack(StackFrameInfo* callstackArray, uint32_t &callstackSize, uint32_t maxSize)
 {
+	//Copy the frames without stopping the emulation, retry if the callstack changed during the copy
+	for(int attempt = 0; attempt < 100; attempt++) {
+		uint32_t version = _version.load(std::memory_order_acquire);
+		if(version & 1) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		uint32_t size = std::min(_size, maxSize);
+		uint32_t start = _head + _size - size;
+		for(uint32_t i = 0; i < size; i++) {
+			callstackArray[i] = _frames[(start + i) & FrameMask];
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if(_version.load(std::memory_order_relaxed) == version) {
+			callstackSize = size;
+			return;
+		}
+	}
+
+	//The callstack keeps changing (e.g deep recursion), stop the emulation to copy it
 	DebugBreakHelper helper(_debugger);
-	int i = 0;
-	for(StackFrameInfo &info : _callstack) {
-		callstackArray[i] = info;
-		i++;
+	uint32_t size = std::min(_size, maxSize);
+	uint32_t start = _head + _size - size;
+	for(uint32_t i = 0; i < size; i++) {
+		callstackArray[i] = _frames[(start + i) & FrameMask];
 	}
-	callstackSize = i;
+	callstackSize = size;
 }
 
 int32_t CallstackManager::GetReturnAddress()
 {
-	DebugBreakHelper helper(_debugger);
-	if(_callstack.empty()) {
-		return -1;
-	}
-	return _callstack.back().Return;
+	StackFrameInfo frame;
+	uint32_t size = 0;
+	GetCallstack(&frame, size, 1);
+	return size ? (int32_t)frame.Return : -1;
 }
 
 int64_t CallstackManager::GetReturnStackPointer()
 {
-	DebugBreakHelper helper(_debugger);
-	if(_callstack.empty()) {
-		return -1;
-	}
-	return _callstack.back().ReturnStackPointer;
+	StackFrameInfo frame;
+	uint32_t size = 0;
+	GetCallstack(&frame, size, 1);
+	return size ? (int64_t)frame.ReturnStackPointer : -1;
 }
 
 Profiler* CallstackManager::GetProfiler()
@@ -114,6 +174,10 @@ Profiler* CallstackManager::GetProfiler()
 
 void CallstackManager::Clear()
 {
-	_callstack.clear();
+	BeginUpdate();
+	_head = 0;
+	_size = 0;
+	memset(_returnAddrCount, 0, sizeof(_returnAddrCount));
 	_profiler->ResetState();
+	EndUpdate();
 }
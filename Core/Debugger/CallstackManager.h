@@ -6,13 +6,53 @@ class Debugger;
 class Profiler;
 class IDebugger;
 
+//Profiler state saved for each callstack frame (restored when the frame returns)
+struct ProfilerFrame
+{
+	uint32_t Function;
+	uint32_t Node;
+	uint32_t Edge;
+	StackFrameFlags Flags;
+	uint32_t Generation; //Frame is only valid if this matches the profiler's current generation
+	uint64_t CycleCount;
+};
+
 class CallstackManager
 {
+public:
+	static constexpr uint32_t MaxFrames = 512;
+
 private:
+	static constexpr uint32_t FrameMask = MaxFrames - 1;
+	static constexpr uint32_t ReturnFilterBits = 10;
+
 	Debugger* _debugger;
-	deque<StackFrameInfo> _callstack;
 	unique_ptr<Profiler> _profiler;
 
+	//Ring buffer, frame i (0 = oldest) is stored at (_head + i) & FrameMask.
+	//Once full, pushing a frame drops the oldest one - games can use various tricks that could keep making the callstack grow
+	StackFrameInfo _frames[MaxFrames] = {};
+	ProfilerFrame _profilerFrames[MaxFrames] = {};
+	uint32_t _head = 0;
+	uint32_t _size = 0;
+
+	//Number of frames returning to an address with each hash value - a 0 means no frame returns to that address
+	uint16_t _returnAddrCount[1 << ReturnFilterBits] = {};
+
+	//Odd while the callstack is being modified - lets other threads copy the callstack without stopping the emulation
+	atomic<uint32_t> _version;
+
+	static __forceinline uint32_t GetReturnHash(uint32_t addr) { return (addr * 0x9E3779B1) >> (32 - ReturnFilterBits); }
+
+	__forceinline StackFrameInfo& GetTopFrame() { return _frames[(_head + _size - 1) & FrameMask]; }
+
+	void BeginUpdate();
+	void EndUpdate();
+
+	void InternalPush(AddressInfo& src, uint32_t srcAddr, AddressInfo& dest, uint32_t destAddr, AddressInfo& ret, uint32_t returnAddress, uint32_t returnStackPointer, StackFrameFlags flags);
+	void InternalPop();
+	int32_t FindReturnAddr(uint32_t destAddr);
+
 public:
 	CallstackManager(Debugger* debugger, IDebugger* cpuDebugger);
 	~CallstackManager();
@@ -22,23 +62,21 @@ public:
 
 	__forceinline bool IsReturnAddrMatch(uint32_t destAddr)
 	{
-		if(_callstack.empty()) {
+		if(_size == 0 || _returnAddrCount[GetReturnHash(destAddr)] == 0) {
 			return false;
 		}
-
-		for(auto itt = _callstack.rbegin(); itt != _callstack.rend(); itt++) {
-			if((*itt).Return == destAddr) {
-				return true;
-			}
-		}
-
-		return false;
+		return GetTopFrame().Return == destAddr || FindReturnAddr(destAddr) >= 0;
 	}
 
-	void GetCallstack(StackFrameInfo* callstackArray, uint32_t &callstackSize);
+	//Copies the most recent frames (up to maxSize), oldest first. Can be called from any thread.
+	void GetCallstack(StackFrameInfo* callstackArray, uint32_t &callstackSize, uint32_t maxSize = MaxFrames);
 	int32_t GetReturnAddress();
 	int64_t GetReturnStackPointer();
 	Profiler* GetProfiler();
 
+	//Used by the profiler, depth 0 is the most recent frame (emulation thread only)
+	uint32_t GetSize() { return _size; }
+	ProfilerFrame& GetProfilerFrame(uint32_t depth) { return _profilerFrames[(_head + _size - 1 - depth) & FrameMask]; }
+
 	void Clear();
-};
\ No newline at end of file
+};
@@ -16,6 +16,7 @@ CodeDataLogger::CodeDataLogger(Debugger* debugger, MemoryType memType, uint32_t
 	_memSize = memSize;
 	_romCrc32 = romCrc32;
 	_cdlData = new uint8_t[memSize];
+	_coverage.resize(((uint64_t)memSize + (1 << CoverageBlockShift) - 1) >> CoverageBlockShift);
 	Reset();
 
 	debugger->GetCdlManager()->RegisterCdl(memType, this);
@@ -29,6 +30,37 @@ CodeDataLogger::~CodeDataLogger()
 void CodeDataLogger::Reset()
 {
 	memset(_cdlData, 0, _memSize);
+	std::fill(_coverage.begin(), _coverage.end(), CdlCoverageCounters {});
+	_totalCoverage = {};
+}
+
+void CodeDataLogger::AddCoverage(int32_t absoluteAddr, uint8_t prevFlags, uint8_t newFlags)
+{
+	CdlCoverageCounters& block = _coverage[absoluteAddr >> CoverageBlockShift];
+	if((newFlags & CdlFlags::Code) && !(prevFlags & CdlFlags::Code)) {
+		block.CodeBytes++;
+		_totalCoverage.CodeBytes++;
+	}
+	if((newFlags & CdlFlags::Data) && !(prevFlags & CdlFlags::Data)) {
+		block.DataBytes++;
+		_totalCoverage.DataBytes++;
+	}
+	constexpr uint8_t codeAndData = CdlFlags::Code | CdlFlags::Data;
+	if((prevFlags & codeAndData) != codeAndData && ((prevFlags | newFlags) & codeAndData) == codeAndData) {
+		block.CodeAndDataBytes++;
+		_totalCoverage.CodeAndDataBytes++;
+	}
+}
+
+void CodeDataLogger::RebuildCoverage()
+{
+	std::fill(_coverage.begin(), _coverage.end(), CdlCoverageCounters {});
+	_totalCoverage = {};
+	for(uint32_t i = 0; i < _memSize; i++) {
+		if(_cdlData[i] & (CdlFlags::Code | CdlFlags::Data)) {
+			AddCoverage(i, 0, _cdlData[i]);
+		}
+	}
 }
 
 uint8_t* CodeDataLogger::GetRawData()
@@ -60,6 +92,7 @@ bool CodeDataLogger::LoadCdlFile(string cdlFilepath, bool autoResetCdl)
 				uint32_t savedCrc = cdlData[5] | (cdlData[6] << 8) | (cdlData[7] << 16) | (cdlData[8] << 24);
 				if((!autoResetCdl || savedCrc == _romCrc32) && fileSize >= _memSize + CodeDataLogger::HeaderSize) {
 					memcpy(_cdlData, cdlData.data() + CodeDataLogger::HeaderSize, _memSize);
+					RebuildCoverage();
 					InternalLoadCdlFile(cdlData.data() + CodeDataLogger::HeaderSize, (uint32_t)cdlData.size() - CodeDataLogger::HeaderSize);
 				}
 			} else {
@@ -67,6 +100,7 @@ bool CodeDataLogger::LoadCdlFile(string cdlFilepath, bool autoResetCdl)
 
 				//Older CRC-less CDL file, use as-is without checking CRC to avoid data loss
 				memcpy(_cdlData, cdlData.data(), _memSize);
+				RebuildCoverage();
 				InternalLoadCdlFile(cdlData.data(), (uint32_t)cdlData.size());
 			}
 			
@@ -100,27 +134,32 @@ string CodeDataLogger::GetCdlFilePath(string romName)
 
 CdlStatistics CodeDataLogger::GetStatistics()
 {
-	uint32_t codeSize = 0;
-	uint32_t dataSize = 0;
-	uint32_t bothSize = 0;
-
-	for(int i = 0, len = _memSize; i < len; i++) {
-		uint32_t isCode = (uint32_t)(_cdlData[i] & CdlFlags::Code);
-		uint32_t isData = (uint32_t)(_cdlData[i] & CdlFlags::Data) >> 1;
-		codeSize += isCode;
-		dataSize += isData;
-		bothSize += isCode & isData;
-	}
-
-	dataSize -= bothSize;
-
 	CdlStatistics stats = {};
-	stats.CodeBytes = codeSize;
-	stats.DataBytes = dataSize;
+	stats.CodeBytes = _totalCoverage.CodeBytes;
+	stats.DataBytes = _totalCoverage.DataBytes - _totalCoverage.CodeAndDataBytes;
 	stats.TotalBytes = _memSize;
 	return stats;
 }
 
+vector<CdlBankCoverage> CodeDataLogger::GetBankCoverage(uint32_t bankSize)
+{
+	uint32_t blockSize = 1 << CoverageBlockShift;
+	bankSize = std::max(blockSize, (bankSize + blockSize - 1) & ~(blockSize - 1));
+
+	vector<CdlBankCoverage> banks;
+	for(uint32_t start = 0; start < _memSize; start += bankSize) {
+		CdlBankCoverage bank = {};
+		bank.Start = start;
+		bank.Size = std::min(bankSize, _memSize - start);
+		for(uint32_t i = start >> CoverageBlockShift; i < _coverage.size() && i < (start + bank.Size + blockSize - 1) >> CoverageBlockShift; i++) {
+			bank.CodeBytes += _coverage[i].CodeBytes;
+			bank.DataBytes += _coverage[i].DataBytes - _coverage[i].CodeAndDataBytes;
+		}
+		banks.push_back(bank);
+	}
+	return banks;
+}
+
 bool CodeDataLogger::IsCode(uint32_t absoluteAddr)
 {
 	return (_cdlData[absoluteAddr] & CdlFlags::Code) != 0;
@@ -145,6 +184,7 @@ void CodeDataLogger::SetCdlData(uint8_t *cdlData, uint32_t length)
 {
 	if(length <= _memSize) {
 		memcpy(_cdlData, cdlData, length);
+		RebuildCoverage();
 	}
 }
 
@@ -179,6 +219,7 @@ void CodeDataLogger::MarkBytesAs(uint32_t start, uint32_t end, uint8_t flags)
 	for(uint32_t i = start; i <= end; i++) {
 		_cdlData[i] = (_cdlData[i] & 0xFC) | (int)flags;
 	}
+	RebuildCoverage();
 }
 
 void CodeDataLogger::StripData(uint8_t* romBuffer, CdlStripOption flag)
@@ -10,11 +10,27 @@ class CodeDataLogger
 protected:
 	constexpr static int HeaderSize = 9; //"CDLv2" + 4-byte CRC32 value
 
+	constexpr static uint32_t CoverageBlockShift = 12; //Coverage counters are kept for each 4 KB block
+
 	uint8_t* _cdlData = nullptr;
 	CpuType _cpuType = CpuType::Snes;
 	MemoryType _memType = {};
 	uint32_t _memSize = 0;
 	uint32_t _romCrc32 = 0;
+
+	//Number of code/data/code+data bytes in each block, updated when a byte gets its first code or data flag
+	vector<CdlCoverageCounters> _coverage;
+	CdlCoverageCounters _totalCoverage = {};
+
+	__forceinline void UpdateCoverage(int32_t absoluteAddr, uint8_t prevFlags, uint8_t newFlags)
+	{
+		if((newFlags & ~prevFlags) & (CdlFlags::Code | CdlFlags::Data)) {
+			AddCoverage(absoluteAddr, prevFlags, newFlags);
+		}
+	}
+
+	void AddCoverage(int32_t absoluteAddr, uint8_t prevFlags, uint8_t newFlags);
+	void RebuildCoverage();
 	
 	virtual void InternalLoadCdlFile(uint8_t* cdlData, uint32_t cdlSize) {}
 	virtual void InternalSaveCdlFile(ofstream& cdlFile) {}
@@ -36,17 +52,23 @@ public:
 	void SetCode(int32_t absoluteAddr)
 	{
 		for(int i = 0; i < accessWidth; i++) {
-			_cdlData[absoluteAddr+i] |= CdlFlags::Code | flags;
+			uint8_t prev = _cdlData[absoluteAddr+i];
+			_cdlData[absoluteAddr+i] = prev | CdlFlags::Code | flags;
+			UpdateCoverage(absoluteAddr+i, prev, CdlFlags::Code);
 		}
 	}
 
 	template<uint8_t accessWidth = 1>
 	void SetCode(int32_t absoluteAddr, uint8_t flags)
 	{
-		_cdlData[absoluteAddr] |= CdlFlags::Code | flags; //only sets extra flags on first byte
+		uint8_t prev = _cdlData[absoluteAddr];
+		_cdlData[absoluteAddr] = prev | CdlFlags::Code | flags; //only sets extra flags on first byte
+		UpdateCoverage(absoluteAddr, prev, CdlFlags::Code);
 		if constexpr(accessWidth > 1) {
 			for(int i = 1; i < accessWidth; i++) {
-				_cdlData[absoluteAddr+i] |= CdlFlags::Code;
+				prev = _cdlData[absoluteAddr+i];
+				_cdlData[absoluteAddr+i] = prev | CdlFlags::Code;
+				UpdateCoverage(absoluteAddr+i, prev, CdlFlags::Code);
 			}
 		}
 	}
@@ -55,12 +77,17 @@ public:
 	void SetData(int32_t absoluteAddr)
 	{
 		for(int i = 0; i < accessWidth; i++) {
-			_cdlData[absoluteAddr+i] |= CdlFlags::Data | flags;
+			uint8_t prev = _cdlData[absoluteAddr+i];
+			_cdlData[absoluteAddr+i] = prev | CdlFlags::Data | flags;
+			UpdateCoverage(absoluteAddr+i, prev, CdlFlags::Data);
 		}
 	}
 
 	virtual CdlStatistics GetStatistics();
 
+	//Code/data byte counts for each bank of bankSize bytes (rounded up to a multiple of 4 KB), without scanning the CDL data
+	vector<CdlBankCoverage> GetBankCoverage(uint32_t bankSize);
+
 	bool IsCode(uint32_t absoluteAddr);
 	bool IsJumpTarget(uint32_t absoluteAddr);
 	bool IsSubEntryPoint(uint32_t absoluteAddr);
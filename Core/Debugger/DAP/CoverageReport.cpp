@@ -0,0 +1,108 @@
+#include "CoverageReport.h"
+#include "SourceMapper.h"
+#include <algorithm>
+
+void CoverageReport::Build(const SourceMapper& mapper, const uint8_t* cdlData, uint32_t cdlSize, uint32_t romFileOffset)
+{
+	struct LineFlags {
+		int fileId;
+		int line;
+		bool code;
+		bool data;
+	};
+
+	std::vector<LineFlags> flags;
+	mapper.ForEachRomSpan([&](int fileId, int line, uint32_t romOffset, uint32_t size) {
+		if(fileId < 0 || romOffset < romFileOffset || romOffset - romFileOffset >= cdlSize) {
+			// Not part of the PRG ROM (e.g. the iNES header)
+			return;
+		}
+
+		uint32_t start = romOffset - romFileOffset;
+		uint32_t end = std::min(cdlSize, start + size);
+		LineFlags entry = { fileId, line, false, false };
+		for(uint32_t i = start; i < end; i++) {
+			entry.code |= (cdlData[i] & 0x01) != 0;
+			entry.data |= (cdlData[i] & 0x02) != 0;
+		}
+		flags.push_back(entry);
+	});
+
+	std::sort(flags.begin(), flags.end(), [](const LineFlags& a, const LineFlags& b) {
+		return a.fileId != b.fileId ? a.fileId < b.fileId : a.line < b.line;
+	});
+
+	const std::vector<std::string>& fileNames = mapper.GetSourceFiles();
+	_files.clear();
+	_lineCount = 0;
+	_hitLineCount = 0;
+
+	int currentFileId = -1;
+	for(const LineFlags& entry : flags) {
+		if(entry.fileId != currentFileId) {
+			currentFileId = entry.fileId;
+			_files.emplace_back();
+			_files.back().name = entry.fileId < (int)fileNames.size() ? fileNames[entry.fileId] : std::string();
+		}
+
+		CoverageFile& file = _files.back();
+		if(file.lines.empty() || file.lines.back().line != entry.line) {
+			file.lines.push_back(CoverageLine{ entry.line, false, false });
+		}
+		file.lines.back().code |= entry.code;
+		file.lines.back().data |= entry.data;
+	}
+
+	for(CoverageFile& file : _files) {
+		for(const CoverageLine& line : file.lines) {
+			if(line.code || line.data) {
+				file.linesHit++;
+			}
+		}
+		_lineCount += (uint32_t)file.lines.size();
+		_hitLineCount += file.linesHit;
+	}
+}
+
+std::string CoverageReport::ToLcov() const
+{
+	std::string out = "TN:\n";
+	for(const CoverageFile& file : _files) {
+		out += "SF:" + file.name + "\n";
+		for(const CoverageLine& line : file.lines) {
+			out += "DA:" + std::to_string(line.line) + "," + ((line.code || line.data) ? "1" : "0") + "\n";
+		}
+		out += "LF:" + std::to_string(file.lines.size()) + "\n";
+		out += "LH:" + std::to_string(file.linesHit) + "\n";
+		out += "end_of_record\n";
+	}
+	return out;
+}
+
+JsonValue CoverageReport::ToJson() const
+{
+	auto files = JsonValue::MakeArray();
+	for(const CoverageFile& file : _files) {
+		auto lines = JsonValue::MakeArray();
+		for(const CoverageLine& line : file.lines) {
+			auto entry = JsonValue::MakeObject();
+			entry.Set("line", JsonValue::MakeNumber(line.line));
+			entry.Set("code", JsonValue::MakeBool(line.code));
+			entry.Set("data", JsonValue::MakeBool(line.data));
+			lines.Push(std::move(entry));
+		}
+
+		auto entry = JsonValue::MakeObject();
+		entry.Set("name", JsonValue::MakeString(file.name));
+		entry.Set("linesFound", JsonValue::MakeNumber((double)file.lines.size()));
+		entry.Set("linesHit", JsonValue::MakeNumber(file.linesHit));
+		entry.Set("lines", std::move(lines));
+		files.Push(std::move(entry));
+	}
+
+	auto result = JsonValue::MakeObject();
+	result.Set("linesFound", JsonValue::MakeNumber(_lineCount));
+	result.Set("linesHit", JsonValue::MakeNumber(_hitLineCount));
+	result.Set("files", std::move(files));
+	return result;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "DapJson.h"
+
+class SourceMapper;
+
+struct CoverageLine {
+	int line = 0;
+	bool code = false;   // at least one byte of the line was executed
+	bool data = false;   // at least one byte of the line was read as data
+};
+
+struct CoverageFile {
+	std::string name;
+	std::vector<CoverageLine> lines;  // sorted by line
+	uint32_t linesHit = 0;
+};
+
+// Maps the CDL flags of the PRG ROM to the source lines of a ca65 .dbg file.
+// A line counts as hit when any of its bytes was executed or read as data.
+class CoverageReport {
+public:
+	// romFileOffset: offset of the PRG ROM data in the linker's output file (e.g. 16 for the iNES header)
+	void Build(const SourceMapper& mapper, const uint8_t* cdlData, uint32_t cdlSize, uint32_t romFileOffset);
+
+	const std::vector<CoverageFile>& GetFiles() const { return _files; }
+	uint32_t GetLineCount() const { return _lineCount; }
+	uint32_t GetHitLineCount() const { return _hitLineCount; }
+
+	// lcov tracefile (genhtml, CI coverage services)
+	std::string ToLcov() const;
+	JsonValue ToJson() const;
+
+private:
+	std::vector<CoverageFile> _files;
+	uint32_t _lineCount = 0;
+	uint32_t _hitLineCount = 0;
+};
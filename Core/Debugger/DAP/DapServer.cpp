@@ -13,14 +13,19 @@
 #include "Core/Debugger/DebugUtilities.h"
 #include "Core/Debugger/Disassembler.h"
 #include "Core/Debugger/CallstackManager.h"
+#include "Core/Debugger/Profiler.h"
 #include "Core/Debugger/MemoryDumper.h"
+#include "Core/Debugger/MemorySnapshotManager.h"
 #include "Core/Debugger/ExpressionEvaluator.h"
+#include "Core/Debugger/ReverseJournal.h"
 #include "Core/SNES/SnesCpuTypes.h"
 #include "Utilities/VirtualFile.h"
 #include "Utilities/FolderUtilities.h"
+#include "GDB/console_info.h"
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <sstream>
 #include <thread>
 #include <chrono>
 #include <vector>
@@ -81,12 +86,20 @@ void DapServer::Run()
 			HandleSetBreakpoints(request);
 		} else if(command == DapCommand::Disassemble) {
 			HandleDisassemble(request);
+		} else if(command == DapCommand::StepBack) {
+			HandleStepBack(request);
+		} else if(command == DapCommand::ReverseContinue) {
+			HandleReverseContinue(request);
 		} else if(command == DapCommand::Evaluate) {
 			HandleEvaluate(request);
 		} else if(command == DapCommand::ReadMemory) {
 			HandleReadMemory(request);
 		} else if(command == DapCommand::WriteMemory) {
 			HandleWriteMemory(request);
+		} else if(command == DapCommand::Profile) {
+			HandleProfile(request);
+		} else if(command == DapCommand::Snapshot) {
+			HandleSnapshot(request);
 		} else {
 			// Unknown command — send error response
 			auto resp = MakeResponse(request, false);
@@ -193,6 +206,7 @@ void DapServer::HandleInitialize(const JsonValue& request)
 	body.Set("supportsReadMemoryRequest", JsonValue::MakeBool(true));
 	body.Set("supportsWriteMemoryRequest", JsonValue::MakeBool(true));
 	body.Set("supportsConditionalBreakpoints", JsonValue::MakeBool(true));
+	body.Set("supportsStepBack", JsonValue::MakeBool(true));
 	resp.Set("body", std::move(body));
 	SendResponse(std::move(resp));
 
@@ -220,6 +234,16 @@ void DapServer::HandleLaunch(const JsonValue& request)
 		return;
 	}
 
+	if(args["reverseJournalSize"].GetType() != JsonValue::Type::Null) {
+		double size = args["reverseJournalSize"].GetNumber();
+		if(!(size >= 1 && size <= ReverseJournal::MaxCapacity)) {
+			auto resp = MakeResponse(request, false);
+			resp.Set("message", JsonValue::MakeString("reverseJournalSize must be between 1 and " + std::to_string(ReverseJournal::MaxCapacity)));
+			SendResponse(std::move(resp));
+			return;
+		}
+	}
+
 	// Load ROM — emulator was already Pause()d in DapMain, so the emulation
 	// thread will hit the initial break and block in SleepUntilResume.
 	if(!_emu->LoadRom((VirtualFile)romPath, VirtualFile())) {
@@ -229,6 +253,21 @@ void DapServer::HandleLaunch(const JsonValue& request)
 		return;
 	}
 
+	// Record executed instructions for stepBack/reverseContinue unless disabled by the client
+	if(args["reverseJournal"].GetType() == JsonValue::Type::Null || args["reverseJournal"].GetBool()) {
+		uint32_t capacity = ReverseJournal::DefaultCapacity;
+		if(args["reverseJournalSize"].GetType() != JsonValue::Type::Null) {
+			capacity = (uint32_t)args["reverseJournalSize"].GetNumber();
+		}
+
+		DebuggerRequest req = _emu->GetDebugger(false);
+		Debugger* dbg = req.GetDebugger();
+		auto cpuTypes = _emu->GetCpuTypes();
+		if(dbg && !cpuTypes.empty()) {
+			dbg->SetReverseJournalEnabled(cpuTypes[0], true, capacity);
+		}
+	}
+
 	// Load .dbg symbol file: explicit path or auto-detect from ROM path
 	std::string dbgPath = args["dbgPath"].GetString();
 	if(dbgPath.empty()) {
@@ -338,7 +377,7 @@ void DapServer::HandleStackTrace(const JsonValue& request)
 			}
 			frame.Set("name", JsonValue::MakeString(name));
 
-			SourceLocation loc = _sourceMapper.GetSourceLocation(addr);
+			SourceLocation loc = LookupSourceLocation(dbg, cpu, addr);
 			if(loc.valid && !loc.file.empty()) {
 				frame.Set("line", JsonValue::MakeNumber(loc.line));
 				frame.Set("column", JsonValue::MakeNumber(1));
@@ -368,16 +407,18 @@ void DapServer::HandleStackTrace(const JsonValue& request)
 		// Additional frames from CallstackManager
 		CallstackManager* csm = dbg->GetCallstackManager(cpu);
 		if(csm) {
-			StackFrameInfo csFrames[64];
+			// Lock-free copy of the 63 most recent frames, the emulation keeps running while the UI polls
+			StackFrameInfo csFrames[63];
 			uint32_t csCount = 0;
-			csm->GetCallstack(csFrames, csCount);
+			csm->GetCallstack(csFrames, csCount, 63);
 
-			// CallstackManager returns frames from most recent to oldest
-			for(uint32_t i = 0; i < csCount && frameCount < 64; i++) {
+			// CallstackManager returns frames from oldest to most recent
+			for(uint32_t i = csCount; i > 0; i--) {
+				const StackFrameInfo& csFrame = csFrames[i - 1];
 				const char* annotation = nullptr;
-				if(csFrames[i].Flags == StackFrameFlags::Nmi) annotation = "NMI";
-				else if(csFrames[i].Flags == StackFrameFlags::Irq) annotation = "IRQ";
-				frames.Push(makeFrame(frameCount, csFrames[i].Source, annotation));
+				if(csFrame.Flags == StackFrameFlags::Nmi) annotation = "NMI";
+				else if(csFrame.Flags == StackFrameFlags::Irq) annotation = "IRQ";
+				frames.Push(makeFrame(frameCount, csFrame.Source, annotation));
 				frameCount++;
 			}
 		}
@@ -539,6 +580,86 @@ void DapServer::HandleStepOut(const JsonValue& request)
 	SendResponse(std::move(resp));
 }
 
+void DapServer::HandleStepBack(const JsonValue& request)
+{
+	const JsonValue& args = request["arguments"];
+	int threadId = (int)args["threadId"].GetNumber();
+	CpuType cpu = ThreadIdToCpuType(threadId);
+
+	// Undo the last instruction with the reverse journal — no emulation runs, so
+	// the stopped event is sent here instead of by the notification listener
+	uint32_t stepCount = 0;
+	std::string error;
+	{
+		DebuggerRequest req = _emu->GetDebugger(false);
+		Debugger* dbg = req.GetDebugger();
+		if(dbg) {
+			error = dbg->GetReverseStepError(cpu);
+			if(error.empty()) {
+				stepCount = dbg->ReverseStep(cpu, 1);
+			}
+		}
+	}
+
+	if(!error.empty()) {
+		auto resp = MakeResponse(request, false);
+		resp.Set("message", JsonValue::MakeString(error));
+		SendResponse(std::move(resp));
+		return;
+	}
+
+	if(stepCount == 0) {
+		auto resp = MakeResponse(request, false);
+		resp.Set("message", JsonValue::MakeString("No recorded history to step back into"));
+		SendResponse(std::move(resp));
+		return;
+	}
+
+	auto resp = MakeResponse(request, true);
+	SendResponse(std::move(resp));
+	SendStoppedEvent(DapStoppedReason::Step, cpu);
+}
+
+void DapServer::HandleReverseContinue(const JsonValue& request)
+{
+	const JsonValue& args = request["arguments"];
+	int threadId = (int)args["threadId"].GetNumber();
+	CpuType cpu = ThreadIdToCpuType(threadId);
+
+	// Undo instructions until a breakpoint matches, or until the start of the journal
+	int32_t breakpointId = -1;
+	uint32_t stepCount = 0;
+	std::string error;
+	{
+		DebuggerRequest req = _emu->GetDebugger(false);
+		Debugger* dbg = req.GetDebugger();
+		if(dbg) {
+			error = dbg->GetReverseStepError(cpu);
+			if(error.empty()) {
+				breakpointId = dbg->ReverseContinue(cpu, stepCount);
+			}
+		}
+	}
+
+	if(!error.empty()) {
+		auto resp = MakeResponse(request, false);
+		resp.Set("message", JsonValue::MakeString(error));
+		SendResponse(std::move(resp));
+		return;
+	}
+
+	if(stepCount == 0) {
+		auto resp = MakeResponse(request, false);
+		resp.Set("message", JsonValue::MakeString("No recorded history to step back into"));
+		SendResponse(std::move(resp));
+		return;
+	}
+
+	auto resp = MakeResponse(request, true);
+	SendResponse(std::move(resp));
+	SendStoppedEvent(breakpointId >= 0 ? DapStoppedReason::Breakpoint : DapStoppedReason::Step, cpu);
+}
+
 // ── Phase 2: Breakpoints ──────────────────────────────────────────
 
 // BreakpointData overlays Breakpoint's private fields (same pattern as debugger_cli.cpp)
@@ -557,6 +678,20 @@ struct BreakpointData {
 	char condition[1000];
 };
 
+SourceLocation DapServer::LookupSourceLocation(Debugger* dbg, CpuType cpu, uint32_t addr)
+{
+	// Resolve through the ROM offset first: the CPU address alone is ambiguous when
+	// several banks are mapped at the same address
+	AddressInfo absAddr = dbg->GetAbsoluteAddress({ (int32_t)addr, DebugUtilities::GetCpuMemoryType(cpu) });
+	if(absAddr.Address >= 0 && absAddr.Type == ConsoleInfo::GetPrgRomMemoryType(_emu->GetConsoleType())) {
+		SourceLocation loc = _sourceMapper.GetSourceLocationByRomOffset(absAddr.Address + ConsoleInfo::GetRomFileHeaderSize(_emu->GetConsoleType()));
+		if(loc.valid) {
+			return loc;
+		}
+	}
+	return _sourceMapper.GetSourceLocation(addr);
+}
+
 void DapServer::SyncBreakpoints()
 {
 	DebuggerRequest req = _emu->GetDebugger(false);
@@ -594,12 +729,25 @@ void DapServer::HandleSetBreakpoints(const JsonValue& request)
 			requestedLine = (int)bp["line"].GetNumber();
 		}
 
+		// Source breakpoints inside ROM are set on the ROM offset so they only trigger for the right bank
+		MemoryType bpMemType = cpuMemType;
+		int32_t bpAddr = -1;
+
 		if(isSourceFile && _sourceMapper.IsLoaded()) {
 			// Source breakpoint: resolve file+line → address
 			uint32_t resolved = _sourceMapper.GetAddress(sourcePath, requestedLine);
-			if(resolved != 0xFFFFFFFF) {
+			if(resolved != SourceMapper::InvalidAddress) {
 				addr = (int32_t)resolved;
 			}
+
+			uint32_t romOffset = _sourceMapper.GetRomOffset(sourcePath, requestedLine);
+			uint32_t headerSize = ConsoleInfo::GetRomFileHeaderSize(_emu->GetConsoleType());
+			MemoryType romType = ConsoleInfo::GetPrgRomMemoryType(_emu->GetConsoleType());
+			if(romOffset != SourceMapper::InvalidAddress && romOffset >= headerSize && romType != MemoryType::None &&
+				romOffset - headerSize < (uint32_t)_emu->GetMemory(romType).Size) {
+				bpMemType = romType;
+				bpAddr = (int32_t)(romOffset - headerSize);
+			}
 		} else if(requestedLine > 0) {
 			// Disassembly view: line IS the address
 			addr = (int32_t)requestedLine;
@@ -625,10 +773,10 @@ void DapServer::HandleSetBreakpoints(const JsonValue& request)
 			memset(data, 0, sizeof(BreakpointData));
 			data->id = bpId;
 			data->cpuType = primaryCpu;
-			data->memoryType = cpuMemType;
+			data->memoryType = bpAddr >= 0 ? bpMemType : cpuMemType;
 			data->type = BreakpointTypeFlags::Execute;
-			data->startAddr = addr;
-			data->endAddr = addr;
+			data->startAddr = bpAddr >= 0 ? bpAddr : addr;
+			data->endAddr = bpAddr >= 0 ? bpAddr : addr;
 			data->enabled = true;
 
 			// Condition support
@@ -915,9 +1063,8 @@ void DapServer::HandleWriteMemory(const JsonValue& request)
 	Debugger* dbg = req.GetDebugger();
 	if(dbg && !dataB64.empty()) {
 		std::vector<uint8_t> data = Base64Decode(dataB64);
-		for(size_t i = 0; i < data.size(); i++) {
-			dbg->GetMemoryDumper()->SetMemoryValue(cpuMemType, addr + (uint32_t)i, data[i]);
-		}
+		// Single bulk write: one undo entry and one disassembly cache invalidation pass
+		dbg->GetMemoryDumper()->SetMemoryValues(cpuMemType, addr, data.data(), (uint32_t)data.size());
 		auto body = JsonValue::MakeObject();
 		body.Set("bytesWritten", JsonValue::MakeNumber(data.size()));
 		resp.Set("body", std::move(body));
@@ -925,3 +1072,158 @@ void DapServer::HandleWriteMemory(const JsonValue& request)
 
 	SendResponse(std::move(resp));
 }
+
+// ── Custom requests ────────────────────────────────────────────────
+
+void DapServer::HandleProfile(const JsonValue& request)
+{
+	// arguments: { action: "start"|"stop"|"dump", format?: "folded"|"json", path?: string, threadId?: number }
+	// dump returns the profile in body.data, or writes it to "path" when given
+	const JsonValue& args = request["arguments"];
+	std::string action = args["action"].GetString();
+	std::string format = args["format"].GetString();
+	std::string path = args["path"].GetString();
+
+	auto cpuTypes = _emu->GetCpuTypes();
+	CpuType cpu = cpuTypes.empty() ? CpuType::Snes : cpuTypes[0];
+	if(args["threadId"].GetType() == JsonValue::Type::Number) {
+		cpu = ThreadIdToCpuType((int)args["threadId"].GetNumber());
+	}
+
+	auto resp = MakeResponse(request, true);
+
+	DebuggerRequest req = _emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	CallstackManager* csm = dbg ? dbg->GetCallstackManager(cpu) : nullptr;
+	if(!csm) {
+		resp.Set("success", JsonValue::MakeBool(false));
+		resp.Set("message", JsonValue::MakeString("Profiler not available"));
+		SendResponse(std::move(resp));
+		return;
+	}
+
+	Profiler* profiler = csm->GetProfiler();
+	auto body = JsonValue::MakeObject();
+	if(action == "start") {
+		profiler->Start();
+	} else if(action == "stop") {
+		profiler->Stop();
+	} else if(action == "dump") {
+		ProfilerExportFormat exportFormat = format == "json" ? ProfilerExportFormat::Json : ProfilerExportFormat::FoldedStacks;
+		std::ostringstream ss;
+		profiler->Export(ss, exportFormat, cpu);
+		if(path.empty()) {
+			body.Set("data", JsonValue::MakeString(ss.str()));
+		} else {
+			std::ofstream out(path, std::ios::binary);
+			if(!out) {
+				resp.Set("success", JsonValue::MakeBool(false));
+				resp.Set("message", JsonValue::MakeString("Failed to open " + path));
+				SendResponse(std::move(resp));
+				return;
+			}
+			out << ss.str();
+			body.Set("path", JsonValue::MakeString(path));
+		}
+	} else {
+		resp.Set("success", JsonValue::MakeBool(false));
+		resp.Set("message", JsonValue::MakeString("Unknown profile action: " + action));
+		SendResponse(std::move(resp));
+		return;
+	}
+
+	body.Set("enabled", JsonValue::MakeBool(profiler->IsEnabled()));
+	body.Set("functionCount", JsonValue::MakeNumber(profiler->GetFunctionCount()));
+	resp.Set("body", std::move(body));
+	SendResponse(std::move(resp));
+}
+
+void DapServer::HandleSnapshot(const JsonValue& request)
+{
+	// arguments: { action: "take"|"diff"|"list"|"delete", name?: string, from?: string, to?: string, memoryType?: string }
+	// diff returns body.changes = [{ memoryType, start, length, writer?: { threadId, address } }]
+	// memoryType uses the CLI's region names (e.g "wram"), all regions are compared when it's omitted
+	const JsonValue& args = request["arguments"];
+	std::string action = args["action"].GetString();
+	std::string name = args["name"].GetString();
+
+	auto resp = MakeResponse(request, true);
+	auto fail = [&](const std::string& msg) {
+		resp.Set("success", JsonValue::MakeBool(false));
+		resp.Set("message", JsonValue::MakeString(msg));
+		SendResponse(std::move(resp));
+	};
+
+	DebuggerRequest req = _emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	if(!dbg) {
+		fail("Debugger not available");
+		return;
+	}
+
+	MemorySnapshotManager* snapshots = dbg->GetMemorySnapshotManager();
+	auto regions = ConsoleInfo::GetMemoryRegions(_emu->GetConsoleType());
+	auto body = JsonValue::MakeObject();
+	if(action == "take") {
+		if(name.empty()) {
+			fail("Missing snapshot name");
+			return;
+		}
+		snapshots->TakeSnapshot(name);
+	} else if(action == "delete") {
+		snapshots->DeleteSnapshot(name);
+	} else if(action == "list") {
+		auto names = JsonValue::MakeArray();
+		for(auto& n : snapshots->GetSnapshotNames()) {
+			names.Push(JsonValue::MakeString(n));
+		}
+		body.Set("snapshots", std::move(names));
+	} else if(action == "diff") {
+		std::string from = args["from"].GetString();
+		std::string to = args["to"].GetString();
+		std::string type = args["memoryType"].GetString();
+		if(!snapshots->HasSnapshot(from) || !snapshots->HasSnapshot(to)) {
+			fail("Unknown snapshot");
+			return;
+		}
+
+		std::vector<MemoryDiffEntry> entries;
+		for(auto& r : regions) {
+			if(type.empty() || type == r.shortName) {
+				snapshots->Diff(from, to, r.type, entries);
+			}
+		}
+
+		auto changes = JsonValue::MakeArray();
+		uint32_t totalBytes = 0;
+		for(MemoryDiffEntry& entry : entries) {
+			auto change = JsonValue::MakeObject();
+			for(auto& r : regions) {
+				if(r.type == entry.Type) {
+					change.Set("memoryType", JsonValue::MakeString(r.shortName));
+					break;
+				}
+			}
+			change.Set("start", JsonValue::MakeNumber(entry.Start));
+			change.Set("length", JsonValue::MakeNumber(entry.Length));
+			if(entry.WriterAddress >= 0) {
+				auto writer = JsonValue::MakeObject();
+				char addrStr[16];
+				snprintf(addrStr, sizeof(addrStr), "0x%X", (uint32_t)entry.WriterAddress);
+				writer.Set("threadId", JsonValue::MakeNumber(CpuTypeToThreadId(entry.WriterCpu)));
+				writer.Set("address", JsonValue::MakeString(addrStr));
+				change.Set("writer", std::move(writer));
+			}
+			changes.Push(std::move(change));
+			totalBytes += entry.Length;
+		}
+		body.Set("changes", std::move(changes));
+		body.Set("totalBytes", JsonValue::MakeNumber(totalBytes));
+	} else {
+		fail("Unknown snapshot action: " + action);
+		return;
+	}
+
+	resp.Set("body", std::move(body));
+	SendResponse(std::move(resp));
+}
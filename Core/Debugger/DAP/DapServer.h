@@ -44,6 +44,9 @@ private:
 	// Breakpoint helpers
 	void SyncBreakpoints();
 
+	// Source mapping helpers (ROM-absolute lookups, CPU address fallback)
+	SourceLocation LookupSourceLocation(Debugger* dbg, CpuType cpu, uint32_t addr);
+
 	// Request handlers — Phase 1
 	void HandleInitialize(const JsonValue& request);
 	void HandleLaunch(const JsonValue& request);
@@ -62,12 +65,18 @@ private:
 	void HandleStepOut(const JsonValue& request);
 	void HandleSetBreakpoints(const JsonValue& request);
 	void HandleDisassemble(const JsonValue& request);
+	void HandleStepBack(const JsonValue& request);
+	void HandleReverseContinue(const JsonValue& request);
 
 	// Request handlers — Phase 4
 	void HandleEvaluate(const JsonValue& request);
 	void HandleReadMemory(const JsonValue& request);
 	void HandleWriteMemory(const JsonValue& request);
 
+	// Custom requests
+	void HandleProfile(const JsonValue& request);
+	void HandleSnapshot(const JsonValue& request);
+
 public:
 	DapServer(Emulator* emu, FILE* dapOutput = stdout);
 	~DapServer();
@@ -18,10 +18,15 @@ namespace DapCommand {
 	constexpr const char* StepOut = "stepOut";
 	constexpr const char* SetBreakpoints = "setBreakpoints";
 	constexpr const char* Disassemble = "disassemble";
+	constexpr const char* StepBack = "stepBack";
+	constexpr const char* ReverseContinue = "reverseContinue";
 	// Phase 4
 	constexpr const char* Evaluate = "evaluate";
 	constexpr const char* ReadMemory = "readMemory";
 	constexpr const char* WriteMemory = "writeMemory";
+	// Custom requests
+	constexpr const char* Profile = "profile";
+	constexpr const char* Snapshot = "snapshot";
 }
 
 namespace DapEvent {
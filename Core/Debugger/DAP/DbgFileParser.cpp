@@ -6,15 +6,15 @@
 #include <algorithm>
 
 // Parse comma-separated key=value pairs, calling callback for each
-void DbgFileParser::ParseKeyValue(const std::string& data,
-	void (*callback)(const std::string& key, const std::string& value, void* ctx), void* ctx)
+void DbgFileParser::ParseKeyValue(std::string_view data,
+	void (*callback)(std::string_view key, std::string_view value, void* ctx), void* ctx)
 {
 	size_t pos = 0;
 	while(pos < data.size()) {
 		size_t eq = data.find('=', pos);
-		if(eq == std::string::npos) break;
+		if(eq == std::string_view::npos) break;
 
-		std::string key = data.substr(pos, eq - pos);
+		std::string_view key = data.substr(pos, eq - pos);
 
 		size_t valStart = eq + 1;
 		size_t valEnd;
@@ -23,14 +23,14 @@ void DbgFileParser::ParseKeyValue(const std::string& data,
 		if(valStart < data.size() && data[valStart] == '"') {
 			valStart++;
 			valEnd = data.find('"', valStart);
-			if(valEnd == std::string::npos) valEnd = data.size();
+			if(valEnd == std::string_view::npos) valEnd = data.size();
 			callback(key, data.substr(valStart, valEnd - valStart), ctx);
 			// Skip past closing quote and comma
 			pos = valEnd + 1;
 			if(pos < data.size() && data[pos] == ',') pos++;
 		} else {
 			valEnd = data.find(',', valStart);
-			if(valEnd == std::string::npos) valEnd = data.size();
+			if(valEnd == std::string_view::npos) valEnd = data.size();
 			callback(key, data.substr(valStart, valEnd - valStart), ctx);
 			pos = valEnd;
 			if(pos < data.size() && data[pos] == ',') pos++;
@@ -38,24 +38,41 @@ void DbgFileParser::ParseKeyValue(const std::string& data,
 	}
 }
 
-static uint32_t ParseHexOrDec(const std::string& s)
+static int ParseInt(std::string_view s)
+{
+	int value = 0;
+	bool negative = !s.empty() && s[0] == '-';
+	for(size_t i = negative ? 1 : 0; i < s.size() && s[i] >= '0' && s[i] <= '9'; i++) {
+		value = value * 10 + (s[i] - '0');
+	}
+	return negative ? -value : value;
+}
+
+static uint32_t ParseHexOrDec(std::string_view s)
 {
 	if(s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
-		return (uint32_t)strtoul(s.c_str() + 2, nullptr, 16);
+		uint32_t value = 0;
+		for(size_t i = 2; i < s.size(); i++) {
+			char c = s[i];
+			if(c >= '0' && c <= '9') value = (value << 4) | (c - '0');
+			else if(c >= 'a' && c <= 'f') value = (value << 4) | (c - 'a' + 10);
+			else if(c >= 'A' && c <= 'F') value = (value << 4) | (c - 'A' + 10);
+			else break;
+		}
+		return value;
 	}
-	return (uint32_t)strtoul(s.c_str(), nullptr, 10);
+	return (uint32_t)ParseInt(s);
 }
 
-static std::vector<int> ParseIntList(const std::string& s)
+static std::vector<int> ParseIntList(std::string_view s)
 {
 	std::vector<int> result;
 	size_t pos = 0;
 	while(pos < s.size()) {
 		size_t next = s.find('+', pos);
-		if(next == std::string::npos) next = s.size();
-		std::string part = s.substr(pos, next - pos);
-		if(!part.empty()) {
-			result.push_back(atoi(part.c_str()));
+		if(next == std::string_view::npos) next = s.size();
+		if(next > pos) {
+			result.push_back(ParseInt(s.substr(pos, next - pos)));
 		}
 		pos = next + 1;
 	}
@@ -64,28 +81,38 @@ static std::vector<int> ParseIntList(const std::string& s)
 
 bool DbgFileParser::Parse(const std::string& path, DbgData& out)
 {
-	std::ifstream file(path);
+	std::ifstream file(path, std::ios::binary);
 	if(!file.is_open()) {
 		return false;
 	}
 
-	std::string line;
-	while(std::getline(file, line)) {
+	// Read the whole file at once, lines and key/value pairs are then views into this buffer
+	std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	std::string_view text(content);
+
+	size_t lineStart = 0;
+	while(lineStart < text.size()) {
+		size_t lineEnd = text.find('\n', lineStart);
+		if(lineEnd == std::string_view::npos) lineEnd = text.size();
+		std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+		lineStart = lineEnd + 1;
+
+		if(!line.empty() && line.back() == '\r') line.remove_suffix(1);
 		if(line.empty()) continue;
 
 		// Split on tab: "keyword\tkey=value,key=value,..."
 		size_t tab = line.find('\t');
-		if(tab == std::string::npos) continue;
+		if(tab == std::string_view::npos) continue;
 
-		std::string keyword = line.substr(0, tab);
-		std::string data = line.substr(tab + 1);
+		std::string_view keyword = line.substr(0, tab);
+		std::string_view data = line.substr(tab + 1);
 
 		if(keyword == "file") {
 			DbgFile f;
-			ParseKeyValue(data, [](const std::string& k, const std::string& v, void* ctx) {
+			ParseKeyValue(data, [](std::string_view k, std::string_view v, void* ctx) {
 				DbgFile* f = (DbgFile*)ctx;
-				if(k == "id") f->id = atoi(v.c_str());
-				else if(k == "name") f->name = v;
+				if(k == "id") f->id = ParseInt(v);
+				else if(k == "name") f->name = std::string(v);
 			}, &f);
 			if(f.id >= 0) {
 				if(f.id >= (int)out.files.size()) out.files.resize(f.id + 1);
@@ -93,13 +120,13 @@ bool DbgFileParser::Parse(const std::string& path, DbgData& out)
 			}
 		} else if(keyword == "seg") {
 			DbgSegment s;
-			ParseKeyValue(data, [](const std::string& k, const std::string& v, void* ctx) {
+			ParseKeyValue(data, [](std::string_view k, std::string_view v, void* ctx) {
 				DbgSegment* s = (DbgSegment*)ctx;
-				if(k == "id") s->id = atoi(v.c_str());
-				else if(k == "name") s->name = v;
+				if(k == "id") s->id = ParseInt(v);
+				else if(k == "name") s->name = std::string(v);
 				else if(k == "start") s->start = ParseHexOrDec(v);
 				else if(k == "size") s->size = ParseHexOrDec(v);
-				else if(k == "ooffs") s->ooffs = ParseHexOrDec(v);
+				else if(k == "ooffs") { s->ooffs = ParseHexOrDec(v); s->hasOutput = true; }
 			}, &s);
 			if(s.id >= 0) {
 				if(s.id >= (int)out.segments.size()) out.segments.resize(s.id + 1);
@@ -107,10 +134,10 @@ bool DbgFileParser::Parse(const std::string& path, DbgData& out)
 			}
 		} else if(keyword == "span") {
 			DbgSpan sp;
-			ParseKeyValue(data, [](const std::string& k, const std::string& v, void* ctx) {
+			ParseKeyValue(data, [](std::string_view k, std::string_view v, void* ctx) {
 				DbgSpan* sp = (DbgSpan*)ctx;
-				if(k == "id") sp->id = atoi(v.c_str());
-				else if(k == "seg") sp->segId = atoi(v.c_str());
+				if(k == "id") sp->id = ParseInt(v);
+				else if(k == "seg") sp->segId = ParseInt(v);
 				else if(k == "start") sp->start = ParseHexOrDec(v);
 				else if(k == "size") sp->size = ParseHexOrDec(v);
 			}, &sp);
@@ -120,14 +147,14 @@ bool DbgFileParser::Parse(const std::string& path, DbgData& out)
 			}
 		} else if(keyword == "line") {
 			DbgLine l;
-			std::string spanStr;
-			struct LineCtx { DbgLine* l; std::string* spanStr; };
+			std::string_view spanStr;
+			struct LineCtx { DbgLine* l; std::string_view* spanStr; };
 			LineCtx ctx{&l, &spanStr};
-			ParseKeyValue(data, [](const std::string& k, const std::string& v, void* c) {
+			ParseKeyValue(data, [](std::string_view k, std::string_view v, void* c) {
 				LineCtx* ctx = (LineCtx*)c;
-				if(k == "id") ctx->l->id = atoi(v.c_str());
-				else if(k == "file") ctx->l->fileId = atoi(v.c_str());
-				else if(k == "line") ctx->l->line = atoi(v.c_str());
+				if(k == "id") ctx->l->id = ParseInt(v);
+				else if(k == "file") ctx->l->fileId = ParseInt(v);
+				else if(k == "line") ctx->l->line = ParseInt(v);
 				else if(k == "span") *ctx->spanStr = v;
 			}, &ctx);
 			if(!spanStr.empty()) {
@@ -139,15 +166,15 @@ bool DbgFileParser::Parse(const std::string& path, DbgData& out)
 			}
 		} else if(keyword == "sym") {
 			DbgSymbol sym;
-			ParseKeyValue(data, [](const std::string& k, const std::string& v, void* ctx) {
+			ParseKeyValue(data, [](std::string_view k, std::string_view v, void* ctx) {
 				DbgSymbol* sym = (DbgSymbol*)ctx;
-				if(k == "id") sym->id = atoi(v.c_str());
-				else if(k == "name") sym->name = v;
+				if(k == "id") sym->id = ParseInt(v);
+				else if(k == "name") sym->name = std::string(v);
 				else if(k == "val") sym->val = ParseHexOrDec(v);
-				else if(k == "seg") sym->segId = atoi(v.c_str());
-				else if(k == "type") sym->type = v;
+				else if(k == "seg") sym->segId = ParseInt(v);
+				else if(k == "type") sym->type = std::string(v);
 				else if(k == "size") sym->size = ParseHexOrDec(v);
-				else if(k == "scope") sym->scopeId = atoi(v.c_str());
+				else if(k == "scope") sym->scopeId = ParseInt(v);
 			}, &sym);
 			if(sym.id >= 0) {
 				if(sym.id >= (int)out.symbols.size()) out.symbols.resize(sym.id + 1);
@@ -155,12 +182,12 @@ bool DbgFileParser::Parse(const std::string& path, DbgData& out)
 			}
 		} else if(keyword == "scope") {
 			DbgScope sc;
-			ParseKeyValue(data, [](const std::string& k, const std::string& v, void* ctx) {
+			ParseKeyValue(data, [](std::string_view k, std::string_view v, void* ctx) {
 				DbgScope* sc = (DbgScope*)ctx;
-				if(k == "id") sc->id = atoi(v.c_str());
-				else if(k == "name") sc->name = v;
-				else if(k == "parent") sc->parentId = atoi(v.c_str());
-				else if(k == "sym") sc->symId = atoi(v.c_str());
+				if(k == "id") sc->id = ParseInt(v);
+				else if(k == "name") sc->name = std::string(v);
+				else if(k == "parent") sc->parentId = ParseInt(v);
+				else if(k == "sym") sc->symId = ParseInt(v);
 				else if(k == "size") sc->size = ParseHexOrDec(v);
 			}, &sc);
 			if(sc.id >= 0) {
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
 
@@ -9,6 +10,7 @@ struct DbgSegment {
 	uint32_t start = 0;   // CPU base address
 	uint32_t size = 0;
 	uint32_t ooffs = 0;   // ROM file offset
+	bool hasOutput = false; // ooffs is only set for segments written to the output file
 };
 
 struct DbgFile {
@@ -62,6 +64,6 @@ public:
 	static bool Parse(const std::string& path, DbgData& out);
 
 private:
-	static void ParseKeyValue(const std::string& data,
-		void (*callback)(const std::string& key, const std::string& value, void* ctx), void* ctx);
+	static void ParseKeyValue(std::string_view data,
+		void (*callback)(std::string_view key, std::string_view value, void* ctx), void* ctx);
 };
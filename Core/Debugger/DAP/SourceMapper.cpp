@@ -2,38 +2,102 @@
 #include "DbgFileParser.h"
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	constexpr uint32_t CacheVersion = 1;
+
+	struct CacheHeader {
+		char magic[4];
+		uint32_t version;
+		uint64_t dbgSize;
+		int64_t dbgTime;
+		uint32_t cpuSpanCount;
+		uint32_t romSpanCount;
+		uint32_t fileLineCount;
+		uint32_t symbolCount;
+		uint32_t fileCount;
+		uint32_t stringSize;
+	};
+	static_assert(sizeof(CacheHeader) % 4 == 0, "Cache tables must stay 4-byte aligned");
+}
+
+SourceMapper::~SourceMapper()
+{
+	ReleaseCache();
+}
+
+void SourceMapper::Reset()
+{
+	ReleaseCache();
+	_owned = OwnedTables();
+	_cpuIndex = IntervalIndex();
+	_romIndex = IntervalIndex();
+	_fileLines = {};
+	_symbols = {};
+	_strings = nullptr;
+	_fileNames.clear();
+	_fileNameToId.clear();
+	_loaded = false;
+	_loadedFromCache = false;
+}
 
 bool SourceMapper::LoadDbgFile(const std::string& path)
 {
-	DbgData data;
-	if(!DbgFileParser::Parse(path, data)) {
+	Reset();
+
+	std::error_code ec;
+	uint64_t dbgSize = std::filesystem::file_size(path, ec);
+	if(ec) {
 		return false;
 	}
+	int64_t dbgTime = (int64_t)std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+	std::string cachePath = path + ".idx";
 
-	// Build file name list and reverse lookup
-	_fileNames.clear();
-	_fileNameToId.clear();
+	if(LoadCache(cachePath, dbgSize, dbgTime)) {
+		_loadedFromCache = true;
+	} else {
+		DbgData data;
+		if(!DbgFileParser::Parse(path, data)) {
+			return false;
+		}
+		BuildTables(data);
+		UseOwnedTables();
+		SaveCache(cachePath, dbgSize, dbgTime);
+	}
+
+	_loaded = true;
+	fprintf(stderr, "[DAP] Loaded .dbg%s: %zu files, %u spans, %u symbols\n",
+		_loadedFromCache ? " (cached index)" : "", _fileNames.size(), _cpuIndex.spans.count, _symbols.count);
+	return true;
+}
+
+void SourceMapper::BuildTables(DbgData& data)
+{
+	OwnedTables& t = _owned;
+
+	// File names, indexed by file id
 	for(auto& f : data.files) {
 		if(f.id < 0) continue;
-		if(f.id >= (int)_fileNames.size()) _fileNames.resize(f.id + 1);
-		_fileNames[f.id] = f.name;
-		_fileNameToId[f.name] = f.id;
-
-		// Also index by basename for matching source breakpoints
-		size_t slash = f.name.find_last_of("/\\");
-		if(slash != std::string::npos) {
-			_fileNameToId[f.name.substr(slash + 1)] = f.id;
-		}
+		if(f.id >= (int)t.files.size()) t.files.resize(f.id + 1, StringRef{0, 0});
+		t.files[f.id] = StringRef{(uint32_t)t.strings.size(), (uint32_t)f.name.size()};
+		t.strings += f.name;
 	}
 
 	// Build address spans from lines → spans → segments
-	_addrSpans.clear();
-	_fileLineToAddr.clear();
-
 	for(auto& line : data.lines) {
 		if(line.fileId < 0 || line.spanIds.empty()) continue;
 
-		uint32_t firstAddr = 0xFFFFFFFF;
+		FileLineEntry entry{line.fileId, line.line, InvalidAddress, InvalidAddress};
 
 		for(int spanId : line.spanIds) {
 			if(spanId < 0 || spanId >= (int)data.spans.size()) continue;
@@ -50,89 +114,277 @@ bool SourceMapper::LoadDbgFile(const std::string& path)
 			uint32_t offsetInBank = romOffset % bankSize;
 			uint32_t addr = (bank << 16) | ((seg.start & 0xFFFF) + offsetInBank);
 
-			AddrSpan as;
-			as.addr = addr;
-			as.size = span.size;
-			as.fileId = line.fileId;
-			as.line = line.line;
-			_addrSpans.push_back(as);
+			t.cpuSpans.push_back(AddrSpan{addr, span.size, line.fileId, line.line});
+			entry.addr = std::min(entry.addr, addr);
 
-			if(addr < firstAddr) {
-				firstAddr = addr;
+			if(seg.hasOutput) {
+				t.romSpans.push_back(AddrSpan{romOffset, span.size, line.fileId, line.line});
+				entry.romOffset = std::min(entry.romOffset, romOffset);
 			}
 		}
 
-		// Map file+line → first address
-		if(firstAddr != 0xFFFFFFFF) {
-			FileLineKey key{line.fileId, line.line};
-			auto it = _fileLineToAddr.find(key);
-			if(it == _fileLineToAddr.end() || firstAddr < it->second) {
-				_fileLineToAddr[key] = firstAddr;
-			}
+		if(entry.addr != InvalidAddress) {
+			t.fileLines.push_back(entry);
 		}
 	}
 
-	// Sort address spans for binary search
-	std::sort(_addrSpans.begin(), _addrSpans.end(),
-		[](const AddrSpan& a, const AddrSpan& b) { return a.addr < b.addr; });
+	auto buildIndex = [](std::vector<AddrSpan>& spans, std::vector<uint32_t>& maxEnd) {
+		std::stable_sort(spans.begin(), spans.end(),
+			[](const AddrSpan& a, const AddrSpan& b) { return a.addr < b.addr; });
+		maxEnd.resize(spans.size());
+		uint32_t end = 0;
+		for(size_t i = 0; i < spans.size(); i++) {
+			end = std::max(end, spans[i].addr + spans[i].size);
+			maxEnd[i] = end;
+		}
+	};
+	buildIndex(t.cpuSpans, t.cpuMaxEnd);
+	buildIndex(t.romSpans, t.romMaxEnd);
+
+	// File+line → lowest address, one entry per line
+	std::sort(t.fileLines.begin(), t.fileLines.end(), [](const FileLineEntry& a, const FileLineEntry& b) {
+		return a.fileId != b.fileId ? a.fileId < b.fileId : a.line < b.line;
+	});
+	size_t count = 0;
+	for(const FileLineEntry& entry : t.fileLines) {
+		if(count > 0 && t.fileLines[count - 1].fileId == entry.fileId && t.fileLines[count - 1].line == entry.line) {
+			FileLineEntry& prev = t.fileLines[count - 1];
+			prev.addr = std::min(prev.addr, entry.addr);
+			prev.romOffset = std::min(prev.romOffset, entry.romOffset);
+		} else {
+			t.fileLines[count++] = entry;
+		}
+	}
+	t.fileLines.resize(count);
 
 	// Build symbol table
-	_symbols.clear();
 	for(auto& sym : data.symbols) {
 		if(sym.name.empty() || sym.type != "lab") continue;
-		SymEntry entry;
-		entry.addr = sym.val;
-		entry.size = sym.size;
-		entry.name = sym.name;
-		_symbols.push_back(entry);
+		t.symbols.push_back(SymEntry{sym.val, sym.size, (uint32_t)t.strings.size(), (uint32_t)sym.name.size()});
+		t.strings += sym.name;
 	}
-	std::sort(_symbols.begin(), _symbols.end(),
+	std::stable_sort(t.symbols.begin(), t.symbols.end(),
 		[](const SymEntry& a, const SymEntry& b) { return a.addr < b.addr; });
+}
 
-	_loaded = true;
-	fprintf(stderr, "[DAP] Loaded .dbg: %zu files, %zu spans, %zu symbols\n",
-		_fileNames.size(), _addrSpans.size(), _symbols.size());
+void SourceMapper::UseOwnedTables()
+{
+	_cpuIndex.spans = {_owned.cpuSpans.data(), (uint32_t)_owned.cpuSpans.size()};
+	_cpuIndex.maxEnd = {_owned.cpuMaxEnd.data(), (uint32_t)_owned.cpuMaxEnd.size()};
+	_romIndex.spans = {_owned.romSpans.data(), (uint32_t)_owned.romSpans.size()};
+	_romIndex.maxEnd = {_owned.romMaxEnd.data(), (uint32_t)_owned.romMaxEnd.size()};
+	_fileLines = {_owned.fileLines.data(), (uint32_t)_owned.fileLines.size()};
+	_symbols = {_owned.symbols.data(), (uint32_t)_owned.symbols.size()};
+	_strings = _owned.strings.data();
+	BuildFileNames(_owned.files.data(), (uint32_t)_owned.files.size());
+}
+
+void SourceMapper::BuildFileNames(const StringRef* files, uint32_t fileCount)
+{
+	_fileNames.resize(fileCount);
+	for(uint32_t id = 0; id < fileCount; id++) {
+		_fileNames[id].assign(_strings + files[id].offset, files[id].length);
+		const std::string& name = _fileNames[id];
+		if(name.empty()) continue;
+		_fileNameToId[name] = id;
+
+		// Also index by basename for matching source breakpoints
+		size_t slash = name.find_last_of("/\\");
+		if(slash != std::string::npos) {
+			_fileNameToId[name.substr(slash + 1)] = id;
+		}
+	}
+}
+
+bool SourceMapper::LoadCache(const std::string& cachePath, uint64_t dbgSize, int64_t dbgTime)
+{
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+
+#ifndef _WIN32
+	int fd = open(cachePath.c_str(), O_RDONLY);
+	if(fd < 0) {
+		return false;
+	}
+	struct stat st;
+	if(fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(CacheHeader)) {
+		void* mapped = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(mapped != MAP_FAILED) {
+			_mappedData = mapped;
+			_mappedSize = (size_t)st.st_size;
+			data = (const uint8_t*)mapped;
+			size = _mappedSize;
+		}
+	}
+	close(fd);
+#else
+	std::ifstream file(cachePath, std::ios::binary);
+	if(file) {
+		_cacheBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		data = _cacheBuffer.data();
+		size = _cacheBuffer.size();
+	}
+#endif
+
+	if(!data || size < sizeof(CacheHeader)) {
+		ReleaseCache();
+		return false;
+	}
+
+	CacheHeader header;
+	memcpy(&header, data, sizeof(header));
+	if(memcmp(header.magic, "MDBI", 4) != 0 || header.version != CacheVersion || header.dbgSize != dbgSize || header.dbgTime != dbgTime) {
+		ReleaseCache();
+		return false;
+	}
+
+	uint64_t expectedSize = sizeof(CacheHeader) +
+		(uint64_t)header.cpuSpanCount * (sizeof(AddrSpan) + sizeof(uint32_t)) +
+		(uint64_t)header.romSpanCount * (sizeof(AddrSpan) + sizeof(uint32_t)) +
+		(uint64_t)header.fileLineCount * sizeof(FileLineEntry) +
+		(uint64_t)header.symbolCount * sizeof(SymEntry) +
+		(uint64_t)header.fileCount * sizeof(StringRef) +
+		header.stringSize;
+	if(expectedSize != size) {
+		ReleaseCache();
+		return false;
+	}
+
+	const uint8_t* pos = data + sizeof(CacheHeader);
+	auto take = [&pos](auto& table, uint32_t count) {
+		table.data = (decltype(table.data))pos;
+		table.count = count;
+		pos += (size_t)count * sizeof(*table.data);
+	};
+	take(_cpuIndex.spans, header.cpuSpanCount);
+	take(_cpuIndex.maxEnd, header.cpuSpanCount);
+	take(_romIndex.spans, header.romSpanCount);
+	take(_romIndex.maxEnd, header.romSpanCount);
+	take(_fileLines, header.fileLineCount);
+	take(_symbols, header.symbolCount);
+	Table<StringRef> files;
+	take(files, header.fileCount);
+	_strings = (const char*)pos;
+
+	// Reject string references that point outside of the string table
+	for(const StringRef& ref : files) {
+		if((uint64_t)ref.offset + ref.length > header.stringSize) {
+			Reset();
+			return false;
+		}
+	}
+	for(const SymEntry& sym : _symbols) {
+		if((uint64_t)sym.nameOffset + sym.nameLength > header.stringSize) {
+			Reset();
+			return false;
+		}
+	}
+
+	BuildFileNames(files.data, files.count);
 	return true;
 }
 
-SourceLocation SourceMapper::GetSourceLocation(uint32_t cpuAddr) const
+void SourceMapper::SaveCache(const std::string& cachePath, uint64_t dbgSize, int64_t dbgTime) const
 {
-	if(_addrSpans.empty()) return {};
-
-	// Binary search: find the last span where addr <= cpuAddr
-	auto it = std::upper_bound(_addrSpans.begin(), _addrSpans.end(), cpuAddr,
-		[](uint32_t addr, const AddrSpan& span) { return addr < span.addr; });
-
-	// Check spans around this position (may need to check multiple since
-	// spans can overlap and we want the smallest containing span)
-	SourceLocation best;
-	uint32_t bestSize = 0xFFFFFFFF;
-
-	// Search backwards from upper_bound position
-	auto checkIt = it;
-	while(checkIt != _addrSpans.begin()) {
-		--checkIt;
-		if(checkIt->addr + checkIt->size <= cpuAddr) {
-			// This span ends before our address and all prior spans have
-			// even lower addresses, so we can stop
-			if(checkIt->addr + 256 < cpuAddr) break; // heuristic: stop if too far
-		}
-		if(cpuAddr >= checkIt->addr && cpuAddr < checkIt->addr + checkIt->size) {
-			if(checkIt->size < bestSize) {
-				bestSize = checkIt->size;
-				best.valid = true;
-				best.line = checkIt->line;
-				if(checkIt->fileId >= 0 && checkIt->fileId < (int)_fileNames.size()) {
-					best.file = _fileNames[checkIt->fileId];
-				}
-			}
+	const OwnedTables& t = _owned;
+
+	CacheHeader header = {};
+	memcpy(header.magic, "MDBI", 4);
+	header.version = CacheVersion;
+	header.dbgSize = dbgSize;
+	header.dbgTime = dbgTime;
+	header.cpuSpanCount = (uint32_t)t.cpuSpans.size();
+	header.romSpanCount = (uint32_t)t.romSpans.size();
+	header.fileLineCount = (uint32_t)t.fileLines.size();
+	header.symbolCount = (uint32_t)t.symbols.size();
+	header.fileCount = (uint32_t)t.files.size();
+	header.stringSize = (uint32_t)t.strings.size();
+
+	// Write to a temporary file first so a concurrent reader never sees a partial cache.
+	// The cache is optional, failures (e.g. read-only folder) are ignored.
+	std::string tmpPath = cachePath + ".tmp";
+	{
+		std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+		if(!out) {
+			return;
+		}
+		auto write = [&out](const void* src, size_t size) { out.write((const char*)src, size); };
+		write(&header, sizeof(header));
+		write(t.cpuSpans.data(), t.cpuSpans.size() * sizeof(AddrSpan));
+		write(t.cpuMaxEnd.data(), t.cpuMaxEnd.size() * sizeof(uint32_t));
+		write(t.romSpans.data(), t.romSpans.size() * sizeof(AddrSpan));
+		write(t.romMaxEnd.data(), t.romMaxEnd.size() * sizeof(uint32_t));
+		write(t.fileLines.data(), t.fileLines.size() * sizeof(FileLineEntry));
+		write(t.symbols.data(), t.symbols.size() * sizeof(SymEntry));
+		write(t.files.data(), t.files.size() * sizeof(StringRef));
+		write(t.strings.data(), t.strings.size());
+		if(!out) {
+			out.close();
+			std::remove(tmpPath.c_str());
+			return;
 		}
 	}
 
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, cachePath, ec);
+	if(ec) {
+		std::remove(tmpPath.c_str());
+	}
+}
+
+void SourceMapper::ReleaseCache()
+{
+#ifndef _WIN32
+	if(_mappedData) {
+		munmap(_mappedData, _mappedSize);
+	}
+#endif
+	_mappedData = nullptr;
+	_mappedSize = 0;
+	_cacheBuffer.clear();
+}
+
+const SourceMapper::AddrSpan* SourceMapper::IntervalIndex::Find(uint32_t addr) const
+{
+	// Last span that starts at or before addr
+	const AddrSpan* it = std::upper_bound(spans.begin(), spans.end(), addr,
+		[](uint32_t a, const AddrSpan& span) { return a < span.addr; });
+
+	// Walk back while some earlier span still reaches addr, keeping the smallest containing span
+	const AddrSpan* best = nullptr;
+	for(uint32_t i = (uint32_t)(it - spans.begin()); i > 0 && maxEnd.data[i - 1] > addr; i--) {
+		const AddrSpan& span = spans.data[i - 1];
+		if(addr < span.addr + span.size && (!best || span.size < best->size)) {
+			best = &span;
+		}
+	}
 	return best;
 }
 
-uint32_t SourceMapper::GetAddress(const std::string& file, int line) const
+SourceLocation SourceMapper::ToLocation(const AddrSpan* span) const
+{
+	SourceLocation loc;
+	if(span) {
+		loc.valid = true;
+		loc.line = span->line;
+		if(span->fileId >= 0 && span->fileId < (int)_fileNames.size()) {
+			loc.file = _fileNames[span->fileId];
+		}
+	}
+	return loc;
+}
+
+SourceLocation SourceMapper::GetSourceLocation(uint32_t cpuAddr) const
+{
+	return ToLocation(_cpuIndex.Find(cpuAddr));
+}
+
+SourceLocation SourceMapper::GetSourceLocationByRomOffset(uint32_t romOffset) const
+{
+	return ToLocation(_romIndex.Find(romOffset));
+}
+
+const SourceMapper::FileLineEntry* SourceMapper::FindLine(const std::string& file, int line, bool needRomOffset) const
 {
 	// Try full path first
 	auto fileIt = _fileNameToId.find(file);
@@ -145,43 +397,64 @@ uint32_t SourceMapper::GetAddress(const std::string& file, int line) const
 	}
 
 	if(fileIt == _fileNameToId.end()) {
-		return 0xFFFFFFFF;
+		return nullptr;
 	}
 
+	int fileId = fileIt->second;
+	auto find = [&](int l) -> const FileLineEntry* {
+		const FileLineEntry* it = std::lower_bound(_fileLines.begin(), _fileLines.end(), std::make_pair(fileId, l),
+			[](const FileLineEntry& e, const std::pair<int, int>& key) {
+				return e.fileId != key.first ? e.fileId < key.first : e.line < key.second;
+			});
+		if(it != _fileLines.end() && it->fileId == fileId && it->line == l && (!needRomOffset || it->romOffset != InvalidAddress)) {
+			return it;
+		}
+		return nullptr;
+	};
+
 	// Exact line match
-	auto it = _fileLineToAddr.find(FileLineKey{fileIt->second, line});
-	if(it != _fileLineToAddr.end()) {
-		return it->second;
+	if(const FileLineEntry* entry = find(line)) {
+		return entry;
 	}
 
 	// Search nearby lines (within +5 lines) for closest match
 	for(int delta = 1; delta <= 5; delta++) {
-		it = _fileLineToAddr.find(FileLineKey{fileIt->second, line + delta});
-		if(it != _fileLineToAddr.end()) return it->second;
-		it = _fileLineToAddr.find(FileLineKey{fileIt->second, line - delta});
-		if(it != _fileLineToAddr.end()) return it->second;
+		if(const FileLineEntry* entry = find(line + delta)) return entry;
+		if(const FileLineEntry* entry = find(line - delta)) return entry;
 	}
 
-	return 0xFFFFFFFF;
+	return nullptr;
+}
+
+uint32_t SourceMapper::GetAddress(const std::string& file, int line) const
+{
+	const FileLineEntry* entry = FindLine(file, line, false);
+	return entry ? entry->addr : InvalidAddress;
+}
+
+uint32_t SourceMapper::GetRomOffset(const std::string& file, int line) const
+{
+	const FileLineEntry* entry = FindLine(file, line, true);
+	return entry ? entry->romOffset : InvalidAddress;
 }
 
 std::string SourceMapper::GetSymbolName(uint32_t cpuAddr) const
 {
-	if(_symbols.empty()) return "";
+	if(_symbols.count == 0) return "";
 
 	// Binary search for exact match
-	auto it = std::lower_bound(_symbols.begin(), _symbols.end(), cpuAddr,
+	const SymEntry* it = std::lower_bound(_symbols.begin(), _symbols.end(), cpuAddr,
 		[](const SymEntry& sym, uint32_t addr) { return sym.addr < addr; });
 
 	if(it != _symbols.end() && it->addr == cpuAddr) {
-		return it->name;
+		return std::string(_strings + it->nameOffset, it->nameLength);
 	}
 
 	// Check if the address falls within a sized symbol
 	if(it != _symbols.begin()) {
 		--it;
 		if(it->size > 0 && cpuAddr >= it->addr && cpuAddr < it->addr + it->size) {
-			return it->name;
+			return std::string(_strings + it->nameOffset, it->nameLength);
 		}
 	}
 
@@ -14,58 +14,138 @@ struct SourceLocation {
 
 class SourceMapper {
 public:
+	static constexpr uint32_t InvalidAddress = 0xFFFFFFFF;
+
+	SourceMapper() = default;
+	~SourceMapper();
+	SourceMapper(const SourceMapper&) = delete;
+	SourceMapper& operator=(const SourceMapper&) = delete;
+
+	// Loads the binary index cached next to the .dbg file (<path>.idx) when it matches
+	// the .dbg file's size and modification time, otherwise parses the .dbg and rewrites the cache
 	bool LoadDbgFile(const std::string& path);
 
 	// Address → source
 	SourceLocation GetSourceLocation(uint32_t cpuAddr) const;
 
+	// ROM offset (offset in the linker's output file) → source.
+	// Unlike CPU addresses, ROM offsets are unique across banks.
+	SourceLocation GetSourceLocationByRomOffset(uint32_t romOffset) const;
+
 	// Source → address
 	uint32_t GetAddress(const std::string& file, int line) const;
 
+	// Source → ROM offset (InvalidAddress if the line isn't in a segment written to the ROM)
+	uint32_t GetRomOffset(const std::string& file, int line) const;
+
 	// Symbol lookup
 	std::string GetSymbolName(uint32_t cpuAddr) const;
 
 	bool IsLoaded() const { return _loaded; }
+	bool IsLoadedFromCache() const { return _loadedFromCache; }
 
 	// Get all source files
 	const std::vector<std::string>& GetSourceFiles() const { return _fileNames; }
 
-private:
-	bool _loaded = false;
+	// Calls callback(fileId, line, romOffset, size) for each span written to the ROM
+	template<typename Func>
+	void ForEachRomSpan(Func&& callback) const
+	{
+		for(const AddrSpan& span : _romIndex.spans) {
+			callback(span.fileId, span.line, span.addr, span.size);
+		}
+	}
 
-	// Sorted by address for binary search
+private:
+	// All index records are plain 32-bit fields so the tables can be used directly from the mapped cache file
 	struct AddrSpan {
-		uint32_t addr;     // CPU address (segment.start + span.start)
+		uint32_t addr;     // CPU address or ROM offset
 		uint32_t size;
-		int fileId;
-		int line;
+		int32_t fileId;
+		int32_t line;
 	};
-	std::vector<AddrSpan> _addrSpans;  // sorted by addr
 
-	// File+line → address
-	struct FileLineKey {
-		int fileId;
-		int line;
-		bool operator==(const FileLineKey& o) const { return fileId == o.fileId && line == o.line; }
-	};
-	struct FileLineHash {
-		size_t operator()(const FileLineKey& k) const {
-			return std::hash<int>()(k.fileId) ^ (std::hash<int>()(k.line) << 16);
-		}
+	struct FileLineEntry {
+		int32_t fileId;
+		int32_t line;
+		uint32_t addr;      // lowest CPU address of the line
+		uint32_t romOffset; // lowest ROM offset of the line
 	};
-	std::unordered_map<FileLineKey, uint32_t, FileLineHash> _fileLineToAddr;
 
-	// Symbol lookup: sorted by address
 	struct SymEntry {
 		uint32_t addr;
 		uint32_t size;
-		std::string name;
+		uint32_t nameOffset; // offset/length in the string table
+		uint32_t nameLength;
+	};
+
+	struct StringRef {
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	template<typename T>
+	struct Table {
+		const T* data = nullptr;
+		uint32_t count = 0;
+
+		const T* begin() const { return data; }
+		const T* end() const { return data + count; }
+	};
+
+	// Spans sorted by start address, maxEnd[i] is the highest end address of spans [0, i].
+	// A lookup walks back from the last span starting at or before the address and stops
+	// as soon as no earlier span can reach it, which makes the lookup exact without scanning everything.
+	struct IntervalIndex {
+		Table<AddrSpan> spans;
+		Table<uint32_t> maxEnd;
+
+		const AddrSpan* Find(uint32_t addr) const;
 	};
-	std::vector<SymEntry> _symbols;  // sorted by addr
+
+	// Storage for tables built from a freshly parsed .dbg file
+	struct OwnedTables {
+		std::vector<AddrSpan> cpuSpans;
+		std::vector<uint32_t> cpuMaxEnd;
+		std::vector<AddrSpan> romSpans;
+		std::vector<uint32_t> romMaxEnd;
+		std::vector<FileLineEntry> fileLines;
+		std::vector<SymEntry> symbols;
+		std::vector<StringRef> files;
+		std::string strings;
+	};
+
+	bool _loaded = false;
+	bool _loadedFromCache = false;
+
+	IntervalIndex _cpuIndex;
+	IntervalIndex _romIndex;
+	Table<FileLineEntry> _fileLines;  // sorted by fileId, line
+	Table<SymEntry> _symbols;         // sorted by addr
+	const char* _strings = nullptr;
+
+	OwnedTables _owned;
+
+	// Cache file mapping (or buffer when memory mapping isn't available)
+	void* _mappedData = nullptr;
+	size_t _mappedSize = 0;
+	std::vector<uint8_t> _cacheBuffer;
 
 	// File paths
 	std::vector<std::string> _fileNames;
 
 	// File name → id mapping (for resolving source breakpoints)
 	std::unordered_map<std::string, int> _fileNameToId;
+
+	void Reset();
+	void BuildTables(DbgData& data);
+	void UseOwnedTables();
+	void BuildFileNames(const StringRef* files, uint32_t fileCount);
+
+	bool LoadCache(const std::string& cachePath, uint64_t dbgSize, int64_t dbgTime);
+	void SaveCache(const std::string& cachePath, uint64_t dbgSize, int64_t dbgTime) const;
+	void ReleaseCache();
+
+	const FileLineEntry* FindLine(const std::string& file, int line, bool needRomOffset) const;
+	SourceLocation ToLocation(const AddrSpan* span) const;
 };
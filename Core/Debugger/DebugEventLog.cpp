@@ -0,0 +1,52 @@
+#include "pch.h"
+#include "Debugger/DebugEventLog.h"
+#include "Debugger/DebugEventStore.h"
+
+template<typename T>
+static void WriteValue(uint8_t*& out, T value)
+{
+	for(size_t i = 0; i < sizeof(T); i++) {
+		*out++ = (uint8_t)((uint64_t)value >> (i * 8));
+	}
+}
+
+bool DebugEventLog::Open(string path)
+{
+	_stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!_stream) {
+		return false;
+	}
+
+	uint8_t header[8];
+	uint8_t* out = header;
+	memcpy(out, "MEVL", 4);
+	out += 4;
+	WriteValue<uint32_t>(out, Version);
+	_stream.write((char*)header, sizeof(header));
+	return true;
+}
+
+void DebugEventLog::WriteFrame(uint32_t frameNumber, DebugEventStore& store, uint32_t count)
+{
+	_buffer.resize(8 + count * RecordSize);
+	uint8_t* out = _buffer.data();
+	WriteValue<uint32_t>(out, frameNumber);
+	WriteValue<uint32_t>(out, count);
+
+	for(uint32_t i = 0; i < count; i++) {
+		DebugEventInfo evt = store.Get(i);
+		WriteValue<uint8_t>(out, (uint8_t)evt.Type);
+		WriteValue<uint8_t>(out, (uint8_t)evt.Operation.Type);
+		WriteValue<uint8_t>(out, (uint8_t)evt.Operation.MemType);
+		WriteValue<int8_t>(out, evt.DmaChannel);
+		WriteValue<int16_t>(out, evt.Scanline);
+		WriteValue<uint16_t>(out, evt.Cycle);
+		WriteValue<uint32_t>(out, evt.ProgramCounter);
+		WriteValue<uint32_t>(out, evt.Operation.Address);
+		WriteValue<int32_t>(out, evt.Operation.Value);
+		WriteValue<int16_t>(out, evt.BreakpointId);
+		WriteValue<uint16_t>(out, (uint16_t)evt.Flags);
+	}
+
+	_stream.write((char*)_buffer.data(), _buffer.size());
+}
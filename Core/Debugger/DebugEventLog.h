@@ -0,0 +1,24 @@
+#pragma once
+#include "pch.h"
+#include <fstream>
+
+class DebugEventStore;
+
+//Streams the events of each frame to a binary file.
+//File layout (little endian): "MEVL", uint32 version, then 1 block per frame:
+//  uint32 frame number, uint32 event count, followed by event count records of RecordSize bytes:
+//  uint8 type, uint8 operation type, uint8 memory type, int8 DMA channel, int16 scanline, uint16 cycle,
+//  uint32 program counter, uint32 address, int32 value, int16 breakpoint id, uint16 flags
+class DebugEventLog
+{
+private:
+	std::ofstream _stream;
+	vector<uint8_t> _buffer;
+
+public:
+	static constexpr uint32_t Version = 1;
+	static constexpr uint32_t RecordSize = 24;
+
+	bool Open(string path);
+	void WriteFrame(uint32_t frameNumber, DebugEventStore& store, uint32_t count);
+};
@@ -0,0 +1,106 @@
+#include "pch.h"
+#include "Debugger/DebugEventStore.h"
+
+static uint64_t GetDmaConfigKey(DmaChannelConfig& cfg)
+{
+	//Hashed field by field (the struct has padding bytes)
+	uint64_t key = cfg.SrcAddress | ((uint64_t)cfg.TransferSize << 16) | ((uint64_t)cfg.HdmaTableAddress << 32) | ((uint64_t)cfg.SrcBank << 48) | ((uint64_t)cfg.DestAddress << 56);
+	uint64_t flags = cfg.DmaActive | (cfg.InvertDirection << 1) | (cfg.Decrement << 2) | (cfg.FixedTransfer << 3) | (cfg.HdmaIndirectAddressing << 4) |
+		(cfg.DoTransfer << 5) | (cfg.HdmaFinished << 6) | (cfg.UnusedControlFlag << 7) | (cfg.TransferMode << 8) | (cfg.HdmaBank << 16) |
+		(cfg.HdmaLineCounterAndRepeat << 24) | ((uint64_t)cfg.UnusedRegister << 32);
+	return key ^ (flags * 0x9E3779B97F4A7C15ull);
+}
+
+static bool IsSameDmaConfig(DmaChannelConfig& a, DmaChannelConfig& b)
+{
+	return (
+		a.SrcAddress == b.SrcAddress && a.TransferSize == b.TransferSize && a.HdmaTableAddress == b.HdmaTableAddress &&
+		a.SrcBank == b.SrcBank && a.DestAddress == b.DestAddress && a.DmaActive == b.DmaActive &&
+		a.InvertDirection == b.InvertDirection && a.Decrement == b.Decrement && a.FixedTransfer == b.FixedTransfer &&
+		a.HdmaIndirectAddressing == b.HdmaIndirectAddressing && a.TransferMode == b.TransferMode && a.HdmaBank == b.HdmaBank &&
+		a.HdmaLineCounterAndRepeat == b.HdmaLineCounterAndRepeat && a.DoTransfer == b.DoTransfer &&
+		a.HdmaFinished == b.HdmaFinished && a.UnusedControlFlag == b.UnusedControlFlag && a.UnusedRegister == b.UnusedRegister
+	);
+}
+
+uint16_t DebugEventStore::InternDmaConfig(DmaChannelConfig& cfg)
+{
+	vector<uint16_t>& ids = _dmaConfigIndex[GetDmaConfigKey(cfg)];
+	for(uint16_t id : ids) {
+		if(IsSameDmaConfig(_dmaConfigs[id / DmaChunkSize][id % DmaChunkSize], cfg)) {
+			return id;
+		}
+	}
+
+	if(_dmaConfigCount >= MaxDmaConfigs) {
+		return MaxDmaConfigs;
+	}
+
+	uint16_t id = (uint16_t)_dmaConfigCount;
+	unique_ptr<DmaChannelConfig[]>& chunk = _dmaConfigs[id / DmaChunkSize];
+	if(!chunk) {
+		chunk.reset(new DmaChannelConfig[DmaChunkSize]());
+	}
+	chunk[id % DmaChunkSize] = cfg;
+	_dmaConfigCount++;
+	ids.push_back(id);
+	return id;
+}
+
+bool DebugEventStore::Add(DebugEventInfo& evt)
+{
+	if(_count >= MaxEventCount) {
+		return false;
+	}
+
+	unique_ptr<Chunk>& chunk = _chunks[_count >> ChunkShift];
+	if(!chunk) {
+		chunk.reset(new Chunk());
+	}
+
+	uint32_t i = _count & (ChunkSize - 1);
+	chunk->Operation[i] = evt.Operation;
+	chunk->TargetMemory[i] = evt.TargetMemory;
+	chunk->ProgramCounter[i] = evt.ProgramCounter;
+	chunk->Flags[i] = evt.Flags;
+	chunk->RegisterId[i] = evt.RegisterId;
+	chunk->Scanline[i] = evt.Scanline;
+	chunk->Cycle[i] = evt.Cycle;
+	chunk->BreakpointId[i] = evt.BreakpointId;
+	chunk->DmaConfig[i] = evt.DmaChannel >= 0 ? InternDmaConfig(evt.DmaChannelInfo) : MaxDmaConfigs;
+	chunk->Type[i] = evt.Type;
+	chunk->DmaChannel[i] = evt.DmaChannel;
+	_count++;
+	return true;
+}
+
+void DebugEventStore::Clear()
+{
+	_count = 0;
+	_dmaConfigCount = 0;
+	_dmaConfigIndex.clear();
+}
+
+DebugEventInfo DebugEventStore::Get(uint32_t index)
+{
+	Chunk* chunk = _chunks[index >> ChunkShift].get();
+	uint32_t i = index & (ChunkSize - 1);
+
+	DebugEventInfo evt = {};
+	evt.Operation = chunk->Operation[i];
+	evt.TargetMemory = chunk->TargetMemory[i];
+	evt.ProgramCounter = chunk->ProgramCounter[i];
+	evt.Flags = chunk->Flags[i];
+	evt.RegisterId = chunk->RegisterId[i];
+	evt.Scanline = chunk->Scanline[i];
+	evt.Cycle = chunk->Cycle[i];
+	evt.BreakpointId = chunk->BreakpointId[i];
+	evt.Type = chunk->Type[i];
+	evt.DmaChannel = chunk->DmaChannel[i];
+
+	uint16_t dmaConfig = chunk->DmaConfig[i];
+	if(dmaConfig < MaxDmaConfigs) {
+		evt.DmaChannelInfo = _dmaConfigs[dmaConfig / DmaChunkSize][dmaConfig % DmaChunkSize];
+	}
+	return evt;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "pch.h"
+#include "Debugger/DebugTypes.h"
+#include "SNES/DmaControllerTypes.h"
+
+enum class EventFlags
+{
+	PreviousFrame = 1 << 0,
+	RegFirstWrite = 1 << 1,
+	RegSecondWrite = 1 << 2,
+	WithTargetMemory = 1 << 3,
+	SmsVdpPaletteWrite = 1 << 4,
+	ReadWriteOp = 1 << 5,
+};
+
+struct DebugEventInfo
+{
+	MemoryOperationInfo Operation;
+	DebugEventType Type;
+	uint32_t ProgramCounter;
+	int16_t Scanline;
+	uint16_t Cycle;
+	int16_t BreakpointId = -1;
+	int8_t DmaChannel = -1;
+	DmaChannelConfig DmaChannelInfo;
+	uint32_t Flags;
+	int32_t RegisterId = -1;
+	MemoryOperationInfo TargetMemory;
+	uint32_t Color = 0;
+};
+
+//Columnar (struct of arrays) storage for the events of a single frame.
+//Events are stored in fixed-size chunks that are kept when the store is cleared and never move once allocated,
+//so a snapshot (a store + an event count) stays valid while the emulation keeps appending events after it.
+//DMA channel configs are interned: each event only stores the index of its config.
+class DebugEventStore
+{
+private:
+	static constexpr uint32_t ChunkShift = 12;
+	static constexpr uint32_t ChunkSize = 1 << ChunkShift;
+	static constexpr uint32_t MaxChunks = 256;
+	static constexpr uint32_t DmaChunkSize = 1024;
+	static constexpr uint32_t MaxDmaConfigs = 0xFFFF;
+
+	struct Chunk
+	{
+		MemoryOperationInfo Operation[ChunkSize];
+		MemoryOperationInfo TargetMemory[ChunkSize];
+		uint32_t ProgramCounter[ChunkSize];
+		uint32_t Flags[ChunkSize];
+		int32_t RegisterId[ChunkSize];
+		int16_t Scanline[ChunkSize];
+		uint16_t Cycle[ChunkSize];
+		int16_t BreakpointId[ChunkSize];
+		uint16_t DmaConfig[ChunkSize];
+		DebugEventType Type[ChunkSize];
+		int8_t DmaChannel[ChunkSize];
+	};
+
+	unique_ptr<Chunk> _chunks[MaxChunks];
+	uint32_t _count = 0;
+
+	unique_ptr<DmaChannelConfig[]> _dmaConfigs[(MaxDmaConfigs + DmaChunkSize - 1) / DmaChunkSize];
+	uint32_t _dmaConfigCount = 0;
+	unordered_map<uint64_t, vector<uint16_t>> _dmaConfigIndex;
+
+	uint16_t InternDmaConfig(DmaChannelConfig& cfg);
+
+public:
+	static constexpr uint32_t MaxEventCount = ChunkSize * MaxChunks;
+
+	//Returns false when the store is full (the event is dropped)
+	bool Add(DebugEventInfo& evt);
+	void Clear();
+
+	uint32_t GetCount() { return _count; }
+	DebugEventInfo Get(uint32_t index);
+
+	__forceinline DebugEventType GetType(uint32_t index) { return _chunks[index >> ChunkShift]->Type[index & (ChunkSize - 1)]; }
+	__forceinline int16_t GetScanline(uint32_t index) { return _chunks[index >> ChunkShift]->Scanline[index & (ChunkSize - 1)]; }
+	__forceinline uint16_t GetCycle(uint32_t index) { return _chunks[index >> ChunkShift]->Cycle[index & (ChunkSize - 1)]; }
+	__forceinline MemoryOperationInfo& GetOperation(uint32_t index) { return _chunks[index >> ChunkShift]->Operation[index & (ChunkSize - 1)]; }
+};
+
+//The first Count events of a store, as they were when the view was taken
+struct DebugEventFrameView
+{
+	DebugEventStore* Store = nullptr;
+	uint32_t Count = 0;
+};
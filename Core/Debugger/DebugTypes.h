@@ -82,6 +82,21 @@ struct CdlStatistics
 	uint32_t TotalChrBytes;
 };
 
+struct CdlCoverageCounters
+{
+	uint32_t CodeBytes;
+	uint32_t DataBytes;
+	uint32_t CodeAndDataBytes;
+};
+
+struct CdlBankCoverage
+{
+	uint32_t Start;
+	uint32_t Size;
+	uint32_t CodeBytes;
+	uint32_t DataBytes; //Bytes only used as data
+};
+
 struct DisassemblyResult
 {
 	AddressInfo Address;
@@ -4,6 +4,7 @@
 #include "Debugger/DisassemblyInfo.h"
 #include "Debugger/MemoryDumper.h"
 #include "Debugger/MemoryAccessCounter.h"
+#include "Debugger/MemorySnapshotManager.h"
 #include "Debugger/CodeDataLogger.h"
 #include "Debugger/Disassembler.h"
 #include "Debugger/DisassemblySearch.h"
@@ -17,6 +18,7 @@
 #include "Debugger/TraceLogFileSaver.h"
 #include "Debugger/CdlManager.h"
 #include "Debugger/ITraceLogger.h"
+#include "Debugger/ReverseJournal.h"
 #include "SNES/SnesCpuTypes.h"
 #include "SNES/SpcTypes.h"
 #include "SNES/Coprocessors/SA1/Sa1Types.h"
@@ -77,6 +79,7 @@ Debugger::Debugger(Emulator* emu, IConsole* console)
 	_disassembler.reset(new Disassembler(console, this));
 	_disassemblySearch.reset(new DisassemblySearch(_disassembler.get(), _labelManager.get()));
 	_memoryAccessCounter.reset(new MemoryAccessCounter(this));
+	_memorySnapshotManager.reset(new MemorySnapshotManager(this));
 	_traceLogSaver.reset(new TraceLogFileSaver());
 	_cdlManager.reset(new CdlManager(this, _disassembler.get()));
 
@@ -146,13 +149,14 @@ void Debugger::Reset()
 	for(int i = 0; i <= (int)DebugUtilities::GetLastCpuType(); i++) {
 		if(_debuggers[i].Debugger) {
 			_debuggers[i].Debugger->Reset();
+			if(ReverseJournal* journal = _debuggers[i].Debugger->GetReverseJournal()) {
+				journal->Clear();
+			}
 		}
 		
 		BaseEventManager* evtMgr = GetEventManager((CpuType)i);
 		if(evtMgr) {
-			//Call twice to clear both current and previous frame
-			evtMgr->ClearFrameEvents();
-			evtMgr->ClearFrameEvents();
+			evtMgr->ResetEvents();
 		}
 	}
 }
@@ -192,8 +196,10 @@ uint64_t Debugger::GetCpuCycleCount()
 bool Debugger::ProcessStepBack(IDebugger* debugger)
 {
 	if(debugger->CheckStepBack()) {
-		//Step back target reached, break at the current instruction
-		debugger->GetStepRequest()->Break(BreakSource::CpuStep);
+		if(!debugger->IsStepBackReplay()) {
+			//Step back target reached, break at the current instruction
+			debugger->GetStepRequest()->Break(BreakSource::CpuStep);
+		}
 
 		//Reset prev op code flag to prevent debugger code from incorrectly flagging
 		//an instruction as the start of a function, etc. after loading the state
@@ -219,6 +225,10 @@ void Debugger::ProcessInstruction()
 	debugger->IgnoreBreakpoints = false;
 	debugger->AllowChangeProgramCounter = true;
 
+	if(ReverseJournal* journal = debugger->GetReverseJournal()) {
+		journal->RecordInstruction();
+	}
+
 	switch(type) {
 		case CpuType::Snes: GetDebugger<type, SnesDebugger>()->ProcessInstruction(); break;
 		case CpuType::Spc: GetDebugger<type, SpcDebugger>()->ProcessInstruction(); break;
@@ -276,6 +286,10 @@ bool Debugger::ProcessMemoryWrite(uint32_t addr, T& value, MemoryOperationType o
 		return !_debuggers[(int)type].Debugger->GetFrozenAddressManager().IsFrozenAddress(addr);
 	}
 
+	if(ReverseJournal* journal = _debuggers[(int)type].Debugger->GetReverseJournal()) {
+		journal->RecordWrite(addr, (uint32_t)value, accessWidth);
+	}
+
 	switch(type) {
 		case CpuType::Snes: GetDebugger<CpuType::Snes, SnesDebugger>()->ProcessWrite(addr, value, opType); break;
 		case CpuType::Spc: GetDebugger<CpuType::Spc, SpcDebugger>()->ProcessWrite<flags>(addr, value, opType); break;
@@ -314,7 +328,7 @@ void Debugger::ProcessMemoryAccess(uint32_t addr, T& value)
 	MemoryOperationInfo operation(addr, value, opType, memType);
 
 	if constexpr(opType == MemoryOperationType::Write) {
-		_memoryAccessCounter->ProcessMemoryWrite<accessWidth>(addressInfo, _emu->GetMasterClock());
+		_memoryAccessCounter->ProcessMemoryWrite<accessWidth>(addressInfo, _emu->GetMasterClock(), cpuType);
 	} else {
 		_memoryAccessCounter->ProcessMemoryRead<accessWidth>(addressInfo, _emu->GetMasterClock());
 	}
@@ -588,6 +602,12 @@ void Debugger::ProcessEvent(EventType type, std::optional<CpuType> cpuTypeOpt)
 				uint32_t pc = _debuggers[(int)cpuType].Debugger->GetProgramCounter(false);
 				_debuggers[(int)cpuType].Debugger->SetProgramCounter(pc, true);
 
+				//The journal's history is still valid when the state was loaded by the debugger's own step back/replay
+				ReverseJournal* journal = _debuggers[(int)cpuType].Debugger->GetReverseJournal();
+				if(journal && !_debuggers[(int)cpuType].Debugger->IsStepBack()) {
+					journal->Clear();
+				}
+
 				CallstackManager* callstackManager = _debuggers[(int)cpuType].Debugger->GetCallstackManager();
 				if(callstackManager) {
 					callstackManager->Clear();
@@ -632,6 +652,7 @@ void Debugger::Run()
 	for(int i = 0; i <= (int)DebugUtilities::GetLastCpuType(); i++) {
 		if(_debuggers[i].Debugger) {
 			_debuggers[i].Debugger->ResetStepBackCache();
+			_debuggers[i].Debugger->ResumeFromJournal();
 			_debuggers[i].Debugger->Run();
 		}
 	}
@@ -669,6 +690,7 @@ void Debugger::Step(CpuType cpuType, int32_t stepCount, StepType type, BreakSour
 	if(debugger) {
 		if(type != StepType::StepBack) {
 			debugger->ResetStepBackCache();
+			debugger->ResumeFromJournal();
 		} else {
 			debugger->StepBack(stepCount);
 		}
@@ -680,6 +702,7 @@ void Debugger::Step(CpuType cpuType, int32_t stepCount, StepType type, BreakSour
 	for(int i = 0; i <= (int)DebugUtilities::GetLastCpuType(); i++) {
 		if(_debuggers[i].Debugger && _debuggers[i].Debugger.get() != debugger) {
 			_debuggers[i].Debugger->ResetStepBackCache();
+			_debuggers[i].Debugger->ResumeFromJournal();
 			_debuggers[i].Debugger->Run();
 		}
 	}
@@ -687,6 +710,54 @@ void Debugger::Step(CpuType cpuType, int32_t stepCount, StepType type, BreakSour
 	_waitForBreakResume = false;
 }
 
+void Debugger::SetReverseJournalEnabled(CpuType cpuType, bool enabled, uint32_t capacity)
+{
+	DebugBreakHelper helper(this);
+	IDebugger* debugger = _debuggers[(int)cpuType].Debugger.get();
+	if(debugger) {
+		debugger->SetReverseJournal(enabled ? new ReverseJournal(this, debugger, cpuType, GetCpuStateSize(cpuType), capacity) : nullptr);
+	}
+}
+
+ReverseJournal* Debugger::GetReverseJournal(CpuType cpuType)
+{
+	IDebugger* debugger = _debuggers[(int)cpuType].Debugger.get();
+	return debugger ? debugger->GetReverseJournal() : nullptr;
+}
+
+string Debugger::GetReverseStepError(CpuType cpuType)
+{
+	if(!GetReverseJournal(cpuType)) {
+		return "Reverse execution journal is off";
+	} else if(!IsPaused()) {
+		//Execution would keep going from the undone instructions without replaying the rest of the hardware state
+		return "Execution must be paused to step back";
+	} else if(_settings->GetPreferences().RewindBufferSize == 0) {
+		//Resuming replays from the last rewind keyframe, there is none when rewind is disabled
+		return "Rewind is disabled (RewindBufferSize is 0), execution can't resume after stepping back";
+	}
+	return "";
+}
+
+uint32_t Debugger::ReverseStep(CpuType cpuType, uint32_t count)
+{
+	DebugBreakHelper helper(this);
+	if(!GetReverseStepError(cpuType).empty()) {
+		return 0;
+	}
+	return GetReverseJournal(cpuType)->StepBack(count);
+}
+
+int32_t Debugger::ReverseContinue(CpuType cpuType, uint32_t& stepCount)
+{
+	DebugBreakHelper helper(this);
+	stepCount = 0;
+	if(!GetReverseStepError(cpuType).empty()) {
+		return -1;
+	}
+	return GetReverseJournal(cpuType)->ReverseContinue(stepCount);
+}
+
 bool Debugger::IsPaused()
 {
 	return _waitForBreakResume;
@@ -787,45 +858,37 @@ void Debugger::BreakImmediately(CpuType sourceCpu, BreakSource source)
 	}
 }
 
-void Debugger::GetCpuState(BaseState &dstState, CpuType cpuType)
+uint32_t Debugger::GetCpuStateSize(CpuType cpuType)
 {
-	BaseState& srcState = GetCpuStateRef(cpuType);
 	switch(cpuType) {
-		case CpuType::Snes: memcpy(&dstState, &srcState, sizeof(SnesCpuState)); break;
-		case CpuType::Spc: memcpy(&dstState, &srcState, sizeof(SpcState)); break;
-		case CpuType::NecDsp: memcpy(&dstState, &srcState, sizeof(NecDspState)); break;
-		case CpuType::Sa1: memcpy(&dstState, &srcState, sizeof(SnesCpuState)); break;
-		case CpuType::Gsu: memcpy(&dstState, &srcState, sizeof(GsuState)); break;
-		case CpuType::Cx4: memcpy(&dstState, &srcState, sizeof(Cx4State)); break;
-		case CpuType::St018: memcpy(&dstState, &srcState, sizeof(ArmV3CpuState)); break;
-		case CpuType::Gameboy: memcpy(&dstState, &srcState, sizeof(GbCpuState)); break;
-		case CpuType::Nes: memcpy(&dstState, &srcState, sizeof(NesCpuState)); break;
-		case CpuType::Pce: memcpy(&dstState, &srcState, sizeof(PceCpuState)); break;
-		case CpuType::Sms: memcpy(&dstState, &srcState, sizeof(SmsCpuState)); break;
-		case CpuType::Gba: memcpy(&dstState, &srcState, sizeof(GbaCpuState)); break;
-		case CpuType::Ws: memcpy(&dstState, &srcState, sizeof(WsCpuState)); break;
+		case CpuType::Snes: return sizeof(SnesCpuState);
+		case CpuType::Spc: return sizeof(SpcState);
+		case CpuType::NecDsp: return sizeof(NecDspState);
+		case CpuType::Sa1: return sizeof(SnesCpuState);
+		case CpuType::Gsu: return sizeof(GsuState);
+		case CpuType::Cx4: return sizeof(Cx4State);
+		case CpuType::St018: return sizeof(ArmV3CpuState);
+		case CpuType::Gameboy: return sizeof(GbCpuState);
+		case CpuType::Nes: return sizeof(NesCpuState);
+		case CpuType::Pce: return sizeof(PceCpuState);
+		case CpuType::Sms: return sizeof(SmsCpuState);
+		case CpuType::Gba: return sizeof(GbaCpuState);
+		case CpuType::Ws: return sizeof(WsCpuState);
 	}
+	return 0;
+}
+
+void Debugger::GetCpuState(BaseState &dstState, CpuType cpuType)
+{
+	BaseState& srcState = GetCpuStateRef(cpuType);
+	memcpy(&dstState, &srcState, GetCpuStateSize(cpuType));
 }
 
 void Debugger::SetCpuState(BaseState& srcState, CpuType cpuType)
 {
 	DebugBreakHelper helper(this);
 	BaseState& dstState = GetCpuStateRef(cpuType);
-	switch(cpuType) {
-		case CpuType::Snes: memcpy(&dstState, &srcState, sizeof(SnesCpuState)); break;
-		case CpuType::Spc: memcpy(&dstState, &srcState, sizeof(SpcState)); break;
-		case CpuType::NecDsp: memcpy(&dstState, &srcState, sizeof(NecDspState)); break;
-		case CpuType::Sa1: memcpy(&dstState, &srcState, sizeof(SnesCpuState)); break;
-		case CpuType::Gsu: memcpy(&dstState, &srcState, sizeof(GsuState)); break;
-		case CpuType::Cx4: memcpy(&dstState, &srcState, sizeof(Cx4State)); break;
-		case CpuType::St018: memcpy(&dstState, &srcState, sizeof(ArmV3CpuState)); break;
-		case CpuType::Gameboy: memcpy(&dstState, &srcState, sizeof(GbCpuState)); break;
-		case CpuType::Nes: memcpy(&dstState, &srcState, sizeof(NesCpuState)); break;
-		case CpuType::Pce: memcpy(&dstState, &srcState, sizeof(PceCpuState)); break;
-		case CpuType::Sms: memcpy(&dstState, &srcState, sizeof(SmsCpuState)); break;
-		case CpuType::Gba: memcpy(&dstState, &srcState, sizeof(GbaCpuState)); break;
-		case CpuType::Ws: memcpy(&dstState, &srcState, sizeof(WsCpuState)); break;
-	}
+	memcpy(&dstState, &srcState, GetCpuStateSize(cpuType));
 }
 
 BaseState& Debugger::GetCpuStateRef(CpuType cpuType)
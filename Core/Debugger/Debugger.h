@@ -20,6 +20,7 @@ class EmuSettings;
 class ExpressionEvaluator;
 class MemoryDumper;
 class MemoryAccessCounter;
+class MemorySnapshotManager;
 class Disassembler;
 class DisassemblySearch;
 class BreakpointManager;
@@ -35,6 +36,7 @@ class IDebugger;
 class ITraceLogger;
 class TraceLogFileSaver;
 class FrozenAddressManager;
+class ReverseJournal;
 
 struct TraceRow;
 struct BaseState;
@@ -65,6 +67,7 @@ private:
 
 	unique_ptr<MemoryDumper> _memoryDumper;
 	unique_ptr<MemoryAccessCounter> _memoryAccessCounter;
+	unique_ptr<MemorySnapshotManager> _memorySnapshotManager;
 	unique_ptr<CodeDataLogger> _codeDataLogger;
 	unique_ptr<Disassembler> _disassembler;
 	unique_ptr<DisassemblySearch> _disassemblySearch;
@@ -96,6 +99,8 @@ private:
 
 	void ClearPendingBreakExceptions();
 
+	uint32_t GetCpuStateSize(CpuType cpuType);
+
 	bool IsBreakpointForbidden(BreakSource source, CpuType sourceCpu, MemoryOperationInfo* operation);
 
 public:
@@ -131,6 +136,14 @@ public:
 	bool IsPaused();
 	bool IsExecutionStopped();
 
+	void SetReverseJournalEnabled(CpuType cpuType, bool enabled, uint32_t capacity);
+	ReverseJournal* GetReverseJournal(CpuType cpuType);
+
+	//Returns why the journal can't be used to step back right now (empty string when it can)
+	string GetReverseStepError(CpuType cpuType);
+	uint32_t ReverseStep(CpuType cpuType, uint32_t count);
+	int32_t ReverseContinue(CpuType cpuType, uint32_t& stepCount);
+
 	bool HasBreakRequest();
 	void BreakRequest(bool release);
 	void ResetSuspendCounter();
@@ -182,6 +195,7 @@ public:
 	TraceLogFileSaver* GetTraceLogFileSaver() { return _traceLogSaver.get(); }
 	MemoryDumper* GetMemoryDumper() { return _memoryDumper.get(); }
 	MemoryAccessCounter* GetMemoryAccessCounter() { return _memoryAccessCounter.get(); }
+	MemorySnapshotManager* GetMemorySnapshotManager() { return _memorySnapshotManager.get(); }
 	Disassembler* GetDisassembler() { return _disassembler.get(); }
 	DisassemblySearch* GetDisassemblySearch() { return _disassemblySearch.get(); }
 	LabelManager* GetLabelManager() { return _labelManager.get(); }
@@ -44,6 +44,7 @@ void Disassembler::InitSource(MemoryType type)
 {
 	uint32_t size = _memoryDumper->GetMemorySize(type);
 	_sources[(int)type] = { vector<DisassemblyInfo>(size), size };
+	_searchIndex.Reset(type, size);
 }
 
 DisassemblerSource& Disassembler::GetSource(MemoryType type)
@@ -61,10 +62,12 @@ uint32_t Disassembler::BuildCache(AddressInfo &addrInfo, uint8_t cpuFlags, CpuTy
 		DisassemblyInfo &disInfo = src.Cache[address];
 		if(!disInfo.IsInitialized() || !disInfo.IsValid(cpuFlags)) {
 			disInfo.Initialize(address, cpuFlags, type, addrInfo.Type, _memoryDumper);
+			_searchIndex.AddPending(addrInfo.Type, address);
 			for(int i = 1; i < disInfo.GetOpSize() && address + i < src.Cache.size() ; i++) {
 				//Clear any instructions that start in the middle of this one
 				//(can happen when resizing an instruction after X/M updates)
 				src.Cache[address + i] = DisassemblyInfo();
+				_searchIndex.Invalidate(addrInfo.Type, address + i);
 			}
 			returnSize += disInfo.GetOpSize();
 		} else {
@@ -102,11 +105,26 @@ void Disassembler::InvalidateCache(AddressInfo addrInfo, CpuType type)
 		for(int i = 0; i < 4; i++) {
 			if(addrInfo.Address >= i) {
 				src.Cache[addrInfo.Address - i].Reset();
+				_searchIndex.Invalidate(addrInfo.Type, addrInfo.Address - i);
 			}
 		}
 	}
 }
 
+void Disassembler::InvalidateCache(AddressInfo addrInfo, uint32_t length, CpuType type)
+{
+	//Same as calling InvalidateCache for each byte in the range, in a single pass
+	if(addrInfo.Address >= 0 && length > 0) {
+		DisassemblerSource& src = GetSource(addrInfo.Type);
+		uint32_t start = (uint32_t)std::max(0, addrInfo.Address - 3);
+		uint32_t end = (uint32_t)std::min<uint64_t>((uint64_t)addrInfo.Address + length, src.Cache.size());
+		for(uint32_t i = start; i < end; i++) {
+			src.Cache[i].Reset();
+			_searchIndex.Invalidate(addrInfo.Type, i);
+		}
+	}
+}
+
 vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t bank)
 {
 	if(!_debugger->HasCpuType(cpuType)) {
@@ -3,6 +3,7 @@
 #include "Debugger/DisassemblyInfo.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/DebugUtilities.h"
+#include "Debugger/DisassemblySearchIndex.h"
 
 class IConsole;
 class Debugger;
@@ -32,6 +33,7 @@ private:
 	MemoryDumper *_memoryDumper;
 
 	DisassemblerSource _sources[DebugUtilities::GetMemoryTypeCount()] = {};
+	DisassemblySearchIndex _searchIndex;
 	
 	void InitSource(MemoryType type);
 	DisassemblerSource& GetSource(MemoryType type);
@@ -47,6 +49,7 @@ public:
 	uint32_t BuildCache(AddressInfo &addrInfo, uint8_t cpuFlags, CpuType type);
 	void ResetPrgCache();
 	void InvalidateCache(AddressInfo addrInfo, CpuType type);
+	void InvalidateCache(AddressInfo addrInfo, uint32_t length, CpuType type);
 
 	__forceinline DisassemblyInfo GetDisassemblyInfo(AddressInfo& info, uint32_t cpuAddress, uint8_t cpuFlags, CpuType type)
 	{
@@ -1,12 +1,16 @@
 #include "pch.h"
+#include "Debugger/Debugger.h"
 #include "Debugger/Disassembler.h"
 #include "Debugger/DisassemblySearch.h"
 #include "Debugger/LabelManager.h"
+#include "Shared/EmuSettings.h"
+#include <thread>
 
 DisassemblySearch::DisassemblySearch(Disassembler* disassembler, LabelManager* labelManager)
 {
 	_disassembler = disassembler;
 	_labelManager = labelManager;
+	_index = &disassembler->_searchIndex;
 }
 
 int32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options)
@@ -18,7 +22,164 @@ int32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* search
 
 uint32_t DisassemblySearch::FindOccurrences(CpuType cpuType, const char* searchString, DisassemblySearchOptions options, CodeLineData output[], uint32_t maxResultCount)
 {
-	return SearchDisassembly(cpuType, searchString, 0, options, output, maxResultCount);
+	if(maxResultCount == 0 || !_disassembler->_debugger->HasCpuType(cpuType)) {
+		return 0;
+	}
+
+	MemoryType memType = DebugUtilities::GetCpuMemoryType(cpuType);
+	uint32_t bankCount = (uint32_t)_disassembler->GetMaxBank(cpuType) + 1;
+	string searchStr = searchString;
+	vector<uint8_t> candidates[DebugUtilities::GetMemoryTypeCount()];
+	bool useIndex = PrepareIndexFilter(cpuType, searchStr, options, candidates);
+
+	//Each bank is disassembled and searched independently, the matching rows are then merged in bank order
+	vector<vector<DisassemblyResult>> bankMatches(bankCount);
+	std::atomic<uint32_t> nextBank(0);
+	auto searchBanks = [&]() {
+		CodeLineData lineData = {};
+		string txt;
+		uint32_t bank;
+		while((bank = nextBank++) < bankCount) {
+			vector<DisassemblyResult> rows = _disassembler->Disassemble(cpuType, (uint16_t)bank);
+			for(DisassemblyResult& row : rows) {
+				if(row.CpuAddress < 0 || (useIndex && CanSkipRow(row, candidates))) {
+					continue;
+				}
+				if(IsLineMatch(cpuType, memType, row, searchStr, options, false, lineData, txt)) {
+					bankMatches[bank].push_back(row);
+					if(bankMatches[bank].size() >= maxResultCount) {
+						break;
+					}
+				}
+			}
+		}
+	};
+
+	uint32_t threadCount = std::max(1u, std::min(std::thread::hardware_concurrency(), bankCount));
+	vector<std::thread> threads;
+	for(uint32_t i = 1; i < threadCount; i++) {
+		threads.push_back(std::thread(searchBanks));
+	}
+	searchBanks();
+	for(std::thread& thread : threads) {
+		thread.join();
+	}
+
+	uint32_t resultCount = 0;
+	for(vector<DisassemblyResult>& matches : bankMatches) {
+		for(DisassemblyResult& row : matches) {
+			_disassembler->GetLineData(row, cpuType, memType, output[resultCount]);
+			if(++resultCount == maxResultCount) {
+				return resultCount;
+			}
+		}
+	}
+	return resultCount;
+}
+
+bool DisassemblySearch::PrepareIndexFilter(CpuType cpuType, string& searchStr, DisassemblySearchOptions& options, vector<uint8_t> candidates[])
+{
+	UpdateIndex();
+
+	//The index can only be used for searches that start with a complete mnemonic (e.g "sta $2118"):
+	//labels, effective addresses and block headers never contain a space, and the first word of an
+	//instruction line is always its mnemonic. This only holds if a mnemonic can't appear after the start of the line:
+	//WS lines can start with a prefix (e.g "rep movsb"), ARM operands can contain a shift (e.g "mov r0, r1, LSL #2")
+	//and NEC DSP lines can contain several operations (e.g "OR A | MOV TR,B"), so these CPUs are excluded.
+	//GSU mnemonics depend on the ALT1/ALT2 flags the instruction ran with, which the index doesn't track.
+	switch(cpuType) {
+		case CpuType::Ws:
+		case CpuType::Gba:
+		case CpuType::St018:
+		case CpuType::NecDsp:
+		case CpuType::Gsu:
+			return false;
+
+		default:
+			break;
+	}
+
+	size_t pos = searchStr.find(' ');
+	if(pos == string::npos || pos == 0 || TextContains(searchStr, "sub start", 9, options)) {
+		return false;
+	}
+
+	string mnemonic = searchStr.substr(0, pos);
+	if(mnemonic.find_first_not_of("0123456789abcdefABCDEF") == string::npos) {
+		//Could match the bytes of a .db line
+		return false;
+	}
+
+	if(!_index->HasMnemonic(mnemonic, options.MatchCase)) {
+		return false;
+	}
+
+	_index->GetCandidates(mnemonic, options.MatchCase, candidates);
+	return true;
+}
+
+void DisassemblySearch::UpdateIndex()
+{
+	string text;
+	for(std::pair<MemoryType, uint32_t>& entry : _index->TakePending()) {
+		DisassemblerSource& src = _disassembler->GetSource(entry.first);
+		if(entry.second >= src.Cache.size() || !src.Cache[entry.second].IsInitialized()) {
+			continue;
+		}
+
+		//Mnemonics don't depend on labels or on the CPU address, render the line without them
+		text.clear();
+		src.Cache[entry.second].GetDisassembly(text, 0, nullptr, _disassembler->_settings);
+		_index->Add(entry.first, entry.second, text.substr(0, text.find(' ')));
+	}
+}
+
+bool DisassemblySearch::CanSkipRow(DisassemblyResult& row, vector<uint8_t> candidates[])
+{
+	constexpr uint16_t textFlags = LineFlags::Comment | LineFlags::ShowAsData | LineFlags::Label | LineFlags::BlockStart | LineFlags::BlockEnd | LineFlags::Empty | LineFlags::SubStart;
+	if((row.Flags & textFlags) || row.Address.Address < 0) {
+		return (row.Flags & LineFlags::Comment) == 0;
+	}
+
+	//Instructions that aren't in the cache (unidentified data shown as code) aren't indexed
+	DisassemblerSource& src = _disassembler->GetSource(row.Address.Type);
+	if(!src.Cache[row.Address.Address].IsInitialized()) {
+		return false;
+	}
+
+	vector<uint8_t>& typeCandidates = candidates[(int)row.Address.Type];
+	return (uint32_t)row.Address.Address >= typeCandidates.size() || !typeCandidates[row.Address.Address];
+}
+
+bool DisassemblySearch::IsLineMatch(CpuType cpuType, MemoryType memType, DisassemblyResult& row, string& searchStr, DisassemblySearchOptions& options, bool checkValue, CodeLineData& lineData, string& txt)
+{
+	_disassembler->GetLineData(row, cpuType, memType, lineData);
+
+	if(TextContains(searchStr, lineData.Text, 1000, options) || TextContains(searchStr, lineData.Comment, 1000, options)) {
+		return true;
+	}
+
+	if(lineData.EffectiveAddress.ShowAddress && lineData.EffectiveAddress.Address >= 0) {
+		txt = _labelManager->GetLabel({ (int32_t)lineData.EffectiveAddress.Address, lineData.EffectiveAddress.Type });
+		if(txt.empty()) {
+			txt = "[$" + DebugUtilities::AddressToHex(lineData.LineCpuType, lineData.EffectiveAddress.Address) + "]";
+		} else {
+			txt = "[" + txt + "]";
+		}
+
+		if(TextContains(searchStr, txt.c_str(), (int)txt.size(), options)) {
+			return true;
+		}
+	}
+
+	if(checkValue && lineData.EffectiveAddress.ValueSize > 0) {
+		txt = "$" + (lineData.EffectiveAddress.ValueSize == 2 ? HexUtilities::ToHex((uint16_t)lineData.Value) : HexUtilities::ToHex((uint8_t)lineData.Value));
+		if(TextContains(searchStr, txt.c_str(), (int)txt.size(), options)) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 uint32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options, CodeLineData searchResults[], uint32_t maxResultCount)
@@ -29,11 +190,13 @@ uint32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searc
 
 	vector<DisassemblyResult> rows = _disassembler->Disassemble(cpuType, bank);
 	if(rows.empty()) {
-		return -1;
+		return 0;
 	}
 	int step = options.SearchBackwards ? -1 : 1;
 
 	string searchStr = searchString;
+	vector<uint8_t> candidates[DebugUtilities::GetMemoryTypeCount()];
+	bool useIndex = PrepareIndexFilter(cpuType, searchStr, options, candidates);
 
 	int32_t startRow = _disassembler->GetMatchingRow(rows, startAddress, options.SearchBackwards);
 	if(options.SearchBackwards) {
@@ -76,50 +239,15 @@ uint32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searc
 
 			prevAddress = rows[i].CpuAddress;
 
-			_disassembler->GetLineData(rows[i], cpuType, memType, lineData);
-
-			if(TextContains(searchStr, lineData.Text, 1000, options)) {
-				searchResults[resultCount] = lineData;
-				if(maxResultCount == ++resultCount) {
-					return resultCount;
-				}
+			if(useIndex && CanSkipRow(rows[i], candidates)) {
 				continue;
 			}
 
-			if(TextContains(searchStr, lineData.Comment, 1000, options)) {
+			if(IsLineMatch(cpuType, memType, rows[i], searchStr, options, maxResultCount == 1, lineData, txt)) {
 				searchResults[resultCount] = lineData;
 				if(maxResultCount == ++resultCount) {
 					return resultCount;
 				}
-				continue;
-			}
-
-			if(lineData.EffectiveAddress.ShowAddress && lineData.EffectiveAddress.Address >= 0) {
-				txt = _labelManager->GetLabel({ (int32_t)lineData.EffectiveAddress.Address, lineData.EffectiveAddress.Type });
-				if(txt.empty()) {
-					txt = "[$" + DebugUtilities::AddressToHex(lineData.LineCpuType, lineData.EffectiveAddress.Address) + "]";
-				} else {
-					txt = "[" + txt + "]";
-				}
-
-				if(TextContains(searchStr, txt.c_str(), (int)txt.size(), options)) {
-					searchResults[resultCount] = lineData;
-					if(maxResultCount == ++resultCount) {
-						return resultCount;
-					}
-					continue;
-				}
-			}
-
-			if(maxResultCount == 1 && lineData.EffectiveAddress.ValueSize > 0) {
-				txt = "$" + (lineData.EffectiveAddress.ValueSize == 2 ? HexUtilities::ToHex((uint16_t)lineData.Value) : HexUtilities::ToHex((uint8_t)lineData.Value));
-				if(TextContains(searchStr, txt.c_str(), (int)txt.size(), options)) {
-					searchResults[resultCount] = lineData;
-					if(maxResultCount == ++resultCount) {
-						return resultCount;
-					}
-					continue;
-				}
 			}
 		}
 
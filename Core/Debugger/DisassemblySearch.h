@@ -5,6 +5,7 @@
 #include "Debugger/DebugUtilities.h"
 
 class Disassembler;
+class DisassemblySearchIndex;
 class LabelManager;
 enum class CpuType : uint8_t;
 
@@ -21,9 +22,15 @@ class DisassemblySearch
 private:
 	Disassembler* _disassembler;
 	LabelManager* _labelManager;
+	DisassemblySearchIndex* _index;
 
 	uint32_t SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options, CodeLineData searchResults[], uint32_t maxResultCount);
 
+	void UpdateIndex();
+	bool PrepareIndexFilter(CpuType cpuType, string& searchStr, DisassemblySearchOptions& options, vector<uint8_t> candidates[]);
+	bool CanSkipRow(DisassemblyResult& row, vector<uint8_t> candidates[]);
+	bool IsLineMatch(CpuType cpuType, MemoryType memType, DisassemblyResult& row, string& searchStr, DisassemblySearchOptions& options, bool checkValue, CodeLineData& lineData, string& txt);
+
 	template<bool matchCase> bool TextContains(string& needle, const char* hay, int size, DisassemblySearchOptions& options);
 	bool TextContains(string& needle, const char* hay, int size, DisassemblySearchOptions& options);
 	bool IsWordSeparator(char c);
@@ -32,5 +39,7 @@ public:
 	DisassemblySearch(Disassembler* disassembler, LabelManager* labelManager);
 
 	int32_t SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options);
+
+	//Searches every bank of the CPU's address space (on multiple threads), results are sorted by address
 	uint32_t FindOccurrences(CpuType cpuType, const char* searchString, DisassemblySearchOptions options, CodeLineData output[], uint32_t maxResultCount);
 };
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "pch.h"
+#include "Debugger/DisassemblySearchIndex.h"
+
+string DisassemblySearchIndex::GetKey(MemoryType memType, const string& mnemonic)
+{
+	string key = mnemonic;
+	key += (char)('A' + (int)memType);
+	return key;
+}
+
+bool DisassemblySearchIndex::EndsWith(const string& mnemonic, const string& text, bool matchCase)
+{
+	if(text.size() > mnemonic.size()) {
+		return false;
+	}
+
+	size_t offset = mnemonic.size() - text.size();
+	for(size_t i = 0; i < text.size(); i++) {
+		char a = mnemonic[offset + i];
+		char b = text[i];
+		if(matchCase ? a != b : tolower(a) != tolower(b)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+vector<std::pair<MemoryType, uint32_t>> DisassemblySearchIndex::TakePending()
+{
+	auto lock = _lock.AcquireSafe();
+	vector<std::pair<MemoryType, uint32_t>> pending;
+	pending.swap(_pending);
+	return pending;
+}
+
+void DisassemblySearchIndex::Add(MemoryType memType, uint32_t address, const string& mnemonic)
+{
+	auto lock = _lock.AcquireSafe();
+	string key = GetKey(memType, mnemonic);
+	auto result = _postingIndex.find(key);
+	if(result == _postingIndex.end()) {
+		result = _postingIndex.emplace(key, (uint32_t)_postings.size()).first;
+		_postings.push_back({ memType, mnemonic, {} });
+	}
+	_postings[result->second].Addresses.push_back(address);
+}
+
+void DisassemblySearchIndex::Reset(MemoryType memType, uint32_t size)
+{
+	auto lock = _lock.AcquireSafe();
+	_queued[(int)memType].assign(size, 0);
+
+	vector<Posting> postings;
+	_postingIndex.clear();
+	for(Posting& posting : _postings) {
+		if(posting.Type != memType) {
+			_postingIndex[GetKey(posting.Type, posting.Mnemonic)] = (uint32_t)postings.size();
+			postings.push_back(std::move(posting));
+		}
+	}
+	_postings = std::move(postings);
+}
+
+bool DisassemblySearchIndex::HasMnemonic(const string& mnemonic, bool matchCase)
+{
+	auto lock = _lock.AcquireSafe();
+	for(Posting& posting : _postings) {
+		if(posting.Mnemonic.size() == mnemonic.size() && EndsWith(posting.Mnemonic, mnemonic, matchCase)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void DisassemblySearchIndex::GetCandidates(const string& mnemonic, bool matchCase, vector<uint8_t> outCandidates[])
+{
+	auto lock = _lock.AcquireSafe();
+	for(Posting& posting : _postings) {
+		if(!EndsWith(posting.Mnemonic, mnemonic, matchCase)) {
+			continue;
+		}
+
+		vector<uint8_t>& candidates = outCandidates[(int)posting.Type];
+		for(uint32_t addr : posting.Addresses) {
+			if(addr >= candidates.size()) {
+				candidates.resize(addr + 1);
+			}
+			candidates[addr] = 1;
+		}
+	}
+}
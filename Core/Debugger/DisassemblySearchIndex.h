@@ -0,0 +1,66 @@
+#pragma once
+#include "pch.h"
+#include "Shared/MemoryType.h"
+#include "Utilities/SimpleLock.h"
+
+//Mnemonic postings for the instructions found in the disassembly cache.
+//The disassembler queues each address the first time it initializes it (this is done on the emulation thread,
+//so it only records the address), and the mnemonics are only rendered the next time a search needs the index.
+//An address is queued again once its instruction has been invalidated, re-initializing it with other CPU flags
+//(e.g SNES M/X) doesn't change its mnemonic on the CPUs the index is used for.
+//Entries are never removed when an instruction is invalidated: the index can return addresses that
+//no longer match (the search still checks each candidate line), but never misses an instruction.
+class DisassemblySearchIndex
+{
+private:
+	struct Posting
+	{
+		MemoryType Type;
+		string Mnemonic;
+		vector<uint32_t> Addresses;
+	};
+
+	SimpleLock _lock;
+	vector<std::pair<MemoryType, uint32_t>> _pending;
+
+	//1 byte per address, set when the address is queued and cleared when its instruction is invalidated (emulation thread only)
+	vector<uint8_t> _queued[(int)MemoryType::None + 1];
+
+	vector<Posting> _postings;
+	unordered_map<string, uint32_t> _postingIndex;
+
+	static string GetKey(MemoryType memType, const string& mnemonic);
+	static bool EndsWith(const string& mnemonic, const string& text, bool matchCase);
+
+public:
+	__forceinline void AddPending(MemoryType memType, uint32_t address)
+	{
+		vector<uint8_t>& queued = _queued[(int)memType];
+		if(address < queued.size()) {
+			if(queued[address]) {
+				return;
+			}
+			queued[address] = 1;
+		}
+
+		auto lock = _lock.AcquireSafe();
+		_pending.push_back({ memType, address });
+	}
+
+	__forceinline void Invalidate(MemoryType memType, uint32_t address)
+	{
+		vector<uint8_t>& queued = _queued[(int)memType];
+		if(address < queued.size()) {
+			queued[address] = 0;
+		}
+	}
+
+	vector<std::pair<MemoryType, uint32_t>> TakePending();
+	void Add(MemoryType memType, uint32_t address, const string& mnemonic);
+	void Reset(MemoryType memType, uint32_t size);
+
+	bool HasMnemonic(const string& mnemonic, bool matchCase);
+
+	//Marks every address whose mnemonic ends with the given text (1 byte per address in outCandidates[memType])
+	void GetCandidates(const string& mnemonic, bool matchCase, vector<uint8_t> outCandidates[]);
+};
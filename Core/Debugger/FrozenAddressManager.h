@@ -1,34 +1,117 @@
 #pragma once
 #include "pch.h"
 
+//Frozen addresses are stored in a bitmap (1 bit per address), split in 4096-address pages that are
+//only allocated once an address inside them gets frozen. A summary bitmap (1 bit per page) marks the
+//pages that contain at least 1 frozen address, so the check done on every write is usually a single bit test.
 class FrozenAddressManager
 {
 protected:
-	unordered_set<uint32_t> _frozenAddresses;
+	static constexpr uint32_t PageShift = 12;
+	static constexpr uint32_t WordsPerPage = (1 << PageShift) / 64;
+
+	vector<uint64_t> _summary;
+	vector<unique_ptr<uint64_t[]>> _pages;
+
+	__forceinline bool IsPageFrozen(uint32_t page)
+	{
+		return (page >> 6) < _summary.size() && (_summary[page >> 6] & (1ull << (page & 0x3F)));
+	}
+
+	//Sets/clears the bits for [start, end] (both addresses must be in the same page)
+	void UpdatePage(uint32_t page, uint32_t start, uint32_t end, bool freeze)
+	{
+		if(!_pages[page]) {
+			if(!freeze) {
+				return;
+			}
+			_pages[page].reset(new uint64_t[WordsPerPage]());
+		}
+
+		uint64_t* words = _pages[page].get();
+		uint32_t first = (start >> 6) & (WordsPerPage - 1);
+		uint32_t last = (end >> 6) & (WordsPerPage - 1);
+		for(uint32_t i = first; i <= last; i++) {
+			uint64_t mask = ~0ull;
+			if(i == first) {
+				mask &= ~0ull << (start & 0x3F);
+			}
+			if(i == last) {
+				mask &= ~0ull >> (63 - (end & 0x3F));
+			}
+			words[i] = freeze ? (words[i] | mask) : (words[i] & ~mask);
+		}
+
+		bool hasFrozen = false;
+		for(uint32_t i = 0; i < WordsPerPage; i++) {
+			if(words[i]) {
+				hasFrozen = true;
+				break;
+			}
+		}
+
+		if(hasFrozen) {
+			_summary[page >> 6] |= 1ull << (page & 0x3F);
+		} else {
+			_summary[page >> 6] &= ~(1ull << (page & 0x3F));
+		}
+	}
 
 public:
 	void UpdateFrozenAddresses(uint32_t start, uint32_t end, bool freeze)
 	{
-		if(freeze) {
-			for(uint32_t i = start; i <= end; i++) {
-				_frozenAddresses.emplace(i);
+		if(end < start) {
+			return;
+		}
+
+		uint32_t lastPage = end >> PageShift;
+		if(lastPage >= _pages.size()) {
+			if(!freeze) {
+				if(_pages.empty()) {
+					return;
+				}
+				lastPage = (uint32_t)_pages.size() - 1;
+				end = std::min(end, (lastPage << PageShift) | ((1 << PageShift) - 1));
+			} else {
+				_pages.resize(lastPage + 1);
+				_summary.resize((lastPage >> 6) + 1);
 			}
-		} else {
-			for(uint32_t i = start; i <= end; i++) {
-				_frozenAddresses.erase(i);
+		}
+
+		for(uint32_t page = start >> PageShift; page <= lastPage && start <= end; page++) {
+			uint32_t pageEnd = std::min(end, (page << PageShift) | ((1 << PageShift) - 1));
+			UpdatePage(page, start, pageEnd, freeze);
+			if(pageEnd == end) {
+				break;
 			}
+			start = pageEnd + 1;
 		}
 	}
 
 	bool IsFrozenAddress(uint32_t addr)
 	{
-		return _frozenAddresses.size() > 0 && _frozenAddresses.find(addr) != _frozenAddresses.end();
+		uint32_t page = addr >> PageShift;
+		if(!IsPageFrozen(page)) {
+			return false;
+		}
+		return (_pages[page][(addr >> 6) & (WordsPerPage - 1)] >> (addr & 0x3F)) & 0x01;
 	}
 
 	void GetFrozenState(uint32_t start, uint32_t end, bool* outState)
 	{
-		for(uint32_t i = start; i <= end; i++) {
-			outState[i - start] = _frozenAddresses.find(i) != _frozenAddresses.end();
+		for(uint64_t i = start; i <= end;) {
+			uint32_t addr = (uint32_t)i;
+			uint32_t page = addr >> PageShift;
+			uint64_t pageEnd = std::min<uint64_t>(end, ((uint64_t)page << PageShift) | ((1 << PageShift) - 1));
+			if(!IsPageFrozen(page)) {
+				memset(outState + (i - start), 0, (size_t)(pageEnd - i + 1));
+			} else {
+				uint64_t* words = _pages[page].get();
+				for(uint64_t j = i; j <= pageEnd; j++) {
+					outState[j - start] = (words[(j >> 6) & (WordsPerPage - 1)] >> (j & 0x3F)) & 0x01;
+				}
+			}
+			i = pageEnd + 1;
 		}
 	}
-};
\ No newline at end of file
+};
@@ -3,6 +3,7 @@
 #include "Debugger/DebuggerFeatures.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/StepBackManager.h"
+#include "Debugger/ReverseJournal.h"
 #include "Debugger/FrozenAddressManager.h"
 
 enum class StepType;
@@ -24,6 +25,7 @@ class IDebugger
 protected:
 	unique_ptr<StepRequest> _step;
 	unique_ptr<StepBackManager> _stepBackManager;
+	unique_ptr<ReverseJournal> _reverseJournal;
 
 	FrozenAddressManager _frozenAddressManager;
 
@@ -39,11 +41,31 @@ public:
 	bool CheckStepBack() { return _stepBackManager->CheckStepBack(); }
 	bool IsStepBack() { return _stepBackManager->IsRewinding(); }
 	void ResetStepBackCache() { return _stepBackManager->ResetCache(); }
-	void StepBack(int32_t stepCount) { return _stepBackManager->StepBack((StepBackType)stepCount); }
+	void StepBack(int32_t stepCount)
+	{
+		if(_reverseJournal) {
+			_reverseJournal->Clear();
+		}
+		_stepBackManager->StepBack((StepBackType)stepCount);
+	}
+	bool IsStepBackReplay() { return _stepBackManager->IsReplay(); }
 	virtual StepBackConfig GetStepBackConfig() { return { GetCpuCycleCount(), 0, 0 }; }
 
 	FrozenAddressManager& GetFrozenAddressManager() { return _frozenAddressManager; }
 
+	ReverseJournal* GetReverseJournal() { return _reverseJournal.get(); }
+	void SetReverseJournal(ReverseJournal* journal) { _reverseJournal.reset(journal); }
+
+	//Called before execution resumes - if the reverse journal undid instructions, replays from the
+	//last rewind keyframe to restore the rest of the hardware state at the journal's position
+	void ResumeFromJournal()
+	{
+		if(_reverseJournal && _reverseJournal->IsRewound()) {
+			_stepBackManager->ReplayTo(_reverseJournal->GetClock());
+			_reverseJournal->Resume();
+		}
+	}
+
 	virtual void ResetPrevOpCode() {}
 
 	virtual void OnBeforeBreak(CpuType cpuType) {}
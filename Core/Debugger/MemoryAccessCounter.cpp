@@ -41,7 +41,7 @@ ReadResult MemoryAccessCounter::ProcessMemoryRead(AddressInfo &addressInfo, uint
 }
 
 template<uint8_t accessWidth>
-void MemoryAccessCounter::ProcessMemoryWrite(AddressInfo& addressInfo, uint64_t masterClock)
+void MemoryAccessCounter::ProcessMemoryWrite(AddressInfo& addressInfo, uint64_t masterClock, CpuType cpuType)
 {
 	if(addressInfo.Address < 0) {
 		return;
@@ -52,6 +52,14 @@ void MemoryAccessCounter::ProcessMemoryWrite(AddressInfo& addressInfo, uint64_t
 		counts.WriteStamp = masterClock;
 		counts.WriteCounter++;
 	}
+
+	vector<MemoryWriteSource>& sources = _writeSources[(int)addressInfo.Type];
+	if(!sources.empty()) {
+		MemoryWriteSource src = { (int32_t)_debugger->GetProgramCounter(cpuType, true), cpuType };
+		for(int i = 0; i < accessWidth; i++) {
+			sources[addressInfo.Address + i] = src;
+		}
+	}
 }
 
 template<uint8_t accessWidth>
@@ -73,6 +81,7 @@ void MemoryAccessCounter::ResetCounts()
 	DebugBreakHelper helper(_debugger);
 	for(int i = 0; i < DebugUtilities::GetMemoryTypeCount(); i++) {
 		memset(_counters[i].data(), 0, _counters[i].size() * sizeof(AddressCounters));
+		std::fill(_writeSources[i].begin(), _writeSources[i].end(), MemoryWriteSource { -1, CpuType::Snes });
 	}
 	_enableBreakOnUninitRead = _debugger->GetConsole()->GetMasterClock() < 1000;
 }
@@ -96,13 +105,32 @@ void MemoryAccessCounter::GetAccessCounts(uint32_t offset, uint32_t length, Memo
 	}
 }
 
+void MemoryAccessCounter::EnableWriteSources()
+{
+	DebugBreakHelper helper(_debugger);
+	for(int i = (int)DebugUtilities::GetLastCpuMemoryType() + 1; i < DebugUtilities::GetMemoryTypeCount(); i++) {
+		if(_writeSources[i].empty() && !_counters[i].empty() && !DebugUtilities::IsRom((MemoryType)i)) {
+			_writeSources[i] = vector<MemoryWriteSource>(_counters[i].size(), MemoryWriteSource { -1, CpuType::Snes });
+		}
+	}
+}
+
+MemoryWriteSource MemoryAccessCounter::GetWriteSource(MemoryType memoryType, uint32_t address)
+{
+	vector<MemoryWriteSource>& sources = _writeSources[(int)memoryType];
+	if(address < sources.size()) {
+		return sources[address];
+	}
+	return { -1, CpuType::Snes };
+}
+
 template ReadResult MemoryAccessCounter::ProcessMemoryRead<1>(AddressInfo& addressInfo, uint64_t masterClock);
 template ReadResult MemoryAccessCounter::ProcessMemoryRead<2>(AddressInfo& addressInfo, uint64_t masterClock);
 template ReadResult MemoryAccessCounter::ProcessMemoryRead<4>(AddressInfo& addressInfo, uint64_t masterClock);
 
-template void MemoryAccessCounter::ProcessMemoryWrite<1>(AddressInfo& addressInfo, uint64_t masterClock);
-template void MemoryAccessCounter::ProcessMemoryWrite<2>(AddressInfo& addressInfo, uint64_t masterClock);
-template void MemoryAccessCounter::ProcessMemoryWrite<4>(AddressInfo& addressInfo, uint64_t masterClock);
+template void MemoryAccessCounter::ProcessMemoryWrite<1>(AddressInfo& addressInfo, uint64_t masterClock, CpuType cpuType);
+template void MemoryAccessCounter::ProcessMemoryWrite<2>(AddressInfo& addressInfo, uint64_t masterClock, CpuType cpuType);
+template void MemoryAccessCounter::ProcessMemoryWrite<4>(AddressInfo& addressInfo, uint64_t masterClock, CpuType cpuType);
 
 template void MemoryAccessCounter::ProcessMemoryExec<1>(AddressInfo& addressInfo, uint64_t masterClock);
 template void MemoryAccessCounter::ProcessMemoryExec<2>(AddressInfo& addressInfo, uint64_t masterClock);
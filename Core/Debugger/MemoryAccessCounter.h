@@ -23,6 +23,13 @@ struct AddressCounters
 	uint32_t ExecCounter;
 };
 
+//Instruction that performed the last write to a byte
+struct MemoryWriteSource
+{
+	int32_t Address;
+	CpuType Cpu;
+};
+
 enum class ReadResult
 {
 	Normal,
@@ -35,6 +42,9 @@ class MemoryAccessCounter
 private:
 	vector<AddressCounters> _counters[DebugUtilities::GetMemoryTypeCount()];
 
+	//Only allocated once EnableWriteSources() is called (used by memory snapshot diffs)
+	vector<MemoryWriteSource> _writeSources[DebugUtilities::GetMemoryTypeCount()];
+
 	Debugger* _debugger = nullptr;
 	bool _enableBreakOnUninitRead = false;
 
@@ -42,10 +52,15 @@ public:
 	MemoryAccessCounter(Debugger *debugger);
 
 	template<uint8_t accessWidth = 1> ReadResult ProcessMemoryRead(AddressInfo& addressInfo, uint64_t masterClock);
-	template<uint8_t accessWidth = 1> void ProcessMemoryWrite(AddressInfo& addressInfo, uint64_t masterClock);
+	template<uint8_t accessWidth = 1> void ProcessMemoryWrite(AddressInfo& addressInfo, uint64_t masterClock, CpuType cpuType);
 	template<uint8_t accessWidth = 1> void ProcessMemoryExec(AddressInfo& addressInfo, uint64_t masterClock);
 
 	void ResetCounts();
 
 	void GetAccessCounts(uint32_t offset, uint32_t length, MemoryType memoryType, AddressCounters counts[]);
+
+	//Starts recording which instruction writes to each byte of RAM (ROM is excluded)
+	void EnableWriteSources();
+	bool IsWriteSourceEnabled(MemoryType memoryType) { return !_writeSources[(int)memoryType].empty(); }
+	MemoryWriteSource GetWriteSource(MemoryType memoryType, uint32_t address);
 };
\ No newline at end of file
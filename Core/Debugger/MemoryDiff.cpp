@@ -0,0 +1,151 @@
+#include "pch.h"
+#include "Debugger/MemoryDiff.h"
+#include "Utilities/SimdUtilities.h"
+
+//The SIMD versions skip over blocks that don't contain what is being searched for, and return the
+//position of the first block that does (or of the last incomplete block) - the scalar loops then
+//find the exact position.
+
+static uint32_t FindMismatchScalar(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t end)
+{
+	for(; pos + 8 <= end; pos += 8) {
+		uint64_t va, vb;
+		memcpy(&va, a + pos, 8);
+		memcpy(&vb, b + pos, 8);
+		if(va != vb) {
+			break;
+		}
+	}
+	while(pos < end && a[pos] == b[pos]) {
+		pos++;
+	}
+	return pos;
+}
+
+static uint32_t FindMatchScalar(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t end)
+{
+	while(pos < end && a[pos] != b[pos]) {
+		pos++;
+	}
+	return pos;
+}
+
+#if defined(MESEN_SIMD_X86)
+SIMD_TARGET_SSE41 static uint32_t FindMismatchSse41(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t end)
+{
+	for(; pos + 16 <= end; pos += 16) {
+		__m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + pos)), _mm_loadu_si128((const __m128i*)(b + pos)));
+		if(_mm_movemask_epi8(eq) != 0xFFFF) {
+			break;
+		}
+	}
+	return pos;
+}
+
+SIMD_TARGET_SSE41 static uint32_t FindMatchSse41(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t end)
+{
+	for(; pos + 16 <= end; pos += 16) {
+		__m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + pos)), _mm_loadu_si128((const __m128i*)(b + pos)));
+		if(_mm_movemask_epi8(eq) != 0) {
+			break;
+		}
+	}
+	return pos;
+}
+
+SIMD_TARGET_AVX2 static uint32_t FindMismatchAvx2(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t end)
+{
+	for(; pos + 32 <= end; pos += 32) {
+		__m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + pos)), _mm256_loadu_si256((const __m256i*)(b + pos)));
+		if((uint32_t)_mm256_movemask_epi8(eq) != 0xFFFFFFFF) {
+			break;
+		}
+	}
+	return pos;
+}
+
+SIMD_TARGET_AVX2 static uint32_t FindMatchAvx2(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t end)
+{
+	for(; pos + 32 <= end; pos += 32) {
+		__m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + pos)), _mm256_loadu_si256((const __m256i*)(b + pos)));
+		if(_mm256_movemask_epi8(eq) != 0) {
+			break;
+		}
+	}
+	return pos;
+}
+#elif defined(MESEN_SIMD_NEON)
+static uint32_t FindMismatchNeon(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t end)
+{
+	for(; pos + 16 <= end; pos += 16) {
+		uint8x16_t eq = vceqq_u8(vld1q_u8(a + pos), vld1q_u8(b + pos));
+		if(vminvq_u8(eq) != 0xFF) {
+			break;
+		}
+	}
+	return pos;
+}
+
+static uint32_t FindMatchNeon(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t end)
+{
+	for(; pos + 16 <= end; pos += 16) {
+		uint8x16_t eq = vceqq_u8(vld1q_u8(a + pos), vld1q_u8(b + pos));
+		if(vmaxvq_u8(eq) != 0) {
+			break;
+		}
+	}
+	return pos;
+}
+#endif
+
+static uint32_t FindMismatch(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t end)
+{
+#if defined(MESEN_SIMD_X86)
+	if(SimdUtilities::HasAvx2()) {
+		pos = FindMismatchAvx2(a, b, pos, end);
+	} else if(SimdUtilities::HasSse41()) {
+		pos = FindMismatchSse41(a, b, pos, end);
+	}
+#elif defined(MESEN_SIMD_NEON)
+	if(SimdUtilities::HasNeon()) {
+		pos = FindMismatchNeon(a, b, pos, end);
+	}
+#endif
+	return FindMismatchScalar(a, b, pos, end);
+}
+
+static uint32_t FindMatch(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t end)
+{
+#if defined(MESEN_SIMD_X86)
+	if(SimdUtilities::HasAvx2()) {
+		pos = FindMatchAvx2(a, b, pos, end);
+	} else if(SimdUtilities::HasSse41()) {
+		pos = FindMatchSse41(a, b, pos, end);
+	}
+#elif defined(MESEN_SIMD_NEON)
+	if(SimdUtilities::HasNeon()) {
+		pos = FindMatchNeon(a, b, pos, end);
+	}
+#endif
+	return FindMatchScalar(a, b, pos, end);
+}
+
+void MemoryDiff::FindChangedRanges(const uint8_t* a, const uint8_t* b, uint32_t length, uint32_t baseOffset, vector<MemoryDiffRange>& ranges)
+{
+	uint32_t pos = 0;
+	while(true) {
+		pos = FindMismatch(a, b, pos, length);
+		if(pos >= length) {
+			break;
+		}
+
+		uint32_t end = FindMatch(a, b, pos + 1, length);
+		uint32_t start = baseOffset + pos;
+		if(!ranges.empty() && ranges.back().Start + ranges.back().Length == start) {
+			ranges.back().Length += end - pos;
+		} else {
+			ranges.push_back({ start, end - pos });
+		}
+		pos = end;
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "pch.h"
+
+struct MemoryDiffRange
+{
+	uint32_t Start;
+	uint32_t Length;
+};
+
+//Byte-compare kernel used by the memory snapshot diffs.
+//Equal blocks are skipped with SSE4.1/AVX2/NEON compares when the CPU supports them (same results as the scalar version)
+class MemoryDiff
+{
+public:
+	//Appends the ranges of bytes that differ between a and b to ranges (as offsets + baseOffset).
+	//A range that starts right where the last range in the list ends is merged with it, which allows
+	//a large buffer to be compared in several calls (e.g one call per page).
+	static void FindChangedRanges(const uint8_t* a, const uint8_t* b, uint32_t length, uint32_t baseOffset, vector<MemoryDiffRange>& ranges);
+};
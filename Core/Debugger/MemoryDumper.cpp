@@ -124,12 +124,6 @@ void MemoryDumper::GetMemoryState(MemoryType type, uint8_t *buffer)
 			}
 			break;
 
-		case MemoryType::SpcMemory:
-			for(int i = 0; i <= 0xFFFF; i++) {
-				buffer[i] = _spc->DebugRead(i);
-			}
-			break;
-		
 		case MemoryType::Sa1Memory:
 			if(_cartridge->GetSa1()) {
 				for(int i = 0; i <= 0xFFFFFF; i += 0x1000) {
@@ -166,102 +160,47 @@ void MemoryDumper::GetMemoryState(MemoryType type, uint8_t *buffer)
 			}
 			break;
 
-		case MemoryType::GameboyMemory: {
-			if(_gameboy) {
-				GbMemoryManager* memManager = _gameboy->GetMemoryManager();
-				for(int i = 0; i <= 0xFFFF; i++) {
-					buffer[i] = memManager->DebugRead(i);
-				}
-			}
-			break;
-		}
-
-		case MemoryType::NesMemory: {
-			if(_nesConsole) {
-				for(int i = 0; i <= 0xFFFF; i++) {
-					buffer[i] = _nesConsole->DebugRead(i);
-				}
-			}
-			break;
-		}
-
-		case MemoryType::NesPpuMemory: {
-			if(_nesConsole) {
-				for(int i = 0; i < 0x4000; i++) {
-					buffer[i] = _nesConsole->DebugReadVram(i);
-				}
-			}
-			break;
-		}
-
-		case MemoryType::PceMemory: {
-			if(_pceConsole) {
-				PceMemoryManager* memManager = _pceConsole->GetMemoryManager();
-				for(int i = 0; i <= 0xFFFF; i++) {
-					buffer[i] = memManager->DebugRead(i);
-				}
-			}
-			break;
-		}
-
-		case MemoryType::SmsMemory: {
-			if(_smsConsole) {
-				SmsMemoryManager* memManager = _smsConsole->GetMemoryManager();
-				for(int i = 0; i <= 0xFFFF; i++) {
-					buffer[i] = memManager->DebugRead(i);
-				}
-			}
-			break;
-		}
-
-		case MemoryType::GbaMemory: {
-			if(_gbaConsole) {
-				GbaMemoryManager* memManager = _gbaConsole->GetMemoryManager();
-				for(int i = 0; i <= 0xFFFFFFF; i++) {
-					buffer[i] = memManager->DebugRead(i);
-				}
-			}
-			break;
-		}
-
-		case MemoryType::WsMemory: {
-			if(_wsConsole) {
-				WsMemoryManager* memManager = _wsConsole->GetMemoryManager();
-				for(int i = 0; i <= 0xFFFFF; i++) {
-					buffer[i] = memManager->DebugRead(i);
-				}
-			}
-			break;
-		}
-
-		default: 
-			uint8_t* src = GetMemoryBuffer(type);
-			if(src) {
-				memcpy(buffer, src, GetMemorySize(type));
-			}
+		default:
+			InternalGetMemoryValues(type, 0, GetMemorySize(type), buffer);
 			break;
 	}
 }
 
 void MemoryDumper::InternalSetMemoryValues(MemoryType originalMemoryType, uint32_t startAddress, uint8_t* data, uint32_t length, bool disableSideEffects, bool undoAllowed)
 {
+	if(originalMemoryType == MemoryType::NecDspMemory) {
+		InternalSetMemoryValues(MemoryType::DspProgramRom, startAddress, data, length, disableSideEffects, undoAllowed);
+		return;
+	}
+
 	uint32_t memSize = GetMemorySize(originalMemoryType);
-	
+	if(startAddress >= memSize) {
+		return;
+	}
+	length = std::min(length, memSize - startAddress);
+
 	UndoBatch undoBatch = {};
 	UndoEntry undoEntry = { MemoryType::None };
 
+	//Disassembly cache invalidation is done once per contiguous range of written bytes
 	Disassembler* disassembler = _debugger->GetDisassembler();
+	AddressInfo invalidStart = { -1, MemoryType::None };
+	uint32_t invalidLength = 0;
+	auto flushInvalidRange = [&]() {
+		if(invalidLength > 0) {
+			disassembler->InvalidateCache(invalidStart, invalidLength, DebugUtilities::ToCpuType(invalidStart.Type));
+			invalidLength = 0;
+		}
+	};
+
+	bool isRelative = disableSideEffects && DebugUtilities::IsRelativeMemory(originalMemoryType);
 
 	for(uint32_t i = 0; i < length; i++) {
 		uint32_t address = startAddress + i;
-		if(address >= memSize) {
-			break;
-		}
-
 		uint8_t value = data[i];
 
 		MemoryType memoryType = originalMemoryType;
-		if(disableSideEffects && DebugUtilities::IsRelativeMemory(memoryType)) {
+		if(isRelative) {
 			AddressInfo addr = { (int32_t)address, memoryType };
 			addr = _debugger->GetAbsoluteAddress(addr);
 			if(addr.Address < 0) {
@@ -275,7 +214,6 @@ void MemoryDumper::InternalSetMemoryValues(MemoryType originalMemoryType, uint32
 			case MemoryType::SnesMemory: _memoryManager->GetMemoryMappings()->DebugWrite(address, value); break;
 			case MemoryType::SpcMemory: _spc->DebugWrite(address, value); break;
 			case MemoryType::Sa1Memory: _cartridge->GetSa1()->GetMemoryMappings()->DebugWrite(address, value); break;
-			case MemoryType::NecDspMemory: SetMemoryValue(MemoryType::DspProgramRom, address, value, disableSideEffects); return;
 			case MemoryType::GsuMemory: _cartridge->GetGsu()->GetMemoryMappings()->DebugWrite(address, value); break;
 			case MemoryType::Cx4Memory: _cartridge->GetCx4()->GetMemoryMappings()->DebugWrite(address, value); break;
 			case MemoryType::St018Memory: _cartridge->GetSt018()->DebugWrite(address, value); break;
@@ -292,11 +230,13 @@ void MemoryDumper::InternalSetMemoryValues(MemoryType originalMemoryType, uint32
 				uint8_t* src = GetMemoryBuffer(memoryType);
 				if(src) {
 					if(undoAllowed) {
-						if(undoEntry.MemType != memoryType) {
+						//Relative addresses can map to non-contiguous absolute addresses, start a new entry when needed
+						if(undoEntry.MemType != memoryType || undoEntry.StartAddress + undoEntry.OriginalData.size() != address) {
 							if(undoEntry.OriginalData.size() > 0) {
-								undoBatch.Entries.push_back(undoEntry);
+								undoBatch.Entries.push_back(std::move(undoEntry));
 							}
 							undoEntry = { memoryType, address };
+							undoEntry.OriginalData.reserve(length - i);
 						}
 
 						uint8_t originalValue = src[address];
@@ -315,8 +255,11 @@ void MemoryDumper::InternalSetMemoryValues(MemoryType originalMemoryType, uint32
 						default:
 							src[address] = value;
 
-							AddressInfo addr = { (int32_t)address, memoryType };
-							disassembler->InvalidateCache(addr, DebugUtilities::ToCpuType(memoryType));
+							if(invalidStart.Type != memoryType || invalidStart.Address + invalidLength != address) {
+								flushInvalidRange();
+								invalidStart = { (int32_t)address, memoryType };
+							}
+							invalidLength++;
 							break;
 					}
 				}
@@ -324,11 +267,13 @@ void MemoryDumper::InternalSetMemoryValues(MemoryType originalMemoryType, uint32
 		}
 	}
 
+	flushInvalidRange();
+
 	if(undoAllowed && undoEntry.MemType != MemoryType::None) {
-		undoBatch.Entries.push_back(undoEntry);
+		undoBatch.Entries.push_back(std::move(undoEntry));
 
 		auto lock = _undoLock.AcquireSafe();
-		_undoHistory.push_back(undoBatch);
+		_undoHistory.push_back(std::move(undoBatch));
 		if(_undoHistory.size() > 200) {
 			_undoHistory.pop_front();
 		}
@@ -348,10 +293,11 @@ void MemoryDumper::SetMemoryValue(MemoryType memoryType, uint32_t address, uint8
 
 void MemoryDumper::GetMemoryValues(MemoryType memoryType, uint32_t start, uint32_t end, uint8_t* output)
 {
-	int x = 0;
 	uint32_t size = GetMemorySize(memoryType);
-	for(uint32_t i = start; i <= end && i < size; i++) {
-		output[x++] = InternalGetMemoryValue(memoryType, i);
+	uint32_t x = 0;
+	if(start < size) {
+		x = std::min(end, size - 1) - start + 1;
+		InternalGetMemoryValues(memoryType, start, x, output);
 	}
 
 	if(end >= size) {
@@ -359,6 +305,32 @@ void MemoryDumper::GetMemoryValues(MemoryType memoryType, uint32_t start, uint32
 	}
 }
 
+void MemoryDumper::InternalGetMemoryValues(MemoryType memoryType, uint32_t start, uint32_t length, uint8_t* output)
+{
+	switch(memoryType) {
+		case MemoryType::SpcMemory: _spc->DebugReadBlock(start, output, length); break;
+		case MemoryType::GameboyMemory: _gameboy->GetMemoryManager()->DebugReadBlock(start, output, length); break;
+		case MemoryType::NesMemory: _nesConsole->DebugReadBlock(start, output, length); break;
+		case MemoryType::NesPpuMemory: _nesConsole->DebugReadVramBlock(start, output, length); break;
+		case MemoryType::PceMemory: _pceConsole->GetMemoryManager()->DebugReadBlock(start, output, length); break;
+		case MemoryType::SmsMemory: _smsConsole->GetMemoryManager()->DebugReadBlock(start, output, length); break;
+		case MemoryType::GbaMemory: _gbaConsole->GetMemoryManager()->DebugReadBlock(start, output, length); break;
+		case MemoryType::WsMemory: _wsConsole->GetMemoryManager()->DebugReadBlock(start, output, length); break;
+
+		default: {
+			uint8_t* src = DebugUtilities::IsRelativeMemory(memoryType) ? nullptr : GetMemoryBuffer(memoryType);
+			if(src) {
+				memcpy(output, src + start, length);
+			} else {
+				for(uint32_t i = 0; i < length; i++) {
+					output[i] = InternalGetMemoryValue(memoryType, start + i);
+				}
+			}
+			break;
+		}
+	}
+}
+
 uint8_t MemoryDumper::GetMemoryValue(MemoryType memoryType, uint32_t address, bool disableSideEffects)
 {
 	if(address >= GetMemorySize(memoryType)) {
@@ -50,6 +50,7 @@ private:
 	deque<UndoBatch> _undoHistory;
 
 	uint8_t InternalGetMemoryValue(MemoryType memoryType, uint32_t address, bool disableSideEffects = true);
+	void InternalGetMemoryValues(MemoryType memoryType, uint32_t start, uint32_t length, uint8_t* output);
 	void InternalSetMemoryValues(MemoryType memoryType, uint32_t startAddress, uint8_t* data, uint32_t length, bool disableSideEffects, bool undoAllowed);
 
 public:
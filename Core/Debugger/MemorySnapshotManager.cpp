@@ -0,0 +1,148 @@
+#include "pch.h"
+#include "Debugger/MemorySnapshotManager.h"
+#include "Debugger/MemoryDiff.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/DebugBreakHelper.h"
+#include "Debugger/DebugUtilities.h"
+#include "Debugger/MemoryDumper.h"
+#include "Debugger/MemoryAccessCounter.h"
+
+MemorySnapshotManager::MemorySnapshotManager(Debugger* debugger)
+{
+	_debugger = debugger;
+}
+
+MemorySnapshotManager::MemorySnapshot* MemorySnapshotManager::FindMemory(Snapshot& snapshot, MemoryType type)
+{
+	for(MemorySnapshot& mem : snapshot.Memory) {
+		if(mem.Type == type) {
+			return &mem;
+		}
+	}
+	return nullptr;
+}
+
+void MemorySnapshotManager::TakeSnapshot(string name)
+{
+	//Start tracking writers now, so the diffs between this snapshot and the next ones can report them
+	MemoryAccessCounter* counter = _debugger->GetMemoryAccessCounter();
+	counter->EnableWriteSources();
+
+	DebugBreakHelper helper(_debugger);
+	MemoryDumper* dumper = _debugger->GetMemoryDumper();
+
+	Snapshot snapshot;
+	for(int i = (int)DebugUtilities::GetLastCpuMemoryType() + 1; i < DebugUtilities::GetMemoryTypeCount(); i++) {
+		MemoryType type = (MemoryType)i;
+		uint32_t size = dumper->GetMemorySize(type);
+		uint8_t* src = dumper->GetMemoryBuffer(type);
+		if(size == 0 || !src || DebugUtilities::IsRom(type)) {
+			continue;
+		}
+
+		MemorySnapshot mem;
+		mem.Type = type;
+		mem.Size = size;
+
+		MemorySnapshot* prev = FindMemory(_lastSnapshot, type);
+		if(prev && prev->Size != size) {
+			prev = nullptr;
+		}
+
+		for(uint32_t offset = 0, page = 0; offset < size; offset += PageSize, page++) {
+			uint32_t len = std::min(PageSize, size - offset);
+			if(prev && memcmp(prev->Pages[page]->data(), src + offset, len) == 0) {
+				//Unchanged since the last snapshot, share the page
+				mem.Pages.push_back(prev->Pages[page]);
+			} else {
+				mem.Pages.push_back(std::make_shared<vector<uint8_t>>(src + offset, src + offset + len));
+			}
+		}
+		snapshot.Memory.push_back(std::move(mem));
+	}
+
+	_lastSnapshot = snapshot;
+	_snapshots[name] = std::move(snapshot);
+}
+
+bool MemorySnapshotManager::HasSnapshot(string name)
+{
+	return _snapshots.find(name) != _snapshots.end();
+}
+
+vector<string> MemorySnapshotManager::GetSnapshotNames()
+{
+	vector<string> names;
+	for(auto& entry : _snapshots) {
+		names.push_back(entry.first);
+	}
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+void MemorySnapshotManager::DeleteSnapshot(string name)
+{
+	_snapshots.erase(name);
+}
+
+bool MemorySnapshotManager::Diff(string from, string to, MemoryType memType, vector<MemoryDiffEntry>& result)
+{
+	auto fromResult = _snapshots.find(from);
+	auto toResult = _snapshots.find(to);
+	if(fromResult == _snapshots.end() || toResult == _snapshots.end()) {
+		return false;
+	}
+
+	MemoryAccessCounter* counter = _debugger->GetMemoryAccessCounter();
+	vector<MemoryDiffRange> ranges;
+	for(MemorySnapshot& a : fromResult->second.Memory) {
+		MemorySnapshot* b = FindMemory(toResult->second, a.Type);
+		if(!b || (memType != MemoryType::None && a.Type != memType)) {
+			continue;
+		}
+
+		ranges.clear();
+		uint32_t size = std::min(a.Size, b->Size);
+		for(uint32_t page = 0; page * PageSize < size; page++) {
+			if(a.Pages[page] == b->Pages[page]) {
+				//Shared page, nothing changed
+				continue;
+			}
+			uint32_t len = std::min(PageSize, size - page * PageSize);
+			MemoryDiff::FindChangedRanges(a.Pages[page]->data(), b->Pages[page]->data(), len, page * PageSize, ranges);
+		}
+
+		//Split the ranges wherever the last writer changes
+		bool hasWriters = counter->IsWriteSourceEnabled(a.Type);
+		for(MemoryDiffRange& range : ranges) {
+			uint32_t end = range.Start + range.Length;
+			uint32_t start = range.Start;
+			MemoryWriteSource src = hasWriters ? counter->GetWriteSource(a.Type, start) : MemoryWriteSource { -1, CpuType::Snes };
+			for(uint32_t addr = start + 1; addr <= end; addr++) {
+				MemoryWriteSource next = (hasWriters && addr < end) ? counter->GetWriteSource(a.Type, addr) : src;
+				if(addr == end || next.Address != src.Address || next.Cpu != src.Cpu) {
+					result.push_back({ a.Type, start, addr - start, src.Address, src.Cpu });
+					start = addr;
+					src = next;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool MemorySnapshotManager::GetSnapshotValue(string name, MemoryType memType, uint32_t address, uint8_t& value)
+{
+	auto result = _snapshots.find(name);
+	if(result == _snapshots.end()) {
+		return false;
+	}
+
+	MemorySnapshot* mem = FindMemory(result->second, memType);
+	if(!mem || address >= mem->Size) {
+		return false;
+	}
+
+	value = (*mem->Pages[address / PageSize])[address % PageSize];
+	return true;
+}
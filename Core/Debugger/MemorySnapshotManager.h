@@ -0,0 +1,58 @@
+#pragma once
+#include "pch.h"
+#include "Debugger/DebugTypes.h"
+#include "Debugger/MemoryDiff.h"
+#include "Shared/MemoryType.h"
+
+class Debugger;
+
+struct MemoryDiffEntry
+{
+	MemoryType Type;
+	uint32_t Start;
+	uint32_t Length;
+
+	//Instruction that last wrote to the range (WriterAddress is -1 when unknown, e.g for DMA or debugger edits done before the 1st snapshot)
+	int32_t WriterAddress;
+	CpuType WriterCpu;
+};
+
+//Named snapshots of the console's RAM, which can be compared with each other.
+//Snapshots are split into pages that are shared with the previous snapshot when their content
+//hasn't changed, so taking many snapshots of a mostly static memory space is cheap.
+class MemorySnapshotManager
+{
+private:
+	static constexpr uint32_t PageSize = 0x1000;
+
+	struct MemorySnapshot
+	{
+		MemoryType Type = MemoryType::None;
+		uint32_t Size = 0;
+		vector<shared_ptr<vector<uint8_t>>> Pages;
+	};
+
+	struct Snapshot
+	{
+		vector<MemorySnapshot> Memory;
+	};
+
+	Debugger* _debugger = nullptr;
+	unordered_map<string, Snapshot> _snapshots;
+	Snapshot _lastSnapshot;
+
+	static MemorySnapshot* FindMemory(Snapshot& snapshot, MemoryType type);
+
+public:
+	MemorySnapshotManager(Debugger* debugger);
+
+	//Snapshots every RAM type of the console (ROM types are skipped), replacing any existing snapshot with the same name
+	void TakeSnapshot(string name);
+	bool HasSnapshot(string name);
+	vector<string> GetSnapshotNames();
+	void DeleteSnapshot(string name);
+
+	//Returns the ranges that differ between both snapshots (for all memory types when memType is None), split by writer
+	bool Diff(string from, string to, MemoryType memType, vector<MemoryDiffEntry>& result);
+	bool GetSnapshotValue(string name, MemoryType memType, uint32_t address, uint8_t& value);
+};
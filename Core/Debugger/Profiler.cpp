@@ -1,19 +1,23 @@
 #include "pch.h"
 #include <limits>
 #include "Debugger/Profiler.h"
+#include "Debugger/CallstackManager.h"
 #include "Debugger/DebugBreakHelper.h"
 #include "Debugger/Debugger.h"
 #include "Debugger/IDebugger.h"
+#include "Debugger/LabelManager.h"
 #include "Debugger/MemoryDumper.h"
 #include "Debugger/DebugTypes.h"
 #include "Shared/Interfaces/IConsole.h"
+#include "Utilities/HexUtilities.h"
 
-static constexpr int32_t ResetFunctionIndex = -1;
+static constexpr int32_t ResetFunctionAddress = -1;
 
-Profiler::Profiler(Debugger* debugger, IDebugger* cpuDebugger)
+Profiler::Profiler(Debugger* debugger, IDebugger* cpuDebugger, CallstackManager* callstack)
 {
 	_debugger = debugger;
 	_cpuDebugger = cpuDebugger;
+	_callstack = callstack;
 	InternalReset();
 }
 
@@ -21,35 +25,74 @@ Profiler::~Profiler()
 {
 }
 
-void Profiler::StackFunction(AddressInfo &addr, StackFrameFlags stackFlag)
+uint32_t Profiler::GetFunctionIndex(AddressInfo& addr)
 {
-	if(addr.Address >= 0) {
-		uint32_t key = addr.Address | ((uint8_t)addr.Type << 24);
-		if(_functions.find(key) == _functions.end()) {
-			_functions[key] = ProfiledFunction();
-			_functions[key].Address = addr;
-		}
+	bool added;
+	uint64_t key = (uint32_t)addr.Address | ((uint64_t)addr.Type << 32);
+	uint32_t index = _functionIndexes.GetOrAdd(key, added);
+	if(added) {
+		_functions.push_back({});
+		_functions[index].Address = addr;
+	}
+	return index;
+}
+
+uint32_t Profiler::GetEdgeIndex(uint32_t caller, uint32_t callee)
+{
+	bool added;
+	uint32_t index = _edgeIndexes.GetOrAdd(((uint64_t)caller << 32) | callee, added);
+	if(added) {
+		_edges.push_back({});
+		_edges[index].Caller = caller;
+		_edges[index].Callee = callee;
+	}
+	return index;
+}
+
+uint32_t Profiler::GetNodeIndex(uint32_t parent, uint32_t function)
+{
+	uint64_t key = ((uint64_t)parent << 32) | function;
+	if(_nodes.size() >= MaxStackNodes) {
+		//Table is full, only existing call paths are tracked - new ones are merged into their parent
+		int32_t index = _nodeIndexes.Find(key);
+		return index >= 0 ? (uint32_t)index : parent;
+	}
+
+	bool added;
+	uint32_t index = _nodeIndexes.GetOrAdd(key, added);
+	if(added) {
+		_nodes.push_back({});
+		_nodes[index].Parent = (int32_t)parent;
+		_nodes[index].Function = function;
+	}
+	return index;
+}
+
+void Profiler::StackFunction(AddressInfo &addr, StackFrameFlags stackFlag, ProfilerFrame& frame)
+{
+	if(addr.Address >= 0 && _enabled) {
+		uint32_t function = GetFunctionIndex(addr);
 
 		UpdateCycles();
 
-		_stackFlags.push_back(stackFlag);
-		_cycleCountStack.push_back(_currentCycleCount);
-		_functionStack.push_back(_currentFunction);
+		uint32_t edge = GetEdgeIndex(_currentFunction, function);
+		_edges[edge].CallCount++;
 
-		if(_functionStack.size() > 100) {
-			//Keep stack to 100 functions at most (to prevent performance issues, esp. in debug builds)
-			//Only happens when software doesn't use JSR/RTS normally to enter/leave functions
-			_functionStack.pop_front();
-			_cycleCountStack.pop_front();
-			_stackFlags.pop_front();
-		}
+		frame = { _currentFunction, _currentNode, edge, stackFlag, _generation, _currentCycleCount };
 
-		ProfiledFunction& func = _functions[key];
+		ProfiledFunction& func = _functions[function];
 		func.CallCount++;
 		func.Flags = stackFlag;
 
-		_currentFunction = key;
+		_currentNode = GetNodeIndex(_currentNode, function);
+		_currentFunction = function;
 		_currentCycleCount = 0;
+	} else if(_enabled) {
+		//Calls to unresolved addresses stay in the current function, but frames below them still get inclusive cycles
+		frame = { UnresolvedFunction, _currentNode, 0, stackFlag, _generation, 0 };
+	} else {
+		//Frames pushed while the profiler is disabled are ignored when they return
+		frame.Generation = _generation - 1;
 	}
 }
 
@@ -61,23 +104,21 @@ void Profiler::UpdateCycles()
 	uint64_t clockGap = masterClock - _prevMasterClock;
 	func.ExclusiveCycles += clockGap;
 	func.InclusiveCycles += clockGap;
+	_nodes[_currentNode].ExclusiveCycles += clockGap;
 	
-	int32_t len = (int32_t)_functionStack.size();
-	for(int32_t i = len - 1; i >= 0; i--) {
-		_functions[_functionStack[i]].InclusiveCycles += clockGap;
-		if(_stackFlags[i] != StackFrameFlags::None) {
-			//Don't apply inclusive times to stack frames before an IRQ/NMI
-			break;
-		}
-	}
+	uint32_t depth = std::min(_callstack->GetSize(), MaxInclusiveDepth);
+	ForEachInclusiveFrame(depth, _generation,
+		[this](uint32_t i) -> ProfilerFrame& { return _callstack->GetProfilerFrame(i); },
+		[this, clockGap](uint32_t function) { _functions[function].InclusiveCycles += clockGap; }
+	);
 
 	_currentCycleCount += clockGap;
 	_prevMasterClock = masterClock;
 }
 
-void Profiler::UnstackFunction()
+void Profiler::UnstackFunction(ProfilerFrame& entry)
 {
-	if(!_functionStack.empty()) {
+	if(entry.Generation == _generation && entry.Function != UnresolvedFunction && _enabled) {
 		UpdateCycles();
 
 		//Return to the previous function
@@ -85,13 +126,13 @@ void Profiler::UnstackFunction()
 		func.MinCycles = std::min(func.MinCycles, _currentCycleCount);
 		func.MaxCycles = std::max(func.MaxCycles, _currentCycleCount);
 
-		_currentFunction = _functionStack.back();
-		_functionStack.pop_back();
-		_stackFlags.pop_back();
+		_edges[entry.Edge].InclusiveCycles += _currentCycleCount;
+
+		_currentFunction = entry.Function;
+		_currentNode = entry.Node;
 
 		//Add the subroutine's cycle count to the current routine's cycle count
-		_currentCycleCount = _cycleCountStack.back() + _currentCycleCount;
-		_cycleCountStack.pop_back();
+		_currentCycleCount = entry.CycleCount + _currentCycleCount;
 	}
 }
 
@@ -101,38 +142,167 @@ void Profiler::Reset()
 	InternalReset();
 }
 
+void Profiler::Start()
+{
+	DebugBreakHelper helper(_debugger);
+	InternalReset();
+	_enabled = true;
+}
+
+void Profiler::Stop()
+{
+	DebugBreakHelper helper(_debugger);
+	if(_enabled) {
+		UpdateCycles();
+		_enabled = false;
+	}
+}
+
 void Profiler::ResetState()
 {
 	_prevMasterClock = _cpuDebugger->GetCpuCycleCount(true);
 	_currentCycleCount = 0;
-	_functionStack.clear();
-	_stackFlags.clear();
-	_cycleCountStack.clear();
-	_currentFunction = ResetFunctionIndex;
+	_generation++; //Invalidates the profiler state of all frames currently on the callstack
+	_currentFunction = 0;
+	_currentNode = 0;
 }
 
 void Profiler::InternalReset()
 {
 	ResetState();
 	
+	_functionIndexes.Clear();
 	_functions.clear();
-	_functions[ResetFunctionIndex] = ProfiledFunction();
-	_functions[ResetFunctionIndex].Address = { ResetFunctionIndex, MemoryType::None };
+	_edgeIndexes.Clear();
+	_edges.clear();
+	_nodeIndexes.Clear();
+	_nodes.clear();
+
+	//Function 0 and node 0 are the root ("reset") function
+	AddressInfo resetAddr = { ResetFunctionAddress, MemoryType::None };
+	GetFunctionIndex(resetAddr);
+	_nodes.push_back({});
 }
 
 void Profiler::GetProfilerData(ProfiledFunction* profilerData, uint32_t& functionCount)
 {
 	DebugBreakHelper helper(_debugger);
 	
-	UpdateCycles();
+	if(_enabled) {
+		UpdateCycles();
+	}
+
+	functionCount = (uint32_t)std::min<size_t>(_functions.size(), 100000);
+	for(uint32_t i = 0; i < functionCount; i++) {
+		profilerData[i] = _functions[i];
+	}
+}
 
-	functionCount = 0;
-	for(auto& func : _functions) {
-		profilerData[functionCount] = func.second;
-		functionCount++;
+string Profiler::GetFunctionName(uint32_t function, CpuType cpuType)
+{
+	AddressInfo& addr = _functions[function].Address;
+	if(addr.Address == ResetFunctionAddress) {
+		return "[reset]";
+	}
 
-		if(functionCount >= 100000) {
-			break;
+	string name = _debugger->GetLabelManager()->GetLabel(addr);
+	if(name.empty()) {
+		AddressInfo relAddr = _debugger->GetRelativeAddress(addr, cpuType);
+		if(relAddr.Address >= 0) {
+			name = "$" + HexUtilities::ToHex((uint32_t)relAddr.Address);
+		} else {
+			name = "[" + HexUtilities::ToHex((uint32_t)addr.Address) + "]";
 		}
 	}
+
+	//Folded stack format uses ";" as a separator and " " before the sample count
+	std::replace(name.begin(), name.end(), ';', '_');
+	std::replace(name.begin(), name.end(), ' ', '_');
+	return name;
+}
+
+void Profiler::Export(ostream& out, ProfilerExportFormat format, CpuType cpuType)
+{
+	DebugBreakHelper helper(_debugger);
+
+	if(_enabled) {
+		UpdateCycles();
+	}
+
+	vector<string> names;
+	names.reserve(_functions.size());
+	for(uint32_t i = 0; i < _functions.size(); i++) {
+		names.push_back(GetFunctionName(i, cpuType));
+	}
+
+	switch(format) {
+		case ProfilerExportFormat::FoldedStacks: ExportFoldedStacks(out, names); break;
+		case ProfilerExportFormat::Json: ExportJson(out, names); break;
+	}
+}
+
+void Profiler::ExportFoldedStacks(ostream& out, vector<string>& names)
+{
+	//One line per call path: "root;caller;callee <exclusive cycles>" (flamegraph.pl/speedscope/inferno format)
+	vector<uint32_t> path;
+	for(uint32_t i = 0; i < _nodes.size(); i++) {
+		if(_nodes[i].ExclusiveCycles == 0) {
+			continue;
+		}
+
+		path.clear();
+		for(int32_t node = (int32_t)i; node >= 0; node = _nodes[node].Parent) {
+			path.push_back(_nodes[node].Function);
+		}
+
+		for(size_t j = path.size(); j > 0; j--) {
+			out << names[path[j - 1]];
+			if(j > 1) {
+				out << ';';
+			}
+		}
+		out << ' ' << _nodes[i].ExclusiveCycles << '\n';
+	}
+}
+
+static void WriteJsonString(ostream& out, const string& str)
+{
+	out << '"';
+	for(char c : str) {
+		if(c == '"' || c == '\\') {
+			out << '\\' << c;
+		} else if((uint8_t)c < 0x20) {
+			out << ' ';
+		} else {
+			out << c;
+		}
+	}
+	out << '"';
+}
+
+void Profiler::ExportJson(ostream& out, vector<string>& names)
+{
+	out << "{\"functions\":[";
+	for(uint32_t i = 0; i < _functions.size(); i++) {
+		ProfiledFunction& func = _functions[i];
+		out << (i > 0 ? ",\n" : "\n") << "{\"id\":" << i << ",\"name\":";
+		WriteJsonString(out, names[i]);
+		out << ",\"address\":" << func.Address.Address;
+		out << ",\"memoryType\":" << (int)func.Address.Type;
+		out << ",\"callCount\":" << func.CallCount;
+		out << ",\"inclusiveCycles\":" << func.InclusiveCycles;
+		out << ",\"exclusiveCycles\":" << func.ExclusiveCycles;
+		out << ",\"minCycles\":" << (func.MinCycles == UINT64_MAX ? 0 : func.MinCycles);
+		out << ",\"maxCycles\":" << func.MaxCycles;
+		out << ",\"flags\":" << (int)func.Flags << "}";
+	}
+
+	out << "],\n\"edges\":[";
+	for(uint32_t i = 0; i < _edges.size(); i++) {
+		ProfiledCallEdge& edge = _edges[i];
+		out << (i > 0 ? ",\n" : "\n");
+		out << "{\"caller\":" << edge.Caller << ",\"callee\":" << edge.Callee;
+		out << ",\"callCount\":" << edge.CallCount << ",\"inclusiveCycles\":" << edge.InclusiveCycles << "}";
+	}
+	out << "]}\n";
 }
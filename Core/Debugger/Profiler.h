@@ -1,6 +1,8 @@
 #pragma once
 #include "pch.h"
 #include "Debugger/DebugTypes.h"
+#include "Debugger/CallstackManager.h"
+#include "Utilities/FlatIndexMap.h"
 
 class Debugger;
 class IDebugger;
@@ -16,33 +18,111 @@ struct ProfiledFunction
 	StackFrameFlags Flags = {};
 };
 
+struct ProfiledCallEdge
+{
+	uint32_t Caller = 0;
+	uint32_t Callee = 0;
+	uint64_t CallCount = 0;
+	uint64_t InclusiveCycles = 0;
+};
+
+//A node in the call tree (one per unique call path), used for the folded stack (flamegraph) output
+struct ProfiledStackNode
+{
+	int32_t Parent = -1;
+	uint32_t Function = 0;
+	uint64_t ExclusiveCycles = 0;
+};
+
+enum class ProfilerExportFormat
+{
+	FoldedStacks,
+	Json
+};
+
 class Profiler
 {
 private:
+	//Inclusive cycles are only added to the 100 most recent functions on the stack (to prevent performance issues, esp. in debug builds)
+	//Only matters when software doesn't use JSR/RTS normally to enter/leave functions
+	static constexpr uint32_t MaxInclusiveDepth = 100;
+
+	//Limits memory usage when code never returns normally (each new call path adds a node)
+	static constexpr uint32_t MaxStackNodes = 0x100000;
+
 	Debugger* _debugger = nullptr;
 	IDebugger* _cpuDebugger = nullptr;
 
-	unordered_map<int32_t, ProfiledFunction> _functions;
-	
-	deque<int32_t> _functionStack;
-	deque<StackFrameFlags> _stackFlags;
-	deque<uint64_t> _cycleCountStack;
+	//The profiler's call stack is stored in the callstack manager's frames
+	CallstackManager* _callstack = nullptr;
+	uint32_t _generation = 0;
+
+	FlatIndexMap _functionIndexes;
+	vector<ProfiledFunction> _functions;
+
+	FlatIndexMap _edgeIndexes;
+	vector<ProfiledCallEdge> _edges;
+
+	FlatIndexMap _nodeIndexes;
+	vector<ProfiledStackNode> _nodes;
 
 	uint64_t _currentCycleCount = 0;
 	uint64_t _prevMasterClock = 0;
-	int32_t _currentFunction = -1;
+	uint32_t _currentFunction = 0;
+	uint32_t _currentNode = 0;
+	//Off until Start(), so the call tables aren't updated on every call/return when nobody is profiling
+	bool _enabled = false;
 
 	void InternalReset();
 	void UpdateCycles();
 
+	uint32_t GetFunctionIndex(AddressInfo& addr);
+	uint32_t GetEdgeIndex(uint32_t caller, uint32_t callee);
+	uint32_t GetNodeIndex(uint32_t parent, uint32_t function);
+
+	string GetFunctionName(uint32_t function, CpuType cpuType);
+	void ExportFoldedStacks(ostream& out, vector<string>& names);
+	void ExportJson(ostream& out, vector<string>& names);
+
 public:
-	Profiler(Debugger* debugger, IDebugger* cpuDebugger);
+	//Function index of frames pushed for calls to an unresolved (e.g ram) address, these aren't profiled
+	static constexpr uint32_t UnresolvedFunction = UINT32_MAX;
+
+	//Calls addCycles(function) for each frame that should get inclusive cycles, starting from the most recent frame (depth 0)
+	template<typename TGetFrame, typename TAddCycles>
+	static void ForEachInclusiveFrame(uint32_t depth, uint32_t generation, TGetFrame getFrame, TAddCycles addCycles)
+	{
+		for(uint32_t i = 0; i < depth; i++) {
+			ProfilerFrame& frame = getFrame(i);
+			if(frame.Generation != generation) {
+				//This frame and the ones below it were pushed before the profiler was started
+				break;
+			}
+			if(frame.Function != UnresolvedFunction) {
+				addCycles(frame.Function);
+			}
+			if(frame.Flags != StackFrameFlags::None) {
+				//Don't apply inclusive times to stack frames before an IRQ/NMI
+				break;
+			}
+		}
+	}
+
+	Profiler(Debugger* debugger, IDebugger* cpuDebugger, CallstackManager* callstack);
 	~Profiler();
 
-	void StackFunction(AddressInfo& addr, StackFrameFlags stackFlag);
-	void UnstackFunction();
+	void StackFunction(AddressInfo& addr, StackFrameFlags stackFlag, ProfilerFrame& frame);
+	void UnstackFunction(ProfilerFrame& frame);
 
 	void Reset();
 	void ResetState();
 	void GetProfilerData(ProfiledFunction* profilerData, uint32_t& functionCount);
-};
\ No newline at end of file
+
+	//Start clears all previous data, stop keeps the data until the next start/reset
+	void Start();
+	void Stop();
+	bool IsEnabled() { return _enabled; }
+
+	uint32_t GetFunctionCount() { return (uint32_t)_functions.size(); }
+	void Export(ostream& out, ProfilerExportFormat format, CpuType cpuType);
+};
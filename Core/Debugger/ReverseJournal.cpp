@@ -0,0 +1,164 @@
+#include "pch.h"
+#include "Debugger/ReverseJournal.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/IDebugger.h"
+#include "Debugger/MemoryDumper.h"
+#include "Debugger/Disassembler.h"
+#include "Debugger/BreakpointManager.h"
+#include "Debugger/DebugUtilities.h"
+#include "Shared/MemoryOperationType.h"
+#include "Shared/Emulator.h"
+#include "Shared/RewindManager.h"
+
+ReverseJournal::ReverseJournal(Debugger* debugger, IDebugger* cpuDebugger, CpuType cpuType, uint32_t stateSize, uint32_t capacity)
+	: _buffer(stateSize, capacity)
+{
+	_debugger = debugger;
+	_cpuDebugger = cpuDebugger;
+	_memoryDumper = debugger->GetMemoryDumper();
+	_rewindManager = debugger->GetEmulator()->GetRewindManager();
+	_keyframeCount = _rewindManager->GetKeyframeCount();
+	_cpuType = cpuType;
+	_cpuMemType = DebugUtilities::GetCpuMemoryType(cpuType);
+	_stateSize = stateSize;
+}
+
+void ReverseJournal::Clear()
+{
+	_buffer.Clear();
+	_undoneCount = 0;
+}
+
+void ReverseJournal::RecordInstruction()
+{
+	uint8_t* state = (uint8_t*)&_cpuDebugger->GetState();
+	if(_buffer.IsOpen()) {
+		_buffer.CloseEntry(state, _cpuDebugger->GetProgramCounter(true));
+	}
+	_buffer.OpenEntry(state, _cpuDebugger->GetStepBackConfig().CurrentCycle);
+
+	uint32_t keyframeCount = _rewindManager->GetKeyframeCount();
+	if(keyframeCount != _keyframeCount) {
+		//A keyframe was saved before this instruction, replaying can't go back further than this
+		_keyframeCount = keyframeCount;
+		_buffer.MarkKeyframe();
+	}
+}
+
+void ReverseJournal::RecordWrite(uint32_t addr, uint32_t value, uint8_t accessWidth)
+{
+	if(!_buffer.IsOpen()) {
+		return;
+	}
+
+	for(uint8_t i = 0; i < accessWidth; i++) {
+		AddressInfo relAddr = { (int32_t)(addr + i), _cpuMemType };
+		AddressInfo absAddr = _debugger->GetAbsoluteAddress(relAddr);
+		if(absAddr.Address < 0 || DebugUtilities::IsRom(absAddr.Type)) {
+			//Writes to registers are not journaled (their state is restored by the step back manager's replay)
+			continue;
+		}
+
+		uint8_t* buffer = _memoryDumper->GetMemoryBuffer(absAddr.Type);
+		if(!buffer || (uint32_t)absAddr.Address >= _memoryDumper->GetMemorySize(absAddr.Type)) {
+			continue;
+		}
+
+		if(!_buffer.AddWrite({ addr + i, absAddr.Address, absAddr.Type, buffer[absAddr.Address], (uint8_t)(value >> (i * 8)) })) {
+			_undoneCount = 0;
+			return;
+		}
+	}
+}
+
+void ReverseJournal::UndoInstruction()
+{
+	//Writes are reverted newest first, the oldest value written to an address must be the one left in memory
+	Disassembler* disassembler = _debugger->GetDisassembler();
+	_buffer.UndoInstruction([=](ReverseJournalBuffer::WriteRecord& write) {
+		_memoryDumper->GetMemoryBuffer(write.AbsType)[write.AbsAddress] = write.OldValue;
+		disassembler->InvalidateCache({ write.AbsAddress, write.AbsType }, _cpuType);
+	});
+	_undoneCount++;
+}
+
+void ReverseJournal::UpdateDebugger()
+{
+	memcpy(&_cpuDebugger->GetState(), _buffer.GetState(), _stateSize);
+	_cpuDebugger->SetProgramCounter(_buffer.GetCurrentEntry().ProgramCounter, true);
+}
+
+uint32_t ReverseJournal::StepBack(uint32_t count)
+{
+	uint32_t stepCount = 0;
+	while(stepCount < count && CanStepBack()) {
+		UndoInstruction();
+		stepCount++;
+	}
+
+	if(stepCount > 0) {
+		UpdateDebugger();
+	}
+	return stepCount;
+}
+
+int32_t ReverseJournal::CheckExecBreakpoint(uint32_t pc)
+{
+	AddressInfo relAddr = { (int32_t)pc, _cpuMemType };
+	AddressInfo absAddr = _debugger->GetAbsoluteAddress(relAddr);
+	MemoryOperationInfo operation(pc, _memoryDumper->GetMemoryValue(_cpuMemType, pc), MemoryOperationType::ExecOpCode, _cpuMemType);
+	return _cpuDebugger->GetBreakpointManager()->CheckBreakpoint(operation, absAddr, false);
+}
+
+int32_t ReverseJournal::CheckWriteBreakpoints(ReverseJournalBuffer::Entry& entry)
+{
+	BreakpointManager* bpManager = _cpuDebugger->GetBreakpointManager();
+	if(!bpManager->HasBreakpointForType(MemoryOperationType::Write)) {
+		return -1;
+	}
+
+	for(uint32_t i = 0; i < entry.WriteCount; i++) {
+		ReverseJournalBuffer::WriteRecord& write = _buffer.GetWrite(entry, i);
+		AddressInfo absAddr = { write.AbsAddress, write.AbsType };
+		MemoryOperationInfo operation(write.Address, write.NewValue, MemoryOperationType::Write, _cpuMemType);
+		int32_t bpId = bpManager->CheckBreakpoint(operation, absAddr, false);
+		if(bpId >= 0) {
+			return bpId;
+		}
+	}
+	return -1;
+}
+
+int32_t ReverseJournal::ReverseContinue(uint32_t& stepCount)
+{
+	int32_t bpId = -1;
+	stepCount = 0;
+
+	while(CanStepBack()) {
+		//Write breakpoints are checked before the writes are reverted, exec breakpoints once the CPU is back at the start of the instruction
+		bpId = CheckWriteBreakpoints(_buffer.GetPreviousEntry());
+		UndoInstruction();
+		stepCount++;
+
+		if(bpId < 0) {
+			memcpy(&_cpuDebugger->GetState(), _buffer.GetState(), _stateSize);
+			bpId = CheckExecBreakpoint(_buffer.GetCurrentEntry().ProgramCounter);
+		}
+
+		if(bpId >= 0) {
+			break;
+		}
+	}
+
+	if(stepCount > 0) {
+		UpdateDebugger();
+	}
+	return bpId;
+}
+
+void ReverseJournal::Resume()
+{
+	//The instruction at the current position will be recorded again when it executes
+	_buffer.Close();
+	_undoneCount = 0;
+}
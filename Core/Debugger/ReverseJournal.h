@@ -0,0 +1,64 @@
+#pragma once
+#include "pch.h"
+#include "Debugger/DebugTypes.h"
+#include "Debugger/ReverseJournalBuffer.h"
+
+class Debugger;
+class IDebugger;
+class MemoryDumper;
+class RewindManager;
+
+//Undo log of the last instructions executed by a CPU, used to step backwards without reloading a save state.
+//Each instruction records the bytes of the CPU state it changed and the previous value of the RAM bytes it wrote.
+//Undoing an instruction only restores the CPU and RAM - when execution resumes from an undone instruction,
+//the step back manager replays from the last rewind keyframe to restore the rest of the hardware state,
+//so instructions can only be undone back to that keyframe.
+class ReverseJournal
+{
+public:
+	static constexpr uint32_t DefaultCapacity = 0x20000; //Number of instructions
+	static constexpr uint32_t MaxCapacity = ReverseJournalBuffer::MaxCapacity;
+
+	static bool IsValidCapacity(uint64_t capacity) { return capacity > 0 && capacity <= MaxCapacity; }
+
+private:
+	Debugger* _debugger = nullptr;
+	IDebugger* _cpuDebugger = nullptr;
+	MemoryDumper* _memoryDumper = nullptr;
+	RewindManager* _rewindManager = nullptr;
+	CpuType _cpuType;
+	MemoryType _cpuMemType;
+	uint32_t _stateSize = 0;
+
+	ReverseJournalBuffer _buffer;
+	uint32_t _undoneCount = 0;
+	uint32_t _keyframeCount = 0;
+
+	void UndoInstruction();
+	void UpdateDebugger();
+
+	int32_t CheckExecBreakpoint(uint32_t pc);
+	int32_t CheckWriteBreakpoints(ReverseJournalBuffer::Entry& entry);
+
+public:
+	ReverseJournal(Debugger* debugger, IDebugger* cpuDebugger, CpuType cpuType, uint32_t stateSize, uint32_t capacity = ReverseJournal::DefaultCapacity);
+
+	void Clear();
+
+	//Called by the debugger before each instruction and before each CPU write
+	void RecordInstruction();
+	void RecordWrite(uint32_t addr, uint32_t value, uint8_t accessWidth);
+
+	//Must be called while execution is paused
+	uint32_t StepBack(uint32_t count);
+	int32_t ReverseContinue(uint32_t& stepCount);
+
+	bool CanStepBack() { return _buffer.CanUndo(); }
+	uint32_t GetInstructionCount() { return _buffer.GetInstructionCount(); }
+	uint32_t GetCapacity() { return _buffer.GetCapacity(); }
+
+	//True when instructions were undone - the rest of the hardware state must be restored before running again
+	bool IsRewound() { return _undoneCount > 0; }
+	uint64_t GetClock() { return _buffer.GetCurrentEntry().Clock; }
+	void Resume();
+};
@@ -0,0 +1,121 @@
+#include "pch.h"
+#include "Debugger/ReverseJournalBuffer.h"
+
+static uint32_t GetPowerOfTwo(uint32_t value)
+{
+	uint32_t result = 1;
+	while(result < value) {
+		result <<= 1;
+	}
+	return result;
+}
+
+ReverseJournalBuffer::ReverseJournalBuffer(uint32_t stateSize, uint32_t capacity)
+{
+	_stateSize = stateSize;
+	_prevState.resize(stateSize);
+
+	//Callers validate the capacity, clamp it anyway (GetPowerOfTwo can't go past 2^31, and the register buffer is 8x larger)
+	capacity = GetPowerOfTwo(std::clamp<uint32_t>(capacity, ReverseJournalBuffer::MinCapacity, ReverseJournalBuffer::MaxCapacity));
+	_entries.resize(capacity);
+	_writes.resize(capacity * 2);
+	_registers.resize(capacity * 8);
+	_entryMask = capacity - 1;
+	_writeMask = capacity * 2 - 1;
+	_registerMask = capacity * 8 - 1;
+}
+
+void ReverseJournalBuffer::Clear()
+{
+	_firstEntry = 0;
+	_keyframeEntry = 0;
+	_entryPos = 0;
+	_writePos = 0;
+	_registerPos = 0;
+	_isOpen = false;
+}
+
+void ReverseJournalBuffer::OpenEntry(uint8_t* state, uint64_t clock)
+{
+	if(_entryPos - _firstEntry > _entryMask) {
+		//Journal is full, drop the oldest instruction
+		DropOldestEntry();
+	}
+
+	Entry& entry = _entries[_entryPos & _entryMask];
+	entry.Clock = clock;
+	entry.ProgramCounter = 0;
+	entry.FirstWrite = _writePos;
+	entry.FirstRegister = _registerPos;
+	entry.WriteCount = 0;
+	entry.RegisterCount = 0;
+
+	memcpy(_prevState.data(), state, _stateSize);
+	_isOpen = true;
+}
+
+void ReverseJournalBuffer::CloseEntry(uint8_t* state, uint32_t programCounter)
+{
+	Entry& entry = _entries[_entryPos & _entryMask];
+	entry.ProgramCounter = programCounter;
+	entry.WriteCount = _writePos - entry.FirstWrite;
+
+	//Only keep the bytes of the CPU state that the instruction changed, compare 8 bytes at a time
+	uint8_t* prevState = _prevState.data();
+	uint32_t i = 0;
+	for(; i + 8 <= _stateSize; i += 8) {
+		uint64_t prev, current;
+		memcpy(&prev, prevState + i, 8);
+		memcpy(&current, state + i, 8);
+		if(prev != current) {
+			for(uint32_t j = i; j < i + 8; j++) {
+				if(prevState[j] != state[j]) {
+					AddRegister(j, prevState[j]);
+				}
+			}
+		}
+	}
+	for(; i < _stateSize; i++) {
+		if(prevState[i] != state[i]) {
+			AddRegister(i, prevState[i]);
+		}
+	}
+
+	entry.RegisterCount = _registerPos - entry.FirstRegister;
+	_entryPos++;
+}
+
+void ReverseJournalBuffer::DropOldestEntry()
+{
+	if(_keyframeEntry == _firstEntry) {
+		_keyframeEntry++;
+	}
+	_firstEntry++;
+}
+
+void ReverseJournalBuffer::AddRegister(uint32_t offset, uint8_t oldValue)
+{
+	//The buffer is always larger than the CPU state, so the current entry never needs to be dropped
+	while(_firstEntry != _entryPos && _registerPos - _entries[_firstEntry & _entryMask].FirstRegister > _registerMask) {
+		DropOldestEntry();
+	}
+
+	_registers[_registerPos & _registerMask] = { (uint16_t)offset, oldValue };
+	_registerPos++;
+}
+
+bool ReverseJournalBuffer::AddWrite(const WriteRecord& write)
+{
+	while(_writePos - _entries[_firstEntry & _entryMask].FirstWrite > _writeMask) {
+		if(_firstEntry == _entryPos) {
+			//The current instruction alone fills the buffer (e.g long DMA transfer), it can't be undone
+			Clear();
+			return false;
+		}
+		DropOldestEntry();
+	}
+
+	_writes[_writePos & _writeMask] = write;
+	_writePos++;
+	return true;
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include "pch.h"
+#include "Shared/MemoryType.h"
+
+//Ring buffers of the reverse journal: one entry per instruction, the RAM bytes it wrote and the CPU state bytes it changed.
+//Positions keep increasing and are masked when accessing the buffers. When a buffer is full, the oldest instructions are dropped.
+class ReverseJournalBuffer
+{
+public:
+	static constexpr uint32_t MinCapacity = 0x400;
+	static constexpr uint32_t MaxCapacity = 0x100000; //~100 MB of buffers
+
+	struct Entry
+	{
+		uint64_t Clock;
+		uint32_t ProgramCounter;
+		uint32_t FirstWrite;
+		uint32_t FirstRegister;
+		uint32_t WriteCount;
+		uint32_t RegisterCount;
+	};
+
+	struct WriteRecord
+	{
+		uint32_t Address;
+		int32_t AbsAddress;
+		MemoryType AbsType;
+		uint8_t OldValue;
+		uint8_t NewValue;
+	};
+
+private:
+	struct RegisterRecord
+	{
+		uint16_t Offset;
+		uint8_t OldValue;
+	};
+
+	uint32_t _stateSize = 0;
+
+	vector<Entry> _entries;
+	vector<WriteRecord> _writes;
+	vector<RegisterRecord> _registers;
+	uint32_t _entryMask = 0;
+	uint32_t _writeMask = 0;
+	uint32_t _registerMask = 0;
+
+	//Entries [_firstEntry, _entryPos) are complete, _entryPos is the instruction currently executing (when _isOpen is set)
+	//Instructions before _keyframeEntry can't be undone (see MarkKeyframe)
+	uint32_t _firstEntry = 0;
+	uint32_t _keyframeEntry = 0;
+	uint32_t _entryPos = 0;
+	uint32_t _writePos = 0;
+	uint32_t _registerPos = 0;
+	bool _isOpen = false;
+
+	//CPU state at the start of the current instruction
+	vector<uint8_t> _prevState;
+
+	void DropOldestEntry();
+	void AddRegister(uint32_t offset, uint8_t oldValue);
+
+public:
+	ReverseJournalBuffer(uint32_t stateSize, uint32_t capacity);
+
+	void Clear();
+
+	//Starts a new instruction (the previous one must be closed first)
+	void OpenEntry(uint8_t* state, uint64_t clock);
+
+	//Completes the current instruction, keeping the bytes of the CPU state it changed
+	void CloseEntry(uint8_t* state, uint32_t programCounter);
+
+	//The current instruction is the first one after a rewind keyframe: resuming after an undo replays from the
+	//most recent keyframe, so the instructions executed before it can no longer be undone
+	void MarkKeyframe() { _keyframeEntry = _entryPos; }
+
+	//Returns false when the current instruction alone filled the write buffer - the journal is cleared
+	bool AddWrite(const WriteRecord& write);
+
+	//Moves back to the start of the previous instruction (CanUndo() must be true).
+	//revertWrite is called for the writes of the current and previous instructions, newest first.
+	template<typename T>
+	void UndoInstruction(T revertWrite)
+	{
+		//Revert the writes done so far by the current instruction (e.g when paused by a write breakpoint)
+		Entry& current = _entries[_entryPos & _entryMask];
+		for(uint32_t i = _writePos; i != current.FirstWrite; i--) {
+			revertWrite(_writes[(i - 1) & _writeMask]);
+		}
+
+		_entryPos--;
+
+		//The previous instruction becomes the current one, restore the state it started with
+		Entry& entry = _entries[_entryPos & _entryMask];
+		for(uint32_t i = entry.FirstWrite + entry.WriteCount; i != entry.FirstWrite; i--) {
+			revertWrite(_writes[(i - 1) & _writeMask]);
+		}
+		for(uint32_t i = entry.RegisterCount; i > 0; i--) {
+			RegisterRecord& reg = _registers[(entry.FirstRegister + i - 1) & _registerMask];
+			_prevState[reg.Offset] = reg.OldValue;
+		}
+
+		_writePos = entry.FirstWrite;
+		_registerPos = entry.FirstRegister;
+		entry.WriteCount = 0;
+		entry.RegisterCount = 0;
+	}
+
+	//Stops recording, the instruction at the current position will be recorded again when it executes
+	void Close() { _isOpen = false; }
+
+	bool IsOpen() { return _isOpen; }
+	bool CanUndo() { return _isOpen && _keyframeEntry != _entryPos; }
+	uint32_t GetInstructionCount() { return _isOpen ? _entryPos - _keyframeEntry : 0; }
+	uint32_t GetCapacity() { return (uint32_t)_entries.size(); }
+	uint32_t GetWriteCapacity() { return (uint32_t)_writes.size(); }
+
+	Entry& GetCurrentEntry() { return _entries[_entryPos & _entryMask]; }
+	Entry& GetPreviousEntry() { return _entries[(_entryPos - 1) & _entryMask]; }
+	WriteRecord& GetWrite(Entry& entry, uint32_t index) { return _writes[(entry.FirstWrite + index) & _writeMask]; }
+	uint8_t* GetState() { return _prevState.data(); }
+};
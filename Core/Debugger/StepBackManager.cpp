@@ -29,10 +29,23 @@ void StepBackManager::StepBack(StepBackType type)
 		
 		_active = true;
 		_allowRetry = true;
+		_breakOnTarget = true;
 		_stateClockLimit = StepBackManager::DefaultClockLimit;
 	}
 }
 
+void StepBackManager::ReplayTo(uint64_t clock)
+{
+	//Reload the last rewind keyframe and run until the target clock without breaking
+	//No save states are needed, the target is the start of an instruction
+	_targetClock = clock;
+	_active = true;
+	_allowRetry = false;
+	_breakOnTarget = false;
+	_stateClockLimit = 0;
+	_cache.clear();
+}
+
 bool StepBackManager::CheckStepBack()
 {
 	if(!_active) {
@@ -90,7 +103,8 @@ bool StepBackManager::CheckStepBack()
 			return false;
 		} else {
 			//Stop rewinding, even if the target was not found
-			_rewindManager->StopRewinding(true);
+			//When replaying, the target is the new present - delete the history after it
+			_rewindManager->StopRewinding(true, !_breakOnTarget);
 		}
 		_active = false;
 		_prevClock = clock;
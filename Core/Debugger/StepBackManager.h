@@ -39,14 +39,17 @@ private:
 	uint64_t _prevClock = 0;
 	bool _active = false;
 	bool _allowRetry = false;
+	bool _breakOnTarget = true;
 	uint64_t _stateClockLimit = StepBackManager::DefaultClockLimit;
 
 public:
 	StepBackManager(Emulator* emu, IDebugger* debugger);
 
 	void StepBack(StepBackType type);
+	void ReplayTo(uint64_t clock);
 	bool CheckStepBack();
 
 	void ResetCache() { _cache.clear(); }
 	bool IsRewinding() { return _active || _rewindManager->IsRewinding(); }
+	bool IsReplay() { return !_breakOnTarget; }
 };
\ No newline at end of file
@@ -217,7 +217,7 @@ void GbaDebugger::ProcessWrite(uint32_t addr, uint32_t value, MemoryOperationTyp
 		_eventManager->AddEvent(DebugEventType::Register, operation);
 	}
 
-	_memoryAccessCounter->ProcessMemoryWrite<accessWidth>(addressInfo, _console->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite<accessWidth>(addressInfo, _console->GetMasterClock(), CpuType::Gba);
 }
 
 void GbaDebugger::Run()
@@ -51,7 +51,7 @@ void GbaEventManager::AddEvent(DebugEventType type, MemoryOperationInfo& operati
 	}
 
 	evt.ProgramCounter = _debugger->GetProgramCounter(CpuType::Gba, true);
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void GbaEventManager::AddEvent(DebugEventType type)
@@ -63,7 +63,7 @@ void GbaEventManager::AddEvent(DebugEventType type)
 	evt.BreakpointId = -1;
 	evt.DmaChannel = -1;
 	evt.ProgramCounter = _debugger->GetProgramCounter(CpuType::Gba, true);
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 DebugEventInfo GbaEventManager::GetEvent(uint16_t y, uint16_t x)
@@ -166,8 +166,7 @@ uint32_t GbaEventManager::TakeEventSnapshot(bool forAutoRefresh)
 		memcpy(_ppuBuffer + offset, _ppu->GetPreviousScreenBuffer() + offset, (GbaConstants::PixelCount - offset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
+	TakeFrameSnapshot();
 	_snapshotScanline = scanline;
 	_snapshotCycle = cycle;
 	_forAutoRefresh = forAutoRefresh;
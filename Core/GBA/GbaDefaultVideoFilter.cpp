@@ -7,6 +7,7 @@
 #include "Shared/RewindManager.h"
 #include "Shared/SettingTypes.h"
 #include "Shared/ColorUtilities.h"
+#include "Shared/Video/VideoFilterKernels.h"
 
 GbaDefaultVideoFilter::GbaDefaultVideoFilter(Emulator* emu, bool applyNtscFilter) : BaseVideoFilter(emu), _ntscFilter(emu)
 {
@@ -67,6 +68,8 @@ void GbaDefaultVideoFilter::InitLookupTable()
 		}
 	}
 
+	//Without color adjustments, the colors can be converted directly instead of using the lookup table
+	_isRgb555Palette = VideoFilterKernels::IsRgb555Palette(_calculatedPalette);
 	_videoConfig = config;
 }
 
@@ -93,11 +96,9 @@ void GbaDefaultVideoFilter::ApplyFilter(uint16_t* ppuOutputBuffer)
 {
 	uint32_t* out = GetOutputBuffer();
 
-	for(uint32_t i = 0; i < GbaConstants::ScreenHeight; i++) {
-		for(uint32_t j = 0; j < GbaConstants::ScreenWidth; j++) {
-			out[i * GbaConstants::ScreenWidth + j] = GetPixel(ppuOutputBuffer, i * GbaConstants::ScreenWidth + j);
-		}
-	}
+	//Rows are contiguous, convert the whole frame at once
+	const uint32_t* palette = _isRgb555Palette ? nullptr : _calculatedPalette;
+	VideoFilterKernels::ConvertRow(out, ppuOutputBuffer, _blendFrames ? _prevFrame : nullptr, palette, 0x7FFF, GbaConstants::PixelCount);
 
 	if(_blendFrames) {
 		std::copy(ppuOutputBuffer, ppuOutputBuffer + GbaConstants::PixelCount, _prevFrame);
@@ -107,17 +108,3 @@ void GbaDefaultVideoFilter::ApplyFilter(uint16_t* ppuOutputBuffer)
 		_ntscFilter.ApplyFilter(out, GbaConstants::ScreenWidth, GbaConstants::ScreenHeight, 0);
 	}
 }
-
-uint32_t GbaDefaultVideoFilter::GetPixel(uint16_t* ppuFrame, uint32_t offset)
-{
-	if(_blendFrames) {
-		return BlendPixels(_calculatedPalette[_prevFrame[offset] & 0x7FFF], _calculatedPalette[ppuFrame[offset] & 0x7FFF]);
-	} else {
-		return _calculatedPalette[ppuFrame[offset] & 0x7FFF];
-	}
-}
-
-uint32_t GbaDefaultVideoFilter::BlendPixels(uint32_t a, uint32_t b)
-{
-	return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
-}
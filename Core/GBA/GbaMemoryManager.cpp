@@ -803,6 +803,66 @@ uint8_t GbaMemoryManager::DebugRead(uint32_t addr)
 	return _state.InternalOpenBus[addr & 0x01];
 }
 
+void GbaMemoryManager::DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length)
+{
+	uint32_t end = std::min<uint32_t>(addr + length, 0x10000000);
+	while(addr < end) {
+		//Find the largest run of bytes that maps to a single contiguous buffer (same logic as DebugRead)
+		uint32_t offset = addr & 0xFFFFFF;
+		uint32_t bankEnd = (addr & 0xFF000000) + 0x1000000;
+		uint8_t* src = nullptr;
+		uint32_t runEnd = bankEnd;
+
+		auto mirror = [&](uint8_t* buffer, uint32_t size) {
+			src = buffer + (offset & (size - 1));
+			runEnd = (addr & ~(size - 1)) + size;
+		};
+
+		switch(addr >> 24) {
+			case 0x00:
+				if(offset < GbaConsole::BootRomSize) {
+					src = _bootRom + offset;
+					runEnd = addr - offset + GbaConsole::BootRomSize;
+				}
+				break;
+
+			case 0x02: mirror(_extWorkRam, GbaConsole::ExtWorkRamSize); break;
+			case 0x03: mirror(_intWorkRam, GbaConsole::IntWorkRamSize); break;
+			case 0x05: mirror(_palette, GbaConsole::PaletteRamSize); break;
+			case 0x07: mirror(_oam, GbaConsole::SpriteRamSize); break;
+
+			case 0x06:
+				//0x00000-0x0FFFF maps to the first 64kb, 0x10000-0x17FFF and 0x18000-0x1FFFF both map to the last 32kb
+				src = _vram + ((offset & 0x10000) ? (offset & 0x17FFF) : (offset & 0xFFFF));
+				runEnd = (addr & ~0x7FFF) + 0x8000;
+				break;
+
+			case 0x08: case 0x09: case 0x0A:
+			case 0x0B: case 0x0C: case 0x0D: {
+				uint32_t romAddr = (((addr >> 24) & 0x01) << 24) | offset;
+				if(romAddr < _prgRomSize) {
+					src = _prgRom + romAddr;
+					runEnd = std::min(bankEnd, addr - romAddr + _prgRomSize);
+				}
+				break;
+			}
+		}
+
+		if(src) {
+			runEnd = std::min(runEnd, end);
+			memcpy(dest, src, runEnd - addr);
+			dest += runEnd - addr;
+			addr = runEnd;
+		} else {
+			//Registers, save RAM/flash and open bus
+			runEnd = std::min(bankEnd, end);
+			for(; addr < runEnd; addr++) {
+				*(dest++) = DebugRead(addr);
+			}
+		}
+	}
+}
+
 void GbaMemoryManager::DebugWrite(uint32_t addr, uint8_t value)
 {
 	uint8_t bank = (addr >> 24);
@@ -188,6 +188,7 @@ public:
 
 	uint32_t DebugCpuRead(GbaAccessModeVal mode, uint32_t addr);
 	uint8_t DebugRead(uint32_t addr);
+	void DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length);
 	void DebugWrite(uint32_t addr, uint8_t value);
 
 	AddressInfo GetAbsoluteAddress(uint32_t addr);
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "GBA/GbaPpu.h"
+#include "GBA/GbaPpuKernels.h"
 #include "GBA/APU/GbaApu.h"
 #include "GBA/GbaTypes.h"
 #include "GBA/GbaConsole.h"
@@ -277,26 +278,35 @@ void GbaPpu::ProcessColorMath()
 	uint8_t mainCoeff = std::min<uint8_t>(16, _state.BlendMainCoefficient);
 	uint8_t subCoeff = std::min<uint8_t>(16, _state.BlendSubCoefficient);
 	
-	GbaPixelData main = {};
-	GbaPixelData sub = {};
 	uint8_t brightness = std::min<uint8_t>(16, _state.Brightness);
 	uint16_t blendColor = effect == GbaPpuBlendEffect::IncreaseBrightness ? GbaPpu::WhiteColor : GbaPpu::BlackColor;
 
-	uint8_t wnd = 0;
+	constexpr uint8_t enabledLayers = (bg0Enabled ? 0x01 : 0) | (bg1Enabled ? 0x02 : 0) | (bg2Enabled ? 0x04 : 0) | (bg3Enabled ? 0x08 : 0);
+
+	uint8_t windowLayerMask[5] = {};
+	if constexpr(windowEnabled) {
+		for(int wnd = 0; wnd < 5; wnd++) {
+			for(int i = 0; i < 4; i++) {
+				windowLayerMask[wnd] |= _state.WindowActiveLayers[wnd][i] ? (1 << i) : 0;
+			}
+		}
+	}
 
 	int start = _lastRenderCycle < 46 ? 0 : std::max(0, ((_lastRenderCycle - 46) / 4) + 1);
 	int end = std::min((_state.Cycle - 46) / 4, 239);
 
+	//Sprite layer (window & mosaic must be processed in order, left to right)
 	for(int x = start; x <= end; x++) {
+		GbaPixelData main;
 		if constexpr(windowEnabled) {
-			wnd = _activeWindow[x];
+			uint8_t wnd = _activeWindow[x];
+			_windowLayerMask[x] = windowLayerMask[wnd];
 			if(_state.WindowActiveLayers[wnd][GbaPpu::SpriteLayerIndex]) {
 				main = _oamReadOutput[x];
 			} else {
 				main = {};
 			}
 		} else {
-			wnd = GbaPpu::NoWindow;
 			main = _oamReadOutput[x];
 		}
 		
@@ -305,48 +315,42 @@ void GbaPpu::ProcessColorMath()
 		} else {
 			main = _renderSprPixel;
 		}
+		_mainPixels[x] = main;
+	}
 
-		sub = {};
+	//Select the top 2 pixels out of the sprite and BG layers
+	GbaPpuKernels::MergeLayers(_mainPixels, _subPixels, _layerOutput, enabledLayers, windowEnabled ? _windowLayerMask : nullptr, start, end);
 
-		if constexpr(bg0Enabled) {
-			ProcessLayerPixel<0, windowEnabled>(x, wnd, main, sub);
-		}
-		if constexpr(bg1Enabled) {
-			ProcessLayerPixel<1, windowEnabled>(x, wnd, main, sub);
-		}
-		if constexpr(bg2Enabled) {
-			ProcessLayerPixel<2, windowEnabled>(x, wnd, main, sub);
-		}
-		if constexpr(bg3Enabled) {
-			ProcessLayerPixel<3, windowEnabled>(x, wnd, main, sub);
-		}
+	//Pick the colors & blend coefficients for each pixel, then blend them all at once
+	for(int x = start; x <= end; x++) {
+		GbaPixelData& main = _mainPixels[x];
+		GbaPixelData& sub = _subPixels[x];
+		uint8_t wnd = windowEnabled ? _activeWindow[x] : GbaPpu::NoWindow;
+
+		//Pixels that aren't blended are output as-is (blending with a=16, b=0 returns the main color)
+		_blendColorA[x] = ReadColor<false>(x, main.Color);
+		_blendCoeffA[x] = 16;
+		_blendColorB[x] = 0;
+		_blendCoeffB[x] = 0;
 
 		if((main.Color & (GbaPpu::SpriteBlendFlag | GbaPpu::DirectColorFlag)) == GbaPpu::SpriteBlendFlag && _state.BlendSub[sub.Layer]) {
 			//Sprite transparency is applied before anything else
-			BlendColors(dst, x, ReadColor<false>(x, main.Color), mainCoeff, ReadColor<true>(x, sub.Color), subCoeff);
+			SetBlendCoefficients(x, mainCoeff, ReadColor<true>(x, sub.Color), subCoeff);
 		} else {
-			if constexpr(effect == GbaPpuBlendEffect::None) {
-				dst[x] = ReadColor<false>(x, main.Color);
-			} else if constexpr(effect == GbaPpuBlendEffect::AlphaBlend) {
-				if(_state.BlendSub[sub.Layer]) {
-					if(!_state.BlendMain[main.Layer] || !_state.WindowActiveLayers[wnd][GbaPpu::EffectLayerIndex]) {
-						dst[x] = ReadColor<false>(x, main.Color);
-					} else {
-						BlendColors(dst, x, ReadColor<false>(x, main.Color), mainCoeff, ReadColor<true>(x, sub.Color), subCoeff);
-					}
-				} else {
-					dst[x] = ReadColor<false>(x, main.Color);
+			if constexpr(effect == GbaPpuBlendEffect::AlphaBlend) {
+				if(_state.BlendSub[sub.Layer] && _state.BlendMain[main.Layer] && _state.WindowActiveLayers[wnd][GbaPpu::EffectLayerIndex]) {
+					SetBlendCoefficients(x, mainCoeff, ReadColor<true>(x, sub.Color), subCoeff);
 				}
-			} else {
-				if(brightness == 0 || !_state.BlendMain[main.Layer] || !_state.WindowActiveLayers[wnd][GbaPpu::EffectLayerIndex]) {
-					dst[x] = ReadColor<false>(x, main.Color);
-				} else {
-					BlendColors(dst, x, ReadColor<false>(x, main.Color), 16 - brightness, blendColor, brightness);
+			} else if constexpr(effect != GbaPpuBlendEffect::None) {
+				if(brightness != 0 && _state.BlendMain[main.Layer] && _state.WindowActiveLayers[wnd][GbaPpu::EffectLayerIndex]) {
+					SetBlendCoefficients(x, 16 - brightness, blendColor, brightness);
 				}
 			}
 		}
 	}
 
+	GbaPpuKernels::BlendColors(dst, _blendColorA, _blendCoeffA, _blendColorB, _blendCoeffB, start, end);
+
 	if(_state.StereoscopicEnabled) {
 		for(int x = start & ~1; x + 1 <= end; x+=2) {
 			uint16_t gLeft = dst[x] & 0x3E0;
@@ -368,21 +372,11 @@ uint16_t GbaPpu::ReadColor(int x, uint16_t addr)
 	}
 }
 
-void GbaPpu::BlendColors(uint16_t* dst, int x, uint16_t main, uint8_t aCoeff, uint16_t sub, uint8_t bCoeff)
+void GbaPpu::SetBlendCoefficients(int x, uint8_t aCoeff, uint16_t sub, uint8_t bCoeff)
 {
-	uint8_t aR = main & 0x1F;
-	uint8_t aG = (main >> 5) & 0x1F;
-	uint8_t aB = (main >> 10) & 0x1F;
-
-	uint8_t bR = sub & 0x1F;
-	uint8_t bG = (sub >> 5) & 0x1F;
-	uint8_t bB = (sub >> 10) & 0x1F;
-
-	uint32_t r = std::min(31, (aR * aCoeff + bR * bCoeff) >> 4);
-	uint32_t g = std::min(31, (aG * aCoeff + bG * bCoeff) >> 4);
-	uint32_t b = std::min(31, (aB * aCoeff + bB * bCoeff) >> 4);
-
-	dst[x] = r | (g << 5) | (b << 10);
+	_blendCoeffA[x] = aCoeff;
+	_blendColorB[x] = sub;
+	_blendCoeffB[x] = bCoeff;
 }
 
 void GbaPpu::InitializeWindows()
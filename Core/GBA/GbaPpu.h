@@ -74,13 +74,6 @@ struct GbaSpriteRendererData
 	uint8_t Height;
 };
 
-struct GbaPixelData
-{
-	uint16_t Color = 0;
-	uint8_t Priority = 0xFF;
-	uint8_t Layer = 5;
-};
-
 class GbaPpu final : public ISerializable
 {
 private:
@@ -166,25 +159,18 @@ private:
 
 	uint16_t _skippedOutput[240];
 
-	template<int i, bool windowEnabled> __forceinline void ProcessLayerPixel(int x, uint8_t wnd, GbaPixelData& main, GbaPixelData& sub)
-	{
-		if constexpr(windowEnabled) {
-			if(!_state.WindowActiveLayers[wnd][i]) {
-				return;
-			}
-		}
-		
-		if(_layerOutput[i][x].Priority < main.Priority) {
-			sub = main;
-			main = _layerOutput[i][x];
-		} else if(_layerOutput[i][x].Priority < sub.Priority) {
-			sub = _layerOutput[i][x];
-		}
-	}
+	//Per-scanline buffers used by the color math stage (see GbaPpuKernels)
+	GbaPixelData _mainPixels[GbaConstants::ScreenWidth] = {};
+	GbaPixelData _subPixels[GbaConstants::ScreenWidth] = {};
+	uint8_t _windowLayerMask[GbaConstants::ScreenWidth] = {};
+	uint16_t _blendColorA[GbaConstants::ScreenWidth] = {};
+	uint16_t _blendColorB[GbaConstants::ScreenWidth] = {};
+	uint8_t _blendCoeffA[GbaConstants::ScreenWidth] = {};
+	uint8_t _blendCoeffB[GbaConstants::ScreenWidth] = {};
 
 	template<GbaPpuBlendEffect effect, bool bg0Enabled, bool bg1Enabled, bool bg2Enabled, bool bg3Enabled, bool windowEnabled> void ProcessColorMath();
 
-	void BlendColors(uint16_t* dst, int x, uint16_t a, uint8_t aCoeff, uint16_t b, uint8_t bCoeff);
+	__forceinline void SetBlendCoefficients(int x, uint8_t aCoeff, uint16_t b, uint8_t bCoeff);
 	template<bool isSubColor> uint16_t ReadColor(int x, uint16_t addr);
 
 	void InitializeWindows();
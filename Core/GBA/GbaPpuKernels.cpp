@@ -0,0 +1,291 @@
+#include "pch.h"
+#include "GBA/GbaPpuKernels.h"
+#include "Utilities/SimdUtilities.h"
+
+//The SIMD versions process GbaPixelData entries as 32-bit values
+static_assert(sizeof(GbaPixelData) == 4, "unexpected GbaPixelData size");
+static_assert(offsetof(GbaPixelData, Color) == 0 && offsetof(GbaPixelData, Priority) == 2 && offsetof(GbaPixelData, Layer) == 3, "unexpected GbaPixelData layout");
+
+static constexpr uint32_t EmptyPixel = 0x05FF0000; //GbaPixelData {} (Priority = 0xFF, Layer = 5)
+static constexpr uint32_t HiddenPriority = 0x00FF0000;
+
+static void MergeLayersScalar(GbaPixelData* main, GbaPixelData* sub, const GbaPixelData layers[4][GbaConstants::ScreenWidth], uint8_t enabledLayers, const uint8_t* layerMask, int start, int end)
+{
+	for(int x = start; x <= end; x++) {
+		GbaPixelData m = main[x];
+		GbaPixelData s = {};
+		uint8_t activeLayers = enabledLayers & (layerMask ? layerMask[x] : 0x0F);
+		for(int i = 0; i < 4; i++) {
+			if(!(activeLayers & (1 << i))) {
+				continue;
+			}
+
+			const GbaPixelData& px = layers[i][x];
+			if(px.Priority < m.Priority) {
+				s = m;
+				m = px;
+			} else if(px.Priority < s.Priority) {
+				s = px;
+			}
+		}
+		main[x] = m;
+		sub[x] = s;
+	}
+}
+
+static void BlendColorsScalar(uint16_t* dst, const uint16_t* a, const uint8_t* aCoeff, const uint16_t* b, const uint8_t* bCoeff, int start, int end)
+{
+	for(int x = start; x <= end; x++) {
+		uint8_t aR = a[x] & 0x1F;
+		uint8_t aG = (a[x] >> 5) & 0x1F;
+		uint8_t aB = (a[x] >> 10) & 0x1F;
+
+		uint8_t bR = b[x] & 0x1F;
+		uint8_t bG = (b[x] >> 5) & 0x1F;
+		uint8_t bB = (b[x] >> 10) & 0x1F;
+
+		uint32_t r = std::min(31, (aR * aCoeff[x] + bR * bCoeff[x]) >> 4);
+		uint32_t g = std::min(31, (aG * aCoeff[x] + bG * bCoeff[x]) >> 4);
+		uint32_t bl = std::min(31, (aB * aCoeff[x] + bB * bCoeff[x]) >> 4);
+
+		dst[x] = r | (g << 5) | (bl << 10);
+	}
+}
+
+#if defined(MESEN_SIMD_X86)
+static __forceinline uint32_t ReadMask4(const uint8_t* layerMask, int x)
+{
+	uint32_t value;
+	memcpy(&value, layerMask + x, sizeof(value));
+	return value;
+}
+
+SIMD_TARGET_SSE41 static int MergeLayersSse41(GbaPixelData* main, GbaPixelData* sub, const GbaPixelData layers[4][GbaConstants::ScreenWidth], uint8_t enabledLayers, const uint8_t* layerMask, int start, int end)
+{
+	const __m128i prioMask = _mm_set1_epi32(0xFF);
+	const __m128i hiddenPrio = _mm_set1_epi32(HiddenPriority);
+	const __m128i zero = _mm_setzero_si128();
+
+	int x = start;
+	for(; x + 3 <= end; x += 4) {
+		__m128i m = _mm_loadu_si128((const __m128i*)(main + x));
+		__m128i s = _mm_set1_epi32(EmptyPixel);
+		__m128i mask = layerMask ? _mm_cvtepu8_epi32(_mm_cvtsi32_si128(ReadMask4(layerMask, x))) : _mm_set1_epi32(0x0F);
+
+		for(int i = 0; i < 4; i++) {
+			if(!(enabledLayers & (1 << i))) {
+				continue;
+			}
+
+			//Layers hidden by the window get the lowest possible priority, which never wins
+			__m128i l = _mm_loadu_si128((const __m128i*)(layers[i] + x));
+			__m128i hidden = _mm_cmpeq_epi32(_mm_and_si128(mask, _mm_set1_epi32(1 << i)), zero);
+			l = _mm_or_si128(l, _mm_and_si128(hidden, hiddenPrio));
+
+			__m128i pl = _mm_and_si128(_mm_srli_epi32(l, 16), prioMask);
+			__m128i pm = _mm_and_si128(_mm_srli_epi32(m, 16), prioMask);
+			__m128i ps = _mm_and_si128(_mm_srli_epi32(s, 16), prioMask);
+			__m128i aboveMain = _mm_cmpgt_epi32(pm, pl);
+			__m128i aboveSub = _mm_cmpgt_epi32(ps, pl);
+
+			s = _mm_blendv_epi8(_mm_blendv_epi8(s, l, aboveSub), m, aboveMain);
+			m = _mm_blendv_epi8(m, l, aboveMain);
+		}
+
+		_mm_storeu_si128((__m128i*)(main + x), m);
+		_mm_storeu_si128((__m128i*)(sub + x), s);
+	}
+	return x;
+}
+
+SIMD_TARGET_AVX2 static int MergeLayersAvx2(GbaPixelData* main, GbaPixelData* sub, const GbaPixelData layers[4][GbaConstants::ScreenWidth], uint8_t enabledLayers, const uint8_t* layerMask, int start, int end)
+{
+	const __m256i prioMask = _mm256_set1_epi32(0xFF);
+	const __m256i hiddenPrio = _mm256_set1_epi32(HiddenPriority);
+	const __m256i zero = _mm256_setzero_si256();
+
+	int x = start;
+	for(; x + 7 <= end; x += 8) {
+		__m256i m = _mm256_loadu_si256((const __m256i*)(main + x));
+		__m256i s = _mm256_set1_epi32(EmptyPixel);
+		__m256i mask = layerMask ? _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(layerMask + x))) : _mm256_set1_epi32(0x0F);
+
+		for(int i = 0; i < 4; i++) {
+			if(!(enabledLayers & (1 << i))) {
+				continue;
+			}
+
+			__m256i l = _mm256_loadu_si256((const __m256i*)(layers[i] + x));
+			__m256i hidden = _mm256_cmpeq_epi32(_mm256_and_si256(mask, _mm256_set1_epi32(1 << i)), zero);
+			l = _mm256_or_si256(l, _mm256_and_si256(hidden, hiddenPrio));
+
+			__m256i pl = _mm256_and_si256(_mm256_srli_epi32(l, 16), prioMask);
+			__m256i pm = _mm256_and_si256(_mm256_srli_epi32(m, 16), prioMask);
+			__m256i ps = _mm256_and_si256(_mm256_srli_epi32(s, 16), prioMask);
+			__m256i aboveMain = _mm256_cmpgt_epi32(pm, pl);
+			__m256i aboveSub = _mm256_cmpgt_epi32(ps, pl);
+
+			s = _mm256_blendv_epi8(_mm256_blendv_epi8(s, l, aboveSub), m, aboveMain);
+			m = _mm256_blendv_epi8(m, l, aboveMain);
+		}
+
+		_mm256_storeu_si256((__m256i*)(main + x), m);
+		_mm256_storeu_si256((__m256i*)(sub + x), s);
+	}
+	return x;
+}
+
+SIMD_TARGET_SSE41 static __forceinline __m128i BlendChannelSse41(__m128i a, __m128i aCoeff, __m128i b, __m128i bCoeff, int shift)
+{
+	const __m128i channelMask = _mm_set1_epi16(0x1F);
+	__m128i ca = _mm_and_si128(_mm_srli_epi16(a, shift), channelMask);
+	__m128i cb = _mm_and_si128(_mm_srli_epi16(b, shift), channelMask);
+	__m128i sum = _mm_add_epi16(_mm_mullo_epi16(ca, aCoeff), _mm_mullo_epi16(cb, bCoeff));
+	return _mm_slli_epi16(_mm_min_epi16(_mm_srli_epi16(sum, 4), channelMask), shift);
+}
+
+SIMD_TARGET_SSE41 static int BlendColorsSse41(uint16_t* dst, const uint16_t* a, const uint8_t* aCoeff, const uint16_t* b, const uint8_t* bCoeff, int start, int end)
+{
+	int x = start;
+	for(; x + 7 <= end; x += 8) {
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + x));
+		__m128i vb = _mm_loadu_si128((const __m128i*)(b + x));
+		__m128i ca = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(aCoeff + x)));
+		__m128i cb = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(bCoeff + x)));
+
+		__m128i out = BlendChannelSse41(va, ca, vb, cb, 0);
+		out = _mm_or_si128(out, BlendChannelSse41(va, ca, vb, cb, 5));
+		out = _mm_or_si128(out, BlendChannelSse41(va, ca, vb, cb, 10));
+		_mm_storeu_si128((__m128i*)(dst + x), out);
+	}
+	return x;
+}
+
+SIMD_TARGET_AVX2 static __forceinline __m256i BlendChannelAvx2(__m256i a, __m256i aCoeff, __m256i b, __m256i bCoeff, int shift)
+{
+	const __m256i channelMask = _mm256_set1_epi16(0x1F);
+	__m256i ca = _mm256_and_si256(_mm256_srli_epi16(a, shift), channelMask);
+	__m256i cb = _mm256_and_si256(_mm256_srli_epi16(b, shift), channelMask);
+	__m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(ca, aCoeff), _mm256_mullo_epi16(cb, bCoeff));
+	return _mm256_slli_epi16(_mm256_min_epi16(_mm256_srli_epi16(sum, 4), channelMask), shift);
+}
+
+SIMD_TARGET_AVX2 static int BlendColorsAvx2(uint16_t* dst, const uint16_t* a, const uint8_t* aCoeff, const uint16_t* b, const uint8_t* bCoeff, int start, int end)
+{
+	int x = start;
+	for(; x + 15 <= end; x += 16) {
+		__m256i va = _mm256_loadu_si256((const __m256i*)(a + x));
+		__m256i vb = _mm256_loadu_si256((const __m256i*)(b + x));
+		__m256i ca = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(aCoeff + x)));
+		__m256i cb = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(bCoeff + x)));
+
+		__m256i out = BlendChannelAvx2(va, ca, vb, cb, 0);
+		out = _mm256_or_si256(out, BlendChannelAvx2(va, ca, vb, cb, 5));
+		out = _mm256_or_si256(out, BlendChannelAvx2(va, ca, vb, cb, 10));
+		_mm256_storeu_si256((__m256i*)(dst + x), out);
+	}
+	return x;
+}
+#elif defined(MESEN_SIMD_NEON)
+static int MergeLayersNeon(GbaPixelData* main, GbaPixelData* sub, const GbaPixelData layers[4][GbaConstants::ScreenWidth], uint8_t enabledLayers, const uint8_t* layerMask, int start, int end)
+{
+	const uint32x4_t prioMask = vdupq_n_u32(0xFF);
+	const uint32x4_t hiddenPrio = vdupq_n_u32(HiddenPriority);
+	const uint32x4_t zero = vdupq_n_u32(0);
+
+	int x = start;
+	for(; x + 3 <= end; x += 4) {
+		uint32x4_t m = vld1q_u32((const uint32_t*)(main + x));
+		uint32x4_t s = vdupq_n_u32(EmptyPixel);
+		uint32x4_t mask = vdupq_n_u32(0x0F);
+		if(layerMask) {
+			uint32_t maskValues[4] = { layerMask[x], layerMask[x + 1], layerMask[x + 2], layerMask[x + 3] };
+			mask = vld1q_u32(maskValues);
+		}
+
+		for(int i = 0; i < 4; i++) {
+			if(!(enabledLayers & (1 << i))) {
+				continue;
+			}
+
+			uint32x4_t l = vld1q_u32((const uint32_t*)(layers[i] + x));
+			uint32x4_t hidden = vceqq_u32(vandq_u32(mask, vdupq_n_u32(1 << i)), zero);
+			l = vorrq_u32(l, vandq_u32(hidden, hiddenPrio));
+
+			uint32x4_t pl = vandq_u32(vshrq_n_u32(l, 16), prioMask);
+			uint32x4_t pm = vandq_u32(vshrq_n_u32(m, 16), prioMask);
+			uint32x4_t ps = vandq_u32(vshrq_n_u32(s, 16), prioMask);
+			uint32x4_t aboveMain = vcgtq_u32(pm, pl);
+			uint32x4_t aboveSub = vcgtq_u32(ps, pl);
+
+			s = vbslq_u32(aboveMain, m, vbslq_u32(aboveSub, l, s));
+			m = vbslq_u32(aboveMain, l, m);
+		}
+
+		vst1q_u32((uint32_t*)(main + x), m);
+		vst1q_u32((uint32_t*)(sub + x), s);
+	}
+	return x;
+}
+
+static __forceinline uint16x8_t BlendChannelNeon(uint16x8_t a, uint16x8_t aCoeff, uint16x8_t b, uint16x8_t bCoeff, int shift)
+{
+	const uint16x8_t channelMask = vdupq_n_u16(0x1F);
+	uint16x8_t ca = vandq_u16(vshlq_u16(a, vdupq_n_s16(-shift)), channelMask);
+	uint16x8_t cb = vandq_u16(vshlq_u16(b, vdupq_n_s16(-shift)), channelMask);
+	uint16x8_t sum = vaddq_u16(vmulq_u16(ca, aCoeff), vmulq_u16(cb, bCoeff));
+	return vshlq_u16(vminq_u16(vshrq_n_u16(sum, 4), channelMask), vdupq_n_s16(shift));
+}
+
+static int BlendColorsNeon(uint16_t* dst, const uint16_t* a, const uint8_t* aCoeff, const uint16_t* b, const uint8_t* bCoeff, int start, int end)
+{
+	int x = start;
+	for(; x + 7 <= end; x += 8) {
+		uint16x8_t va = vld1q_u16(a + x);
+		uint16x8_t vb = vld1q_u16(b + x);
+		uint16x8_t ca = vmovl_u8(vld1_u8(aCoeff + x));
+		uint16x8_t cb = vmovl_u8(vld1_u8(bCoeff + x));
+
+		uint16x8_t out = BlendChannelNeon(va, ca, vb, cb, 0);
+		out = vorrq_u16(out, BlendChannelNeon(va, ca, vb, cb, 5));
+		out = vorrq_u16(out, BlendChannelNeon(va, ca, vb, cb, 10));
+		vst1q_u16(dst + x, out);
+	}
+	return x;
+}
+#endif
+
+void GbaPpuKernels::MergeLayers(GbaPixelData* main, GbaPixelData* sub, const GbaPixelData layers[4][GbaConstants::ScreenWidth], uint8_t enabledLayers, const uint8_t* layerMask, int start, int end)
+{
+	int x = start;
+#if defined(MESEN_SIMD_X86)
+	if(SimdUtilities::HasAvx2()) {
+		x = MergeLayersAvx2(main, sub, layers, enabledLayers, layerMask, x, end);
+	} else if(SimdUtilities::HasSse41()) {
+		x = MergeLayersSse41(main, sub, layers, enabledLayers, layerMask, x, end);
+	}
+#elif defined(MESEN_SIMD_NEON)
+	if(SimdUtilities::HasNeon()) {
+		x = MergeLayersNeon(main, sub, layers, enabledLayers, layerMask, x, end);
+	}
+#endif
+	MergeLayersScalar(main, sub, layers, enabledLayers, layerMask, x, end);
+}
+
+void GbaPpuKernels::BlendColors(uint16_t* dst, const uint16_t* a, const uint8_t* aCoeff, const uint16_t* b, const uint8_t* bCoeff, int start, int end)
+{
+	int x = start;
+#if defined(MESEN_SIMD_X86)
+	if(SimdUtilities::HasAvx2()) {
+		x = BlendColorsAvx2(dst, a, aCoeff, b, bCoeff, x, end);
+	}
+	if(SimdUtilities::HasSse41()) {
+		x = BlendColorsSse41(dst, a, aCoeff, b, bCoeff, x, end);
+	}
+#elif defined(MESEN_SIMD_NEON)
+	if(SimdUtilities::HasNeon()) {
+		x = BlendColorsNeon(dst, a, aCoeff, b, bCoeff, x, end);
+	}
+#endif
+	BlendColorsScalar(dst, a, aCoeff, b, bCoeff, x, end);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "pch.h"
+#include "GBA/GbaTypes.h"
+
+//Per-scanline kernels used by the PPU's color math stage.
+//Each function has a scalar implementation and SSE4.1/AVX2/NEON versions that produce
+//identical results - the best version supported by the CPU is picked at runtime.
+class GbaPpuKernels
+{
+public:
+	//For each pixel in [start, end], selects the top 2 pixels out of main[x] (the sprite pixel)
+	//and the BG layers set in enabledLayers. When layerMask is not null, layer i is only
+	//considered if bit i is set in layerMask[x] (i.e the layer is enabled by the active window).
+	static void MergeLayers(GbaPixelData* main, GbaPixelData* sub, const GbaPixelData layers[4][GbaConstants::ScreenWidth], uint8_t enabledLayers, const uint8_t* layerMask, int start, int end);
+
+	//For each pixel in [start, end], for each 5-bit color channel: dst = min(31, (a * aCoeff + b * bCoeff) >> 4)
+	//Pixels with aCoeff=16 and bCoeff=0 are copied from a as-is.
+	static void BlendColors(uint16_t* dst, const uint16_t* a, const uint8_t* aCoeff, const uint16_t* b, const uint8_t* bCoeff, int start, int end);
+};
@@ -190,6 +190,13 @@ namespace GbaPpuMemAccess
 	};
 }
 
+struct GbaPixelData
+{
+	uint16_t Color = 0;
+	uint8_t Priority = 0xFF;
+	uint8_t Layer = 5;
+};
+
 struct GbaPpuState : BaseState
 {
 	uint32_t FrameCount;
@@ -36,6 +36,8 @@ void GbApu::Init(Emulator* emu, Gameboy* gameboy)
 
 	blip_clear(_leftChannel);
 	blip_clear(_rightChannel);
+	_leftDeltas.Clear();
+	_rightDeltas.Clear();
 
 	blip_set_rates(_leftChannel, GbApu::ApuFrequency, GbApu::SampleRate);
 	blip_set_rates(_rightChannel, GbApu::ApuFrequency, GbApu::SampleRate);
@@ -124,7 +126,7 @@ void GbApu::UpdateOutput(GameboyConfig& cfg)
 	) * (_state.LeftVolume + 1) * 40;
 
 	if(_prevLeftOutput != leftOutput) {
-		blip_add_delta(_leftChannel, _clockCounter, leftOutput - _prevLeftOutput);
+		_leftDeltas.Add(_clockCounter, leftOutput - _prevLeftOutput);
 		_prevLeftOutput = leftOutput;
 	}
 
@@ -136,13 +138,15 @@ void GbApu::UpdateOutput(GameboyConfig& cfg)
 	) * (_state.RightVolume + 1) * 40;
 
 	if(_prevRightOutput != rightOutput) {
-		blip_add_delta(_rightChannel, _clockCounter, rightOutput - _prevRightOutput);
+		_rightDeltas.Add(_clockCounter, rightOutput - _prevRightOutput);
 		_prevRightOutput = rightOutput;
 	}
 }
 
 void GbApu::PlayQueuedAudio()
 {
+	_leftDeltas.Flush(_leftChannel);
+	_rightDeltas.Flush(_rightChannel);
 	blip_end_frame(_leftChannel, _clockCounter);
 	blip_end_frame(_rightChannel, _clockCounter);
 
@@ -155,6 +159,8 @@ void GbApu::PlayQueuedAudio()
 void GbApu::GetSoundSamples(int16_t* &samples, uint32_t& sampleCount)
 {
 	Run();
+	_leftDeltas.Flush(_leftChannel);
+	_rightDeltas.Flush(_rightChannel);
 	blip_end_frame(_leftChannel, _clockCounter);
 	blip_end_frame(_rightChannel, _clockCounter);
 
@@ -411,6 +417,8 @@ void GbApu::Serialize(Serializer& s)
 		_clockCounter = 0;
 		blip_clear(_leftChannel);
 		blip_clear(_rightChannel);
+		_leftDeltas.Clear();
+		_rightDeltas.Clear();
 	}
 
 	SV(_state.ApuEnabled); SV(_state.FrameSequenceStep);
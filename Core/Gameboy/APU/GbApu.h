@@ -4,6 +4,7 @@
 #include "Gameboy/APU/GbWaveChannel.h"
 #include "Gameboy/APU/GbNoiseChannel.h"
 #include "Utilities/Audio/blip_buf.h"
+#include "Utilities/Audio/BlipDeltaBuffer.h"
 #include "Utilities/ISerializable.h"
 
 class Emulator;
@@ -33,6 +34,8 @@ private:
 	int16_t* _soundBuffer = nullptr;
 	blip_t* _leftChannel = nullptr;
 	blip_t* _rightChannel = nullptr;
+	BlipDeltaBuffer _leftDeltas;
+	BlipDeltaBuffer _rightDeltas;
 
 	int16_t _prevLeftOutput = 0;
 	int16_t _prevRightOutput = 0;
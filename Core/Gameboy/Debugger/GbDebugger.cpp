@@ -212,7 +212,7 @@ void GbDebugger::ProcessWrite(uint32_t addr, uint8_t value, MemoryOperationType
 		_eventManager->AddEvent(DebugEventType::Register, operation);
 	}
 
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _gameboy->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _gameboy->GetMasterClock(), CpuType::Gameboy);
 }
 
 void GbDebugger::Run()
@@ -321,7 +321,7 @@ void GbDebugger::ProcessPpuWrite(uint16_t addr, uint8_t value, MemoryType memory
 	MemoryOperationInfo operation(addr, value, MemoryOperationType::Write, memoryType);
 	AddressInfo addressInfo { addr, memoryType };
 	_debugger->ProcessBreakConditions(CpuType::Gameboy, *_step.get(), _breakpointManager.get(), operation, addressInfo);
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _gameboy->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _gameboy->GetMasterClock(), CpuType::Gameboy);
 }
 
 void GbDebugger::ProcessPpuCycle()
@@ -35,7 +35,7 @@ void GbEventManager::AddEvent(DebugEventType type, MemoryOperationInfo& operatio
 	evt.BreakpointId = breakpointId;
 	evt.DmaChannel = -1;
 	evt.ProgramCounter = _debugger->GetProgramCounter(CpuType::Gameboy, true);
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void GbEventManager::AddEvent(DebugEventType type)
@@ -47,7 +47,7 @@ void GbEventManager::AddEvent(DebugEventType type)
 	evt.BreakpointId = -1;
 	evt.DmaChannel = -1;
 	evt.ProgramCounter = _cpu->GetState().PC;
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 DebugEventInfo GbEventManager::GetEvent(uint16_t y, uint16_t x)
@@ -145,8 +145,7 @@ uint32_t GbEventManager::TakeEventSnapshot(bool forAutoRefresh)
 		memcpy(_ppuBuffer + offset, _ppu->GetPreviousEventViewerBuffer() + offset, (size - offset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
+	TakeFrameSnapshot();
 	_snapshotScanline = scanline;
 	_snapshotCycle = cycle;
 	_forAutoRefresh = forAutoRefresh;
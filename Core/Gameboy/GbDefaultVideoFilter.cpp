@@ -8,6 +8,7 @@
 #include "Shared/RewindManager.h"
 #include "Shared/SettingTypes.h"
 #include "Shared/ColorUtilities.h"
+#include "Shared/Video/VideoFilterKernels.h"
 
 GbDefaultVideoFilter::GbDefaultVideoFilter(Emulator* emu, bool applyNtscFilter) : BaseVideoFilter(emu), _ntscFilter(emu)
 {
@@ -72,6 +73,8 @@ void GbDefaultVideoFilter::InitLookupTable()
 		}
 	}
 
+	//Without color adjustments, the colors can be converted directly instead of using the lookup table
+	_isRgb555Palette = VideoFilterKernels::IsRgb555Palette(_calculatedPalette);
 	_videoConfig = config;
 }
 
@@ -101,11 +104,9 @@ void GbDefaultVideoFilter::ApplyFilter(uint16_t* ppuOutputBuffer)
 
 	uint32_t* out = GetOutputBuffer();
 	
-	for(uint32_t i = 0; i < GbConstants::ScreenHeight; i++) {
-		for(uint32_t j = 0; j < GbConstants::ScreenWidth; j++) {
-			out[i * GbConstants::ScreenWidth + j] = GetPixel(ppuOutputBuffer, i * GbConstants::ScreenWidth + j);
-		}
-	}
+	//Rows are contiguous, convert the whole frame at once
+	const uint32_t* palette = _isRgb555Palette ? nullptr : _calculatedPalette;
+	VideoFilterKernels::ConvertRow(out, ppuOutputBuffer, _blendFrames ? _prevFrame : nullptr, palette, 0x7FFF, GbConstants::PixelCount);
 
 	if(_blendFrames) {
 		std::copy(ppuOutputBuffer, ppuOutputBuffer + GbConstants::PixelCount, _prevFrame);
@@ -115,17 +116,3 @@ void GbDefaultVideoFilter::ApplyFilter(uint16_t* ppuOutputBuffer)
 		_ntscFilter.ApplyFilter(out, GbConstants::ScreenWidth, GbConstants::ScreenHeight, 0);
 	}
 }
-
-uint32_t GbDefaultVideoFilter::GetPixel(uint16_t* ppuFrame, uint32_t offset)
-{
-	if(_blendFrames) {
-		return BlendPixels(_calculatedPalette[_prevFrame[offset]], _calculatedPalette[ppuFrame[offset]]);
-	} else {
-		return _calculatedPalette[ppuFrame[offset]];
-	}
-}
-
-uint32_t GbDefaultVideoFilter::BlendPixels(uint32_t a, uint32_t b)
-{
-	return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
-}
@@ -10,6 +10,7 @@ class GbDefaultVideoFilter : public BaseVideoFilter
 {
 private:
 	uint32_t _calculatedPalette[0x8000] = {};
+	bool _isRgb555Palette = false;
 	VideoConfig _videoConfig = {};
 
 	uint16_t* _prevFrame = nullptr;
@@ -21,9 +22,6 @@ private:
 
 	void InitLookupTable();
 
-	__forceinline static uint32_t BlendPixels(uint32_t a, uint32_t b);
-	__forceinline uint32_t GetPixel(uint16_t* ppuFrame, uint32_t offset);
-
 protected:
 	void OnBeforeApplyFilter() override;
 	FrameInfo GetFrameInfo() override;
@@ -88,6 +88,12 @@ bool GbDmaController::IsOamDmaRunning()
 	return _state.OamDmaRunning;
 }
 
+bool GbDmaController::IsOamDmaActive()
+{
+	//Also true when a DMA was requested but hasn't started yet
+	return _state.OamDmaRunning || _state.DmaCounter > 0 || _state.DmaStartDelay > 0;
+}
+
 uint16_t GbDmaController::GetOamReadAddress()
 {
 	return (_state.InternalDest << 8) + (160 - _state.DmaCounter);
@@ -32,6 +32,7 @@ public:
 	bool IsOamDmaConflict(uint16_t addr);
 	uint16_t ProcessOamDmaReadConflict(uint16_t addr);
 	bool IsOamDmaRunning();
+	bool IsOamDmaActive();
 
 	uint8_t Read();
 	void Write(uint8_t value);
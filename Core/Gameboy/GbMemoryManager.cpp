@@ -245,6 +245,28 @@ uint8_t GbMemoryManager::DebugRead(uint16_t addr)
 	return 0;
 }
 
+void GbMemoryManager::DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length)
+{
+	uint32_t end = std::min<uint32_t>(addr + length, 0x10000);
+	while(addr < end) {
+		uint32_t pageEnd = std::min<uint32_t>((addr & 0xFF00) + 0x100, end);
+		uint8_t* ptr = _reads[addr >> 8];
+		if(_state.IsReadRegister[addr >> 8]) {
+			for(; addr < pageEnd; addr++) {
+				*(dest++) = PeekRegister(addr);
+			}
+		} else {
+			if(ptr) {
+				memcpy(dest, ptr + (uint8_t)addr, pageEnd - addr);
+			} else {
+				memset(dest, 0, pageEnd - addr);
+			}
+			dest += pageEnd - addr;
+			addr = pageEnd;
+		}
+	}
+}
+
 void GbMemoryManager::DebugWrite(uint16_t addr, uint8_t value)
 {
 	if(_state.IsWriteRegister[addr >> 8]) {
@@ -376,6 +398,7 @@ void GbMemoryManager::WriteRegister(uint16_t addr, uint8_t value)
 		if(addr == 0xFFFF) {
 			_state.IrqEnabled = value; //IE register
 		} else if(addr == 0xFF46) {
+			_ppu->CancelBatchedLine();
 			_dmaController->Write(value);
 		} else if(addr >= 0xFF80) {
 			_highRam[addr & 0x7F] = value; //80-FE
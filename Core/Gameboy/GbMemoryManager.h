@@ -84,6 +84,7 @@ public:
 	uint64_t GetApuCycleCount();
 	
 	uint8_t DebugRead(uint16_t addr);
+	void DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length);
 	void DebugWrite(uint16_t addr, uint8_t value);
 
 	uint8_t* GetMappedBlock(uint16_t addr);
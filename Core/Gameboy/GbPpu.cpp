@@ -106,6 +106,8 @@ uint16_t* GbPpu::GetPreviousEventViewerBuffer()
 
 void GbPpu::SetCpuStopState(bool stopped)
 {
+	CancelBatchedLine();
+
 	if(!_gameboy->IsCgb()) {
 		if(stopped) {
 			_lcdDisabled = true;
@@ -174,8 +176,16 @@ void GbPpu::ExecCycle()
 	}
 
 	if(_state.Mode == PpuMode::Drawing) {
-		RunDrawCycle();
-		if(_drawnPixels == 160) {
+		if(_batchedLine) {
+			//The line was already rendered at the start of mode 3, only the switch to hblank is left
+			_batchedLine = false;
+		} else if(_state.Cycle == 89 && CanBatchLine()) {
+			RunBatchedLine();
+		} else {
+			RunDrawCycle();
+		}
+
+		if(_drawnPixels == 160 && !_batchedLine) {
 			//Mode turns to hblank on the same cycle as the last pixel is output
 			_state.IrqMode = PpuMode::HBlank;
 			if(_gameboy->IsSgb()) {
@@ -375,6 +385,7 @@ void GbPpu::ProcessPpuCycle()
 	_gbcTileGlitch = false;
 
 	if(_emu->IsDebugging()) {
+		CancelBatchedLine();
 		_emu->ProcessPpuCycle<CpuType::Gameboy>();
 		if(_state.Mode != PpuMode::Drawing) {
 			_currentEventViewerBuffer[456 * _state.Scanline + _state.Cycle] = evtColors[(int)_state.Mode];
@@ -388,6 +399,102 @@ void GbPpu::ProcessPpuCycle()
 	}
 }
 
+bool GbPpu::CanBatchLine()
+{
+	//The sprite fetcher's OAM reads depend on the DMA's progress while OAM DMA runs, and
+	//the debugger needs to see the renderer's state on every cycle (event viewer, breakpoints)
+	return (
+		!_emu->IsDebugging() &&
+		!_gbcTileGlitch &&
+		!_dmaController->IsOamDmaActive() &&
+		!(_state.Scanline == 0 && _isFirstFrame)
+	);
+}
+
+void GbPpu::RunBatchedLine()
+{
+	//Most lines have no mid-line writes to PPU registers, VRAM or OAM - on these, the output of the
+	//pixel FIFO only depends on the state it has at the start of mode 3. Render the whole line now and
+	//idle until the cycle the last pixel would have been output on, to keep the same mode 3 length and
+	//STAT timing. Any write that could affect rendering calls CancelBatchedLine() first, which reverts
+	//to the snapshot and replays the line dot by dot up to the current cycle.
+	SaveRendererState(_batchedLineStart);
+
+	//Mode 3 can't end after cycle 455 (the line ends)
+	constexpr int maxCycles = 456 - 89;
+	int cycles = 0;
+	do {
+		RunDrawCycle();
+		cycles++;
+	} while(_drawnPixels < 160 && cycles < maxCycles);
+
+	if(_drawnPixels < 160) {
+		//Line doesn't finish in time, keep using the dot-by-dot renderer
+		RestoreRendererState(_batchedLineStart);
+		RunDrawCycle();
+		return;
+	}
+
+	//The first draw cycle is this one (89), the last one is 89 + cycles - 1.
+	//Cycles in between are skipped by Exec() as idle cycles.
+	_state.IdleCycles = cycles - 2;
+	_batchedLine = true;
+}
+
+void GbPpu::RevertBatchedLine()
+{
+	_batchedLine = false;
+	_state.IdleCycles = 0;
+	RestoreRendererState(_batchedLineStart);
+
+	//Catch up to the current cycle, which has already been processed
+	for(int i = 89; i <= _state.Cycle; i++) {
+		RunDrawCycle();
+	}
+}
+
+void GbPpu::SaveRendererState(RendererSnapshot& snapshot)
+{
+	snapshot.BgFifo = _bgFifo;
+	snapshot.BgFetcher = _bgFetcher;
+	snapshot.OamFifo = _oamFifo;
+	snapshot.OamFetcher = _oamFetcher;
+	snapshot.DrawnPixels = _drawnPixels;
+	snapshot.FetchColumn = _fetchColumn;
+	snapshot.FetchWindow = _fetchWindow;
+	snapshot.WindowCounter = _windowCounter;
+	snapshot.WxEnableFlag = _wxEnableFlag;
+	snapshot.InsertGlitchBgPixel = _insertGlitchBgPixel;
+	snapshot.FetchSprite = _fetchSprite;
+	memcpy(snapshot.SpriteX, _spriteX, sizeof(_spriteX));
+	memcpy(snapshot.OamReadBuffer, _oamReadBuffer, sizeof(_oamReadBuffer));
+	snapshot.TileIndex = _tileIndex;
+	snapshot.LastPixelType = _lastPixelType;
+	snapshot.LastBgColor = _lastBgColor;
+	snapshot.EventColor = _evtColor;
+}
+
+void GbPpu::RestoreRendererState(RendererSnapshot& snapshot)
+{
+	_bgFifo = snapshot.BgFifo;
+	_bgFetcher = snapshot.BgFetcher;
+	_oamFifo = snapshot.OamFifo;
+	_oamFetcher = snapshot.OamFetcher;
+	_drawnPixels = snapshot.DrawnPixels;
+	_fetchColumn = snapshot.FetchColumn;
+	_fetchWindow = snapshot.FetchWindow;
+	_windowCounter = snapshot.WindowCounter;
+	_wxEnableFlag = snapshot.WxEnableFlag;
+	_insertGlitchBgPixel = snapshot.InsertGlitchBgPixel;
+	_fetchSprite = snapshot.FetchSprite;
+	memcpy(_spriteX, snapshot.SpriteX, sizeof(_spriteX));
+	memcpy(_oamReadBuffer, snapshot.OamReadBuffer, sizeof(_oamReadBuffer));
+	_tileIndex = snapshot.TileIndex;
+	_lastPixelType = snapshot.LastPixelType;
+	_lastBgColor = snapshot.LastBgColor;
+	_evtColor = snapshot.EventColor;
+}
+
 void GbPpu::RunDrawCycle()
 {
 	if(_rendererIdle) {
@@ -902,6 +1009,8 @@ uint8_t GbPpu::Read(uint16_t addr)
 
 void GbPpu::Write(uint16_t addr, uint8_t value)
 {
+	CancelBatchedLine();
+
 	switch(addr) {
 		case 0xFF40:
 			_state.Control = value; 
@@ -1023,6 +1132,7 @@ void GbPpu::Write(uint16_t addr, uint8_t value)
 
 void GbPpu::SetTileFetchGlitchState()
 {
+	CancelBatchedLine();
 	_gbcTileGlitch = true;
 }
 
@@ -1056,6 +1166,7 @@ uint8_t GbPpu::PeekVram(uint16_t addr)
 void GbPpu::WriteVram(uint16_t addr, uint8_t value)
 {
 	if(IsVramWriteAllowed()) {
+		CancelBatchedLine();
 		uint16_t vramAddr = (_state.CgbVramBank << 13) | (addr & 0x1FFF);
 		_emu->ProcessPpuWrite<CpuType::Gameboy>(vramAddr, value, MemoryType::GbVideoRam);
 		_vram[vramAddr] = value;
@@ -1106,9 +1217,11 @@ void GbPpu::WriteOam(uint8_t addr, uint8_t value, bool forDma)
 	//On the DMG, there is a 4 clock gap (80 to 83) between OAM evaluation & rendering where writing is allowed
 	if(addr < 0xA0) {
 		if(forDma) {
+			CancelBatchedLine();
 			_oam[addr] = value;
 			_emu->ProcessPpuWrite<CpuType::Gameboy>(addr, value, MemoryType::GbSpriteRam);
 		} else if(IsOamWriteAllowed()) {
+			CancelBatchedLine();
 			_oam[addr] = value;
 			_emu->ProcessPpuWrite<CpuType::Gameboy>(addr, value, MemoryType::GbSpriteRam);
 		} else {
@@ -1207,6 +1320,8 @@ uint8_t GbPpu::ReadCgbRegister(uint16_t addr)
 
 void GbPpu::WriteCgbRegister(uint16_t addr, uint8_t value)
 {
+	CancelBatchedLine();
+
 	if(!_state.CgbEnabled && _memoryManager->IsBootRomDisabled()) {
 		return;
 	}
@@ -1269,6 +1384,9 @@ void GbPpu::WriteCgbPalette(uint8_t& pos, uint16_t* pal, bool autoInc, uint8_t v
 
 void GbPpu::Serialize(Serializer& s)
 {
+	//Save states always contain the dot-by-dot renderer's state
+	CancelBatchedLine();
+
 	SV(_state.Scanline); SV(_state.Cycle); SV(_state.Mode); SV(_state.LyCompare); SV(_state.BgPalette); SV(_state.ObjPalette0); SV(_state.ObjPalette1);
 	SV(_state.ScrollX); SV(_state.ScrollY); SV(_state.WindowX); SV(_state.WindowY); SV(_state.Control); SV(_state.LcdEnabled); SV(_state.WindowTilemapSelect);
 	SV(_state.WindowEnabled); SV(_state.BgTileSelect); SV(_state.BgTilemapSelect); SV(_state.LargeSprites); SV(_state.SpritesEnabled); SV(_state.BgEnabled);
@@ -70,6 +70,31 @@ private:
 	GbPixelType _lastPixelType = {};
 	uint8_t _lastBgColor = 0;
 
+	//Renderer state at the start of a batched line (see RunBatchedLine)
+	struct RendererSnapshot
+	{
+		GbPpuFifo BgFifo;
+		GbPpuFetcher BgFetcher;
+		GbPpuFifo OamFifo;
+		GbPpuFetcher OamFetcher;
+		int16_t DrawnPixels;
+		uint8_t FetchColumn;
+		bool FetchWindow;
+		int16_t WindowCounter;
+		bool WxEnableFlag;
+		bool InsertGlitchBgPixel;
+		int16_t FetchSprite;
+		uint8_t SpriteX[10];
+		uint8_t OamReadBuffer[2];
+		uint8_t TileIndex;
+		GbPixelType LastPixelType;
+		uint8_t LastBgColor;
+		EvtColor EventColor;
+	};
+
+	RendererSnapshot _batchedLineStart = {};
+	bool _batchedLine = false;
+
 	__forceinline void WriteBgPixel(uint8_t colorIndex);
 	__forceinline void WriteObjPixel(uint8_t colorIndex);
 
@@ -81,6 +106,11 @@ private:
 	__forceinline void ProcessVisibleScanline();
 	__forceinline void RunDrawCycle();
 	__forceinline void RunSpriteEvaluation();
+	bool CanBatchLine();
+	void RunBatchedLine();
+	void RevertBatchedLine();
+	void SaveRendererState(RendererSnapshot& snapshot);
+	void RestoreRendererState(RendererSnapshot& snapshot);
 	void ResetRenderer();
 	void ClockSpriteFetcher();
 	void FindNextSprite();
@@ -126,6 +156,16 @@ public:
 	template<bool singleStep>
 	void Exec();
 
+	//Must be called before anything that can affect rendering happens in the middle of a scanline
+	//(PPU register/VRAM/OAM writes, OAM DMA, etc.) - if the current line was rendered ahead of time,
+	//this reverts to the dot-by-dot renderer, caught up to the current cycle.
+	__forceinline void CancelBatchedLine()
+	{
+		if(_batchedLine) {
+			RevertBatchedLine();
+		}
+	}
+
 	uint8_t Read(uint16_t addr);
 	void Write(uint16_t addr, uint8_t value);
 
@@ -868,6 +868,11 @@ uint8_t BaseMapper::PeekRam(uint16_t addr)
 	return DebugReadRam(addr);
 }
 
+uint8_t* BaseMapper::GetPeekPage(uint16_t addr)
+{
+	return (_prgMemoryAccess[addr >> 8] & MemoryAccessType::Read) ? _prgPages[addr >> 8] : nullptr;
+}
+
 uint8_t BaseMapper::DebugReadRam(uint16_t addr)
 {
 	if(_prgMemoryAccess[addr >> 8] & MemoryAccessType::Read) {
@@ -950,6 +955,12 @@ uint8_t BaseMapper::DebugReadVram(uint16_t addr, bool disableSideEffects)
 	return InternalReadVram(addr);
 }
 
+uint8_t* BaseMapper::GetVramPeekPage(uint16_t addr)
+{
+	addr &= 0x3FFF;
+	return (_chrMemoryAccess[addr >> 8] & MemoryAccessType::Read) ? _chrPages[addr >> 8] : nullptr;
+}
+
 uint8_t BaseMapper::MapperReadVram(uint16_t addr, MemoryOperationType operationType)
 {
 	return InternalReadVram(addr);
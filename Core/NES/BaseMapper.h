@@ -226,6 +226,7 @@ public:
 
 	uint8_t ReadRam(uint16_t addr) override;
 	uint8_t PeekRam(uint16_t addr) override;
+	uint8_t* GetPeekPage(uint16_t addr) override;
 	uint8_t DebugReadRam(uint16_t addr);
 	void WriteRam(uint16_t addr, uint8_t value) override;
 	void DebugWriteRam(uint16_t addr, uint8_t value);
@@ -250,6 +251,7 @@ public:
 	void WriteVram(uint16_t addr, uint8_t value);
 
 	uint8_t DebugReadVram(uint16_t addr, bool disableSideEffects = true);
+	uint8_t* GetVramPeekPage(uint16_t addr);
 
 	void CopyChrTile(uint32_t address, uint8_t *dest);
 
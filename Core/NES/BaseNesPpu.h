@@ -90,6 +90,12 @@ protected:
 	//705
 	NesSpriteInfo _spriteTiles[64] = {};
 
+	//Index of the first opaque sprite at each dot of the current scanline (0xFF = none) and its color
+	//Built once per scanline from _spriteTiles (which don't change between dots 1 and 256)
+	uint8_t _spriteLineIndex[257] = {};
+	uint8_t _spriteLineColor[257] = {};
+	bool _spriteLineValid = false;
+
 	Emulator* _emu = nullptr;
 	EmuSettings* _settings = nullptr;
 	uint16_t* _outputBuffers[2] = {};
@@ -242,7 +242,7 @@ void NesDebugger::ProcessWrite(uint32_t addr, uint8_t value, MemoryOperationType
 		_traceLogger->LogNonExec(operation, addressInfo);
 	}
 
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _cpu->GetCycleCount());
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _cpu->GetCycleCount(), CpuType::Nes);
 	_step->ProcessCpuCycle();
 	_debugger->ProcessBreakConditions(CpuType::Nes, *_step.get(), _breakpointManager.get(), operation, addressInfo);
 }
@@ -359,7 +359,7 @@ void NesDebugger::ProcessPpuWrite(uint16_t addr, uint8_t value, MemoryType memor
 		_mapper->GetPpuAbsoluteAddress(addr, addressInfo);
 	}
 	_debugger->ProcessBreakConditions(CpuType::Nes, *_step.get(), _breakpointManager.get(), operation, addressInfo);
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _console->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _console->GetMasterClock(), CpuType::Nes);
 }
 
 void NesDebugger::ProcessPpuCycle()
@@ -80,7 +80,7 @@ void NesEventManager::AddEvent(DebugEventType type, MemoryOperationInfo& operati
 		}
 	}
 
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void NesEventManager::AddEvent(DebugEventType type)
@@ -99,12 +99,11 @@ void NesEventManager::AddEvent(DebugEventType type)
 	evt.BreakpointId = -1;
 	evt.ProgramCounter = _cpu->GetState().PC;
 	evt.DmaChannel = -1;
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
-void NesEventManager::ClearFrameEvents()
+void NesEventManager::OnFrameStart()
 {
-	BaseEventManager::ClearFrameEvents();
 	AddEvent(DebugEventType::BgColorChange);
 }
 
@@ -221,8 +220,7 @@ uint32_t NesEventManager::TakeEventSnapshot(bool forAutoRefresh)
 		memcpy(_ppuBuffer + offset, ppu->GetScreenBuffer(true) + offset, (NesConstants::ScreenPixelCount - offset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
+	TakeFrameSnapshot();
 	_snapshotScanline = scanline;
 	_snapshotCycle = cycle;
 	_forAutoRefresh = forAutoRefresh;
@@ -271,19 +269,21 @@ void NesEventManager::DrawPixel(uint32_t *buffer, int32_t x, uint32_t y, uint32_
 	buffer[y * NesConstants::CyclesPerLine * 4 + NesConstants::CyclesPerLine * 2 + x * 2 + 1] = color;
 }
 
-void NesEventManager::ProcessNtscBorderColorEvents(vector<DebugEventInfo>& events, vector<uint16_t>& bgColor, uint32_t& currentPos, uint16_t& currentColor)
+void NesEventManager::ProcessNtscBorderColorEvents(DebugEventFrameView& events, vector<uint16_t>& bgColor, uint32_t& currentPos, uint16_t& currentColor)
 {
-	for(DebugEventInfo& evt : events) {
-		if(evt.Type == DebugEventType::BgColorChange) {
-			uint32_t pos = ((evt.Scanline + 1) * NesConstants::CyclesPerLine) + evt.Cycle;
-			if(evt.Scanline >= 242) {
+	DebugEventStore* store = events.Store;
+	for(uint32_t i = 0; i < events.Count; i++) {
+		if(store->GetType(i) == DebugEventType::BgColorChange) {
+			int16_t scanline = store->GetScanline(i);
+			uint32_t pos = ((scanline + 1) * NesConstants::CyclesPerLine) + store->GetCycle(i);
+			if(scanline >= 242) {
 				break;
 			}
 
 			if(pos >= currentPos) {
 				std::fill(bgColor.begin() + currentPos, bgColor.begin() + pos, currentColor);
 				currentPos = pos;
-				currentColor = evt.Operation.Address;
+				currentColor = store->GetOperation(i).Address;
 			}
 		}
 	}
@@ -63,13 +63,14 @@ private:
 	void DrawNtscBorders(uint32_t *buffer);
 	void DrawPixel(uint32_t *buffer, int32_t x, uint32_t y, uint32_t color);
 
-	void ProcessNtscBorderColorEvents(vector<DebugEventInfo>& events, vector<uint16_t>& bgColor, uint32_t& currentPos, uint16_t& currentColor);
+	void ProcessNtscBorderColorEvents(DebugEventFrameView& events, vector<uint16_t>& bgColor, uint32_t& currentPos, uint16_t& currentColor);
 
 protected:
 	void ConvertScanlineCycleToRowColumn(int32_t& x, int32_t& y) override;
 	void DrawScreen(uint32_t* buffer) override;
 
 	bool ShowPreviousFrameEvents() override;
+	void OnFrameStart() override;
 	int GetScanlineOffset() override { return 1; }
 
 public:
@@ -79,8 +80,6 @@ public:
 	void AddEvent(DebugEventType type, MemoryOperationInfo& operation, int32_t breakpointId = -1) override;
 	void AddEvent(DebugEventType type) override;
 
-	void ClearFrameEvents() override;
-
 	EventViewerCategoryCfg GetEventConfig(DebugEventInfo& evt) override;
 
 	uint32_t TakeEventSnapshot(bool forAutoRefresh) override;
@@ -33,6 +33,7 @@ void Epsm::Write(uint8_t dataBus, uint8_t outPins)
 	} else if(!isHigh && wasHigh) {
 		//falling edge
 		_data = (_data & 0xF0) | ((dataBus & 0xF0) >> 4);
+		Run();
 		_opn.Write(_addr, _data);
 	}
 
@@ -42,6 +43,7 @@ void Epsm::Write(uint8_t dataBus, uint8_t outPins)
 void Epsm::WriteRam(uint16_t addr, uint8_t value)
 {
 	//401C-401F writes
+	Run();
 	_opn.Write(addr, value);
 }
 
@@ -50,6 +52,7 @@ void Epsm::OnRegionChanged()
 	uint64_t masterClockRate = _console->GetMasterClockRate();
 	if(_masterClockRate != masterClockRate) {
 		//Reset alignment between cpu & epsm clocks if the region changes (e.g pal to ntsc, etc.)
+		Run();
 		_masterClockRate = masterClockRate;
 		_clockCounter = GetTargetClock();
 	}
@@ -64,23 +67,44 @@ uint64_t Epsm::GetTargetClock()
 
 void Epsm::Exec()
 {
-	constexpr int clocksPerSample = 144;
+	//Rendering is deferred until the next register write or until the audio is mixed,
+	//except when a timer is about to expire (timers can trigger IRQs)
+	uint32_t clocksToTimer = _opn.GetClocksToNextTimer();
+	if(clocksToTimer && GetTargetClock() - _clockCounter >= clocksToTimer) {
+		Run();
+	}
+}
+
+void Epsm::Run()
+{
+	constexpr uint32_t clocksPerSample = 144;
+	constexpr uint64_t maxClocks = 0x1000000;
 
 	uint64_t targetClock = GetTargetClock();
 
 	while(_clockCounter < targetClock) {
-		_clockCounter++;
-		_opn.Exec();
-
-		if(++_sampleClockCounter == clocksPerSample) {
-			_opn.GenerateSamples(_samples);
-			_sampleClockCounter = 0;
+		//Run up to the next timer expiration, all samples in between are generated by a single call
+		uint64_t clocks = std::min(targetClock - _clockCounter, maxClocks);
+		uint32_t clocksToTimer = _opn.GetClocksToNextTimer();
+		if(clocksToTimer && clocksToTimer < clocks) {
+			clocks = clocksToTimer;
 		}
+
+		//A sample that ends on the same clock as a timer expiration is generated after the timer is processed
+		uint32_t samplesBefore = (uint32_t)((_sampleClockCounter + clocks - 1) / clocksPerSample);
+		uint32_t sampleCount = (uint32_t)((_sampleClockCounter + clocks) / clocksPerSample);
+		_opn.GenerateSamples(_samples, samplesBefore);
+		_opn.Exec((uint32_t)clocks);
+		_opn.GenerateSamples(_samples, sampleCount - samplesBefore);
+
+		_sampleClockCounter = (uint8_t)((_sampleClockCounter + clocks) % clocksPerSample);
+		_clockCounter += clocks;
 	}
 }
 
 void Epsm::MixAudio(int16_t* out, uint32_t sampleCount, uint32_t sampleRate)
 {
+	Run();
 	_resampler.SetVolume(_console->GetNesConfig().EpsmVolume / 100.0);
 	_resampler.SetSampleRates(_opn.GetSampleRate(), sampleRate);
 	_resampler.Resample<true>(_samples.data(), (uint32_t)_samples.size() / 2, out, sampleCount, true);
@@ -99,6 +123,10 @@ uint8_t Epsm::ReadRam(uint16_t addr)
 
 void Epsm::Serialize(Serializer& s)
 {
+	if(s.IsSaving()) {
+		Run();
+	}
+
 	SV(_clockCounter);
 	SV(_prevOutPins);
 	SV(_addr);
@@ -27,6 +27,7 @@ private:
 	uint8_t _addr = 0;
 
 	uint64_t GetTargetClock();
+	void Run();
 
 public:
 	Epsm(Emulator* emu, NesConsole* console, vector<uint8_t>& adpcmRom);
@@ -52,5 +52,8 @@ public:
 	virtual void WriteRam(uint16_t addr, uint8_t value) = 0;
 	virtual uint8_t PeekRam(uint16_t addr) { return 0; }
 
+	//Returns the start of the 256-byte page that contains addr, if PeekRam would return its content as-is (nullptr otherwise)
+	virtual uint8_t* GetPeekPage(uint16_t addr) { return nullptr; }
+
 	virtual ~INesMemoryHandler() {}
 };
\ No newline at end of file
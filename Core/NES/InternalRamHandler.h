@@ -30,6 +30,11 @@ public:
 		return ReadRam(addr);
 	}
 
+	uint8_t* GetPeekPage(uint16_t addr) override
+	{
+		return _internalRam + (addr & Mask & 0xFF00);
+	}
+
 	void WriteRam(uint16_t addr, uint8_t value) override
 	{
 		_internalRam[addr & Mask] = value;
@@ -440,6 +440,11 @@ void NesConsole::DebugWrite(uint16_t addr, uint8_t value, bool disableSideEffect
 	_memoryManager->DebugWrite(addr, value, disableSideEffects);
 }
 
+void NesConsole::DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length)
+{
+	_memoryManager->DebugReadBlock(addr, dest, length);
+}
+
 uint8_t NesConsole::DebugReadVram(uint16_t addr)
 {
 	if(addr >= 0x3F00) {
@@ -449,6 +454,24 @@ uint8_t NesConsole::DebugReadVram(uint16_t addr)
 	}
 }
 
+void NesConsole::DebugReadVramBlock(uint32_t addr, uint8_t* dest, uint32_t length)
+{
+	uint32_t end = std::min<uint32_t>(addr + length, 0x4000);
+	while(addr < end) {
+		uint32_t pageEnd = std::min<uint32_t>((addr & 0xFF00) + 0x100, end);
+		uint8_t* page = addr < 0x3F00 ? _mapper->GetVramPeekPage(addr) : nullptr;
+		if(page) {
+			memcpy(dest, page + (uint8_t)addr, pageEnd - addr);
+			dest += pageEnd - addr;
+			addr = pageEnd;
+		} else {
+			for(; addr < pageEnd; addr++) {
+				*(dest++) = DebugReadVram(addr);
+			}
+		}
+	}
+}
+
 void NesConsole::DebugWriteVram(uint16_t addr, uint8_t value)
 {
 	if(addr >= 0x3F00) {
@@ -105,8 +105,10 @@ public:
 	AudioTrackInfo GetAudioTrackInfo() override;
 	void ProcessAudioPlayerAction(AudioPlayerActionParams p) override;
 	uint8_t DebugRead(uint16_t addr);
+	void DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length);
 	void DebugWrite(uint16_t addr, uint8_t value, bool disableSideEffects);
 	uint8_t DebugReadVram(uint16_t addr);
+	void DebugReadVramBlock(uint32_t addr, uint8_t* dest, uint32_t length);
 	void DebugWriteVram(uint16_t addr, uint8_t value);
 
 	void ProcessCheatCode(InternalCheatCode& code, uint32_t addr, uint8_t& value) override;
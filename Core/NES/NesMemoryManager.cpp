@@ -117,6 +117,34 @@ uint8_t NesMemoryManager::DebugRead(uint16_t addr)
 	return value;
 }
 
+void NesMemoryManager::DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length)
+{
+	uint32_t end = std::min<uint32_t>(addr + length, 0x10000);
+	bool hasCheats = _cheatManager->HasCheats<CpuType::Nes>();
+	while(addr < end) {
+		uint32_t pageEnd = std::min<uint32_t>((addr & 0xFF00) + 0x100, end);
+
+		//Pages can only be copied as-is when a single handler is registered for the whole page
+		INesMemoryHandler* handler = _ramReadHandlers[addr];
+		uint8_t* page = hasCheats ? nullptr : handler->GetPeekPage(addr);
+		for(uint32_t i = addr & 0xFF00, len = i + 0x100; page && i < len; i++) {
+			if(_ramReadHandlers[i] != handler) {
+				page = nullptr;
+			}
+		}
+
+		if(page) {
+			memcpy(dest, page + (uint8_t)addr, pageEnd - addr);
+			dest += pageEnd - addr;
+			addr = pageEnd;
+		} else {
+			for(; addr < pageEnd; addr++) {
+				*(dest++) = DebugRead(addr);
+			}
+		}
+	}
+}
+
 uint16_t NesMemoryManager::DebugReadWord(uint16_t addr)
 {
 	return DebugRead(addr) | (DebugRead(addr + 1) << 8);
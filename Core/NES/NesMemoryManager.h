@@ -49,6 +49,7 @@ public:
 	void UnregisterIODevice(INesMemoryHandler* handler);
 
 	uint8_t DebugRead(uint16_t addr);
+	void DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length);
 	uint16_t DebugReadWord(uint16_t addr);
 	void DebugWrite(uint16_t addr, uint8_t value, bool disableSideEffects = true);
 
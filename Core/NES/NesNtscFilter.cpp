@@ -80,7 +80,12 @@ void NesNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		NesDefaultVideoFilter::ApplyPalBorder(ppuOutputBuffer);
 	}
 
-	nes_ntsc_blit(&_ntscData, ppuOutputBuffer, _baseFrameInfo.Width, GetVideoPhase(), _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, NES_NTSC_OUT_WIDTH(_baseFrameInfo.Width) * 4);
+	//Rows are filtered independently, each band starts with the burst phase the row would have in a single pass
+	uint32_t burstPhase = GetVideoPhase();
+	uint32_t rowWidth = _baseFrameInfo.Width;
+	RunRows(_baseFrameInfo.Height, [&](uint32_t startRow, uint32_t endRow) {
+		nes_ntsc_blit(&_ntscData, ppuOutputBuffer + startRow * rowWidth, rowWidth, (burstPhase + startRow) % nes_ntsc_burst_count, rowWidth, endRow - startRow, _ntscBuffer + startRow * baseWidth, baseWidth * 4);
+	});
 
 	for(uint32_t i = 0; i < frameInfo.Height; i+=2) {
 		memcpy(GetOutputBuffer()+i*frameInfo.Width, _ntscBuffer + yOffset + xOffset + (i/2)*baseWidth, frameInfo.Width * sizeof(uint32_t));
@@ -129,6 +129,7 @@ template<class T> void NesPpu<T>::Reset(bool softReset)
 
 	memset(_hasSprite, 0, sizeof(_hasSprite));
 	memset(_spriteTiles, 0, sizeof(_spriteTiles));
+	_spriteLineValid = false;
 	_spriteCount = 0;
 	_secondaryOamAddr = 0;
 	_sprite0Visible = false;
@@ -812,6 +813,30 @@ template<class T> void NesPpu<T>::ShiftTileRegisters()
 	_highBitShift <<= 1;
 }
 
+template<class T> void NesPpu<T>::BuildSpriteLine()
+{
+	//Decode all of the scanline's sprites at once rather than looping over them on every dot.
+	//Sprites are drawn back to front, so the lowest-index opaque sprite ends up in the buffer.
+	memset(_spriteLineIndex, 0xFF, sizeof(_spriteLineIndex));
+	for(int i = (int)_spriteCount - 1; i >= 0; i--) {
+		NesSpriteInfo& spr = _spriteTiles[i];
+		for(int shift = 0; shift < 8 && spr.SpriteX + shift + 1 < 257; shift++) {
+			uint8_t spriteColor;
+			if(spr.HorizontalMirror) {
+				spriteColor = ((spr.LowByte >> shift) & 0x01) | ((spr.HighByte >> shift) & 0x01) << 1;
+			} else {
+				spriteColor = ((spr.LowByte << shift) & 0x80) >> 7 | ((spr.HighByte << shift) & 0x80) >> 6;
+			}
+
+			if(spriteColor != 0) {
+				_spriteLineIndex[spr.SpriteX + shift + 1] = (uint8_t)i;
+				_spriteLineColor[spr.SpriteX + shift + 1] = spr.PaletteOffset + spriteColor;
+			}
+		}
+	}
+	_spriteLineValid = true;
+}
+
 template<class T> uint8_t NesPpu<T>::GetPixelColor()
 {
 	uint8_t offset = _xScroll;
@@ -828,35 +853,27 @@ template<class T> uint8_t NesPpu<T>::GetPixelColor()
 
 	if(_hasSprite[_cycle] && _cycle > _minimumDrawSpriteCycle) {
 		//SpriteMask = true: Hide sprites in leftmost 8 pixels of screen
-		for(uint8_t i = 0; i < _spriteCount; i++) {
-			int32_t shift = (int32_t)_cycle - _spriteTiles[i].SpriteX - 1;
-			if(shift >= 0 && shift < 8) {
-				_lastSprite = &_spriteTiles[i];
-				uint8_t spriteColor;
-				if(_spriteTiles[i].HorizontalMirror) {
-					spriteColor = ((_lastSprite->LowByte >> shift) & 0x01) | ((_lastSprite->HighByte >> shift) & 0x01) << 1;
-				} else {
-					spriteColor = ((_lastSprite->LowByte << shift) & 0x80) >> 7 | ((_lastSprite->HighByte << shift) & 0x80) >> 6;
-				}
-
-				if(spriteColor != 0) {
-					//First sprite without a 00 color, use it.
-					if(i == 0 && spriteBgColor != 0 && _sprite0Visible && _cycle != 256 && _mask.BackgroundEnabled && !_statusFlags.Sprite0Hit && _cycle > _minimumDrawSpriteStandardCycle) {
-						//"The hit condition is basically sprite zero is in range AND the first sprite output unit is outputting a non-zero pixel AND the background drawing unit is outputting a non-zero pixel."
-						//"Sprite zero hits do not register at x=255" (cycle 256)
-						//"... provided that background and sprite rendering are both enabled"
-						//"Should always miss when Y >= 239"
-						_statusFlags.Sprite0Hit = true;
+		if(!_spriteLineValid) {
+			BuildSpriteLine();
+		}
 
-						_emu->AddDebugEvent<CpuType::Nes>(DebugEventType::SpriteZeroHit);
-					}
+		uint8_t i = _spriteLineIndex[_cycle];
+		if(i != 0xFF) {
+			//First sprite without a 00 color, use it.
+			_lastSprite = &_spriteTiles[i];
+			if(i == 0 && spriteBgColor != 0 && _sprite0Visible && _cycle != 256 && _mask.BackgroundEnabled && !_statusFlags.Sprite0Hit && _cycle > _minimumDrawSpriteStandardCycle) {
+				//"The hit condition is basically sprite zero is in range AND the first sprite output unit is outputting a non-zero pixel AND the background drawing unit is outputting a non-zero pixel."
+				//"Sprite zero hits do not register at x=255" (cycle 256)
+				//"... provided that background and sprite rendering are both enabled"
+				//"Should always miss when Y >= 239"
+				_statusFlags.Sprite0Hit = true;
+
+				_emu->AddDebugEvent<CpuType::Nes>(DebugEventType::SpriteZeroHit);
+			}
 
-					if(_emulatorSpritesEnabled && (backgroundColor == 0 || !_spriteTiles[i].BackgroundPriority)) {
-						//Check sprite priority
-						return _lastSprite->PaletteOffset + spriteColor;
-					}
-					break;
-				}
+			if(_emulatorSpritesEnabled && (backgroundColor == 0 || !_lastSprite->BackgroundPriority)) {
+				//Check sprite priority
+				return _spriteLineColor[_cycle];
 			}
 		}
 	}
@@ -898,6 +915,7 @@ template<class T> void NesPpu<T>::ProcessScanlineImpl()
 		if(_cycle == 257) {
 			_spriteIndex = 0;
 			memset(_hasSprite, 0, sizeof(_hasSprite));
+			_spriteLineValid = false;
 			if(_prevRenderingEnabled) {
 				//copy horizontal scrolling value from t
 				_videoRamAddr = (_videoRamAddr & ~0x041F) | (_tmpVideoRamAddr & 0x041F);
@@ -1584,6 +1602,7 @@ template<class T> void NesPpu<T>::Serialize(Serializer& s)
 		for(int i = 0; i < 257; i++) {
 			_hasSprite[i] = true;
 		}
+		_spriteLineValid = false;
 
 		_lastUpdatedPixel = -1;
 
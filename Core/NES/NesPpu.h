@@ -76,6 +76,7 @@ protected:
 	void SetOamCorruptionFlags();
 	void ProcessOamCorruption();
 
+	void BuildSpriteLine();
 	__forceinline uint8_t GetPixelColor();
 
 	void SendFrame();
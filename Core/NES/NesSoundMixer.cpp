@@ -42,6 +42,12 @@ void NesSoundMixer::Serialize(Serializer& s)
 	SVArray(_currentOutput, MaxChannelCount);
 	SV(_previousOutputLeft);
 	SV(_previousOutputRight);
+
+	if(!s.IsSaving()) {
+		for(uint32_t i = 0; i < MaxChannelCount; i++) {
+			UpdateChannelOutput(i);
+		}
+	}
 }
 
 void NesSoundMixer::Reset()
@@ -54,6 +60,9 @@ void NesSoundMixer::Reset()
 	blip_clear(_blipBufRight);
 
 	_timestamps.clear();
+	_changedChannels = 0;
+	_leftDeltas.Clear();
+	_rightDeltas.Clear();
 
 	for(uint32_t i = 0; i < MaxChannelCount; i++) {
 		_volumes[i] = 1.0;
@@ -161,17 +170,20 @@ void NesSoundMixer::UpdateRates(bool forceUpdate)
 			}
 			hasPanning = true;
 		}
+		UpdateChannelOutput(i);
 	}
 	_hasPanning = hasPanning;
 }
 
+void NesSoundMixer::UpdateChannelOutput(uint32_t channel)
+{
+	_weightedOutput[0][channel] = _currentOutput[channel] * _volumes[channel] * (2.0 - _panning[channel]);
+	_weightedOutput[1][channel] = _currentOutput[channel] * _volumes[channel] * _panning[channel];
+}
+
 double NesSoundMixer::GetChannelOutput(AudioChannel channel, bool forRightChannel)
 {
-	if(forRightChannel) {
-		return _currentOutput[(int)channel] * _volumes[(int)channel] * _panning[(int)channel];
-	} else {
-		return _currentOutput[(int)channel] * _volumes[(int)channel] * (2.0 - _panning[(int)channel]);
-	}
+	return _weightedOutput[forRightChannel ? 1 : 0][(int)channel];
 }
 
 int16_t NesSoundMixer::GetOutputVolume(bool forRightChannel)
@@ -195,6 +207,7 @@ void NesSoundMixer::AddDelta(AudioChannel channel, uint32_t time, int16_t delta)
 	if(delta != 0) {
 		_timestamps.push_back(time);
 		_channelOutput[(int)channel][time] += delta;
+		_changedChannels |= 1 << (int)channel;
 	}
 }
 
@@ -203,30 +216,52 @@ void NesSoundMixer::EndFrame(uint32_t time)
 	sort(_timestamps.begin(), _timestamps.end());
 	_timestamps.erase(std::unique(_timestamps.begin(), _timestamps.end()), _timestamps.end());
 
+	//Only the channels that received deltas during this frame need to be checked at each timestamp
+	uint32_t changedChannels[MaxChannelCount];
+	uint32_t changedCount = 0;
+	for(uint32_t j = 0; j < MaxChannelCount; j++) {
+		if(_changedChannels & (1 << j)) {
+			changedChannels[changedCount++] = j;
+		}
+	}
+
 	for(size_t i = 0, len = _timestamps.size(); i < len; i++) {
 		uint32_t stamp = _timestamps[i];
-		for(uint32_t j = 0; j < MaxChannelCount; j++) {
-			_currentOutput[j] += _channelOutput[j][stamp];
+		for(uint32_t k = 0; k < changedCount; k++) {
+			uint32_t j = changedChannels[k];
+			int16_t delta = _channelOutput[j][stamp];
+			if(delta != 0) {
+				_currentOutput[j] += delta;
+				_channelOutput[j][stamp] = 0;
+				UpdateChannelOutput(j);
+			}
 		}
 
 		int16_t currentOutput = GetOutputVolume(false) * 4;
-		blip_add_delta(_blipBufLeft, stamp, (int)(currentOutput - _previousOutputLeft));
-		_previousOutputLeft = currentOutput;
+		if(currentOutput != _previousOutputLeft) {
+			_leftDeltas.Add(stamp, (int)(currentOutput - _previousOutputLeft));
+			_previousOutputLeft = currentOutput;
+		}
 
 		if(_hasPanning) {
 			currentOutput = GetOutputVolume(true) * 4;
-			blip_add_delta(_blipBufRight, stamp, (int)(currentOutput - _previousOutputRight));
-			_previousOutputRight = currentOutput;
+			if(currentOutput != _previousOutputRight) {
+				_rightDeltas.Add(stamp, (int)(currentOutput - _previousOutputRight));
+				_previousOutputRight = currentOutput;
+			}
 		}
 	}
 
+	//The deltas of the whole frame are synthesized in a single batch
+	_leftDeltas.Flush(_blipBufLeft);
 	blip_end_frame(_blipBufLeft, time);
 	if(_hasPanning) {
+		_rightDeltas.Flush(_blipBufRight);
 		blip_end_frame(_blipBufRight, time);
 	}
 
-	//Reset everything
+	//Reset everything (_channelOutput is cleared as it's read)
 	_timestamps.clear();
-	memset(_channelOutput, 0, sizeof(_channelOutput));
+	_changedChannels = 0;
 }
 
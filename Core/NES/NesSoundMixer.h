@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "Utilities/ISerializable.h"
 #include "Utilities/Audio/blip_buf.h"
+#include "Utilities/Audio/BlipDeltaBuffer.h"
 #include "Utilities/Audio/StereoDelayFilter.h"
 #include "Utilities/Audio/StereoPanningFilter.h"
 #include "Utilities/Audio/StereoCombFilter.h"
@@ -36,9 +37,13 @@ private:
 	vector<uint32_t> _timestamps;
 	int16_t _channelOutput[MaxChannelCount][CycleLength] = {};
 	int16_t _currentOutput[MaxChannelCount] = {};
+	double _weightedOutput[2][MaxChannelCount] = {}; //_currentOutput with volume/panning applied ([0] = left, [1] = right)
+	uint32_t _changedChannels = 0; //channels that received deltas during the current frame
 
 	blip_t* _blipBufLeft = nullptr;
 	blip_t* _blipBufRight = nullptr;
+	BlipDeltaBuffer _leftDeltas;
+	BlipDeltaBuffer _rightDeltas;
 	int16_t* _outputBuffer = nullptr;
 	size_t _sampleCount = 0;
 	double _volumes[MaxChannelCount] = {};
@@ -49,6 +54,7 @@ private:
 
 	bool _hasPanning = false;
 
+	__forceinline void UpdateChannelOutput(uint32_t channel);
 	__forceinline double GetChannelOutput(AudioChannel channel, bool forRightChannel);
 	__forceinline int16_t GetOutputVolume(bool forRightChannel);
 	void EndFrame(uint32_t time);
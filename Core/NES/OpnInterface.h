@@ -63,17 +63,29 @@ public:
 		}
 	}
 
-	void Exec()
+	//Number of clocks until the next timer expires (0 when no timer is running)
+	uint32_t GetClocksToNextTimer()
 	{
-		if(_busyCounter) {
-			_busyCounter--;
+		uint32_t clocks = 0;
+		for(uint32_t timer : _timers) {
+			if(timer && (clocks == 0 || timer < clocks)) {
+				clocks = timer;
+			}
 		}
+		return clocks;
+	}
+
+	//Same as running the chip's timers for X clocks, one clock at a time
+	//Must not go past the next timer expiration (see GetClocksToNextTimer)
+	void Exec(uint32_t clocks)
+	{
+		_busyCounter = _busyCounter > clocks ? _busyCounter - clocks : 0;
 
-		if(_timers[0] && --_timers[0] == 0) {
+		if(_timers[0] && (_timers[0] -= clocks) == 0) {
 			m_engine->engine_timer_expired(0);
 		}
 
-		if(_timers[1] && --_timers[1] == 0) {
+		if(_timers[1] && (_timers[1] -= clocks) == 0) {
 			m_engine->engine_timer_expired(1);
 		}
 	}
@@ -88,13 +100,25 @@ public:
 		return _opn.sample_rate(OpnInterface::ClockRate);
 	}
 
-	void GenerateSamples(vector<int16_t>& samples)
+	void GenerateSamples(vector<int16_t>& samples, uint32_t count)
 	{
-		ymfm::ymf288::output_data output;
-		_opn.generate(&output, 1);
-
-		samples.push_back(output.data[0] + (output.data[2] >> 2));
-		samples.push_back(output.data[1] + (output.data[2] >> 2));
+		constexpr uint32_t blockSize = 64;
+		ymfm::ymf288::output_data output[blockSize];
+
+		size_t pos = samples.size();
+		samples.resize(pos + count * 2);
+		int16_t* out = samples.data() + pos;
+
+		while(count > 0) {
+			uint32_t sampleCount = std::min(count, blockSize);
+			_opn.generate(output, sampleCount);
+			for(uint32_t i = 0; i < sampleCount; i++) {
+				out[0] = output[i].data[0] + (output[i].data[2] >> 2);
+				out[1] = output[i].data[1] + (output[i].data[2] >> 2);
+				out += 2;
+			}
+			count -= sampleCount;
+		}
 	}
 
 	void Serialize(Serializer& s) override
@@ -220,7 +220,7 @@ void PceDebugger::ProcessWrite(uint32_t addr, uint8_t value, MemoryOperationType
 		_traceLogger->LogNonExec(operation, addressInfo);
 	}
 
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetState().CycleCount);
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetState().CycleCount, CpuType::Pce);
 	_step->ProcessCpuCycle();
 	_debugger->ProcessBreakConditions(CpuType::Pce, *_step.get(), _breakpointManager.get(), operation, addressInfo);
 }
@@ -335,7 +335,7 @@ void PceDebugger::ProcessPpuWrite(uint16_t addr, uint16_t value, MemoryType memo
 	MemoryOperationInfo operation(addr, value, MemoryOperationType::Write, memoryType);
 	AddressInfo addressInfo { addr, memoryType };
 	_debugger->ProcessBreakConditions(CpuType::Pce, *_step.get(), _breakpointManager.get(), operation, addressInfo);
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _console->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _console->GetMasterClock(), CpuType::Pce);
 }
 
 void PceDebugger::ProcessPpuCycle()
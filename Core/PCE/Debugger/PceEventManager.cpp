@@ -60,7 +60,7 @@ void PceEventManager::AddEvent(DebugEventType type, MemoryOperationInfo &operati
 		}
 	}
 
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void PceEventManager::AddEvent(DebugEventType type)
@@ -72,7 +72,7 @@ void PceEventManager::AddEvent(DebugEventType type)
 	evt.BreakpointId = -1;
 	evt.DmaChannel = -1;
 	evt.ProgramCounter = _cpu->GetState().PC;
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 DebugEventInfo PceEventManager::GetEvent(uint16_t y, uint16_t x)
@@ -209,8 +209,7 @@ uint32_t PceEventManager::TakeEventSnapshot(bool forAutoRefresh)
 		memcpy(_rowClockDividers + scanlineOffset, _vpc->GetPreviousScreenBuffer() + size + scanlineOffset, (PceConstants::ScreenHeight - scanlineOffset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
+	TakeFrameSnapshot();
 	_snapshotScanline = scanline;
 	_snapshotCycle = cycle;
 	_forAutoRefresh = forAutoRefresh;
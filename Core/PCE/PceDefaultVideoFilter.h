@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "PCE/PceConstants.h"
 #include "Shared/Video/BaseVideoFilter.h"
+#include "Shared/Video/VideoFilterKernels.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/Emulator.h"
 
@@ -188,9 +189,7 @@ public:
 				uint32_t xOffset = PceConstants::GetLeftOverscan(_frameDivider) + (overscan.Left * 4 / _frameDivider);
 				uint32_t baseDstOffset = i * frameInfo.Width;
 				uint32_t baseSrcOffset = i * PceConstants::MaxScreenWidth + yOffset + xOffset;
-				for(uint32_t j = 0; j < frameInfo.Width; j++) {
-					out[baseDstOffset + j] = GetPixel(ppuOutputBuffer, baseSrcOffset + j);
-				}
+				VideoFilterKernels::ConvertPalette(out + baseDstOffset, ppuOutputBuffer + baseSrcOffset, _calculatedPalette, 0x3FF, frameInfo.Width);
 			}
 		} else {
 			//Always output at 4x scale
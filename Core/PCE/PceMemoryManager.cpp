@@ -331,6 +331,24 @@ uint8_t PceMemoryManager::DebugRead(uint16_t addr)
 	return 0xFF;
 }
 
+void PceMemoryManager::DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length)
+{
+	uint32_t end = std::min<uint32_t>(addr + length, 0x10000);
+	while(addr < end) {
+		uint32_t bankEnd = std::min<uint32_t>((addr & 0xE000) + 0x2000, end);
+		uint8_t bank = _state.Mpr[(addr & 0xE000) >> 13];
+		if(bank == 0xFF) {
+			for(; addr < bankEnd; addr++) {
+				*(dest++) = DebugRead(addr);
+			}
+		} else {
+			memcpy(dest, _readBanks[bank] + (addr & 0x1FFF), bankEnd - addr);
+			dest += bankEnd - addr;
+			addr = bankEnd;
+		}
+	}
+}
+
 void PceMemoryManager::DebugWrite(uint16_t addr, uint8_t value)
 {
 	uint8_t bank = _state.Mpr[(addr & 0xE000) >> 13];
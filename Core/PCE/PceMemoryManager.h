@@ -83,6 +83,7 @@ public:
 	void WriteVdc(uint16_t addr, uint8_t value);
 
 	uint8_t DebugRead(uint16_t addr);
+	void DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length);
 	void DebugWrite(uint16_t addr, uint8_t value);
 
 	void SetMprValue(uint8_t regSelect, uint8_t value);
@@ -79,37 +79,43 @@ void PceNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		return;
 	}
 
-	//Convert RGB333 to RGB555 since this is what blargg's SNES NTSC filter expects
-	for(uint32_t i = 0; i < rowCount; i++) {
-		uint8_t clockDivider = _frameDivider ? _frameDivider : ppuOutputBuffer[clockDividerOffset + i + overscan.Top];
-		uint32_t xOffset = PceConstants::GetLeftOverscan(clockDivider) + (overscan.Left * 4 / (clockDivider ? clockDivider : 4));
-		uint32_t rowWidth = PceConstants::GetRowWidth(clockDivider);
-
-		double ratio = _frameDivider ? 1.0 : ((double)rowWidth / baseFrameInfo.Width);
-		uint32_t baseOffset = i * frameWidth;
-		for(uint32_t j = 0; j < frameWidth; j++) {
-			int pos = (int)(j * ratio);
-			uint32_t color = _pceConfig.Palette[ppuOutputBuffer[i * PceConstants::MaxScreenWidth + pos + yOffset + xOffset] & 0x1FF];
-
-			uint8_t r = (color >> 19) & 0x1F;
-			uint8_t g = (color >> 11) & 0x1F;
-			uint8_t b = (color >> 3) & 0x1F;
-
-			_rgb555Buffer[baseOffset + j] = (b << 10) | (g << 5) | r;
+	//Rows are converted and filtered independently, each band starts with the burst phase the row would have in a single pass
+	int burstPhase = IsOddFrame() ? 0 : 1;
+	RunRows(rowCount, [&](uint32_t startRow, uint32_t endRow) {
+		//Convert RGB333 to RGB555 since this is what blargg's SNES NTSC filter expects
+		for(uint32_t i = startRow; i < endRow; i++) {
+			uint8_t clockDivider = _frameDivider ? _frameDivider : ppuOutputBuffer[clockDividerOffset + i + overscan.Top];
+			uint32_t xOffset = PceConstants::GetLeftOverscan(clockDivider) + (overscan.Left * 4 / (clockDivider ? clockDivider : 4));
+			uint32_t rowWidth = PceConstants::GetRowWidth(clockDivider);
+
+			double ratio = _frameDivider ? 1.0 : ((double)rowWidth / baseFrameInfo.Width);
+			uint32_t baseOffset = i * frameWidth;
+			for(uint32_t j = 0; j < frameWidth; j++) {
+				int pos = (int)(j * ratio);
+				uint32_t color = _pceConfig.Palette[ppuOutputBuffer[i * PceConstants::MaxScreenWidth + pos + yOffset + xOffset] & 0x1FF];
+
+				uint8_t r = (color >> 19) & 0x1F;
+				uint8_t g = (color >> 11) & 0x1F;
+				uint8_t b = (color >> 3) & 0x1F;
+
+				_rgb555Buffer[baseOffset + j] = (b << 10) | (g << 5) | r;
+			}
 		}
-	}
 
-	if(_frameDivider) {
-		snes_ntsc_blit(&_ntscData, _rgb555Buffer, frameWidth, IsOddFrame() ? 0 : 1, frameWidth, rowCount, GetOutputBuffer(), frameInfo.Width * sizeof(uint32_t));
-	} else {
-		snes_ntsc_blit_hires(&_ntscData, _rgb555Buffer, frameWidth, IsOddFrame() ? 0 : 1, frameWidth, rowCount, _ntscBuffer, frameInfo.Width * sizeof(uint32_t));
-
-		for(uint32_t i = 0; i < rowCount; i++) {
-			uint32_t* src = _ntscBuffer + i * frameInfo.Width;
-			for(uint32_t j = 0; j < verticalScale; j++) {
-				uint32_t* dst = GetOutputBuffer() + (i * verticalScale + j) * frameInfo.Width;
-				memcpy(dst, src, frameInfo.Width * sizeof(uint32_t));
+		int phase = (burstPhase + startRow) % snes_ntsc_burst_count;
+		uint16_t* input = _rgb555Buffer + startRow * frameWidth;
+		if(_frameDivider) {
+			snes_ntsc_blit(&_ntscData, input, frameWidth, phase, frameWidth, endRow - startRow, GetOutputBuffer() + startRow * frameInfo.Width, frameInfo.Width * sizeof(uint32_t));
+		} else {
+			snes_ntsc_blit_hires(&_ntscData, input, frameWidth, phase, frameWidth, endRow - startRow, _ntscBuffer + startRow * frameInfo.Width, frameInfo.Width * sizeof(uint32_t));
+
+			for(uint32_t i = startRow; i < endRow; i++) {
+				uint32_t* src = _ntscBuffer + i * frameInfo.Width;
+				for(uint32_t j = 0; j < verticalScale; j++) {
+					uint32_t* dst = GetOutputBuffer() + (i * verticalScale + j) * frameInfo.Width;
+					memcpy(dst, src, frameInfo.Width * sizeof(uint32_t));
+				}
 			}
 		}
-	}
+	});
 }
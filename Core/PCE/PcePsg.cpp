@@ -135,12 +135,12 @@ void PcePsg::UpdateOutput(PcEngineConfig& cfg)
 	}
 
 	if(_prevLeftOutput != leftOutput) {
-		blip_add_delta(_leftChannel, _clockCounter, leftOutput - _prevLeftOutput);
+		_leftDeltas.Add(_clockCounter, leftOutput - _prevLeftOutput);
 		_prevLeftOutput = leftOutput;
 	}
 
 	if(_prevRightOutput != rightOutput) {
-		blip_add_delta(_rightChannel, _clockCounter, rightOutput - _prevRightOutput);
+		_rightDeltas.Add(_clockCounter, rightOutput - _prevRightOutput);
 		_prevRightOutput = rightOutput;
 	}
 }
@@ -155,6 +155,8 @@ void PcePsg::UpdateSoundOffset()
 
 void PcePsg::PlayQueuedAudio()
 {
+	_leftDeltas.Flush(_leftChannel);
+	_rightDeltas.Flush(_rightChannel);
 	blip_end_frame(_leftChannel, _clockCounter);
 	blip_end_frame(_rightChannel, _clockCounter);
 
@@ -4,12 +4,12 @@
 #include "PCE/PceTypes.h"
 #include "PCE/PcePsgChannel.h"
 #include "Utilities/ISerializable.h"
+#include "Utilities/Audio/BlipDeltaBuffer.h"
 
 class Emulator;
 class PceConsole;
 class SoundMixer;
 struct PcEngineConfig;
-struct blip_t;
 
 class PcePsg final : public ISerializable
 {
@@ -28,6 +28,8 @@ private:
 	int16_t* _soundBuffer = nullptr;
 	blip_t* _leftChannel = nullptr;
 	blip_t* _rightChannel = nullptr;
+	BlipDeltaBuffer _leftDeltas;
+	BlipDeltaBuffer _rightDeltas;
 	int16_t _prevLeftOutput = 0;
 	int16_t _prevRightOutput = 0;
 
@@ -200,7 +200,7 @@ void SmsDebugger::ProcessWrite(uint32_t addr, uint8_t value, MemoryOperationType
 		_traceLogger->LogNonExec(operation, addressInfo);
 	}
 
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _console->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _console->GetMasterClock(), CpuType::Sms);
 	_step->ProcessCpuCycle();
 	_debugger->ProcessBreakConditions(CpuType::Sms, *_step.get(), _breakpointManager.get(), operation, addressInfo);
 }
@@ -324,7 +324,7 @@ void SmsDebugger::ProcessPpuWrite(uint16_t addr, uint8_t value, MemoryType memor
 	MemoryOperationInfo operation(addr, value, MemoryOperationType::Write, memoryType);
 	AddressInfo addressInfo { addr, memoryType };
 	_debugger->ProcessBreakConditions(CpuType::Sms, *_step.get(), _breakpointManager.get(), operation, addressInfo);
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _console->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _console->GetMasterClock(), CpuType::Sms);
 }
 
 void SmsDebugger::ProcessPpuCycle()
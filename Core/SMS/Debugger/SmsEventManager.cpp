@@ -74,7 +74,7 @@ void SmsEventManager::AddEvent(DebugEventType type, MemoryOperationInfo& operati
 	}
 
 	evt.ProgramCounter = _debugger->GetProgramCounter(CpuType::Sms, true);
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void SmsEventManager::AddEvent(DebugEventType type)
@@ -86,7 +86,7 @@ void SmsEventManager::AddEvent(DebugEventType type)
 	evt.BreakpointId = -1;
 	evt.DmaChannel = -1;
 	evt.ProgramCounter = _cpu->GetState().PC;
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 DebugEventInfo SmsEventManager::GetEvent(uint16_t y, uint16_t x)
@@ -179,8 +179,7 @@ uint32_t SmsEventManager::TakeEventSnapshot(bool forAutoRefresh)
 		memcpy(_ppuBuffer + offset, _vdp->GetScreenBuffer(true) + offset, (256 * 240 - offset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
+	TakeFrameSnapshot();
 	_snapshotScanline = scanline;
 	_snapshotCycle = cycle;
 	_forAutoRefresh = forAutoRefresh;
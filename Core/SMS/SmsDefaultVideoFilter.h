@@ -7,11 +7,13 @@
 #include "Shared/Emulator.h"
 #include "Shared/RewindManager.h"
 #include "Shared/ColorUtilities.h"
+#include "Shared/Video/VideoFilterKernels.h"
 
 class SmsDefaultVideoFilter : public BaseVideoFilter
 {
 private:
 	uint32_t _calculatedPalette[0x8000] = {};
+	bool _isRgb555Palette = false;
 	VideoConfig _videoConfig = {};
 	uint16_t _prevFrame[256 * 240] = {};
 	bool _blendFrames = false;
@@ -54,23 +56,11 @@ protected:
 			}
 		}
 
+		//Without color adjustments, the colors can be converted directly instead of using the lookup table
+		_isRgb555Palette = VideoFilterKernels::IsRgb555Palette(_calculatedPalette);
 		_videoConfig = config;
 	}
 
-	uint32_t GetPixel(uint16_t* vdpFrame, uint32_t offset)
-	{
-		if(_blendFrames) {
-			return BlendPixels(_calculatedPalette[_prevFrame[offset]], _calculatedPalette[vdpFrame[offset]]);
-		} else {
-			return _calculatedPalette[vdpFrame[offset]];
-		}
-	}
-
-	uint32_t BlendPixels(uint32_t a, uint32_t b)
-	{
-		return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
-	}
-
 public:
 	SmsDefaultVideoFilter(Emulator* emu, SmsConsole* console) : BaseVideoFilter(emu)
 	{
@@ -88,14 +78,14 @@ public:
 
 		uint32_t linesToSkip = _console->GetVdp()->GetViewportYOffset();
 		uint32_t scanlineCount = _console->GetVdp()->GetState().VisibleScanlineCount;
+		const uint32_t* palette = _isRgb555Palette ? nullptr : _calculatedPalette;
 
 		for(uint32_t y = 0; y < frame.Height; y++) {
 			if(y + overscan.Top < linesToSkip || y > linesToSkip + scanlineCount - overscan.Top) {
 				memset(out+y*frame.Width, 0, frame.Width * sizeof(uint32_t));
 			} else {
-				for(uint32_t x = 0; x < frame.Width; x++) {
-					out[(y * frame.Width) + x] = GetPixel(in, (y + overscan.Top - linesToSkip) * _baseFrameInfo.Width + x + overscan.Left);
-				}
+				uint32_t offset = (y + overscan.Top - linesToSkip) * _baseFrameInfo.Width + overscan.Left;
+				VideoFilterKernels::ConvertRow(out + y * frame.Width, in + offset, _blendFrames ? _prevFrame + offset : nullptr, palette, 0x7FFF, frame.Width);
 			}
 		}
 
@@ -29,13 +29,20 @@ SmsFmAudio::~SmsFmAudio()
 void SmsFmAudio::Run()
 {
 	if(_fmEnabled && _emu->GetSettings()->GetSmsConfig().EnableFmAudio) {
-		uint64_t clocksToRun = _console->GetMasterClock() - _prevMasterClock;
-		while(clocksToRun >= 72) {
-			int16_t output = OPLL_calc(_opll);
-			_samplesToPlay.push_back(output);
-			_samplesToPlay.push_back(output);
-			_prevMasterClock += 72;
-			clocksToRun -= 72;
+		//Run is called before each register write, so all samples since the last write can be rendered as a single block
+		uint32_t sampleCount = (uint32_t)((_console->GetMasterClock() - _prevMasterClock) / 72);
+		if(sampleCount > 0) {
+			_blockBuffer.resize(sampleCount);
+			OPLL_calcBlock(_opll, _blockBuffer.data(), sampleCount);
+
+			size_t start = _samplesToPlay.size();
+			_samplesToPlay.resize(start + sampleCount * 2);
+			int16_t* out = _samplesToPlay.data() + start;
+			for(uint32_t i = 0; i < sampleCount; i++) {
+				out[i * 2] = _blockBuffer[i];
+				out[i * 2 + 1] = _blockBuffer[i];
+			}
+			_prevMasterClock += (uint64_t)sampleCount * 72;
 		}
 	} else {
 		_prevMasterClock = _console->GetMasterClock();
@@ -14,6 +14,7 @@ private:
 	OPLL* _opll = nullptr;
 	HermiteResampler _resampler;
 	vector<int16_t> _samplesToPlay;
+	vector<int16_t> _blockBuffer;
 	uint64_t _prevMasterClock = 0;
 	uint8_t _audioControl = 0;
 	bool _fmEnabled = false;
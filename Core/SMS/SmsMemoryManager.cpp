@@ -273,6 +273,24 @@ uint8_t SmsMemoryManager::DebugRead(uint16_t addr)
 	return data ? data[(uint8_t)addr] : GetOpenBus();
 }
 
+void SmsMemoryManager::DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length)
+{
+	uint32_t end = std::min<uint32_t>(addr + length, 0x10000);
+	while(addr < end) {
+		uint32_t pageEnd = std::min<uint32_t>((addr & 0xFF00) + 0x100, end);
+		uint8_t* data = _reads[addr >> 8];
+		if(_state.IsReadRegister[addr >> 8] || !data) {
+			for(; addr < pageEnd; addr++) {
+				*(dest++) = DebugRead(addr);
+			}
+		} else {
+			memcpy(dest, data + (uint8_t)addr, pageEnd - addr);
+			dest += pageEnd - addr;
+			addr = pageEnd;
+		}
+	}
+}
+
 void SmsMemoryManager::Write(uint16_t addr, uint8_t value)
 {
 	if(_emu->ProcessMemoryWrite<CpuType::Sms>(addr, value, MemoryOperationType::Write)) {
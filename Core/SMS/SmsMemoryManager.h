@@ -117,6 +117,7 @@ public:
 	}
 
 	uint8_t DebugRead(uint16_t addr);
+	void DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length);
 
 	void Write(uint16_t addr, uint8_t value);
 	void DebugWrite(uint16_t addr, uint8_t value);
@@ -80,12 +80,17 @@ void SmsNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 	uint32_t* out = GetOutputBuffer();
 	
 	uint32_t baseWidth;
+	uint32_t rowWidth = _baseFrameInfo.Width;
 	if(_console->GetModel() == SmsModel::GameGear) {
 		baseWidth = SNES_NTSC_OUT_WIDTH(_baseFrameInfo.Width);
-		snes_ntsc_blit(_snesNtscData.get(), ppuOutputBuffer, _baseFrameInfo.Width, 0, _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, SNES_NTSC_OUT_WIDTH(_baseFrameInfo.Width) * 4);
+		RunRows(_baseFrameInfo.Height, [&](uint32_t startRow, uint32_t endRow) {
+			snes_ntsc_blit(_snesNtscData.get(), ppuOutputBuffer + startRow * rowWidth, rowWidth, startRow % snes_ntsc_burst_count, rowWidth, endRow - startRow, _ntscBuffer + startRow * baseWidth, baseWidth * 4);
+		});
 	} else {
 		baseWidth = SMS_NTSC_OUT_WIDTH(_baseFrameInfo.Width);
-		sms_ntsc_blit(_ntscData.get(), ppuOutputBuffer, _baseFrameInfo.Width, _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, SMS_NTSC_OUT_WIDTH(_baseFrameInfo.Width) * 4);
+		RunRows(_baseFrameInfo.Height, [&](uint32_t startRow, uint32_t endRow) {
+			sms_ntsc_blit(_ntscData.get(), ppuOutputBuffer + startRow * rowWidth, rowWidth, rowWidth, endRow - startRow, _ntscBuffer + startRow * baseWidth, baseWidth * 4);
+		});
 	}
 
 	uint32_t linesToSkip;
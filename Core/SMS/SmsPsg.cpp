@@ -32,6 +32,8 @@ void SmsPsg::SetRegion(ConsoleRegion region)
 {
 	blip_clear(_leftChannel);
 	blip_clear(_rightChannel);
+	_leftDeltas.Clear();
+	_rightDeltas.Clear();
 
 	blip_set_rates(_leftChannel, _console->GetMasterClockRate(), SmsPsg::SampleRate);
 	blip_set_rates(_rightChannel, _console->GetMasterClockRate(), SmsPsg::SampleRate);
@@ -94,8 +96,8 @@ void SmsPsg::Run()
 		_masterClock += 16;
 
 		if(_prevOutputLeft != outputLeft || _prevOutputRight != outputRight) {
-			blip_add_delta(_leftChannel, _clockCounter, outputLeft - _prevOutputLeft);
-			blip_add_delta(_rightChannel, _clockCounter, outputRight - _prevOutputRight);
+			_leftDeltas.Add(_clockCounter, outputLeft - _prevOutputLeft);
+			_rightDeltas.Add(_clockCounter, outputRight - _prevOutputRight);
 			_prevOutputLeft = outputLeft;
 			_prevOutputRight = outputRight;
 		}
@@ -108,6 +110,8 @@ void SmsPsg::Run()
 
 void SmsPsg::PlayQueuedAudio()
 {
+	_leftDeltas.Flush(_leftChannel);
+	_rightDeltas.Flush(_rightChannel);
 	blip_end_frame(_leftChannel, _clockCounter);
 	blip_end_frame(_rightChannel, _clockCounter);
 
@@ -170,6 +174,8 @@ void SmsPsg::Serialize(Serializer& s)
 		_clockCounter = 0;
 		blip_clear(_leftChannel);
 		blip_clear(_rightChannel);
+		_leftDeltas.Clear();
+		_rightDeltas.Clear();
 	}
 
 	SV(_state.SelectedReg);
@@ -6,6 +6,7 @@
 #include "Shared/Audio/SoundMixer.h"
 #include "Utilities/ISerializable.h"
 #include "Utilities/Audio/blip_buf.h"
+#include "Utilities/Audio/BlipDeltaBuffer.h"
 
 class SmsPsg final : public ISerializable
 {
@@ -17,6 +18,8 @@ private:
 	int16_t* _soundBuffer = nullptr;
 	blip_t* _leftChannel = nullptr;
 	blip_t* _rightChannel = nullptr;
+	BlipDeltaBuffer _leftDeltas;
+	BlipDeltaBuffer _rightDeltas;
 
 	SoundMixer* _soundMixer = nullptr;
 	EmuSettings* _settings = nullptr;
@@ -1071,63 +1071,110 @@ bool SmsVdp::IsZoomedSpriteAllowed(int spriteIndex)
 	return _state.EnableDoubleSpriteSize && (!_state.UseMode4 || spriteIndex < ((int)_spriteCount - 4) || _revision != SmsRevision::Sms1);
 }
 
-uint16_t SmsVdp::GetPixelColor()
+void SmsVdp::BuildSpriteLine(int startX)
 {
-	if(!_state.RenderingEnabled || _state.Cycle < SmsVdp::SmsVdpLeftBorder) {
-		return _internalPaletteRam[0x10 | _state.BackgroundColorIndex];
-	}
+	//Decodes the pixels of each sprite for the rest of the scanline, in priority order.
+	//Produces the same colors/collisions as shifting all sprites on every dot, but only touches each sprite's own pixels.
+	memset(_spriteLineColor, 0, sizeof(_spriteLineColor));
+	memset(_spriteLineCollision, 0, sizeof(_spriteLineCollision));
 
-	bool spriteDrawn = false;
-	uint8_t spritePixelColor = 0;
-	uint16_t xPos = GetVisiblePixelIndex();
 	for(int i = 0; i < _spriteCount; i++) {
-		if(xPos >= _spriteShifters[i].SpriteX && xPos < _spriteShifters[i].SpriteX + (8 << (uint8_t)IsZoomedSpriteAllowed(i))) {
+		SpriteShifter& spr = _spriteShifters[i];
+		bool zoomed = IsZoomedSpriteAllowed(i);
+		int start = std::max<int>(spr.SpriteX, startX);
+		int end = std::min<int>(spr.SpriteX + (8 << (uint8_t)zoomed), 256);
+
+		uint8_t tileData[4] = { spr.TileData[0], spr.TileData[1], spr.TileData[2], spr.TileData[3] };
+		for(int x = start; x < end; x++) {
+			uint8_t sprColor;
 			if(_state.UseMode4) {
-				uint8_t sprColor = (
-					((_spriteShifters[i].TileData[0] >> 7) & 0x01) |
-					((_spriteShifters[i].TileData[1] >> 6) & 0x02) |
-					((_spriteShifters[i].TileData[2] >> 5) & 0x04) |
-					((_spriteShifters[i].TileData[3] >> 4) & 0x08)
+				sprColor = (
+					((tileData[0] >> 7) & 0x01) |
+					((tileData[1] >> 6) & 0x02) |
+					((tileData[2] >> 5) & 0x04) |
+					((tileData[3] >> 4) & 0x08)
 				);
-
-				if(!IsZoomedSpriteAllowed(i) || ((_spriteShifters[i].SpriteX - xPos) & 0x01)) {
-					_spriteShifters[i].TileData[0] <<= 1;
-					_spriteShifters[i].TileData[1] <<= 1;
-					_spriteShifters[i].TileData[2] <<= 1;
-					_spriteShifters[i].TileData[3] <<= 1;
-				}
-
-				if(sprColor != 0) {
-					if(spriteDrawn) {
-						_state.SpriteCollision |= _spriteShifters[i].HardwareSprite;
-						continue;
-					} else {
-						spritePixelColor = sprColor;
-						spriteDrawn = true;
-					}
-				}
 			} else {
-				uint8_t sprColor = ((_spriteShifters[i].TileData[0] >> 7) & 0x01);
-				if(!_state.EnableDoubleSpriteSize || ((_spriteShifters[i].SpriteX - xPos) & 0x01)) {
-					_spriteShifters[i].TileData[0] <<= 1;
+				//Only the pixel's presence matters for collisions, TileData[1] contains the sprite's color
+				sprColor = (tileData[0] & 0x80) ? 0xFF : 0;
+			}
+
+			if(!zoomed || ((spr.SpriteX - x) & 0x01)) {
+				tileData[0] <<= 1;
+				if(_state.UseMode4) {
+					tileData[1] <<= 1;
+					tileData[2] <<= 1;
+					tileData[3] <<= 1;
 				}
+			}
 
-				if(sprColor != 0) {
-					if(spriteDrawn) {
-						_state.SpriteCollision |= _spriteShifters[i].HardwareSprite;
-						continue;
-					} else {
-						uint8_t spritePalette = _spriteShifters[i].TileData[1];
-						if(spritePalette != 0) {
-							spritePixelColor = spritePalette;
-							spriteDrawn = true;
-						}
-					}
+			if(sprColor != 0) {
+				if(_spriteLineColor[x] != 0) {
+					_spriteLineCollision[x] |= spr.HardwareSprite;
+				} else {
+					_spriteLineColor[x] = _state.UseMode4 ? sprColor : tileData[1];
 				}
 			}
 		}
 	}
 
+	_spriteLineStartX = startX;
+}
+
+void SmsVdp::CommitSpriteLine(int endX)
+{
+	//Applies the shifts done on the sprites' tile data for the pixels drawn since the line was built
+	if(_spriteLineStartX < 0) {
+		return;
+	}
+
+	for(int i = 0; i < _spriteCount; i++) {
+		SpriteShifter& spr = _spriteShifters[i];
+		bool zoomed = IsZoomedSpriteAllowed(i);
+		int start = std::max<int>(spr.SpriteX, _spriteLineStartX);
+		int end = std::min<int>(spr.SpriteX + (8 << (uint8_t)zoomed), endX);
+		if(end <= start) {
+			continue;
+		}
+
+		int shifts = end - start;
+		if(zoomed) {
+			//Zoomed sprites only shift on every other pixel
+			shifts = ((spr.SpriteX - start) & 0x01) ? (shifts + 1) / 2 : shifts / 2;
+		}
+
+		spr.TileData[0] = (uint8_t)(spr.TileData[0] << shifts);
+		if(_state.UseMode4) {
+			spr.TileData[1] = (uint8_t)(spr.TileData[1] << shifts);
+			spr.TileData[2] = (uint8_t)(spr.TileData[2] << shifts);
+			spr.TileData[3] = (uint8_t)(spr.TileData[3] << shifts);
+		}
+	}
+
+	_spriteLineStartX = -1;
+}
+
+uint16_t SmsVdp::GetPixelColor()
+{
+	if(!_state.RenderingEnabled || _state.Cycle < SmsVdp::SmsVdpLeftBorder) {
+		return _internalPaletteRam[0x10 | _state.BackgroundColorIndex];
+	}
+
+	uint16_t xPos = GetVisiblePixelIndex();
+	if(_spriteLineStartX < 0) {
+		BuildSpriteLine(xPos);
+	}
+
+	uint8_t spritePixelColor = _spriteLineColor[xPos];
+	bool spriteDrawn = spritePixelColor != 0;
+	if(_spriteLineCollision[xPos]) {
+		_state.SpriteCollision = true;
+	}
+
+	if(xPos == 255) {
+		CommitSpriteLine(256);
+	}
+
 	if(_state.Cycle < _minDrawCycle) {
 		return _internalPaletteRam[0x10 | _state.BackgroundColorIndex];
 	}
@@ -1163,6 +1210,9 @@ void SmsVdp::WriteRegister(uint8_t reg, uint8_t value)
 		return;
 	}
 
+	//Registers can change how sprites are drawn, finish processing the pixels drawn so far with the current settings
+	CommitSpriteLine((int)_state.Cycle - SmsVdp::SmsVdpLeftBorder);
+
 	switch(reg) {
 		case 0:
 			_state.SyncDisabled = (value & 0x01) != 0; //TODOSMS not implemented
@@ -1470,6 +1520,8 @@ void SmsVdp::InitGgPowerOnState()
 
 void SmsVdp::Serialize(Serializer& s)
 {
+	CommitSpriteLine((int)_state.Cycle - SmsVdp::SmsVdpLeftBorder);
+
 	SVArray(_videoRam, 0x4000);
 	SVArray(_paletteRam, 0x40);
 	SVArray(_internalPaletteRam, 0x20);
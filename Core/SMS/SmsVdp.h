@@ -90,6 +90,12 @@ private:
 	uint8_t _inRangeSprites[64] = {};
 	SpriteShifter _spriteShifters[64];
 
+	//Sprite pixels for the current scanline, decoded from _spriteShifters in a single pass.
+	//The shifters themselves are only updated when the line is committed (end of line, register write, save state)
+	uint8_t _spriteLineColor[256] = {};
+	bool _spriteLineCollision[256] = {};
+	int16_t _spriteLineStartX = -1;
+
 	uint8_t _paletteRam[0x40] = {};
 	uint16_t _scanlineCount = 262;
 	ConsoleRegion _region = ConsoleRegion::Ntsc;
@@ -146,6 +152,8 @@ private:
 	void LoadSpriteTilesSms();
 	void LoadExtraSpritesSms();
 	__forceinline uint16_t GetPixelColor();
+	void BuildSpriteLine(int startX);
+	void CommitSpriteLine(int endX);
 
 	void LoadSpriteTilesSg();
 	void LoadExtraSpritesSg();
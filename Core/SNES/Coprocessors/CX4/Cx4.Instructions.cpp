@@ -8,12 +8,9 @@ static constexpr int shiftLut[4] = { 0 , 1, 8, 16 };
 
 extern const uint32_t _dataRom[1024];
 
-void Cx4::Exec(uint16_t opCode)
+template<uint8_t op>
+void Cx4::ExecOp(uint8_t param1, uint8_t param2)
 {
-	uint8_t op = (opCode >> 8) & 0xFC;
-	uint8_t param1 = (opCode >> 8) & 0x03;
-	uint8_t param2 = opCode & 0xFF;
-
 	switch(op) {
 		case 0x00: NOP(); break;
 		case 0x04: NOP(); break; //???
@@ -95,7 +92,33 @@ void Cx4::Exec(uint16_t opCode)
 		case 0xF8: NOP(); break; //???
 		case 0xFC: Stop(); break;
 	}
+}
+
+template<size_t... i>
+constexpr std::array<Cx4::Func, 0x40> Cx4::GetOpTable(std::index_sequence<i...>)
+{
+	return { &Cx4::ExecOp<(uint8_t)(i << 2)>... };
+}
+
+const std::array<Cx4::Func, 0x40> Cx4::_opTable = Cx4::GetOpTable(std::make_index_sequence<0x40>());
+
+void Cx4::DecodeOp(uint8_t page, uint8_t pos)
+{
+	uint16_t opCode = _prgRam[page][pos];
+	_decodedPrg[page][pos] = { _opTable[opCode >> 10], (uint8_t)((opCode >> 8) & 0x03), (uint8_t)opCode };
+}
+
+void Cx4::DecodePrgRam()
+{
+	for(int i = 0; i < 256; i++) {
+		DecodeOp(0, i);
+		DecodeOp(1, i);
+	}
+}
 
+void Cx4::Exec(Cx4DecodedOp op)
+{
+	(this->*op.Exec)(op.Param1, op.Param2);
 	Step(1);
 }
 
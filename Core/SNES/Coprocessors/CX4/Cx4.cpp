@@ -49,6 +49,8 @@ Cx4::Cx4(SnesConsole* console)
 	_mappings.RegisterHandler(0x80, 0xBF, 0x6000, 0x7FFF, this);
 
 	_clockRatio = (double)20000000 / console->GetMasterClockRate();
+	memset(_prgRam, 0, sizeof(_prgRam));
+	DecodePrgRam();
 	Reset();
 }
 
@@ -92,7 +94,7 @@ void Cx4::Run()
 		} else {
 			_emu->ProcessInstruction<CpuType::Cx4>();
 
-			uint16_t opCode = _prgRam[_state.Cache.Page][_state.PC];
+			Cx4DecodedOp op = _decodedPrg[_state.Cache.Page][_state.PC];
 			_state.PC++;
 			
 			if(_state.PC == 0) {
@@ -101,7 +103,7 @@ void Cx4::Run()
 				SwitchCachePage();
 			}
 
-			Exec(opCode);
+			Exec(op);
 		}
 	}
 }
@@ -194,6 +196,7 @@ bool Cx4::ProcessCache(uint64_t targetCycle)
 		Step(GetAccessDelay(address + (_state.Cache.Pos * 2) + 1));
 
 		_prgRam[_state.Cache.Page][_state.Cache.Pos] = (msb << 8) | lsb;
+		DecodeOp(_state.Cache.Page, _state.Cache.Pos);
 		_state.Cache.Pos++;
 
 		if(_state.CycleCount > targetCycle) {
@@ -446,6 +449,10 @@ void Cx4::Serialize(Serializer &s)
 	SVArray(_prgRam[0], 256);
 	SVArray(_prgRam[1], 256);
 	SVArray(_dataRam, Cx4::DataRamSize);
+
+	if(!s.IsSaving()) {
+		DecodePrgRam();
+	}
 }
 
 uint8_t Cx4::Peek(uint32_t addr)
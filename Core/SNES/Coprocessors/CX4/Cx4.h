@@ -1,5 +1,7 @@
 #pragma once
 #include "pch.h"
+#include <array>
+#include <utility>
 #include "SNES/Coprocessors/BaseCoprocessor.h"
 #include "SNES/Coprocessors/CX4/Cx4Types.h"
 #include "SNES/MemoryMappings.h"
@@ -12,6 +14,16 @@ class SnesCpu;
 class Cx4 : public BaseCoprocessor
 {
 private:
+	typedef void(Cx4::*Func)(uint8_t param1, uint8_t param2);
+	static const std::array<Func, 0x40> _opTable;
+
+	struct Cx4DecodedOp
+	{
+		Func Exec;
+		uint8_t Param1;
+		uint8_t Param2;
+	};
+
 	static constexpr int DataRamSize = 0xC00;
 
 	Emulator *_emu;
@@ -23,9 +35,15 @@ private:
 
 	Cx4State _state;
 	uint16_t _prgRam[2][256];
+	//Decoded copy of _prgRam, updated as each program word is loaded into the cache
+	Cx4DecodedOp _decodedPrg[2][256];
 	uint8_t _dataRam[Cx4::DataRamSize];
 
-	void Exec(uint16_t opCode);
+	void Exec(Cx4DecodedOp op);
+	template<uint8_t op> void ExecOp(uint8_t param1, uint8_t param2);
+	template<size_t... i> static constexpr std::array<Func, 0x40> GetOpTable(std::index_sequence<i...>);
+	void DecodeOp(uint8_t page, uint8_t pos);
+	void DecodePrgRam();
 	void SwitchCachePage();
 	bool ProcessCache(uint64_t targetCycle);
 	void ProcessDma(uint64_t targetCycle);
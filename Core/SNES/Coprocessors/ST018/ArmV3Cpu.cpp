@@ -387,6 +387,7 @@ void ArmV3Cpu::ArmMrs()
 	SetR(rd, useSpsr ? GetSpsr().ToInt32() : _state.CPSR.ToInt32());
 }
 
+template<bool immediate, ArmAluOperation op, bool updateFlags>
 void ArmV3Cpu::ArmDataProcessing()
 {
 	//Data Processing
@@ -398,15 +399,14 @@ void ArmV3Cpu::ArmDataProcessing()
 	//d: destination reg
 	//p: 2nd operand
 
-	bool immediate = (_opCode & (1 << 25)) != 0;
+	//i, o and s are template parameters (they are part of the op table's index)
 	uint8_t rn = (_opCode >> 16) & 0x0F;
 	uint32_t op1 = R(rn);
 	uint8_t dstReg = (_opCode >> 12) & 0x0F;
-	bool updateFlags = (_opCode & (1 << 20)) != 0;
 
 	uint32_t op2;
 	bool carry = _state.CPSR.Carry;
-	if(immediate) {
+	if constexpr(immediate) {
 		uint8_t shift = (_opCode >> 8) & 0x0F;
 		op2 = (_opCode & 0xFF);
 		if(shift) {
@@ -442,7 +442,7 @@ void ArmV3Cpu::ArmDataProcessing()
 		}
 	}
 
-	switch((ArmAluOperation)((_opCode >> 21) & 0x0F)) {
+	switch(op) {
 		case ArmAluOperation::And: SetR(dstReg, LogicalOp(op1 & op2, carry, updateFlags)); break;
 		case ArmAluOperation::Eor: SetR(dstReg, LogicalOp(op1 ^ op2, carry, updateFlags)); break;
 		case ArmAluOperation::Sub: SetR(dstReg, Sub(op1, op2, true, updateFlags)); break;
@@ -554,6 +554,7 @@ void ArmV3Cpu::ArmMultiplyLong()
 	}
 }
 
+template<bool immediate, bool pre, bool up, bool byte, bool writeBack, bool load>
 void ArmV3Cpu::ArmSingleDataTransfer()
 {
 	//Single Data Transfer (LDR, STR)
@@ -567,12 +568,7 @@ void ArmV3Cpu::ArmSingleDataTransfer()
 	//n: base register
 	//d: src/dst register
 	//o: offset (immediate or register)
-	bool immediate = (_opCode & (1 << 25)) == 0;
-	bool pre = (_opCode & (1 << 24)) != 0;
-	bool up = (_opCode & (1 << 23)) != 0;
-	bool byte = (_opCode & (1 << 22)) != 0;
-	bool writeBack = (_opCode & (1 << 21)) != 0;
-	bool load = (_opCode & (1 << 20)) != 0;
+	//i, p, u, b, w and l are template parameters (they are part of the op table's index)
 	uint8_t rn = (_opCode >> 16) & 0x0F;
 	uint8_t rd = (_opCode >> 12) & 0x0F;
 
@@ -732,45 +728,18 @@ void ArmV3Cpu::ArmInvalidOp()
 #endif
 }
 
-bool ArmV3Cpu::CheckConditions(uint32_t condCode)
-{
-	/*Code Suffix Flags Meaning
-		0000 EQ Z set equal
-		0001 NE Z clear not equal
-		0010 CS C set unsigned higher or same
-		0011 CC C clear unsigned lower
-		0100 MI N set negative
-		0101 PL N clear positive or zero
-		0110 VS V set overflow
-		0111 VC V clear no overflow
-		1000 HI C set and Z clear unsigned higher
-		1001 LS C clear or Z set unsigned lower or same
-		1010 GE N equals V greater or equal
-		1011 LT N not equal to V less than
-		1100 GT Z clear AND(N equals V) greater than
-		1101 LE Z set OR(N not equal to V) less than or equal
-		1110 AL(ignored) always
-	*/
-	switch(condCode) {
-		case 0: return _state.CPSR.Zero;
-		case 1: return !_state.CPSR.Zero;
-		case 2: return _state.CPSR.Carry;
-		case 3: return !_state.CPSR.Carry;
-		case 4: return _state.CPSR.Negative;
-		case 5: return !_state.CPSR.Negative;
-		case 6: return _state.CPSR.Overflow;
-		case 7: return !_state.CPSR.Overflow;
-		case 8: return _state.CPSR.Carry && !_state.CPSR.Zero;
-		case 9: return !_state.CPSR.Carry || _state.CPSR.Zero;
-		case 10: return _state.CPSR.Negative == _state.CPSR.Overflow;
-		case 11: return _state.CPSR.Negative != _state.CPSR.Overflow;
-		case 12: return !_state.CPSR.Zero && (_state.CPSR.Negative == _state.CPSR.Overflow);
-		case 13: return _state.CPSR.Zero || (_state.CPSR.Negative != _state.CPSR.Overflow);
-		case 14: return true;
-		case 15: return false;
-	}
-
-	return true;
+template<size_t... i>
+void ArmV3Cpu::GetArmDataProcessingOps(Func* ops, std::index_sequence<i...>)
+{
+	//Index: bits 20-25 of the opcode (----_00io_ooos)
+	((ops[i] = &ArmV3Cpu::ArmDataProcessing<(i & 0x20) != 0, (ArmAluOperation)((i >> 1) & 0x0F), (i & 0x01) != 0>), ...);
+}
+
+template<size_t... i>
+void ArmV3Cpu::GetArmSingleDataTransferOps(Func* ops, std::index_sequence<i...>)
+{
+	//Index: bits 20-25 of the opcode (----_01ip_ubwl)
+	((ops[i] = &ArmV3Cpu::ArmSingleDataTransfer<(i & 0x20) == 0, (i & 0x10) != 0, (i & 0x08) != 0, (i & 0x04) != 0, (i & 0x02) != 0, (i & 0x01) != 0>), ...);
 }
 
 void ArmV3Cpu::InitArmOpTable()
@@ -784,6 +753,14 @@ void ArmV3Cpu::InitArmOpTable()
 		addEntry(i, &ArmV3Cpu::ArmInvalidOp, ArmOpCategory::InvalidOp);
 	}
 
+	//Data processing and single data transfer ops are specialized for each combination of the
+	//flags in the table index, so the handlers don't need to decode/branch on them at runtime
+	Func dataProcessingOps[0x40];
+	GetArmDataProcessingOps(dataProcessingOps, std::make_index_sequence<0x40>());
+
+	Func singleDataTransferOps[0x40];
+	GetArmSingleDataTransferOps(singleDataTransferOps, std::make_index_sequence<0x40>());
+
 	//Data Processing / PSR Transfer (MRS, MSR)
 	//----_00??_????_----_----_----_????_----
 	for(int i = 0; i <= 0x3FF; i++) {
@@ -796,7 +773,7 @@ void ArmV3Cpu::InitArmOpTable()
 				addEntry(0x000 | i, &ArmV3Cpu::ArmMrs, ArmOpCategory::Mrs);
 			}
 		} else {
-			addEntry(0x000 | i, &ArmV3Cpu::ArmDataProcessing, ArmOpCategory::DataProcessing);
+			addEntry(0x000 | i, dataProcessingOps[(i >> 4) & 0x3F], ArmOpCategory::DataProcessing);
 		}
 	}
 
@@ -809,7 +786,7 @@ void ArmV3Cpu::InitArmOpTable()
 	//Single Data Transfer (LDR, STR)
 	//----_01??_????_----_----_----_????_----
 	for(int i = 0; i <= 0x3FF; i++) {
-		addEntry(0x400 | i, &ArmV3Cpu::ArmSingleDataTransfer, ArmOpCategory::SingleDataTransfer);
+		addEntry(0x400 | i, singleDataTransferOps[(i >> 4) & 0x3F], ArmOpCategory::SingleDataTransfer);
 	}
 
 	//Block Data Transfer (LDM, STM)
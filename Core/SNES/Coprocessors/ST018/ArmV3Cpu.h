@@ -52,20 +52,61 @@ private:
 
 	ArmV3CpuFlags& GetSpsr();
 
+	template<size_t... i> static void GetArmDataProcessingOps(Func* ops, std::index_sequence<i...>);
+	template<size_t... i> static void GetArmSingleDataTransferOps(Func* ops, std::index_sequence<i...>);
 	static void InitArmOpTable();
 	void ArmBranch();
 	void ArmMsr();
 	void ArmMrs();
-	void ArmDataProcessing();
+	template<bool immediate, ArmAluOperation op, bool updateFlags> void ArmDataProcessing();
 	void ArmMultiply();
 	void ArmMultiplyLong();
-	void ArmSingleDataTransfer();
+	template<bool immediate, bool pre, bool up, bool byte, bool writeBack, bool load> void ArmSingleDataTransfer();
 	void ArmBlockDataTransfer();
 	void ArmSingleDataSwap();
 	void ArmSoftwareInterrupt();
 	void ArmInvalidOp();
 
-	bool CheckConditions(uint32_t condCode);
+	__forceinline bool CheckConditions(uint32_t condCode)
+	{
+		/*Code Suffix Flags Meaning
+		0000 EQ Z set equal
+		0001 NE Z clear not equal
+		0010 CS C set unsigned higher or same
+		0011 CC C clear unsigned lower
+		0100 MI N set negative
+		0101 PL N clear positive or zero
+		0110 VS V set overflow
+		0111 VC V clear no overflow
+		1000 HI C set and Z clear unsigned higher
+		1001 LS C clear or Z set unsigned lower or same
+		1010 GE N equals V greater or equal
+		1011 LT N not equal to V less than
+		1100 GT Z clear AND(N equals V) greater than
+		1101 LE Z set OR(N not equal to V) less than or equal
+		1110 AL(ignored) always
+		*/
+		switch(condCode) {
+			case 0: return _state.CPSR.Zero;
+			case 1: return !_state.CPSR.Zero;
+			case 2: return _state.CPSR.Carry;
+			case 3: return !_state.CPSR.Carry;
+			case 4: return _state.CPSR.Negative;
+			case 5: return !_state.CPSR.Negative;
+			case 6: return _state.CPSR.Overflow;
+			case 7: return !_state.CPSR.Overflow;
+			case 8: return _state.CPSR.Carry && !_state.CPSR.Zero;
+			case 9: return !_state.CPSR.Carry || _state.CPSR.Zero;
+			case 10: return _state.CPSR.Negative == _state.CPSR.Overflow;
+			case 11: return _state.CPSR.Negative != _state.CPSR.Overflow;
+			case 12: return !_state.CPSR.Zero && (_state.CPSR.Negative == _state.CPSR.Overflow);
+			case 13: return _state.CPSR.Zero || (_state.CPSR.Negative != _state.CPSR.Overflow);
+			case 14: return true;
+			case 15: return false;
+		}
+
+		return true;
+	}
 
 	void SwitchMode(ArmV3CpuMode mode);
 
@@ -126,7 +126,7 @@ void Cx4Debugger::ProcessWrite(uint32_t addr, uint8_t value, MemoryOperationType
 	MemoryOperationInfo operation(addr, value, type, MemoryType::Cx4Memory);
 	InstructionProgress.LastMemOperation = operation;
 	_debugger->ProcessBreakConditions(CpuType::Cx4, *_step.get(), _breakpointManager.get(), operation, addressInfo);
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetMasterClock(), CpuType::Cx4);
 	if(_traceLogger->IsEnabled()) {
 		_traceLogger->LogNonExec(operation, addressInfo);
 	}
@@ -111,7 +111,7 @@ void GsuDebugger::ProcessWrite(uint32_t addr, uint8_t value, MemoryOperationType
 	}
 
 	_disassembler->InvalidateCache(addressInfo, CpuType::Gsu);
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetMasterClock(), CpuType::Gsu);
 }
 
 void GsuDebugger::Run()
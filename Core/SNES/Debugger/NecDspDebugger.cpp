@@ -109,7 +109,7 @@ void NecDspDebugger::ProcessWrite(uint32_t addr, uint8_t value, MemoryOperationT
 	MemoryOperationInfo operation(addr, value, type, MemoryType::DspDataRam);
 	InstructionProgress.LastMemOperation = operation;
 	_debugger->ProcessBreakConditions(CpuType::NecDsp, *_step.get(), _breakpointManager.get(), operation, addressInfo);
-	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetMasterClock(), CpuType::NecDsp);
 	if(_traceLogger->IsEnabled()) {
 		_traceLogger->LogNonExec(operation, addressInfo);
 	}
@@ -46,7 +46,7 @@ void SnesEventManager::AddEvent(DebugEventType type, MemoryOperationInfo &operat
 
 	evt.ProgramCounter = _debugger->GetProgramCounter(CpuType::Snes, true);
 
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void SnesEventManager::AddEvent(DebugEventType type)
@@ -60,7 +60,7 @@ void SnesEventManager::AddEvent(DebugEventType type)
 	
 	evt.ProgramCounter = (_cpu->GetState().K << 16) | _cpu->GetState().PC;
 
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 DebugEventInfo SnesEventManager::GetEvent(uint16_t y, uint16_t x)
@@ -177,8 +177,7 @@ uint32_t SnesEventManager::TakeEventSnapshot(bool forAutoRefresh)
 		memcpy(_ppuBuffer+offset, _ppu->GetPreviousScreenBuffer()+offset, (size - offset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
+	TakeFrameSnapshot();
 	_snapshotScanline = scanline;
 	_snapshotCycle = cycle;
 	_forAutoRefresh = forAutoRefresh;
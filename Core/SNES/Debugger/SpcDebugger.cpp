@@ -163,7 +163,7 @@ void SpcDebugger::ProcessWrite(uint32_t addr, uint8_t value, MemoryOperationType
 	if constexpr(flags == MemoryAccessFlags::None) {
 		//SPC write
 		_debugger->ProcessBreakConditions(CpuType::Spc, *_step.get(), _breakpointManager.get(), operation, addressInfo);
-		_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetMasterClock());
+		_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetMasterClock(), CpuType::Spc);
 
 		if(_traceLogger->IsEnabled()) {
 			_traceLogger->LogNonExec(operation, addressInfo);
@@ -172,7 +172,7 @@ void SpcDebugger::ProcessWrite(uint32_t addr, uint8_t value, MemoryOperationType
 		//DSP write
 		if(!_ignoreDspReadWrites) {
 			_debugger->ProcessBreakConditions(CpuType::Spc, *_step.get(), _breakpointManager.get(), operation, addressInfo);
-			_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetMasterClock());
+			_memoryAccessCounter->ProcessMemoryWrite(addressInfo, _memoryManager->GetMasterClock(), CpuType::Spc);
 		}
 	}
 }
@@ -157,7 +157,7 @@ void St018Debugger::ProcessWrite(uint32_t addr, uint32_t value, MemoryOperationT
 		_traceLogger->LogNonExec(operation, addressInfo);
 	}
 
-	_memoryAccessCounter->ProcessMemoryWrite<accessWidth>(addressInfo, _console->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite<accessWidth>(addressInfo, _console->GetMasterClock(), CpuType::St018);
 }
 
 void St018Debugger::Run()
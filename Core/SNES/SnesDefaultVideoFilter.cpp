@@ -6,6 +6,7 @@
 #include "Shared/EmuSettings.h"
 #include "Shared/SettingTypes.h"
 #include "Shared/ColorUtilities.h"
+#include "Shared/Video/VideoFilterKernels.h"
 
 SnesDefaultVideoFilter::SnesDefaultVideoFilter(Emulator* emu) : BaseVideoFilter(emu)
 {
@@ -60,6 +61,8 @@ void SnesDefaultVideoFilter::InitLookupTable()
 		}
 	}
 
+	//Without color adjustments, the colors can be converted directly instead of using the lookup table
+	_isRgb555Palette = VideoFilterKernels::IsRgb555Palette(_calculatedPalette);
 	_videoConfig = config;
 }
 
@@ -89,38 +92,31 @@ void SnesDefaultVideoFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 	uint32_t width = _baseFrameInfo.Width;
 	uint32_t xOffset = overscan.Left;
 	uint32_t yOffset = overscan.Top * width;
+	const uint32_t* palette = _isRgb555Palette ? nullptr : _calculatedPalette;
 
 	if(_baseFrameInfo.Width == 256 && _forceFixedRes) {
-		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			for(uint32_t j = 0; j < frameInfo.Width; j++) {
-				out[i * frameInfo.Width + j] = GetPixel(ppuOutputBuffer, i / 2 * width + j / 2 + yOffset + xOffset);
+		//Each source row is converted once, doubled horizontally, and copied to the next output row
+		uint32_t rowBuffer[256];
+		uint32_t srcWidth = frameInfo.Width / 2;
+		for(uint32_t i = 0; i < frameInfo.Height; i += 2) {
+			uint32_t* dst = out + i * frameInfo.Width;
+			VideoFilterKernels::ConvertRow(rowBuffer, ppuOutputBuffer + i / 2 * width + yOffset + xOffset, nullptr, palette, 0x7FFF, srcWidth);
+			VideoFilterKernels::DoublePixels(dst, rowBuffer, srcWidth);
+			if(i + 1 < frameInfo.Height) {
+				memcpy(dst + frameInfo.Width, dst, frameInfo.Width * sizeof(uint32_t));
 			}
 		}
 	} else {
 		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			for(uint32_t j = 0; j < frameInfo.Width; j++) {
-				out[i*frameInfo.Width+j] = GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset);
-			}
+			VideoFilterKernels::ConvertRow(out + i * frameInfo.Width, ppuOutputBuffer + i * width + yOffset + xOffset, nullptr, palette, 0x7FFF, frameInfo.Width);
 		}
 	}
 
 	if(_baseFrameInfo.Width == 512 && _blendHighRes) {
-		//Very basic blend effect for high resolution modes
-		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			for(uint32_t j = 0; j < frameInfo.Width; j++) {
-				uint32_t &pixel1 = out[i*frameInfo.Width + j];
-				pixel1 = BlendPixels(pixel1, out[i * frameInfo.Width + j + 1]);
-			}
+		//Very basic blend effect for high resolution modes - each pixel is blended with the next one (the rows are contiguous)
+		uint32_t pixelCount = frameInfo.Width * frameInfo.Height;
+		if(pixelCount > 0) {
+			VideoFilterKernels::BlendPixels(out, out, out + 1, pixelCount - 1);
 		}
 	}
 }
-
-uint32_t SnesDefaultVideoFilter::GetPixel(uint16_t* ppuFrame, uint32_t offset)
-{
-	return _calculatedPalette[ppuFrame[offset]];
-}
-
-uint32_t SnesDefaultVideoFilter::BlendPixels(uint32_t a, uint32_t b)
-{
-	return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
-}
@@ -8,6 +8,7 @@ class SnesDefaultVideoFilter : public BaseVideoFilter
 {
 private:
 	uint32_t _calculatedPalette[0x8000] = {};
+	bool _isRgb555Palette = false;
 	VideoConfig _videoConfig = {};
 
 	bool _blendHighRes = false;
@@ -15,9 +16,6 @@ private:
 
 	void InitLookupTable();
 
-	__forceinline static uint32_t BlendPixels(uint32_t a, uint32_t b);
-	__forceinline uint32_t GetPixel(uint16_t* ppuFrame, uint32_t offset);
-
 protected:
 	void OnBeforeApplyFilter() override;
 	FrameInfo GetFrameInfo() override;
@@ -58,14 +58,22 @@ void SnesNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 	uint32_t xOffset = overscan.Left;
 	uint32_t yOffset = overscan.Top/2 * baseWidth;
 
+	//Rows are filtered independently, each band starts with the burst phase the row would have in a single pass
+	int burstPhase = IsOddFrame() ? 0 : 1;
+	uint32_t rowWidth = _baseFrameInfo.Width;
+
 	if(useHighResOutput) {
-		snes_ntsc_blit_hires(&_ntscData, ppuOutputBuffer, _baseFrameInfo.Width, IsOddFrame() ? 0 : 1, _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, baseWidth * 4);
+		RunRows(_baseFrameInfo.Height, [&](uint32_t startRow, uint32_t endRow) {
+			snes_ntsc_blit_hires(&_ntscData, ppuOutputBuffer + startRow * rowWidth, rowWidth, (burstPhase + startRow) % snes_ntsc_burst_count, rowWidth, endRow - startRow, _ntscBuffer + startRow * baseWidth, baseWidth * 4);
+		});
 		
 		for(uint32_t i = 0; i < frameInfo.Height; i++) {
 			memcpy(GetOutputBuffer() + i * frameInfo.Width, _ntscBuffer + yOffset*2 + xOffset + i * baseWidth, frameInfo.Width * sizeof(uint32_t));
 		}
 	} else {
-		snes_ntsc_blit(&_ntscData, ppuOutputBuffer, _baseFrameInfo.Width, IsOddFrame() ? 0 : 1, _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, baseWidth * 4);
+		RunRows(_baseFrameInfo.Height, [&](uint32_t startRow, uint32_t endRow) {
+			snes_ntsc_blit(&_ntscData, ppuOutputBuffer + startRow * rowWidth, rowWidth, (burstPhase + startRow) % snes_ntsc_burst_count, rowWidth, endRow - startRow, _ntscBuffer + startRow * baseWidth, baseWidth * 4);
+		});
 
 		for(uint32_t i = 0; i < frameInfo.Height; i += 2) {
 			memcpy(GetOutputBuffer() + i * frameInfo.Width, _ntscBuffer + yOffset + xOffset + i / 2 * baseWidth, frameInfo.Width * sizeof(uint32_t));
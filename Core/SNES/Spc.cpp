@@ -213,6 +213,24 @@ uint8_t Spc::DebugRead(uint16_t addr)
 	}
 }
 
+void Spc::DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length)
+{
+	uint32_t end = std::min<uint32_t>(addr + length, 0x10000);
+	while(addr < end) {
+		uint32_t pageEnd = std::min<uint32_t>((addr & 0xFF00) + 0x100, end);
+		if(addr < 0x100 || addr >= 0xFF00) {
+			//The first page contains the registers and the last one can be mapped to the IPL ROM
+			for(; addr < pageEnd; addr++) {
+				*(dest++) = DebugRead(addr);
+			}
+		} else {
+			memcpy(dest, _ram + addr, pageEnd - addr);
+			dest += pageEnd - addr;
+			addr = pageEnd;
+		}
+	}
+}
+
 void Spc::DebugWrite(uint16_t addr, uint8_t value)
 {
 	_ram[addr] = value;
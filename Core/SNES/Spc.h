@@ -298,6 +298,7 @@ public:
 	void Reset();
 
 	uint8_t DebugRead(uint16_t addr);
+	void DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length);
 	void DebugWrite(uint16_t addr, uint8_t value);
 
 	void DebugWriteDspReg(uint8_t addr, uint8_t value);
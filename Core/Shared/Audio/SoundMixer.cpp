@@ -6,6 +6,7 @@
 #include "Shared/Audio/SoundResampler.h"
 #include "Shared/RewindManager.h"
 #include "Shared/Interfaces/IAudioProvider.h"
+#include "Shared/AvStreamWriter.h"
 #include "Utilities/Audio/Equalizer.h"
 #include "Utilities/Audio/ReverbFilter.h"
 #include "Utilities/Audio/CrossFeedFilter.h"
@@ -70,6 +71,18 @@ void SoundMixer::PlayAudioBuffer(int16_t* samples, uint32_t sampleCount, uint32_
 	}
 
 	EmuSettings* settings = _emu->GetSettings();
+	if(settings->CheckFlag(EmulationFlags::TestMode)) {
+		//No audio output in test mode, skip resampling and mixing
+		//Audio providers still need to consume their samples, otherwise their buffers keep growing
+		uint32_t sampleRate = settings->GetAudioConfig().SampleRate;
+		uint32_t count = (uint32_t)std::min<uint64_t>((uint64_t)sampleCount * sampleRate / sourceRate, 0x10000 / 2);
+		memset(_sampleBuffer, 0, count * 2 * sizeof(int16_t));
+		for(IAudioProvider* provider : _audioProviders) {
+			provider->MixAudio(_sampleBuffer, count, sampleRate);
+		}
+		return;
+	}
+
 	AudioPlayerHud* audioPlayer = _emu->GetAudioPlayerHud();
 	AudioConfig cfg = settings->GetAudioConfig();
 	uint32_t masterVolume = audioPlayer ? audioPlayer->GetVolume() : cfg.MasterVolume;
@@ -123,6 +136,10 @@ void SoundMixer::PlayAudioBuffer(int16_t* samples, uint32_t sampleCount, uint32_
 
 	RewindManager* rewindManager = _emu->GetRewindManager();
 	if(!_emu->IsRunAheadFrame() && rewindManager && rewindManager->SendAudio(out, count)) {
+		if(_streamWriter) {
+			_streamWriter->AddAudio(out, count, cfg.SampleRate);
+		}
+
 		//Only send the audio to the device if the emulation is running
 		//(this is to prevent playing an audio blip when loading a save state)
 		if(!_emu->IsPaused() && _audioDevice) {
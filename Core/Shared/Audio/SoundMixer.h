@@ -10,6 +10,7 @@ class SoundResampler;
 class IAudioProvider;
 class CrossFeedFilter;
 class ReverbFilter;
+class AvStreamWriter;
 
 class SoundMixer 
 {
@@ -30,6 +31,8 @@ private:
 	unique_ptr<CrossFeedFilter> _crossFeedFilter;
 	unique_ptr<ReverbFilter> _reverbFilter;
 
+	AvStreamWriter* _streamWriter = nullptr;
+
 	void ProcessEqualizer(int16_t *samples, uint32_t sampleCount, uint32_t targetRate);
 
 public:
@@ -40,6 +43,7 @@ public:
 	void StopAudio(bool clearBuffer = false);
 
 	void RegisterAudioDevice(IAudioDevice *audioDevice);
+	void SetStreamWriter(AvStreamWriter* writer) { _streamWriter = writer; }
 
 	void RegisterAudioProvider(IAudioProvider* provider);
 	void UnregisterAudioProvider(IAudioProvider* provider);
@@ -0,0 +1,287 @@
+#include "pch.h"
+#include "Shared/AvStreamWriter.h"
+
+AvStreamWriter::AvStreamWriter()
+{
+	_audio.resize(AudioBufferSize);
+}
+
+AvStreamWriter::~AvStreamWriter()
+{
+	Stop();
+}
+
+bool AvStreamWriter::Start(const string& videoPath, const string& audioPath, double fps, bool backPressure)
+{
+	Stop();
+
+	if(!videoPath.empty()) {
+		_videoFile = fopen(videoPath.c_str(), "wb");
+		if(!_videoFile) {
+			return false;
+		}
+		string ext = videoPath.size() > 4 ? videoPath.substr(videoPath.size() - 4) : "";
+		std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+		_rawVideo = ext != ".y4m";
+	}
+
+	if(!audioPath.empty()) {
+		_audioFile = fopen(audioPath.c_str(), "wb");
+		if(!_audioFile) {
+			if(_videoFile) {
+				fclose(_videoFile);
+				_videoFile = nullptr;
+			}
+			return false;
+		}
+	}
+
+	_fps = fps > 0 ? fps : 60.0;
+	_backPressure = backPressure;
+	_stop = false;
+	_frameRead = _frameWrite = 0;
+	_audioRead = _audioWrite = 0;
+	_width = _height = 0;
+	_sampleRate = 0;
+	_droppedFrames = _droppedSamples = 0;
+	_headerWritten = false;
+	_wavHeaderWritten = false;
+	_audioByteCount = 0;
+
+	_thread = std::thread(&AvStreamWriter::WriterLoop, this);
+	return true;
+}
+
+void AvStreamWriter::Stop()
+{
+	if(!_thread.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_dataSignal.notify_all();
+	_spaceSignal.notify_all();
+
+	//The writer thread flushes everything that was queued before exiting
+	_thread.join();
+
+	if(_videoFile) {
+		fclose(_videoFile);
+		_videoFile = nullptr;
+	}
+
+	if(_audioFile) {
+		if(_wavHeaderWritten && fseek(_audioFile, 0, SEEK_SET) == 0) {
+			//Regular file, the header can be updated with the actual data size (not possible for pipes)
+			WriteWavHeader((uint32_t)std::min<uint64_t>(_audioByteCount, 0xFFFFFFFF - 36));
+		}
+		fclose(_audioFile);
+		_audioFile = nullptr;
+	}
+}
+
+void AvStreamWriter::AddFrame(const uint32_t* argb, uint32_t width, uint32_t height)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	if(!_videoFile || _stop || width == 0 || height == 0) {
+		return;
+	}
+
+	if(_width == 0) {
+		//The stream's size is set by the first frame, the pool is allocated once
+		_width = width;
+		_height = height;
+		for(vector<uint32_t>& frame : _frames) {
+			frame.resize(width * height);
+		}
+	}
+
+	if(_frameWrite - _frameRead >= FramePoolSize) {
+		if(!_backPressure) {
+			_droppedFrames++;
+			return;
+		}
+		_spaceSignal.wait(lock, [this] { return _stop || _frameWrite - _frameRead < FramePoolSize; });
+		if(_stop) {
+			return;
+		}
+	}
+
+	//The writer thread doesn't touch this slot until _frameWrite is incremented
+	uint32_t* dst = _frames[_frameWrite % FramePoolSize].data();
+	lock.unlock();
+
+	if(width == _width && height == _height) {
+		memcpy(dst, argb, width * height * sizeof(uint32_t));
+	} else {
+		//e.g SNES switching between 256 and 512 pixels wide modes
+		for(uint32_t y = 0; y < _height; y++) {
+			const uint32_t* srcRow = argb + (y * height / _height) * width;
+			for(uint32_t x = 0; x < _width; x++) {
+				dst[y * _width + x] = srcRow[x * width / _width];
+			}
+		}
+	}
+
+	lock.lock();
+	_frameWrite++;
+	lock.unlock();
+	_dataSignal.notify_one();
+}
+
+void AvStreamWriter::AddAudio(const int16_t* samples, uint32_t sampleCount, uint32_t sampleRate)
+{
+	uint32_t count = std::min<uint32_t>(sampleCount * 2, AudioBufferSize);
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	if(!_audioFile || _stop || count == 0) {
+		return;
+	}
+
+	if(_sampleRate == 0) {
+		_sampleRate = sampleRate;
+	}
+
+	if(AudioBufferSize - (_audioWrite - _audioRead) < count) {
+		if(!_backPressure) {
+			_droppedSamples += count / 2;
+			return;
+		}
+		_spaceSignal.wait(lock, [this, count] { return _stop || AudioBufferSize - (_audioWrite - _audioRead) >= count; });
+		if(_stop) {
+			return;
+		}
+	}
+
+	uint32_t start = _audioWrite & (AudioBufferSize - 1);
+	lock.unlock();
+
+	uint32_t firstPart = std::min(count, AudioBufferSize - start);
+	memcpy(_audio.data() + start, samples, firstPart * sizeof(int16_t));
+	memcpy(_audio.data(), samples + firstPart, (count - firstPart) * sizeof(int16_t));
+
+	lock.lock();
+	_audioWrite += count;
+	lock.unlock();
+	_dataSignal.notify_one();
+}
+
+void AvStreamWriter::WriterLoop()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while(true) {
+		_dataSignal.wait(lock, [this] { return _stop || _frameRead != _frameWrite || _audioRead != _audioWrite; });
+
+		if(_frameRead == _frameWrite && _audioRead == _audioWrite) {
+			//Stop requested and everything has been written
+			break;
+		}
+
+		uint32_t frameRead = _frameRead;
+		uint32_t frameWrite = _frameWrite;
+		uint32_t audioRead = _audioRead;
+		uint32_t audioWrite = _audioWrite;
+		lock.unlock();
+
+		while(audioRead != audioWrite) {
+			uint32_t start = audioRead & (AudioBufferSize - 1);
+			uint32_t count = std::min(audioWrite - audioRead, AudioBufferSize - start);
+			WriteAudio(_audio.data() + start, count);
+			audioRead += count;
+		}
+
+		if(frameRead != frameWrite) {
+			//Release each slot as soon as it's written, the decoder may be waiting for one
+			WriteFrame(_frames[frameRead % FramePoolSize].data());
+			frameRead++;
+		}
+
+		lock.lock();
+		_frameRead = frameRead;
+		_audioRead = audioRead;
+		_spaceSignal.notify_all();
+	}
+}
+
+void AvStreamWriter::ConvertToYuv444(const uint32_t* argb, uint32_t pixelCount, uint8_t* y, uint8_t* u, uint8_t* v)
+{
+	//BT.601, limited range (the Y4M default)
+	for(uint32_t i = 0; i < pixelCount; i++) {
+		int r = (argb[i] >> 16) & 0xFF;
+		int g = (argb[i] >> 8) & 0xFF;
+		int b = argb[i] & 0xFF;
+		y[i] = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+		u[i] = (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+		v[i] = (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+	}
+}
+
+void AvStreamWriter::WriteFrame(const uint32_t* argb)
+{
+	uint32_t pixelCount = _width * _height;
+	if(_rawVideo) {
+		_outputBuffer.resize(pixelCount * 4);
+		uint8_t* out = _outputBuffer.data();
+		for(uint32_t i = 0; i < pixelCount; i++) {
+			out[i * 4] = (argb[i] >> 16) & 0xFF;
+			out[i * 4 + 1] = (argb[i] >> 8) & 0xFF;
+			out[i * 4 + 2] = argb[i] & 0xFF;
+			out[i * 4 + 3] = 0xFF;
+		}
+	} else {
+		if(!_headerWritten) {
+			uint32_t fpsNumerator = (uint32_t)std::round(_fps * 1000);
+			fprintf(_videoFile, "YUV4MPEG2 W%u H%u F%u:1000 Ip A1:1 C444\n", _width, _height, fpsNumerator);
+			_headerWritten = true;
+		}
+
+		_outputBuffer.resize(pixelCount * 3);
+		uint8_t* out = _outputBuffer.data();
+		ConvertToYuv444(argb, pixelCount, out, out + pixelCount, out + pixelCount * 2);
+		fputs("FRAME\n", _videoFile);
+	}
+
+	fwrite(_outputBuffer.data(), 1, _outputBuffer.size(), _videoFile);
+	fflush(_videoFile);
+}
+
+void AvStreamWriter::WriteWavHeader(uint32_t dataSize)
+{
+	auto write32 = [this](uint32_t value) {
+		uint8_t bytes[4] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+		fwrite(bytes, 1, 4, _audioFile);
+	};
+	auto write16 = [this](uint16_t value) {
+		uint8_t bytes[2] = { (uint8_t)value, (uint8_t)(value >> 8) };
+		fwrite(bytes, 1, 2, _audioFile);
+	};
+
+	fwrite("RIFF", 1, 4, _audioFile);
+	write32(dataSize + 36);
+	fwrite("WAVEfmt ", 1, 8, _audioFile);
+	write32(16); //fmt chunk size
+	write16(1); //PCM
+	write16(2); //Stereo
+	write32(_sampleRate);
+	write32(_sampleRate * 4); //Byte rate
+	write16(4); //Block align
+	write16(16); //Bits per sample
+	fwrite("data", 1, 4, _audioFile);
+	write32(dataSize);
+}
+
+void AvStreamWriter::WriteAudio(const int16_t* samples, uint32_t count)
+{
+	if(!_wavHeaderWritten) {
+		//The length isn't known in advance, readers treat the maximum size as "until the end of the stream"
+		WriteWavHeader(0xFFFFFFFF - 36);
+		_wavHeaderWritten = true;
+	}
+
+	fwrite(samples, sizeof(int16_t), count, _audioFile);
+	fflush(_audioFile);
+	_audioByteCount += count * sizeof(int16_t);
+}
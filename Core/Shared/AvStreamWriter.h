@@ -0,0 +1,74 @@
+#pragma once
+#include "pch.h"
+#include <condition_variable>
+#include <mutex>
+
+//Streams the decoded frames (Y4M or raw RGBA) and the mixed audio (WAV) to files or FIFOs, e.g for an external ffmpeg.
+//Frames and samples are copied into preallocated buffers and written by a dedicated thread, the emulation only
+//waits for the writer when back-pressure is enabled - otherwise data that doesn't fit in the buffers is dropped.
+class AvStreamWriter
+{
+public:
+	static constexpr uint32_t FramePoolSize = 8;
+	static constexpr uint32_t AudioBufferSize = 0x40000; //int16 samples (~2.7 seconds of 48kHz stereo)
+
+private:
+	FILE* _videoFile = nullptr;
+	FILE* _audioFile = nullptr;
+	bool _rawVideo = false;
+	double _fps = 60.0;
+	bool _backPressure = false;
+
+	std::thread _thread;
+	std::mutex _mutex;
+	std::condition_variable _dataSignal;
+	std::condition_variable _spaceSignal;
+	bool _stop = false;
+
+	//Frame pool - ring buffer, slots [_frameRead, _frameWrite) are waiting to be written
+	vector<uint32_t> _frames[FramePoolSize];
+	uint32_t _frameRead = 0;
+	uint32_t _frameWrite = 0;
+	uint32_t _width = 0;
+	uint32_t _height = 0;
+
+	//Audio ring buffer, same scheme as the frame pool
+	vector<int16_t> _audio;
+	uint32_t _audioRead = 0;
+	uint32_t _audioWrite = 0;
+	uint32_t _sampleRate = 0;
+
+	uint32_t _droppedFrames = 0;
+	uint32_t _droppedSamples = 0;
+
+	//Only used by the writer thread
+	vector<uint8_t> _outputBuffer;
+	bool _headerWritten = false;
+	bool _wavHeaderWritten = false;
+	uint64_t _audioByteCount = 0;
+
+	void WriterLoop();
+	void WriteFrame(const uint32_t* argb);
+	void WriteAudio(const int16_t* samples, uint32_t count);
+	void WriteWavHeader(uint32_t dataSize);
+
+public:
+	AvStreamWriter();
+	~AvStreamWriter();
+
+	//Either path can be empty. Video is written as Y4M when the file name ends with .y4m, raw RGBA otherwise.
+	//Opening a FIFO blocks until the reader opens it.
+	bool Start(const string& videoPath, const string& audioPath, double fps, bool backPressure);
+	void Stop();
+
+	//Called by the video decoder thread, frames with another size than the first one are scaled to its size
+	void AddFrame(const uint32_t* argb, uint32_t width, uint32_t height);
+
+	//Called by the emulation thread with interleaved stereo samples
+	void AddAudio(const int16_t* samples, uint32_t sampleCount, uint32_t sampleRate);
+
+	uint32_t GetDroppedFrames() { return _droppedFrames; }
+	uint32_t GetDroppedSamples() { return _droppedSamples; }
+
+	static void ConvertToYuv444(const uint32_t* argb, uint32_t pixelCount, uint8_t* y, uint8_t* u, uint8_t* v);
+};
@@ -131,6 +131,28 @@ void BaseControlDevice::SetTextState(string textState)
 	}
 }
 
+bool BaseControlDevice::SetBitState(const MousePosition* pos, const uint8_t* bits, uint32_t bitCount)
+{
+	if(IsRawString() || (pos && !HasCoordinates())) {
+		//SetTextState would treat the text as raw data or read the coordinates as keys
+		return false;
+	}
+
+	auto lock = _stateLock.AcquireSafe();
+	ClearState();
+
+	if(pos) {
+		SetCoordinates(*pos);
+	}
+
+	for(uint32_t i = 0; i < bitCount; i++) {
+		if(bits[i >> 3] & (1 << (i & 0x07))) {
+			SetBit((uint8_t)i);
+		}
+	}
+	return true;
+}
+
 string BaseControlDevice::GetTextState()
 {
 	auto lock = _stateLock.AcquireSafe();
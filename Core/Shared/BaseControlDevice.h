@@ -87,6 +87,11 @@ public:
 	virtual void SetTextState(string state);
 	virtual string GetTextState();
 
+	//Sets the same state as SetTextState, without building/parsing the text (used by movie playback).
+	//pos is null when the text state has no coordinates, bit i is set when the i-th key (colons excluded) is pressed.
+	//Returns false when the text state must be used instead.
+	virtual bool SetBitState(const MousePosition* pos, const uint8_t* bits, uint32_t bitCount);
+
 	void SetStateFromInput();
 	virtual void OnAfterSetState() { }
 	
@@ -123,6 +123,12 @@ public:
 		UpdateStateFromPorts();
 	}
 
+	bool SetBitState(const MousePosition* pos, const uint8_t* bits, uint32_t bitCount) override
+	{
+		//The keys of each port are only separated by colons in the text state
+		return false;
+	}
+
 	string GetTextState() override
 	{
 		auto lock = _stateLock.AcquireSafe();
@@ -137,6 +137,7 @@ void Emulator::Run()
 		}
 
 		ProcessAutoSaveState();
+		_movieManager->ProcessEndOfFrame();
 
 		WaitForLock();
 
@@ -528,7 +529,11 @@ bool Emulator::InternalLoadRom(VirtualFile romFile, VirtualFile patchFile, bool
 
 	if(stopRom) {
 		_stopFlag = false;
-		_emuThread.reset(new thread(&Emulator::Run, this));
+		MessageLog* log = MessageManager::GetThreadLog();
+		_emuThread.reset(new thread([this, log]() {
+			MessageManager::SetThreadLog(log);
+			Run();
+		}));
 	}
 
 	return true;
@@ -56,6 +56,7 @@ std::unordered_map<string, string> MessageManager::_enResources = {
 	{ "UnsupportedMapper", u8"Unsupported mapper (%1), cannot load game." },
 };
 
+thread_local MessageLog* MessageManager::_threadLog = nullptr;
 std::list<string> MessageManager::_log;
 SimpleLock MessageManager::_logLock;
 SimpleLock MessageManager::_messageLock;
@@ -145,10 +146,16 @@ void MessageManager::DisplayMessage(string title, string message, string param1,
 
 void MessageManager::Log(string message)
 {
-	auto lock = _logLock.AcquireSafe();
 	if(message.empty()) {
 		message = "------------------------------------------------------";
 	}
+
+	if(_threadLog) {
+		_threadLog->Add(message);
+		return;
+	}
+
+	auto lock = _logLock.AcquireSafe();
 	if(_log.size() >= 1000) {
 		_log.pop_front();
 	}
@@ -159,6 +166,16 @@ void MessageManager::Log(string message)
 	}
 }
 
+void MessageManager::SetThreadLog(MessageLog* log)
+{
+	_threadLog = log;
+}
+
+MessageLog* MessageManager::GetThreadLog()
+{
+	return _threadLog;
+}
+
 void MessageManager::ClearLog()
 {
 	auto lock = _logLock.AcquireSafe();
@@ -174,3 +191,22 @@ string MessageManager::GetLog()
 	}
 	return ss.str();
 }
+
+void MessageLog::Add(string message)
+{
+	auto lock = _lock.AcquireSafe();
+	if(_messages.size() >= 1000) {
+		_messages.pop_front();
+	}
+	_messages.push_back(message);
+}
+
+string MessageLog::Get()
+{
+	auto lock = _lock.AcquireSafe();
+	stringstream ss;
+	for(string& msg : _messages) {
+		ss << msg << "\n";
+	}
+	return ss.str();
+}
@@ -14,9 +14,22 @@
 	#define LogDebugIf(cond, msg)
 #endif
 
+//Log kept apart from the global one, used to separate the output of emulators running side by side
+class MessageLog
+{
+private:
+	SimpleLock _lock;
+	std::list<string> _messages;
+
+public:
+	void Add(string message);
+	string Get();
+};
+
 class MessageManager
 {
 private:
+	thread_local static MessageLog* _threadLog;
 	static IMessageManager* _messageManager;
 	static std::unordered_map<string, string> _enResources;
 
@@ -36,6 +49,11 @@ public:
 	static void DisplayMessage(string title, string message, string param1 = "", string param2 = "");
 
 	static void Log(string message = "");
+
+	//Messages logged by the calling thread go to this log instead of the global one (nullptr to restore)
+	//The emulation thread of an emulator inherits the log of the thread that loaded the game
+	static void SetThreadLog(MessageLog* log);
+	static MessageLog* GetThreadLog();
 	static void ClearLog();
 	static string GetLog();
 };
@@ -12,6 +12,7 @@
 #include "Shared/BatteryManager.h"
 #include "Shared/CheatManager.h"
 #include "Utilities/ZipReader.h"
+#include "Utilities/ZipWriter.h"
 #include "Utilities/StringUtilities.h"
 #include "Utilities/HexUtilities.h"
 #include "Utilities/VirtualFile.h"
@@ -19,10 +20,11 @@
 #include "Utilities/Serializer.h"
 #include "Shared/SettingTypes.h"
 
-MesenMovie::MesenMovie(Emulator* emu, bool forTest)
+MesenMovie::MesenMovie(Emulator* emu, bool forTest, MoviePlaybackOptions options)
 {
 	_emu = emu;
 	_forTest = forTest;
+	_options = options;
 }
 
 MesenMovie::~MesenMovie()
@@ -33,7 +35,11 @@ MesenMovie::~MesenMovie()
 void MesenMovie::Stop()
 {
 	if(_playing) {
-		bool isEndOfMovie = _lastPollCounter >= _inputData.size();
+		bool isEndOfMovie = _lastPollCounter >= GetInputFrameCount();
+
+		if(isEndOfMovie && !_options.ConvertTo.empty()) {
+			SaveConvertedMovie();
+		}
 
 		if(!_forTest) {
 			MessageManager::DisplayMessage("Movies", isEndOfMovie ? "MovieEnded" : "MovieStopped");
@@ -69,11 +75,29 @@ bool MesenMovie::SetInput(BaseControlDevice *device)
 		_deviceIndex = 0;
 	}
 
-	if(_inputData.size() > inputRowIndex && _inputData[inputRowIndex].size() > _deviceIndex) {
-		device->SetTextState(_inputData[inputRowIndex][_deviceIndex]);
+	size_t deviceCount = 0;
+	if(_useTrack) {
+		if(inputRowIndex < _track.GetFrameCount()) {
+			deviceCount = _track.GetPortCount();
+			if(_deviceIndex < deviceCount) {
+				MovieInputTrack::PortState state = _track.GetPortState(inputRowIndex, (uint32_t)_deviceIndex);
+				MousePosition pos = { state.X, state.Y };
+				if(!device->SetBitState(state.HasCoordinates ? &pos : nullptr, state.Bits, state.BitCount)) {
+					_track.GetTextState(inputRowIndex, (uint32_t)_deviceIndex, _textState);
+					device->SetTextState(_textState);
+				}
+			}
+		}
+	} else if(_inputData.size() > inputRowIndex) {
+		deviceCount = _inputData[inputRowIndex].size();
+		if(_deviceIndex < deviceCount) {
+			device->SetTextState(_inputData[inputRowIndex][_deviceIndex]);
+		}
+	}
 
+	if(_deviceIndex < deviceCount) {
 		_deviceIndex++;
-		if(_deviceIndex >= _inputData[inputRowIndex].size()) {
+		if(_deviceIndex >= deviceCount) {
 			//Move to the next frame's data
 			_deviceIndex = 0;
 		}
@@ -89,6 +113,86 @@ bool MesenMovie::IsPlaying()
 	return _playing;
 }
 
+uint32_t MesenMovie::GetInputFrameCount()
+{
+	return _useTrack ? _track.GetFrameCount() : (uint32_t)_inputData.size();
+}
+
+void MesenMovie::ProcessEndOfFrame()
+{
+	//Called by the emulation thread between frames, where save states can be taken
+	BaseControlManager* controlManager = _controlManager;
+	if(!_playing || _options.ConvertTo.empty() || !controlManager) {
+		return;
+	}
+
+	uint32_t frame = controlManager->GetPollCounter();
+	if(frame >= _nextKeyframe && frame < _track.GetFrameCount()) {
+		stringstream state;
+		_emu->GetSaveStateManager()->SaveState(state);
+		_keyframeStates.push_back({ frame, state.str() });
+		_nextKeyframe = frame + std::max<uint32_t>(_options.KeyframeInterval, 1);
+	}
+}
+
+void MesenMovie::SeekToKeyframe(uint32_t frame)
+{
+	int64_t keyframe = _useTrack && _romMatches ? _track.FindKeyframe(frame) : -1;
+
+	stringstream stateData;
+	if(keyframe <= 0 || !_reader->GetStream(MovieInputTrack::GetKeyframeName((uint32_t)keyframe), stateData)) {
+		MessageManager::Log("[Movie] No keyframe before frame " + std::to_string(frame) + ", playing from the start");
+		return;
+	}
+
+	if(_emu->GetSaveStateManager()->LoadState(stateData)) {
+		_controlManager->SetPollCounter((uint32_t)keyframe);
+		_lastPollCounter = (uint32_t)keyframe;
+		MessageManager::Log("[Movie] Starting from keyframe at frame " + std::to_string(keyframe));
+	} else {
+		MessageManager::Log("[Movie] Could not load keyframe at frame " + std::to_string(keyframe) + ", playing from the start");
+	}
+}
+
+bool MesenMovie::SaveConvertedMovie()
+{
+	ZipWriter writer;
+	if(!writer.Initialize(_options.ConvertTo)) {
+		MessageManager::Log("[Movie] Could not write to file: " + _options.ConvertTo);
+		return false;
+	}
+
+	//Copy everything else as-is - Input.txt is kept for builds that can't read the binary track
+	for(string& filename : _reader->GetFileList()) {
+		if(filename == MovieInputTrack::FileName || filename.rfind("Keyframes/", 0) == 0) {
+			continue;
+		}
+		vector<uint8_t> fileData;
+		if(_reader->ExtractFile(filename, fileData)) {
+			writer.AddFile(fileData, filename);
+		}
+	}
+
+	_track.ClearKeyframes();
+	for(auto& keyframe : _keyframeStates) {
+		_track.AddKeyframe(keyframe.first);
+		stringstream stateData(keyframe.second);
+		writer.AddFile(stateData, MovieInputTrack::GetKeyframeName(keyframe.first));
+	}
+
+	vector<uint8_t> trackData;
+	_track.Save(trackData);
+	writer.AddFile(trackData, MovieInputTrack::FileName);
+
+	if(!writer.Save()) {
+		MessageManager::Log("[Movie] Could not write to file: " + _options.ConvertTo);
+		return false;
+	}
+
+	MessageManager::Log("[Movie] Converted " + std::to_string(_track.GetFrameCount()) + " frames, " + std::to_string(_keyframeStates.size()) + " keyframes: " + _options.ConvertTo);
+	return true;
+}
+
 vector<uint8_t> MesenMovie::LoadBattery(string extension)
 {
 	vector<uint8_t> batteryData;
@@ -117,24 +221,15 @@ bool MesenMovie::Play(VirtualFile &file)
 	_reader.reset(new ZipReader());
 	_reader->LoadArchive(ss);
 
-	stringstream settingsData, inputData;
+	stringstream settingsData;
 	if(!_reader->GetStream("GameSettings.txt", settingsData)) {
 		MessageManager::Log("[Movie] File not found: GameSettings.txt");
 		return false;
 	}
-	if(!_reader->GetStream("Input.txt", inputData)) {
-		MessageManager::Log("[Movie] File not found: Input.txt");
+	if(!LoadInput()) {
 		return false;
 	}
 
-	while(inputData) {
-		string line;
-		std::getline(inputData, line);
-		if(line.substr(0, 1) == "|") {
-			_inputData.push_back(StringUtilities::Split(line.substr(1), '|'));
-		}
-	}
-
 	_deviceIndex = 0;
 
 	ParseSettings(settingsData);
@@ -171,12 +266,13 @@ bool MesenMovie::Play(VirtualFile &file)
 
 	LoadCheats();
 
+	string movieSha1 = LoadString(_settings, MovieKeys::Sha1);
+	string romSha1 = _emu->GetHash(HashType::Sha1);
+	_romMatches = movieSha1.empty() || romSha1.empty() || movieSha1 == romSha1;
+
 	stringstream saveStateData;
 	if(_reader->GetStream("SaveState.mss", saveStateData)) {
-		string movieSha1 = LoadString(_settings, MovieKeys::Sha1);
-		string romSha1 = _emu->GetHash(HashType::Sha1);
-
-		if(!movieSha1.empty() && !romSha1.empty() && movieSha1 != romSha1) {
+		if(!_romMatches) {
 			//ROM doesn't match movie — skip save state, force deterministic RAM
 			MessageManager::Log("[Movie] ROM SHA1 mismatch, skipping save state (movie: " + movieSha1 + ", rom: " + romSha1 + ")");
 			_emu->GetSettings()->GetSnesConfig().RamPowerOnState = RamState::AllZeros;
@@ -194,11 +290,54 @@ bool MesenMovie::Play(VirtualFile &file)
 
 	_controlManager->UpdateControlDevices();
 	_controlManager->SetPollCounter(0);
+	if(_options.StartFrame > 0) {
+		SeekToKeyframe(_options.StartFrame);
+	}
+	_nextKeyframe = std::max<uint32_t>(_options.KeyframeInterval, 1);
 	_playing = true;
 
 	return true;
 }
 
+bool MesenMovie::LoadInput()
+{
+	vector<uint8_t> trackData;
+	if(_reader->CheckFile(MovieInputTrack::FileName) && _reader->ExtractFile(MovieInputTrack::FileName, trackData)) {
+		if(!_track.Load(trackData)) {
+			MessageManager::Log("[Movie] Invalid input track: " + string(MovieInputTrack::FileName));
+			return false;
+		}
+		_useTrack = true;
+		return true;
+	}
+
+	stringstream inputData;
+	if(!_reader->GetStream("Input.txt", inputData)) {
+		MessageManager::Log("[Movie] File not found: Input.txt");
+		return false;
+	}
+
+	vector<vector<string>> rows;
+	while(inputData) {
+		string line;
+		std::getline(inputData, line);
+		if(line.substr(0, 1) == "|") {
+			rows.push_back(StringUtilities::Split(line.substr(1), '|'));
+		}
+	}
+
+	//Keep the text only when the input can't be stored as fixed-width rows (e.g raw string devices)
+	_useTrack = _track.FromText(rows);
+	if(!_useTrack) {
+		if(!_options.ConvertTo.empty()) {
+			MessageManager::Log("[Movie] This movie's input can't be converted to a binary input track");
+			return false;
+		}
+		_inputData = std::move(rows);
+	}
+	return true;
+}
+
 template<typename T>
 T FromString(string name, const vector<string> &enumNames, T defaultValue)
 {
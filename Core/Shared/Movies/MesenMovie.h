@@ -5,6 +5,7 @@
 #include "Shared/BatteryManager.h"
 #include "Shared/Interfaces/INotificationListener.h"
 #include "Shared/Movies/MovieManager.h"
+#include "Shared/Movies/MovieInputTrack.h"
 
 class ZipReader;
 class Emulator;
@@ -24,6 +25,13 @@ private:
 	size_t _deviceIndex = 0;
 	uint32_t _lastPollCounter = 0;
 	vector<vector<string>> _inputData;
+	MovieInputTrack _track;
+	bool _useTrack = false;
+	string _textState;
+	MoviePlaybackOptions _options;
+	bool _romMatches = true;
+	uint32_t _nextKeyframe = 0;
+	vector<std::pair<uint32_t, string>> _keyframeStates;
 	vector<string> _cheats;
 	vector<CheatCode> _originalCheats;
 	stringstream _emuSettingsBackup;
@@ -42,8 +50,13 @@ private:
 	void LoadCheats();
 	bool LoadCheat(string cheatData, CheatCode &code);
 
+	bool LoadInput();
+	uint32_t GetInputFrameCount();
+	void SeekToKeyframe(uint32_t frame);
+	bool SaveConvertedMovie();
+
 public:
-	MesenMovie(Emulator* emu, bool silent);
+	MesenMovie(Emulator* emu, bool silent, MoviePlaybackOptions options = {});
 	virtual ~MesenMovie();
 
 	bool Play(VirtualFile &file) override;
@@ -51,6 +64,7 @@ public:
 
 	bool SetInput(BaseControlDevice* device) override;
 	bool IsPlaying() override;
+	void ProcessEndOfFrame() override;
 
 	//Inherited via IBatteryProvider
 	vector<uint8_t> LoadBattery(string extension) override;
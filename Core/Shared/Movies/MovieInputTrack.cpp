@@ -0,0 +1,287 @@
+#include "pch.h"
+#include "Shared/Movies/MovieInputTrack.h"
+
+static bool ParseCoordinate(const string& text, int16_t& value)
+{
+	//Only accept the exact format written by GetTextState, so that the text can be rebuilt as-is
+	try {
+		long result = std::stol(text);
+		if(result < INT16_MIN || result > INT16_MAX || std::to_string(result) != text) {
+			return false;
+		}
+		value = (int16_t)result;
+		return true;
+	} catch(std::exception&) {
+		return false;
+	}
+}
+
+bool MovieInputTrack::InitPort(Port& port, const string& text)
+{
+	size_t keyStart = 0;
+	port.HasCoordinates = text.find(' ') != string::npos;
+	if(port.HasCoordinates) {
+		size_t secondSpace = text.find(' ', text.find(' ') + 1);
+		if(secondSpace == string::npos) {
+			return false;
+		}
+		keyStart = secondSpace + 1;
+	}
+
+	port.KeyNames = text.substr(keyStart);
+	port.BitCount = 0;
+	for(char c : port.KeyNames) {
+		if(c != ':') {
+			port.BitCount++;
+		}
+	}
+	return true;
+}
+
+bool MovieInputTrack::EncodePort(Port& port, const string& text, uint8_t* dst)
+{
+	size_t keyStart = 0;
+	if(port.HasCoordinates) {
+		size_t firstSpace = text.find(' ');
+		size_t secondSpace = firstSpace == string::npos ? string::npos : text.find(' ', firstSpace + 1);
+		int16_t x, y;
+		if(secondSpace == string::npos || !ParseCoordinate(text.substr(0, firstSpace), x) || !ParseCoordinate(text.substr(firstSpace + 1, secondSpace - firstSpace - 1), y)) {
+			return false;
+		}
+		dst[0] = (uint8_t)x;
+		dst[1] = (uint8_t)((uint16_t)x >> 8);
+		dst[2] = (uint8_t)y;
+		dst[3] = (uint8_t)((uint16_t)y >> 8);
+		dst += 4;
+		keyStart = secondSpace + 1;
+	}
+
+	if(text.size() - keyStart != port.KeyNames.size() || text.find(' ', keyStart) != string::npos) {
+		return false;
+	}
+
+	uint32_t bit = 0;
+	for(size_t i = 0; i < port.KeyNames.size(); i++) {
+		char c = text[keyStart + i];
+		char& keyName = port.KeyNames[i];
+		if(c == ':' || keyName == ':') {
+			if(c != keyName) {
+				return false;
+			}
+			continue;
+		}
+
+		if(c != '.') {
+			if(keyName == '.') {
+				//First time this button is pressed in the movie
+				keyName = c;
+			} else if(keyName != c) {
+				return false;
+			}
+			dst[bit >> 3] |= 1 << (bit & 0x07);
+		}
+		bit++;
+	}
+	return true;
+}
+
+void MovieInputTrack::UpdateLayout()
+{
+	_frameSize = 0;
+	for(Port& port : _ports) {
+		port.Offset = _frameSize;
+		_frameSize += (port.HasCoordinates ? 4 : 0) + (port.BitCount + 7) / 8;
+	}
+}
+
+bool MovieInputTrack::FromText(const vector<vector<string>>& rows)
+{
+	_ports.clear();
+	_data.clear();
+	_keyframes.clear();
+	_frameCount = 0;
+	_frameSize = 0;
+
+	if(rows.empty()) {
+		return true;
+	}
+
+	_ports.resize(rows[0].size());
+	for(size_t i = 0; i < _ports.size(); i++) {
+		if(!InitPort(_ports[i], rows[0][i])) {
+			_ports.clear();
+			return false;
+		}
+	}
+	UpdateLayout();
+
+	_data.resize(rows.size() * _frameSize);
+	for(size_t row = 0; row < rows.size(); row++) {
+		bool valid = rows[row].size() == _ports.size();
+		for(size_t i = 0; valid && i < _ports.size(); i++) {
+			valid = EncodePort(_ports[i], rows[row][i], _data.data() + row * _frameSize + _ports[i].Offset);
+		}
+
+		if(!valid) {
+			_ports.clear();
+			_data.clear();
+			_frameSize = 0;
+			return false;
+		}
+	}
+
+	_frameCount = (uint32_t)rows.size();
+	return true;
+}
+
+void MovieInputTrack::GetTextState(uint32_t frame, uint32_t port, string& out)
+{
+	Port& p = _ports[port];
+	const uint8_t* src = _data.data() + (size_t)frame * _frameSize + p.Offset;
+
+	out.clear();
+	if(p.HasCoordinates) {
+		int16_t x = (int16_t)(src[0] | (src[1] << 8));
+		int16_t y = (int16_t)(src[2] | (src[3] << 8));
+		out += std::to_string(x) + " " + std::to_string(y) + " ";
+		src += 4;
+	}
+
+	uint32_t bit = 0;
+	for(char keyName : p.KeyNames) {
+		if(keyName == ':') {
+			out += ':';
+		} else {
+			out += (src[bit >> 3] & (1 << (bit & 0x07))) ? keyName : '.';
+			bit++;
+		}
+	}
+}
+
+MovieInputTrack::PortState MovieInputTrack::GetPortState(uint32_t frame, uint32_t port)
+{
+	Port& p = _ports[port];
+	const uint8_t* src = _data.data() + (size_t)frame * _frameSize + p.Offset;
+
+	PortState state = {};
+	state.HasCoordinates = p.HasCoordinates;
+	if(p.HasCoordinates) {
+		state.X = (int16_t)(src[0] | (src[1] << 8));
+		state.Y = (int16_t)(src[2] | (src[3] << 8));
+		src += 4;
+	}
+	state.Bits = src;
+	state.BitCount = p.BitCount;
+	return state;
+}
+
+void MovieInputTrack::AddKeyframe(uint32_t frame)
+{
+	auto result = std::lower_bound(_keyframes.begin(), _keyframes.end(), frame);
+	if(result == _keyframes.end() || *result != frame) {
+		_keyframes.insert(result, frame);
+	}
+}
+
+int64_t MovieInputTrack::FindKeyframe(uint32_t frame)
+{
+	auto result = std::upper_bound(_keyframes.begin(), _keyframes.end(), frame);
+	if(result == _keyframes.begin()) {
+		return -1;
+	}
+	return *(result - 1);
+}
+
+void MovieInputTrack::Save(vector<uint8_t>& out)
+{
+	auto write32 = [&out](uint32_t value) {
+		out.insert(out.end(), { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) });
+	};
+
+	out.clear();
+	out.insert(out.end(), { 'M', 'M', 'I', 'B' });
+	write32(MovieInputTrack::FormatVersion);
+	write32((uint32_t)_ports.size());
+	write32(_frameCount);
+	write32((uint32_t)_keyframes.size());
+
+	for(Port& port : _ports) {
+		out.push_back(port.HasCoordinates ? 1 : 0);
+		write32((uint32_t)port.KeyNames.size());
+		out.insert(out.end(), port.KeyNames.begin(), port.KeyNames.end());
+	}
+
+	for(uint32_t frame : _keyframes) {
+		write32(frame);
+	}
+
+	out.insert(out.end(), _data.begin(), _data.end());
+}
+
+bool MovieInputTrack::Load(const vector<uint8_t>& data)
+{
+	size_t pos = 0;
+	auto read32 = [&data, &pos](uint32_t& value) {
+		if(pos + 4 > data.size()) {
+			return false;
+		}
+		value = data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16) | ((uint32_t)data[pos + 3] << 24);
+		pos += 4;
+		return true;
+	};
+
+	_ports.clear();
+	_data.clear();
+	_keyframes.clear();
+	_frameCount = 0;
+	_frameSize = 0;
+
+	uint32_t version, portCount, frameCount, keyframeCount;
+	if(data.size() < 4 || memcmp(data.data(), "MMIB", 4) != 0) {
+		return false;
+	}
+	pos = 4;
+	if(!read32(version) || version > MovieInputTrack::FormatVersion || !read32(portCount) || !read32(frameCount) || !read32(keyframeCount)) {
+		return false;
+	}
+
+	//Sizes are checked against the remaining data before allocating anything
+	if(portCount > data.size() - pos || keyframeCount > (data.size() - pos) / 4) {
+		return false;
+	}
+
+	vector<Port> ports(portCount);
+	for(Port& port : ports) {
+		uint32_t length;
+		if(pos >= data.size()) {
+			return false;
+		}
+		port.HasCoordinates = data[pos++] != 0;
+		if(!read32(length) || length > data.size() - pos) {
+			return false;
+		}
+		port.KeyNames.assign((const char*)data.data() + pos, length);
+		pos += length;
+		port.BitCount = (uint32_t)std::count_if(port.KeyNames.begin(), port.KeyNames.end(), [](char c) { return c != ':'; });
+	}
+
+	vector<uint32_t> keyframes(keyframeCount);
+	for(uint32_t& frame : keyframes) {
+		if(!read32(frame)) {
+			return false;
+		}
+	}
+
+	_ports = std::move(ports);
+	UpdateLayout();
+	if((uint64_t)frameCount * _frameSize != data.size() - pos || !std::is_sorted(keyframes.begin(), keyframes.end())) {
+		_ports.clear();
+		_frameSize = 0;
+		return false;
+	}
+
+	_data.assign(data.begin() + pos, data.end());
+	_keyframes = std::move(keyframes);
+	_frameCount = frameCount;
+	return true;
+}
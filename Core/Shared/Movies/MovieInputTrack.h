@@ -0,0 +1,69 @@
+#pragma once
+#include "pch.h"
+
+//Binary version of a movie's Input.txt, stored as Input.bin in the .mmo archive.
+//Each port's text state is reduced to a fixed-width bitfield (plus 16-bit X/Y coordinates for pointer devices),
+//so every input row has the same size and a row is read by indexing into the table. The key names seen in the
+//text are kept per port, which allows the exact text state to be rebuilt for the device.
+//The file also contains the index of the save state keyframes stored in the archive (Keyframes/<row>.mss),
+//each keyframe being the state at the end of the frame after which input row <row> is the next one to be read.
+class MovieInputTrack
+{
+public:
+	static constexpr uint32_t FormatVersion = 1;
+	static constexpr const char* FileName = "Input.bin";
+
+	struct PortState
+	{
+		bool HasCoordinates;
+		int16_t X;
+		int16_t Y;
+		const uint8_t* Bits; //Bit i is set when the i-th key of the text state (colons excluded) is pressed
+		uint32_t BitCount;
+	};
+
+private:
+	struct Port
+	{
+		string KeyNames; //Name of each bit, colons are kept as-is (used by hubs to separate their ports)
+		bool HasCoordinates = false;
+		uint32_t BitCount = 0;
+		uint32_t Offset = 0;
+	};
+
+	vector<Port> _ports;
+	uint32_t _frameSize = 0;
+	uint32_t _frameCount = 0;
+	vector<uint8_t> _data;
+	vector<uint32_t> _keyframes;
+
+	bool InitPort(Port& port, const string& text);
+	bool EncodePort(Port& port, const string& text, uint8_t* dst);
+	void UpdateLayout();
+
+public:
+	//Fails when a column can't be stored as a fixed-width bitfield (e.g barcode readers, which use raw strings)
+	bool FromText(const vector<vector<string>>& rows);
+
+	bool Load(const vector<uint8_t>& data);
+	void Save(vector<uint8_t>& out);
+
+	uint32_t GetFrameCount() { return _frameCount; }
+	uint32_t GetPortCount() { return (uint32_t)_ports.size(); }
+	uint32_t GetFrameSize() { return _frameSize; }
+
+	//Rebuilds the text state of a port (same format as BaseControlDevice::GetTextState)
+	void GetTextState(uint32_t frame, uint32_t port, string& out);
+
+	//Binary state of a port, points into the track's data (see BaseControlDevice::SetBitState)
+	PortState GetPortState(uint32_t frame, uint32_t port);
+
+	void AddKeyframe(uint32_t frame);
+	void ClearKeyframes() { _keyframes.clear(); }
+	const vector<uint32_t>& GetKeyframes() { return _keyframes; }
+
+	//Returns the last keyframe at or before the given row, -1 if there is none
+	int64_t FindKeyframe(uint32_t frame);
+
+	static string GetKeyframeName(uint32_t frame) { return "Keyframes/" + std::to_string(frame) + ".mss"; }
+};
@@ -24,7 +24,7 @@ void MovieManager::Record(RecordMovieOptions options)
 	}
 }
 
-void MovieManager::Play(VirtualFile file, bool forTest)
+void MovieManager::Play(VirtualFile file, bool forTest, MoviePlaybackOptions options)
 {
 	vector<uint8_t> fileData;
 	if(file.IsValid() && file.ReadFile(fileData)) {
@@ -36,7 +36,7 @@ void MovieManager::Play(VirtualFile file, bool forTest)
 
 			vector<string> files = reader.GetFileList();
 			if(std::find(files.begin(), files.end(), "GameSettings.txt") != files.end()) {
-				player.reset(new MesenMovie(_emu, forTest));
+				player.reset(new MesenMovie(_emu, forTest, options));
 			}
 		}
 
@@ -62,6 +62,14 @@ void MovieManager::Stop()
 	_recorder.reset();
 }
 
+void MovieManager::ProcessEndOfFrame()
+{
+	shared_ptr<IMovie> player = _player.lock();
+	if(player) {
+		player->ProcessEndOfFrame();
+	}
+}
+
 bool MovieManager::Playing()
 {
 	return _player != nullptr;
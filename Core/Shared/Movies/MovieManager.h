@@ -17,6 +17,7 @@ public:
 	virtual bool Play(VirtualFile& file) = 0;
 	virtual void Stop() = 0;
 	virtual bool IsPlaying() = 0;
+	virtual void ProcessEndOfFrame() {}
 };
 
 class MovieManager
@@ -30,8 +31,9 @@ public:
 	MovieManager(Emulator* emu);
 
 	void Record(RecordMovieOptions options);
-	void Play(VirtualFile file, bool silent = false);
+	void Play(VirtualFile file, bool silent = false, MoviePlaybackOptions options = {});
 	void Stop();
+	void ProcessEndOfFrame();
 	bool Playing();
 	bool Recording();
 };
@@ -17,6 +17,16 @@ struct RecordMovieOptions
 	RecordMovieFrom RecordFrom = RecordMovieFrom::StartWithoutSaveData;
 };
 
+struct MoviePlaybackOptions
+{
+	//Input frame to start from - playback resumes from the last keyframe before it (requires keyframes, see MovieInputTrack)
+	uint32_t StartFrame = 0;
+
+	//When set, the movie is played to the end and saved to this file with a binary input track and keyframes
+	string ConvertTo;
+	uint32_t KeyframeInterval = 600;
+};
+
 namespace MovieKeys
 {
 	constexpr const char* MesenVersion = "MesenVersion";
@@ -144,6 +144,7 @@ void RewindManager::AddHistoryBlock()
 		}
 		_currentHistory = RewindData();
 		_currentHistory.SaveState(_emu, _history);
+		_keyframeCount++;
 	}
 }
 
@@ -51,6 +51,8 @@ private:
 	deque<RewindData> _historyBackup;
 	RewindData _currentHistory = {};
 
+	uint32_t _keyframeCount = 0;
+
 	RewindState _rewindState = RewindState::Stopped;
 	int32_t _framesToFastForward = 0;
 
@@ -95,6 +97,9 @@ public:
 	deque<RewindData> GetHistory();
 	RewindStats GetStats();
 
+	//Incremented each time a new save state (keyframe) is added to the history
+	uint32_t GetKeyframeCount() { return _keyframeCount; }
+
 	void SendFrame(RenderedFrame& frame, bool forRewind);
 	bool SendAudio(int16_t *soundBuffer, uint32_t sampleCount);
 };
\ No newline at end of file
@@ -10,7 +10,7 @@ enum class EmulationFlags
 	MaximumSpeed = 0x04,
 	InBackground = 0x08,
 	ConsoleMode = 0x10,
-	TestMode = 0x20,
+	TestMode = 0x20, //Frames aren't decoded and audio isn't mixed (emulation only)
 	OutputToStdout = 0x40,
 };
 
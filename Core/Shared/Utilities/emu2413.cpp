@@ -886,24 +886,28 @@ static INLINE void calc_envelope(OPLL_SLOT *slot, OPLL_SLOT *buddy, uint16_t eg_
   }
 }
 
+static INLINE void update_slot(OPLL *opll, int i, uint16_t eg_counter, uint32_t pm_phase) {
+  OPLL_SLOT *slot = &opll->slot[i];
+  OPLL_SLOT *buddy = NULL;
+  if (slot->type == 0) {
+    buddy = &opll->slot[i + 1];
+  }
+  if (slot->type == 1) {
+    buddy = &opll->slot[i - 1];
+  }
+  if (slot->update_requests) {
+    commit_slot_update(slot);
+  }
+  calc_envelope(slot, buddy, eg_counter, opll->test_flag & 1);
+  calc_phase(slot, pm_phase, opll->test_flag & 4);
+}
+
 static void update_slots(OPLL *opll) {
   int i;
   opll->eg_counter++;
 
   for (i = 0; i < 18; i++) {
-    OPLL_SLOT *slot = &opll->slot[i];
-    OPLL_SLOT *buddy = NULL;
-    if (slot->type == 0) {
-      buddy = &opll->slot[i + 1];
-    }
-    if (slot->type == 1) {
-      buddy = &opll->slot[i - 1];
-    }
-    if (slot->update_requests) {
-      commit_slot_update(slot);
-    }
-    calc_envelope(slot, buddy, opll->eg_counter, opll->test_flag & 1);
-    calc_phase(slot, opll->pm_phase, opll->test_flag & 4);
+    update_slot(opll, i, opll->eg_counter, opll->pm_phase);
   }
 }
 
@@ -924,10 +928,10 @@ static INLINE int16_t to_linear(uint16_t h, OPLL_SLOT *slot, int16_t am) {
   return lookup_exp_table(h + att);
 }
 
-static INLINE int16_t calc_slot_car(OPLL *opll, int ch, int16_t fm) {
+static INLINE int16_t calc_slot_car(OPLL *opll, int ch, int16_t fm, uint8_t lfo_am) {
   OPLL_SLOT *slot = CAR(opll, ch);
 
-  uint8_t am = slot->patch->AM ? opll->lfo_am : 0;
+  uint8_t am = slot->patch->AM ? lfo_am : 0;
 
   slot->output[1] = slot->output[0];
   slot->output[0] = to_linear(slot->wave_table[(slot->pg_out + 2 * (fm >> 1)) & (PG_WIDTH - 1)], slot, am);
@@ -935,11 +939,11 @@ static INLINE int16_t calc_slot_car(OPLL *opll, int ch, int16_t fm) {
   return slot->output[0];
 }
 
-static INLINE int16_t calc_slot_mod(OPLL *opll, int ch) {
+static INLINE int16_t calc_slot_mod(OPLL *opll, int ch, uint8_t lfo_am) {
   OPLL_SLOT *slot = MOD(opll, ch);
 
   int16_t fm = slot->patch->FB > 0 ? (slot->output[1] + slot->output[0]) >> (9 - slot->patch->FB) : 0;
-  uint8_t am = slot->patch->AM ? opll->lfo_am : 0;
+  uint8_t am = slot->patch->AM ? lfo_am : 0;
 
   slot->output[1] = slot->output[0];
   slot->output[0] = to_linear(slot->wave_table[(slot->pg_out + fm) & (PG_WIDTH - 1)], slot, am);
@@ -993,6 +997,53 @@ static INLINE int16_t calc_slot_hat(OPLL *opll) {
 #define _MO(x) (-(x) >> 1)
 #define _RO(x) (x)
 
+/* CH7-9 (or the rhythm sounds), YM2413 only */
+static void update_upper_channels(OPLL *opll) {
+  int16_t *out = opll->ch_out;
+
+  /* CH7 */
+  if (!opll->rhythm_mode) {
+    if (!(opll->mask & OPLL_MASK_CH(6))) {
+      out[6] = _MO(calc_slot_car(opll, 6, calc_slot_mod(opll, 6, opll->lfo_am), opll->lfo_am));
+    }
+  } else {
+    if (!(opll->mask & OPLL_MASK_BD)) {
+      out[9] = _RO(calc_slot_car(opll, 6, calc_slot_mod(opll, 6, opll->lfo_am), opll->lfo_am));
+    }
+  }
+  update_noise(opll, 14);
+
+  /* CH8 */
+  if (!opll->rhythm_mode) {
+    if (!(opll->mask & OPLL_MASK_CH(7))) {
+      out[7] = _MO(calc_slot_car(opll, 7, calc_slot_mod(opll, 7, opll->lfo_am), opll->lfo_am));
+    }
+  } else {
+    if (!(opll->mask & OPLL_MASK_HH)) {
+      out[10] = _RO(calc_slot_hat(opll));
+    }
+    if (!(opll->mask & OPLL_MASK_SD)) {
+      out[11] = _RO(calc_slot_snare(opll));
+    }
+  }
+  update_noise(opll, 2);
+
+  /* CH9 */
+  if (!opll->rhythm_mode) {
+    if (!(opll->mask & OPLL_MASK_CH(8))) {
+      out[8] = _MO(calc_slot_car(opll, 8, calc_slot_mod(opll, 8, opll->lfo_am), opll->lfo_am));
+    }
+  } else {
+    if (!(opll->mask & OPLL_MASK_TOM)) {
+      out[12] = _RO(calc_slot_tom(opll));
+    }
+    if (!(opll->mask & OPLL_MASK_CYM)) {
+      out[13] = _RO(calc_slot_cym(opll));
+    }
+  }
+  update_noise(opll, 2);
+}
+
 static void update_output(OPLL *opll) {
   int16_t *out;
   int i;
@@ -1008,52 +1059,12 @@ static void update_output(OPLL *opll) {
   /* CH1-6 */
   for (i = 0; i < 6; i++) {
     if (!(opll->mask & OPLL_MASK_CH(i))) {
-      out[i] = _MO(calc_slot_car(opll, i, calc_slot_mod(opll, i)));
+      out[i] = _MO(calc_slot_car(opll, i, calc_slot_mod(opll, i, opll->lfo_am), opll->lfo_am));
     }
   }
 
   if(opll->chip_type == 0) {
-    /* CH7 */
-    if (!opll->rhythm_mode) {
-      if (!(opll->mask & OPLL_MASK_CH(6))) {
-        out[6] = _MO(calc_slot_car(opll, 6, calc_slot_mod(opll, 6)));
-      }
-    } else {
-      if (!(opll->mask & OPLL_MASK_BD)) {
-        out[9] = _RO(calc_slot_car(opll, 6, calc_slot_mod(opll, 6)));
-      }
-    }
-    update_noise(opll, 14);
-
-    /* CH8 */
-    if (!opll->rhythm_mode) {
-      if (!(opll->mask & OPLL_MASK_CH(7))) {
-        out[7] = _MO(calc_slot_car(opll, 7, calc_slot_mod(opll, 7)));
-      }
-    } else {
-      if (!(opll->mask & OPLL_MASK_HH)) {
-        out[10] = _RO(calc_slot_hat(opll));
-      }
-      if (!(opll->mask & OPLL_MASK_SD)) {
-        out[11] = _RO(calc_slot_snare(opll));
-      }
-    }
-    update_noise(opll, 2);
-   
-    /* CH9 */
-    if (!opll->rhythm_mode) {
-      if (!(opll->mask & OPLL_MASK_CH(8))) {
-        out[8] = _MO(calc_slot_car(opll, 8, calc_slot_mod(opll, 8)));
-      }
-    } else {
-      if (!(opll->mask & OPLL_MASK_TOM)) {
-        out[12] = _RO(calc_slot_tom(opll));
-      }
-      if (!(opll->mask & OPLL_MASK_CYM)) {
-        out[13] = _RO(calc_slot_cym(opll));
-      }
-    }
-    update_noise(opll, 2);
+    update_upper_channels(opll);
   }
 }
 
@@ -1092,6 +1103,77 @@ INLINE static void mix_output_stereo(OPLL *opll) {
   }
 }
 
+/* Max number of internal samples rendered by render_block */
+#define OPLL_BLOCK_SIZE 256
+
+/*
+ * Same result as calling update_output() and mix_output() count times (without rate conversion).
+ * CH1-6 don't depend on each other, so each of them is rendered over the whole block with the
+ * per-sample LFO/envelope counters, and the channels are then summed in a loop that can be vectorized.
+ */
+static void render_block(OPLL *opll, int16_t *mix, int count) {
+  int16_t ch_buf[14][OPLL_BLOCK_SIZE];
+  uint32_t eg_counter[OPLL_BLOCK_SIZE];
+  uint32_t pm_phase[OPLL_BLOCK_SIZE];
+  uint8_t lfo_am[OPLL_BLOCK_SIZE];
+  const int ch_count = opll->chip_type == 0 ? 14 : 6;
+  int i, n;
+
+  /* LFO, envelope counter, noise and CH7-9 (slots 12-17) are updated sample by sample */
+  for (n = 0; n < count; n++) {
+    update_ampm(opll);
+    if (opll->chip_type == 0) {
+      update_short_noise(opll);
+    }
+    opll->eg_counter++;
+    eg_counter[n] = opll->eg_counter;
+    pm_phase[n] = opll->pm_phase;
+    lfo_am[n] = opll->lfo_am;
+
+    for (i = 12; i < 18; i++) {
+      update_slot(opll, i, opll->eg_counter, opll->pm_phase);
+    }
+    if (opll->chip_type == 0) {
+      update_upper_channels(opll);
+    }
+    for (i = 6; i < ch_count; i++) {
+      ch_buf[i][n] = opll->ch_out[i];
+    }
+  }
+
+  /* CH1-6 */
+  for (i = 0; i < 6; i++) {
+    int16_t *out = ch_buf[i];
+    if (opll->mask & OPLL_MASK_CH(i)) {
+      /* Muted channels keep their last output */
+      for (n = 0; n < count; n++) {
+        update_slot(opll, i << 1, eg_counter[n], pm_phase[n]);
+        update_slot(opll, (i << 1) | 1, eg_counter[n], pm_phase[n]);
+        out[n] = opll->ch_out[i];
+      }
+    } else {
+      for (n = 0; n < count; n++) {
+        update_slot(opll, i << 1, eg_counter[n], pm_phase[n]);
+        update_slot(opll, (i << 1) | 1, eg_counter[n], pm_phase[n]);
+        out[n] = _MO(calc_slot_car(opll, i, calc_slot_mod(opll, i, lfo_am[n]), lfo_am[n]));
+      }
+      opll->ch_out[i] = out[count - 1];
+    }
+  }
+
+  /* 16-bit sum, wraps around like mix_output */
+  for (n = 0; n < count; n++) {
+    mix[n] = ch_buf[0][n];
+  }
+  for (i = 1; i < ch_count; i++) {
+    const int16_t *in = ch_buf[i];
+    for (n = 0; n < count; n++) {
+      mix[n] = (int16_t)(mix[n] + in[n]);
+    }
+  }
+  opll->mix_out[0] = mix[count - 1];
+}
+
 /***********************************************************
 
                    External Interfaces
@@ -1488,6 +1570,59 @@ int16_t OPLL_calc(OPLL *opll) {
   return opll->mix_out[0];
 }
 
+void OPLL_calcBlock(OPLL *opll, int16_t *out, uint32_t count) {
+  int16_t mix[OPLL_BLOCK_SIZE];
+  int32_t last[OPLL_BLOCK_SIZE];
+  uint32_t produced, i;
+  int32_t total, steps;
+  int16_t prev;
+  double time;
+
+  if (opll->conv) {
+    while (count--) {
+      *out++ = OPLL_calc(opll);
+    }
+    return;
+  }
+
+  while (count > 0) {
+    /* Same step accounting as OPLL_calc: find which internal sample is output for each output sample */
+    total = 0;
+    produced = 0;
+    prev = opll->mix_out[0];
+    while (produced < count && produced < OPLL_BLOCK_SIZE) {
+      time = opll->out_time;
+      steps = 0;
+      while (opll->out_step > time) {
+        time += opll->inp_step;
+        steps++;
+      }
+      if (total + steps > OPLL_BLOCK_SIZE) {
+        break;
+      }
+      opll->out_time = time - opll->out_step;
+      total += steps;
+      last[produced++] = total - 1;
+    }
+
+    if (produced == 0) {
+      /* More internal samples than the block size for a single output sample */
+      *out++ = OPLL_calc(opll);
+      count--;
+      continue;
+    }
+
+    if (total > 0) {
+      render_block(opll, mix, total);
+    }
+    for (i = 0; i < produced; i++) {
+      out[i] = last[i] < 0 ? prev : mix[last[i]];
+    }
+    out += produced;
+    count -= produced;
+  }
+}
+
 void OPLL_calcStereo(OPLL *opll, int32_t out[2]) {
   while (opll->out_step > opll->out_time) {
     opll->out_time += opll->inp_step;
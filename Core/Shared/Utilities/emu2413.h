@@ -180,6 +180,12 @@ void OPLL_writeReg(OPLL *opll, uint32_t reg, uint8_t val);
  */
 int16_t OPLL_calc(OPLL *opll);
 
+/**
+ * Calculate count samples, same output as calling OPLL_calc count times.
+ * Register writes must be done between calls, at the sample they apply to.
+ */
+void OPLL_calcBlock(OPLL *opll, int16_t *out, uint32_t count);
+
 /**
  * Calulate stereo sample
  */
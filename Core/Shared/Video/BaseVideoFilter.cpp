@@ -163,15 +163,14 @@ void BaseVideoFilter::YiqToRgb(double y, double i, double q, double& r, double&
 	b = std::max(0.0, std::min(1.0, (y + _yiqToRgbMatrix[4] * i + _yiqToRgbMatrix[5] * q)));
 }
 
-void BaseVideoFilter::TakeScreenshot(VideoFilterType filterType, string filename, std::stringstream *stream)
+bool BaseVideoFilter::GetScreenshot(VideoFilterType filterType, vector<uint32_t>& pixels, FrameInfo& frameInfo)
 {
 	uint32_t* pngBuffer;
-	FrameInfo frameInfo;
 	uint32_t* frameBuffer = nullptr;
 	{
 		auto lock = _frameLock.AcquireSafe();
 		if(_bufferSize == 0 || !GetOutputBuffer()) {
-			return;
+			return false;
 		}
 
 		frameBuffer = new uint32_t[_bufferSize];
@@ -200,14 +199,25 @@ void BaseVideoFilter::TakeScreenshot(VideoFilterType filterType, string filename
 	}
 
 	ScanlineFilter::ApplyFilter(pngBuffer, frameInfo.Width, frameInfo.Height, _emu->GetSettings()->GetVideoConfig().ScanlineIntensity, scale);
-	
+
+	pixels.assign(pngBuffer, pngBuffer + frameInfo.Width * frameInfo.Height);
+	delete[] frameBuffer;
+	return true;
+}
+
+void BaseVideoFilter::TakeScreenshot(VideoFilterType filterType, string filename, std::stringstream *stream)
+{
+	vector<uint32_t> pixels;
+	FrameInfo frameInfo;
+	if(!GetScreenshot(filterType, pixels, frameInfo)) {
+		return;
+	}
+
 	if(!filename.empty()) {
-		PNGHelper::WritePNG(filename, pngBuffer, frameInfo.Width, frameInfo.Height);
+		PNGHelper::WritePNG(filename, pixels.data(), frameInfo.Width, frameInfo.Height);
 	} else {
-		PNGHelper::WritePNG(*stream, pngBuffer, frameInfo.Width, frameInfo.Height);
+		PNGHelper::WritePNG(*stream, pixels.data(), frameInfo.Width, frameInfo.Height);
 	}
-
-	delete[] frameBuffer;
 }
 
 void BaseVideoFilter::TakeScreenshot(string romName, VideoFilterType filterType)
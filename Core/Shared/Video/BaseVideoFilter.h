@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "Utilities/SimpleLock.h"
 #include "Shared/SettingTypes.h"
+#include "Shared/Video/VideoFilterThreadPool.h"
 
 class Emulator;
 
@@ -15,6 +16,7 @@ private:
 	OverscanDimensions _overscan = {};
 	bool _isOddFrame = false;
 	uint32_t _videoPhase = 0;
+	VideoFilterThreadPool* _threadPool = nullptr;
 
 	void UpdateBufferSize();
 
@@ -36,6 +38,9 @@ protected:
 	uint32_t GetVideoPhase();
 	uint32_t GetBufferSize();
 
+	//Splits the rows in bands processed in parallel - bands must not write to the same rows
+	void RunRows(uint32_t rowCount, const VideoFilterThreadPool::RowTask& task) { VideoFilterThreadPool::Run(_threadPool, rowCount, task); }
+
 protected:
 	virtual FrameInfo GetFrameInfo();
 
@@ -48,6 +53,8 @@ public:
 
 	uint32_t* GetOutputBuffer();
 	FrameInfo SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber, uint32_t videoPhase, void* frameData, bool enableOverscan = true);
+	//Frame as it would be saved in a screenshot (rotated, scaled and with scanlines), in ARGB format
+	bool GetScreenshot(VideoFilterType filterType, vector<uint32_t>& pixels, FrameInfo& frameInfo);
 	void TakeScreenshot(string romName, VideoFilterType filterType);
 	void TakeScreenshot(VideoFilterType filterType, string filename, std::stringstream *stream = nullptr);
 
@@ -57,4 +64,5 @@ public:
 	FrameInfo GetFrameInfo(uint16_t* ppuOutputBuffer, bool enableOverscan);
 
 	void SetBaseFrameInfo(FrameInfo frameInfo);
+	void SetThreadPool(VideoFilterThreadPool* pool) { _threadPool = pool; }
 };
@@ -31,7 +31,7 @@ uint32_t ScaleFilter::ApplyBrightness(uint32_t argb, uint8_t brightness)
 	return 0xFF000000 | (r << 16) | (g << 8) | b;
 }
 
-void ScaleFilter::ApplyLcdGridFilter(uint32_t* inputArgbBuffer)
+void ScaleFilter::ApplyLcdGridFilter(uint32_t* inputArgbBuffer, uint32_t startRow, uint32_t endRow)
 {
 	VideoConfig& cfg = _emu->GetSettings()->GetVideoConfig();
 	uint8_t topLeft = (uint8_t)(cfg.LcdGridTopLeftBrightness * 255);
@@ -52,7 +52,7 @@ void ScaleFilter::ApplyLcdGridFilter(uint32_t* inputArgbBuffer)
 		bottomLeft = orgTopLeft;
 	}
 
-	for(uint32_t y = 0; y < _height; y++) {
+	for(uint32_t y = startRow; y < endRow; y++) {
 		for(uint32_t x = 0; x < _width; x++) {
 			uint32_t srcColor = inputArgbBuffer[y * _width + x];
 			
@@ -65,11 +65,12 @@ void ScaleFilter::ApplyLcdGridFilter(uint32_t* inputArgbBuffer)
 	}
 }
 
-void ScaleFilter::ApplyPrescaleFilter(uint32_t *inputArgbBuffer)
+void ScaleFilter::ApplyPrescaleFilter(uint32_t *inputArgbBuffer, uint32_t startRow, uint32_t endRow)
 {
-	uint32_t* outputBuffer = _outputBuffer;
+	uint32_t* outputBuffer = _outputBuffer + startRow * _width * _filterScale * _filterScale;
+	inputArgbBuffer += startRow * _width;
 
-	for(uint32_t y = 0; y < _height; y++) {
+	for(uint32_t y = startRow; y < endRow; y++) {
 		for(uint32_t x = 0; x < _width; x++) {
 			for(uint32_t i = 0; i < _filterScale; i++) {
 				*(outputBuffer++) = *inputArgbBuffer;
@@ -93,23 +94,28 @@ void ScaleFilter::UpdateOutputBuffer(uint32_t width, uint32_t height)
 	}
 }
 
-uint32_t* ScaleFilter::ApplyFilter(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height)
+uint32_t* ScaleFilter::ApplyFilter(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height, VideoFilterThreadPool* threadPool)
 {
 	UpdateOutputBuffer(width, height);
 
-	if(_scaleFilterType == ScaleFilterType::Scale2x) {
-		scale(_filterScale, _outputBuffer, width*sizeof(uint32_t)*_filterScale, inputArgbBuffer, width*sizeof(uint32_t), 4, width, height);
-	} else if(_scaleFilterType == ScaleFilterType::_2xSai) {
-		twoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
-	} else if(_scaleFilterType == ScaleFilterType::Super2xSai) {
-		supertwoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
-	} else if(_scaleFilterType == ScaleFilterType::SuperEagle) {
-		supereagle_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
-	} else if(_scaleFilterType == ScaleFilterType::Prescale) {
-		ApplyPrescaleFilter(inputArgbBuffer);
-	} else if(_scaleFilterType == ScaleFilterType::LcdGrid) {
-		ApplyLcdGridFilter(inputArgbBuffer);
-	}
+	//Each band reads the source rows around it as needed, but only writes the output rows of its own source rows
+	VideoFilterThreadPool::Run(threadPool, height, [&](uint32_t startRow, uint32_t endRow) {
+		if(_scaleFilterType == ScaleFilterType::Scale2x) {
+			if(scale_precondition(_filterScale, 4, width, height) == 0) {
+				scale_rows(_filterScale, _outputBuffer, width*sizeof(uint32_t)*_filterScale, inputArgbBuffer, width*sizeof(uint32_t), 4, width, height, startRow, endRow);
+			}
+		} else if(_scaleFilterType == ScaleFilterType::_2xSai) {
+			twoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale, startRow, endRow);
+		} else if(_scaleFilterType == ScaleFilterType::Super2xSai) {
+			supertwoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale, startRow, endRow);
+		} else if(_scaleFilterType == ScaleFilterType::SuperEagle) {
+			supereagle_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale, startRow, endRow);
+		} else if(_scaleFilterType == ScaleFilterType::Prescale) {
+			ApplyPrescaleFilter(inputArgbBuffer, startRow, endRow);
+		} else if(_scaleFilterType == ScaleFilterType::LcdGrid) {
+			ApplyLcdGridFilter(inputArgbBuffer, startRow, endRow);
+		}
+	});
 
 	return _outputBuffer;
 }
@@ -2,6 +2,7 @@
 
 #include "pch.h"
 #include "Shared/SettingTypes.h"
+#include "Shared/Video/VideoFilterThreadPool.h"
 
 class Emulator;
 
@@ -17,9 +18,9 @@ private:
 	uint32_t _height = 0;
 
 	uint32_t ApplyBrightness(uint32_t argb, uint8_t brightness);
-	void ApplyLcdGridFilter(uint32_t* inputArgbBuffer);
+	void ApplyLcdGridFilter(uint32_t* inputArgbBuffer, uint32_t startRow, uint32_t endRow);
 
-	void ApplyPrescaleFilter(uint32_t *inputArgbBuffer);
+	void ApplyPrescaleFilter(uint32_t *inputArgbBuffer, uint32_t startRow, uint32_t endRow);
 	void UpdateOutputBuffer(uint32_t width, uint32_t height);
 
 public:
@@ -27,7 +28,8 @@ public:
 	~ScaleFilter();
 
 	uint32_t GetScale();
-	uint32_t* ApplyFilter(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height);
+	//When a thread pool is given, the image is split in bands - the output is identical to a single pass
+	uint32_t* ApplyFilter(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height, VideoFilterThreadPool* threadPool = nullptr);
 	FrameInfo GetFrameInfo(FrameInfo baseFrameInfo);
 
 	static unique_ptr<ScaleFilter> GetScaleFilter(Emulator* emu, VideoFilterType filter);
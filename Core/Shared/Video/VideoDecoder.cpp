@@ -11,6 +11,8 @@
 #include "Shared/Video/ScaleFilter.h"
 #include "Shared/Video/RotateFilter.h"
 #include "Shared/Video/ScanlineFilter.h"
+#include "Shared/Video/VideoFilterThreadPool.h"
+#include "Shared/AvStreamWriter.h"
 #include "Shared/Video/DebugHud.h"
 #include "Shared/InputHud.h"
 #include "Shared/RenderedFrame.h"
@@ -75,7 +77,12 @@ void VideoDecoder::UpdateVideoFilter()
 		_videoFilterType = newFilter;
 		_consoleType = consoleType;
 
+		if(!_filterThreadPool) {
+			_filterThreadPool.reset(new VideoFilterThreadPool());
+		}
+
 		_videoFilter.reset(_emu->GetVideoFilter());
+		_videoFilter->SetThreadPool(_filterThreadPool.get());
 		_scaleFilter = ScaleFilter::GetScaleFilter(_emu, _videoFilterType);
 		_forceFilterUpdate = false;
 	}
@@ -125,7 +132,7 @@ void VideoDecoder::DecodeFrame(bool forRewind)
 	_emu->GetDebugHud()->Draw(outputBuffer, frameSize, overscan, _frame.FrameNumber, _videoFilter->GetScaleFactor());
 
 	if(_scaleFilter && !isAudioPlayer) {
-		outputBuffer = _scaleFilter->ApplyFilter(outputBuffer, frameSize.Width, frameSize.Height);
+		outputBuffer = _scaleFilter->ApplyFilter(outputBuffer, frameSize.Width, frameSize.Height, _filterThreadPool.get());
 		frameSize = _scaleFilter->GetFrameInfo(frameSize);
 	}
 
@@ -134,6 +141,10 @@ void VideoDecoder::DecodeFrame(bool forRewind)
 		ScanlineFilter::ApplyFilter(outputBuffer, frameSize.Width, frameSize.Height, _emu->GetSettings()->GetVideoConfig().ScanlineIntensity, scale);
 	}
 
+	if(_streamWriter && !forRewind) {
+		_streamWriter->AddFrame(outputBuffer, frameSize.Width, frameSize.Height);
+	}
+
 	RenderedFrame convertedFrame((void*)outputBuffer, frameSize.Width, frameSize.Height, _frame.Scale, _frame.FrameNumber, _frame.InputData);
 
 	double aspectRatio = _emu->GetSettings()->GetAspectRatio(_emu->GetRegion(), _baseFrameSize);
@@ -194,6 +205,16 @@ void VideoDecoder::UpdateFrame(RenderedFrame frame, bool sync, bool forRewind)
 
 	_emu->OnBeforeSendFrame();
 
+	if(_rawFrameHandler && !forRewind) {
+		_rawFrameHandler(frame);
+	}
+
+	if(_emu->GetSettings()->CheckFlag(EmulationFlags::TestMode)) {
+		//Nothing is displayed in test mode, skip the filters and the renderer
+		_frameCount++;
+		return;
+	}
+
 	_frame = frame;
 	if(sync) {
 		DecodeFrame(forRewind);
@@ -255,3 +276,8 @@ void VideoDecoder::TakeScreenshot(std::stringstream &stream)
 		_videoFilter->TakeScreenshot(_videoFilterType, "", &stream);
 	}
 }
+
+bool VideoDecoder::GetScreenshot(vector<uint32_t>& pixels, FrameInfo& frameInfo)
+{
+	return _videoFilter && _videoFilter->GetScreenshot(_videoFilterType, pixels, frameInfo);
+}
@@ -4,10 +4,13 @@
 #include "Utilities/AutoResetEvent.h"
 #include "Shared/SettingTypes.h"
 #include "Shared/RenderedFrame.h"
+#include <functional>
 
 class BaseVideoFilter;
 class ScaleFilter;
 class RotateFilter;
+class VideoFilterThreadPool;
+class AvStreamWriter;
 class IRenderingDevice;
 class Emulator;
 
@@ -38,6 +41,10 @@ private:
 	unique_ptr<BaseVideoFilter> _videoFilter;
 	unique_ptr<ScaleFilter> _scaleFilter;
 	unique_ptr<RotateFilter> _rotateFilter;
+	unique_ptr<VideoFilterThreadPool> _filterThreadPool;
+
+	std::function<void(const RenderedFrame&)> _rawFrameHandler;
+	AvStreamWriter* _streamWriter = nullptr;
 
 	void UpdateVideoFilter();
 
@@ -52,6 +59,13 @@ public:
 	void DecodeFrame(bool synchronous = false);
 	void TakeScreenshot();
 	void TakeScreenshot(std::stringstream &stream);
+	bool GetScreenshot(vector<uint32_t>& pixels, FrameInfo& frameInfo);
+
+	//Called on the emulation thread with the raw PPU output of each frame, must be set while the emulation is paused
+	void SetRawFrameHandler(std::function<void(const RenderedFrame&)> handler) { _rawFrameHandler = handler; }
+
+	//Receives each decoded frame (as displayed), must be set while the decode thread is stopped or paused
+	void SetStreamWriter(AvStreamWriter* writer) { _streamWriter = writer; }
 	
 	void ForceFilterUpdate() { _forceFilterUpdate = true; }
 
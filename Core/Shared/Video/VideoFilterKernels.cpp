@@ -0,0 +1,285 @@
+#include "pch.h"
+#include "Shared/Video/VideoFilterKernels.h"
+#include "Shared/ColorUtilities.h"
+#include "Utilities/SimdUtilities.h"
+
+static __forceinline uint32_t BlendPixel(uint32_t a, uint32_t b)
+{
+	return (((a ^ b) & 0xfffefefe) >> 1) + (a & b);
+}
+
+static void ConvertRgb555Scalar(uint32_t* dst, const uint16_t* src, uint32_t x, uint32_t count)
+{
+	for(; x < count; x++) {
+		dst[x] = ColorUtilities::Rgb555ToArgb(src[x] & 0x7FFF);
+	}
+}
+
+static void BlendPixelsScalar(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint32_t x, uint32_t count)
+{
+	for(; x < count; x++) {
+		dst[x] = BlendPixel(a[x], b[x]);
+	}
+}
+
+static void DoublePixelsScalar(uint32_t* dst, const uint32_t* src, uint32_t x, uint32_t count)
+{
+	for(; x < count; x++) {
+		dst[x * 2] = src[x];
+		dst[x * 2 + 1] = src[x];
+	}
+}
+
+#if defined(MESEN_SIMD_X86)
+//Expands 8 BGR555 colors to ARGB: returns the 16-bit halves of each pixel (low = green/blue, high = alpha/red)
+SIMD_TARGET_SSE41 static __forceinline void ExpandRgb555Sse41(__m128i colors, __m128i& lo, __m128i& hi)
+{
+	const __m128i channelMask = _mm_set1_epi16(0x1F);
+	__m128i r = _mm_and_si128(colors, channelMask);
+	__m128i g = _mm_and_si128(_mm_srli_epi16(colors, 5), channelMask);
+	__m128i b = _mm_and_si128(_mm_srli_epi16(colors, 10), channelMask);
+
+	//(c << 3) | (c >> 2), like ColorUtilities::Convert5BitTo8Bit
+	r = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2));
+	g = _mm_or_si128(_mm_slli_epi16(g, 3), _mm_srli_epi16(g, 2));
+	b = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+
+	lo = _mm_or_si128(_mm_slli_epi16(g, 8), b);
+	hi = _mm_or_si128(r, _mm_set1_epi16((short)0xFF00));
+}
+
+SIMD_TARGET_SSE41 static uint32_t ConvertRgb555Sse41(uint32_t* dst, const uint16_t* src, uint32_t count)
+{
+	uint32_t x = 0;
+	for(; x + 8 <= count; x += 8) {
+		__m128i lo, hi;
+		ExpandRgb555Sse41(_mm_loadu_si128((const __m128i*)(src + x)), lo, hi);
+		_mm_storeu_si128((__m128i*)(dst + x), _mm_unpacklo_epi16(lo, hi));
+		_mm_storeu_si128((__m128i*)(dst + x + 4), _mm_unpackhi_epi16(lo, hi));
+	}
+	return x;
+}
+
+SIMD_TARGET_AVX2 static uint32_t ConvertRgb555Avx2(uint32_t* dst, const uint16_t* src, uint32_t count)
+{
+	const __m256i channelMask = _mm256_set1_epi16(0x1F);
+	uint32_t x = 0;
+	for(; x + 16 <= count; x += 16) {
+		__m256i colors = _mm256_loadu_si256((const __m256i*)(src + x));
+		__m256i r = _mm256_and_si256(colors, channelMask);
+		__m256i g = _mm256_and_si256(_mm256_srli_epi16(colors, 5), channelMask);
+		__m256i b = _mm256_and_si256(_mm256_srli_epi16(colors, 10), channelMask);
+
+		r = _mm256_or_si256(_mm256_slli_epi16(r, 3), _mm256_srli_epi16(r, 2));
+		g = _mm256_or_si256(_mm256_slli_epi16(g, 3), _mm256_srli_epi16(g, 2));
+		b = _mm256_or_si256(_mm256_slli_epi16(b, 3), _mm256_srli_epi16(b, 2));
+
+		__m256i lo = _mm256_or_si256(_mm256_slli_epi16(g, 8), b);
+		__m256i hi = _mm256_or_si256(r, _mm256_set1_epi16((short)0xFF00));
+
+		//Unpack works within each 128-bit lane: pixels 0-3/8-11 and 4-7/12-15
+		__m256i first = _mm256_unpacklo_epi16(lo, hi);
+		__m256i second = _mm256_unpackhi_epi16(lo, hi);
+		_mm256_storeu_si256((__m256i*)(dst + x), _mm256_permute2x128_si256(first, second, 0x20));
+		_mm256_storeu_si256((__m256i*)(dst + x + 8), _mm256_permute2x128_si256(first, second, 0x31));
+	}
+	return x;
+}
+
+SIMD_TARGET_SSE41 static uint32_t BlendPixelsSse41(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint32_t count)
+{
+	const __m128i mask = _mm_set1_epi32((int)0xfffefefe);
+	uint32_t x = 0;
+	for(; x + 4 <= count; x += 4) {
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + x));
+		__m128i vb = _mm_loadu_si128((const __m128i*)(b + x));
+		__m128i avg = _mm_add_epi32(_mm_srli_epi32(_mm_and_si128(_mm_xor_si128(va, vb), mask), 1), _mm_and_si128(va, vb));
+		_mm_storeu_si128((__m128i*)(dst + x), avg);
+	}
+	return x;
+}
+
+SIMD_TARGET_AVX2 static uint32_t BlendPixelsAvx2(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint32_t count)
+{
+	const __m256i mask = _mm256_set1_epi32((int)0xfffefefe);
+	uint32_t x = 0;
+	for(; x + 8 <= count; x += 8) {
+		__m256i va = _mm256_loadu_si256((const __m256i*)(a + x));
+		__m256i vb = _mm256_loadu_si256((const __m256i*)(b + x));
+		__m256i avg = _mm256_add_epi32(_mm256_srli_epi32(_mm256_and_si256(_mm256_xor_si256(va, vb), mask), 1), _mm256_and_si256(va, vb));
+		_mm256_storeu_si256((__m256i*)(dst + x), avg);
+	}
+	return x;
+}
+
+SIMD_TARGET_SSE41 static uint32_t DoublePixelsSse41(uint32_t* dst, const uint32_t* src, uint32_t count)
+{
+	uint32_t x = 0;
+	for(; x + 4 <= count; x += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + x));
+		_mm_storeu_si128((__m128i*)(dst + x * 2), _mm_unpacklo_epi32(v, v));
+		_mm_storeu_si128((__m128i*)(dst + x * 2 + 4), _mm_unpackhi_epi32(v, v));
+	}
+	return x;
+}
+
+SIMD_TARGET_AVX2 static uint32_t DoublePixelsAvx2(uint32_t* dst, const uint32_t* src, uint32_t count)
+{
+	uint32_t x = 0;
+	for(; x + 8 <= count; x += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + x));
+		__m256i first = _mm256_unpacklo_epi32(v, v);
+		__m256i second = _mm256_unpackhi_epi32(v, v);
+		_mm256_storeu_si256((__m256i*)(dst + x * 2), _mm256_permute2x128_si256(first, second, 0x20));
+		_mm256_storeu_si256((__m256i*)(dst + x * 2 + 8), _mm256_permute2x128_si256(first, second, 0x31));
+	}
+	return x;
+}
+#elif defined(MESEN_SIMD_NEON)
+static uint32_t ConvertRgb555Neon(uint32_t* dst, const uint16_t* src, uint32_t count)
+{
+	const uint16x8_t channelMask = vdupq_n_u16(0x1F);
+	const uint16x8_t alpha = vdupq_n_u16(0xFF00);
+	uint32_t x = 0;
+	for(; x + 8 <= count; x += 8) {
+		uint16x8_t colors = vld1q_u16(src + x);
+		uint16x8_t r = vandq_u16(colors, channelMask);
+		uint16x8_t g = vandq_u16(vshrq_n_u16(colors, 5), channelMask);
+		uint16x8_t b = vandq_u16(vshrq_n_u16(colors, 10), channelMask);
+
+		r = vorrq_u16(vshlq_n_u16(r, 3), vshrq_n_u16(r, 2));
+		g = vorrq_u16(vshlq_n_u16(g, 3), vshrq_n_u16(g, 2));
+		b = vorrq_u16(vshlq_n_u16(b, 3), vshrq_n_u16(b, 2));
+
+		uint16x8x2_t pixels = vzipq_u16(vorrq_u16(vshlq_n_u16(g, 8), b), vorrq_u16(r, alpha));
+		vst1q_u32(dst + x, vreinterpretq_u32_u16(pixels.val[0]));
+		vst1q_u32(dst + x + 4, vreinterpretq_u32_u16(pixels.val[1]));
+	}
+	return x;
+}
+
+static uint32_t BlendPixelsNeon(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint32_t count)
+{
+	const uint32x4_t mask = vdupq_n_u32(0xfffefefe);
+	uint32_t x = 0;
+	for(; x + 4 <= count; x += 4) {
+		uint32x4_t va = vld1q_u32(a + x);
+		uint32x4_t vb = vld1q_u32(b + x);
+		vst1q_u32(dst + x, vaddq_u32(vshrq_n_u32(vandq_u32(veorq_u32(va, vb), mask), 1), vandq_u32(va, vb)));
+	}
+	return x;
+}
+
+static uint32_t DoublePixelsNeon(uint32_t* dst, const uint32_t* src, uint32_t count)
+{
+	uint32_t x = 0;
+	for(; x + 4 <= count; x += 4) {
+		uint32x4_t v = vld1q_u32(src + x);
+		uint32x4x2_t pixels = vzipq_u32(v, v);
+		vst1q_u32(dst + x * 2, pixels.val[0]);
+		vst1q_u32(dst + x * 2 + 4, pixels.val[1]);
+	}
+	return x;
+}
+#endif
+
+bool VideoFilterKernels::IsRgb555Palette(const uint32_t* palette)
+{
+	for(uint32_t i = 0; i < 0x8000; i++) {
+		if(palette[i] != ColorUtilities::Rgb555ToArgb((uint16_t)i)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void VideoFilterKernels::ConvertRgb555(uint32_t* dst, const uint16_t* src, uint32_t count)
+{
+	uint32_t x = 0;
+#if defined(MESEN_SIMD_X86)
+	if(SimdUtilities::HasAvx2()) {
+		x = ConvertRgb555Avx2(dst, src, count);
+	} else if(SimdUtilities::HasSse41()) {
+		x = ConvertRgb555Sse41(dst, src, count);
+	}
+#elif defined(MESEN_SIMD_NEON)
+	if(SimdUtilities::HasNeon()) {
+		x = ConvertRgb555Neon(dst, src, count);
+	}
+#endif
+	ConvertRgb555Scalar(dst, src, x, count);
+}
+
+void VideoFilterKernels::ConvertPalette(uint32_t* dst, const uint16_t* src, const uint32_t* palette, uint16_t mask, uint32_t count)
+{
+	//Gathers aren't faster than scalar loads for a 128kb table, keep the lookups scalar
+	uint32_t x = 0;
+	for(; x + 4 <= count; x += 4) {
+		dst[x] = palette[src[x] & mask];
+		dst[x + 1] = palette[src[x + 1] & mask];
+		dst[x + 2] = palette[src[x + 2] & mask];
+		dst[x + 3] = palette[src[x + 3] & mask];
+	}
+	for(; x < count; x++) {
+		dst[x] = palette[src[x] & mask];
+	}
+}
+
+void VideoFilterKernels::BlendPixels(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint32_t count)
+{
+	uint32_t x = 0;
+#if defined(MESEN_SIMD_X86)
+	if(SimdUtilities::HasAvx2()) {
+		x = BlendPixelsAvx2(dst, a, b, count);
+	} else if(SimdUtilities::HasSse41()) {
+		x = BlendPixelsSse41(dst, a, b, count);
+	}
+#elif defined(MESEN_SIMD_NEON)
+	if(SimdUtilities::HasNeon()) {
+		x = BlendPixelsNeon(dst, a, b, count);
+	}
+#endif
+	BlendPixelsScalar(dst, a, b, x, count);
+}
+
+void VideoFilterKernels::DoublePixels(uint32_t* dst, const uint32_t* src, uint32_t count)
+{
+	uint32_t x = 0;
+#if defined(MESEN_SIMD_X86)
+	if(SimdUtilities::HasAvx2()) {
+		x = DoublePixelsAvx2(dst, src, count);
+	} else if(SimdUtilities::HasSse41()) {
+		x = DoublePixelsSse41(dst, src, count);
+	}
+#elif defined(MESEN_SIMD_NEON)
+	if(SimdUtilities::HasNeon()) {
+		x = DoublePixelsNeon(dst, src, count);
+	}
+#endif
+	DoublePixelsScalar(dst, src, x, count);
+}
+
+void VideoFilterKernels::ConvertRow(uint32_t* dst, const uint16_t* src, const uint16_t* prevSrc, const uint32_t* palette, uint16_t mask, uint32_t count)
+{
+	if(palette) {
+		ConvertPalette(dst, src, palette, mask, count);
+	} else {
+		ConvertRgb555(dst, src, count);
+	}
+
+	if(prevSrc) {
+		//Convert the previous frame in small chunks to keep the temporary buffer in the L1 cache
+		constexpr uint32_t chunkSize = 256;
+		uint32_t prev[chunkSize];
+		for(uint32_t x = 0; x < count; x += chunkSize) {
+			uint32_t size = std::min(chunkSize, count - x);
+			if(palette) {
+				ConvertPalette(prev, prevSrc + x, palette, mask, size);
+			} else {
+				ConvertRgb555(prev, prevSrc + x, size);
+			}
+			//The previous frame is the first operand, like the filters' BlendPixels(prev, current)
+			BlendPixels(dst + x, prev, dst + x, size);
+		}
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "pch.h"
+
+//Per-row kernels used by the default video filters to convert the PPU's output to ARGB.
+//Each function has a scalar implementation and SSE4.1/AVX2/NEON versions that produce
+//identical results - the best version supported by the CPU is picked at runtime.
+class VideoFilterKernels
+{
+public:
+	//Returns true if palette[i] is the plain 8-bit expansion of the BGR555 color i for all 0x8000 colors,
+	//in which case ConvertRgb555 can be used instead of looking up the palette
+	static bool IsRgb555Palette(const uint32_t* palette);
+
+	//dst[i] = ARGB value of the BGR555 color src[i] (bit 15 is ignored), same as ColorUtilities::Rgb555ToArgb
+	static void ConvertRgb555(uint32_t* dst, const uint16_t* src, uint32_t count);
+
+	//dst[i] = palette[src[i] & mask]
+	static void ConvertPalette(uint32_t* dst, const uint16_t* src, const uint32_t* palette, uint16_t mask, uint32_t count);
+
+	//dst[i] = average of a[i] and b[i], rounded down per channel (dst can be the same buffer as a or b)
+	static void BlendPixels(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint32_t count);
+
+	//dst[i * 2] = dst[i * 2 + 1] = src[i]
+	static void DoublePixels(uint32_t* dst, const uint32_t* src, uint32_t count);
+
+	//Converts with the palette (or ConvertRgb555 when palette is null), then blends with the previous frame's colors when prevSrc is not null
+	static void ConvertRow(uint32_t* dst, const uint16_t* src, const uint16_t* prevSrc, const uint32_t* palette, uint16_t mask, uint32_t count);
+};
@@ -0,0 +1,92 @@
+#include "pch.h"
+#include "Shared/Video/VideoFilterThreadPool.h"
+
+VideoFilterThreadPool::VideoFilterThreadPool()
+{
+	_nextBand = 0;
+
+	//The emulation and decode threads are already busy, only use the remaining cores
+	uint32_t coreCount = std::thread::hardware_concurrency();
+	uint32_t workerCount = std::min(MaxWorkerCount, coreCount > 2 ? coreCount - 2 : 0);
+	for(uint32_t i = 0; i < workerCount; i++) {
+		_workers.push_back(std::thread([this]() { WorkerLoop(); }));
+	}
+}
+
+VideoFilterThreadPool::~VideoFilterThreadPool()
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_workSignal.notify_all();
+
+	for(std::thread& worker : _workers) {
+		worker.join();
+	}
+}
+
+uint32_t VideoFilterThreadPool::RunBands()
+{
+	uint32_t doneCount = 0;
+	uint32_t band;
+	while((band = _nextBand.fetch_add(1)) < _bandCount) {
+		uint32_t startRow = (uint32_t)((uint64_t)_rowCount * band / _bandCount);
+		uint32_t endRow = (uint32_t)((uint64_t)_rowCount * (band + 1) / _bandCount);
+		(*_task)(startRow, endRow);
+		doneCount++;
+	}
+	return doneCount;
+}
+
+void VideoFilterThreadPool::WorkerLoop()
+{
+	uint32_t generation = 0;
+	while(true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_workSignal.wait(lock, [&]() { return _stop || _generation != generation; });
+			if(_stop) {
+				return;
+			}
+			generation = _generation;
+		}
+
+		uint32_t doneCount = RunBands();
+		if(doneCount > 0) {
+			std::unique_lock<std::mutex> lock(_mutex);
+			_doneCount += doneCount;
+			if(_doneCount == _bandCount) {
+				_doneSignal.notify_one();
+			}
+		}
+	}
+}
+
+void VideoFilterThreadPool::Run(uint32_t rowCount, const RowTask& task)
+{
+	uint32_t bandCount = std::min<uint32_t>((uint32_t)_workers.size() + 1, rowCount / MinRowsPerBand);
+	if(bandCount <= 1) {
+		task(0, rowCount);
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_task = &task;
+		_rowCount = rowCount;
+		_bandCount = bandCount;
+		_doneCount = 0;
+		_nextBand = 0;
+		_generation++;
+	}
+	_workSignal.notify_all();
+
+	uint32_t doneCount = RunBands();
+
+	//Workers may still be processing their band, the task must stay alive until they are done
+	std::unique_lock<std::mutex> lock(_mutex);
+	_doneCount += doneCount;
+	_doneSignal.wait(lock, [&]() { return _doneCount == _bandCount; });
+	_task = nullptr;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "pch.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+//Small fixed pool of threads used by the video decoder to process a frame in horizontal bands.
+//The thread calling Run() processes bands too and only returns once the whole frame is done.
+class VideoFilterThreadPool
+{
+public:
+	typedef std::function<void(uint32_t startRow, uint32_t endRow)> RowTask;
+
+private:
+	//Bands smaller than this aren't worth waking up another thread for
+	static constexpr uint32_t MinRowsPerBand = 16;
+	static constexpr uint32_t MaxWorkerCount = 3;
+
+	vector<std::thread> _workers;
+	std::mutex _mutex;
+	std::condition_variable _workSignal;
+	std::condition_variable _doneSignal;
+
+	const RowTask* _task = nullptr;
+	uint32_t _rowCount = 0;
+	uint32_t _bandCount = 0;
+	atomic<uint32_t> _nextBand;
+	uint32_t _doneCount = 0;
+	uint32_t _generation = 0;
+	bool _stop = false;
+
+	void WorkerLoop();
+	uint32_t RunBands();
+
+public:
+	VideoFilterThreadPool();
+	~VideoFilterThreadPool();
+
+	//Calls task(startRow, endRow) for consecutive bands covering rows [0, rowCount)
+	void Run(uint32_t rowCount, const RowTask& task);
+
+	//Runs the task on the pool, or on the calling thread for the whole frame when no pool is given
+	static void Run(VideoFilterThreadPool* pool, uint32_t rowCount, const RowTask& task)
+	{
+		if(pool) {
+			pool->Run(rowCount, task);
+		} else {
+			task(0, rowCount);
+		}
+	}
+};
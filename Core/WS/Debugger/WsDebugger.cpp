@@ -225,7 +225,7 @@ void WsDebugger::ProcessWrite(uint32_t addr, uint16_t value, MemoryOperationType
 		_traceLogger->LogNonExec(operation, addressInfo);
 	}
 
-	_memoryAccessCounter->ProcessMemoryWrite<accessWidth>(addressInfo, _console->GetMasterClock());
+	_memoryAccessCounter->ProcessMemoryWrite<accessWidth>(addressInfo, _console->GetMasterClock(), CpuType::Ws);
 	_step->ProcessCpuCycle();
 	_debugger->ProcessBreakConditions<accessWidth>(CpuType::Ws, *_step.get(), _breakpointManager.get(), operation, addressInfo);
 }
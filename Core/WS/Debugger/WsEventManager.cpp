@@ -37,7 +37,7 @@ void WsEventManager::AddEvent(DebugEventType type, MemoryOperationInfo& operatio
 	evt.DmaChannel = -1;
 
 	evt.ProgramCounter = _debugger->GetProgramCounter(CpuType::Ws, true);
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void WsEventManager::AddEvent(DebugEventType type)
@@ -49,7 +49,7 @@ void WsEventManager::AddEvent(DebugEventType type)
 	evt.BreakpointId = -1;
 	evt.DmaChannel = -1;
 	evt.ProgramCounter = _cpu->GetProgramCounter();
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 DebugEventInfo WsEventManager::GetEvent(uint16_t y, uint16_t x)
@@ -166,8 +166,7 @@ uint32_t WsEventManager::TakeEventSnapshot(bool forAutoRefresh)
 		memcpy(_ppuBuffer + offset, _ppu->GetScreenBuffer(true) + offset, (WsConstants::MaxPixelCount - offset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
+	TakeFrameSnapshot();
 	_snapshotScanline = scanline;
 	_snapshotCycle = cycle;
 	_forAutoRefresh = forAutoRefresh;
@@ -5,6 +5,7 @@
 #include "Shared/Emulator.h"
 #include "Shared/ColorUtilities.h"
 #include "Shared/RewindManager.h"
+#include "Shared/Video/VideoFilterKernels.h"
 
 WsDefaultVideoFilter::WsDefaultVideoFilter(Emulator* emu, WsConsole* console, bool applyNtscFilter) : BaseVideoFilter(emu), _ntscFilter(emu)
 {
@@ -20,11 +21,6 @@ WsDefaultVideoFilter::~WsDefaultVideoFilter()
 	delete[] _prevFrame;
 }
 
-uint32_t WsDefaultVideoFilter::BlendPixels(uint32_t a, uint32_t b)
-{
-	return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
-}
-
 void WsDefaultVideoFilter::InitLookupTable()
 {
 	VideoConfig config = _emu->GetSettings()->GetVideoConfig();
@@ -105,15 +101,8 @@ void WsDefaultVideoFilter::ApplyFilter(uint16_t* ppuOutputBuffer)
 	uint32_t* out = GetOutputBuffer();
 	FrameInfo size = _baseFrameInfo;
 
-	if(_blendFrames && _prevFrameSize.Width == size.Width && _prevFrameSize.Height == size.Height) {
-		for(uint32_t i = 0, len = size.Height * size.Width; i < len; i++) {
-			out[i] = BlendPixels(_calculatedPalette[_prevFrame[i]], _calculatedPalette[ppuOutputBuffer[i]]);
-		}
-	} else {
-		for(uint32_t i = 0, len = size.Height * size.Width; i < len; i++) {
-			out[i] = _calculatedPalette[ppuOutputBuffer[i]];
-		}
-	}
+	bool blendFrames = _blendFrames && _prevFrameSize.Width == size.Width && _prevFrameSize.Height == size.Height;
+	VideoFilterKernels::ConvertRow(out, ppuOutputBuffer, blendFrames ? _prevFrame : nullptr, _calculatedPalette, 0x0FFF, size.Width * size.Height);
 
 	if(_blendFrames) {
 		std::copy(ppuOutputBuffer, ppuOutputBuffer + WsConstants::MaxPixelCount, _prevFrame);
@@ -22,8 +22,6 @@ private:
 	bool _applyNtscFilter = false;
 	GenericNtscFilter _ntscFilter;
 
-	uint32_t BlendPixels(uint32_t a, uint32_t b);
-
 	void InitLookupTable();
 
 protected:
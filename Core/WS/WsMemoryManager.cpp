@@ -100,6 +100,22 @@ uint8_t WsMemoryManager::DebugRead(uint32_t addr)
 	return 0;
 }
 
+void WsMemoryManager::DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length)
+{
+	uint32_t end = std::min<uint32_t>(addr + length, 0x100000);
+	while(addr < end) {
+		uint32_t pageEnd = std::min<uint32_t>((addr & 0xFF000) + 0x1000, end);
+		uint8_t* handler = _reads[addr >> 12];
+		if(handler) {
+			memcpy(dest, handler + (addr & 0xFFF), pageEnd - addr);
+		} else {
+			memset(dest, 0, pageEnd - addr);
+		}
+		dest += pageEnd - addr;
+		addr = pageEnd;
+	}
+}
+
 void WsMemoryManager::DebugWrite(uint32_t addr, uint8_t value)
 {
 	uint8_t* handler = _writes[addr >> 12];
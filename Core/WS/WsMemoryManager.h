@@ -89,6 +89,7 @@ public:
 	}
 
 	uint8_t DebugRead(uint32_t addr);
+	void DebugReadBlock(uint32_t addr, uint8_t* dest, uint32_t length);
 	void DebugWrite(uint32_t addr, uint8_t value);
 
 	template<typename T>
@@ -9,6 +9,8 @@
 #include <memory>
 #include <cstring>
 #include <cstdlib>
+#include <fstream>
+#include <iterator>
 
 #include "Core/Shared/Emulator.h"
 #include "Core/Shared/EmuSettings.h"
@@ -22,13 +24,19 @@
 #include "Core/Debugger/Breakpoint.h"
 #include "Core/Debugger/DebugTypes.h"
 #include "Core/Debugger/DebugUtilities.h"
+#include "Core/Debugger/MemoryDumper.h"
+#include "Core/Debugger/BaseEventManager.h"
 #include "Utilities/VirtualFile.h"
 #include "Utilities/FolderUtilities.h"
 #include "Core/Shared/Movies/MovieManager.h"
+#include "Core/Shared/AvStreamWriter.h"
+#include "Core/Shared/Video/VideoDecoder.h"
+#include "Core/Shared/Audio/SoundMixer.h"
 
 #include "cli_notification.h"
 #include "debugger_cli.h"
 #include "batch_runner.h"
+#include "movie_verifier.h"
 #include "console_info.h"
 #include "bus_logging.h"
 
@@ -64,8 +72,29 @@ struct CliArgs {
 	std::vector<uint32_t> breakAddresses;
 	std::vector<BatchAssertion> assertions;
 	std::vector<MemoryDump> dumps;
+	std::vector<MemoryDump> memLoads;
+	std::vector<MemoryDump> diffs;
 	std::string screenshotFile;
+	std::string frameHashFile;
+	std::string checkFrame;
+	uint32_t hashInterval = 1;
+	uint8_t frameTolerance = 0;
+	std::string avOutFile;
+	std::string wavOutFile;
+	bool avBackPressure = false;
 	std::string moviePath;
+	uint32_t movieStartFrame = 0;
+	std::string convertMoviePath;
+	uint32_t keyframeInterval = 600;
+	std::string verifyMoviesDir;
+	uint32_t verifyThreads = 0;
+	uint32_t checkpointInterval = 600;
+	int movieTimeoutMs = 600000;
+	bool updateExpectations = false;
+	std::string reportFile;
+	std::string eventLogFile;
+	std::string coverageFile;
+	std::string dbgFile;
 	bool logBus = false;
 	bool logVram = false;
 	bool logHdma = false;
@@ -87,6 +116,40 @@ static uint32_t ParseAddr(const std::string& s)
 	return std::stoul(str, nullptr, 16);
 }
 
+// Plays the movie to its end at maximum speed, the movie saves the converted file once its input runs out
+static int RunMovieConversion(Emulator* emu, std::shared_ptr<CliNotificationListener> listener, const std::string& outFile)
+{
+	MovieManager* movieManager = emu->GetMovieManager();
+	if(!movieManager->Playing()) {
+		fprintf(stderr, "[Movie] Nothing to convert (see --movie)\n");
+		return 2;
+	}
+
+	remove(outFile.c_str());
+	emu->GetSettings()->SetFlag(EmulationFlags::MaximumSpeed);
+
+	while(movieManager->Playing() && !listener->IsQuitRequested()) {
+		{
+			DebuggerRequest req = emu->GetDebugger(false);
+			Debugger* dbg = req.GetDebugger();
+			if(dbg && dbg->IsPaused()) {
+				// Initial break (or a BRK/STP break), the movie must keep running
+				listener->Reset();
+				dbg->Run();
+			}
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	std::ifstream result(outFile);
+	if(!result) {
+		fprintf(stderr, "[Movie] Conversion failed: %s\n", outFile.c_str());
+		return 2;
+	}
+	fprintf(stderr, "[Movie] Converted: %s\n", outFile.c_str());
+	return 0;
+}
+
 static void PrintUsage(const char* prog)
 {
 	fprintf(stderr,
@@ -108,12 +171,45 @@ static void PrintUsage(const char* prog)
 		"  --check-mem <A>=<V>     Assert memory byte (batch)\n"
 		"  --check-mem16 <A>=<V>   Assert memory word (batch)\n"
 		"  --dump <type> <file>    Dump memory region (batch)\n"
+		"  --load-mem <type> <file> Load file into memory region before running\n"
+		"  --diff <type>           Print bytes changed from start to break (batch)\n"
 		"  --screenshot <file>     Capture frame to PNG (batch)\n"
+		"  --frame-hashes <file>   Write a hash of the raw PPU output of each\n"
+		"                          frame (batch)\n"
+		"  --hash-interval <n>     Only hash every Nth frame (default 1)\n"
+		"  --check-frame <golden>  Assert the frame at the break matches a hash,\n"
+		"                          a .png (see --frame-tolerance) or each frame\n"
+		"                          of a --frame-hashes file (batch)\n"
+		"  --frame-tolerance <n>   Max per-channel difference for .png (default 0)\n"
 		"  --movie <file.mmo>      Play a Mesen movie file (.mmo)\n"
+		"  --start-frame <n>       Start the movie from its last keyframe before\n"
+		"                          input frame N (see --convert-movie)\n"
+		"  --convert-movie <file>  Play --movie to the end, then save it to <file>\n"
+		"                          with a binary input track and keyframes\n"
+		"  --keyframe-interval <n> Frames between keyframes (default 600)\n"
+		"  --verify-movies <dir>   Play every .mmo in <dir> in parallel (no video or\n"
+		"                          audio) and compare RAM/frame hashes taken every\n"
+		"                          --checkpoint-interval frames with <movie>.hashes\n"
+		"  --threads <n>           Movies played at once (default: CPU count)\n"
+		"  --checkpoint-interval <n> Frames between checkpoints (default 600)\n"
+		"  --update-expectations   Write <movie>.hashes instead of comparing\n"
+		"  --movie-timeout <sec>   Max play time of each movie (default 600)\n"
+		"  --report <file>         Write the JSON report to <file> (default stdout)\n"
 		"  --turbo                 Run at maximum speed (no frame limiter)\n"
+		"  --av-out <file>         Stream frames as Y4M (.y4m) or raw RGBA\n"
+		"                          (other names) to a file or FIFO\n"
+		"  --wav-out <file>        Stream audio as 16-bit stereo WAV\n"
+		"  --av-backpressure       Wait for the --av-out/--wav-out reader instead\n"
+		"                          of dropping data when it falls behind\n"
 		"  --log-bus               Log SNES bus writes to stdout\n"
 		"  --log-vram              Log SNES VRAM writes to stdout\n"
 		"  --log-hdma              Log SNES HDMA transfers to stdout\n"
+		"  --event-log <file>      Write register/DMA/IRQ events of each frame\n"
+		"                          to a binary file\n"
+		"  --coverage <file>       Write PRG ROM source line coverage (batch):\n"
+		"                          lcov tracefile, or JSON for .json\n"
+		"  --dbg <file>            ca65 .dbg file for --coverage (default:\n"
+		"                          <rom>.dbg or main.dbg next to the ROM)\n"
 		"  --help                  Show this help\n"
 		"\n"
 		"Address formats: $1234, 0x1234, 1234, 00:8000\n"
@@ -143,6 +239,30 @@ static bool ParseArgs(int argc, char* argv[], CliArgs& args)
 			args.headless = true;
 		} else if(arg == "--movie" && i + 1 < argc) {
 			args.moviePath = argv[++i];
+		} else if(arg == "--start-frame" && i + 1 < argc) {
+			args.movieStartFrame = (uint32_t)std::stoul(argv[++i]);
+		} else if(arg == "--convert-movie" && i + 1 < argc) {
+			args.convertMoviePath = argv[++i];
+		} else if(arg == "--keyframe-interval" && i + 1 < argc) {
+			args.keyframeInterval = (uint32_t)std::stoul(argv[++i]);
+		} else if(arg == "--verify-movies" && i + 1 < argc) {
+			args.verifyMoviesDir = argv[++i];
+		} else if(arg == "--threads" && i + 1 < argc) {
+			args.verifyThreads = (uint32_t)std::stoul(argv[++i]);
+		} else if(arg == "--checkpoint-interval" && i + 1 < argc) {
+			args.checkpointInterval = (uint32_t)std::stoul(argv[++i]);
+		} else if(arg == "--update-expectations") {
+			args.updateExpectations = true;
+		} else if(arg == "--movie-timeout" && i + 1 < argc) {
+			args.movieTimeoutMs = std::stoi(argv[++i]) * 1000;
+		} else if(arg == "--report" && i + 1 < argc) {
+			args.reportFile = argv[++i];
+		} else if(arg == "--event-log" && i + 1 < argc) {
+			args.eventLogFile = argv[++i];
+		} else if(arg == "--coverage" && i + 1 < argc) {
+			args.coverageFile = argv[++i];
+		} else if(arg == "--dbg" && i + 1 < argc) {
+			args.dbgFile = argv[++i];
 		} else if(arg == "--log-bus") {
 			args.logBus = true;
 		} else if(arg == "--log-vram") {
@@ -186,8 +306,30 @@ static bool ParseArgs(int argc, char* argv[], CliArgs& args)
 			// Store type name as string; resolve to MemoryType after console detection
 			// For now store -1 as a sentinel; the type name goes in filename temporarily
 			args.dumps.push_back({-1, type + "\t" + file});
+		} else if(arg == "--load-mem" && i + 2 < argc) {
+			// --load-mem <type> <file> — resolved after ROM load, same as --dump
+			std::string type = argv[++i];
+			std::string file = argv[++i];
+			args.memLoads.push_back({-1, type + "\t" + file});
+		} else if(arg == "--diff" && i + 1 < argc) {
+			// --diff <type> — resolved after ROM load, same as --dump (no file name)
+			args.diffs.push_back({-1, std::string(argv[++i]) + "\t"});
 		} else if(arg == "--screenshot" && i + 1 < argc) {
 			args.screenshotFile = argv[++i];
+		} else if(arg == "--frame-hashes" && i + 1 < argc) {
+			args.frameHashFile = argv[++i];
+		} else if(arg == "--hash-interval" && i + 1 < argc) {
+			args.hashInterval = (uint32_t)std::max(1, std::stoi(argv[++i]));
+		} else if(arg == "--check-frame" && i + 1 < argc) {
+			args.checkFrame = argv[++i];
+		} else if(arg == "--frame-tolerance" && i + 1 < argc) {
+			args.frameTolerance = (uint8_t)std::min(255, std::max(0, std::stoi(argv[++i])));
+		} else if(arg == "--av-out" && i + 1 < argc) {
+			args.avOutFile = argv[++i];
+		} else if(arg == "--wav-out" && i + 1 < argc) {
+			args.wavOutFile = argv[++i];
+		} else if(arg == "--av-backpressure") {
+			args.avBackPressure = true;
 		} else if(arg == "--turbo") {
 			args.turbo = true;
 		} else if(arg[0] == '-') {
@@ -207,16 +349,77 @@ static bool ParseArgs(int argc, char* argv[], CliArgs& args)
 	return true;
 }
 
+// Resolves the "type\tfile" entries stored by ParseArgs for --dump/--load-mem/--diff
+static void ResolveMemoryTypes(std::vector<MemoryDump>& entries, ConsoleType consoleType)
+{
+	for(auto& d : entries) {
+		if(d.memType == -1) {
+			size_t tab = d.filename.find('\t');
+			std::string typeName = d.filename.substr(0, tab);
+			std::string fileName = d.filename.substr(tab + 1);
+			d.filename = fileName;
+
+			auto regions = ConsoleInfo::GetMemoryRegions(consoleType);
+			bool found = false;
+			for(auto& r : regions) {
+				if(typeName == r.shortName) {
+					d.memType = (int)r.type;
+					found = true;
+					break;
+				}
+			}
+			if(!found) {
+				fprintf(stderr, "Unknown memory type '%s' for %s. Valid types:",
+					typeName.c_str(), ConsoleInfo::GetConsoleName(consoleType));
+				for(auto& r : regions) {
+					fprintf(stderr, " %s", r.shortName);
+				}
+				fprintf(stderr, "\n");
+			}
+		}
+	}
+}
+
+static void LoadMemoryFile(Emulator* emu, MemoryType memType, const std::string& filename)
+{
+	std::ifstream in(filename, std::ios::binary);
+	if(!in) {
+		fprintf(stderr, "Could not open %s\n", filename.c_str());
+		return;
+	}
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	DebuggerRequest req = emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	if(!dbg) return;
+
+	uint32_t size = dbg->GetMemoryDumper()->GetMemorySize(memType);
+	if(size == 0) {
+		fprintf(stderr, "Memory type not available for %s\n", filename.c_str());
+		return;
+	}
+	if(data.size() > size) {
+		fprintf(stderr, "Warning: %s is larger than the memory region (%u bytes), truncating\n", filename.c_str(), size);
+		data.resize(size);
+	}
+
+	dbg->GetMemoryDumper()->SetMemoryValues(memType, 0, data.data(), (uint32_t)data.size());
+	fprintf(stderr, "Loaded %zu bytes from %s\n", data.size(), filename.c_str());
+}
+
+// Mesen needs a home folder for save states, battery saves, settings, etc.
+static void InitHomeFolder()
+{
+	const char* home = getenv("MESEN_HOME");
+	if(!home) home = getenv("HOME");
+	std::string mesenHome = std::string(home ? home : "/tmp") + "/.mesen-dap";
+	FolderUtilities::SetHomeFolder(mesenHome);
+}
+
 // --- DAP mode ---
 static int RunDapMode(CliArgs& args)
 {
-	// Set home folder
-	{
-		const char* home = getenv("MESEN_HOME");
-		if(!home) home = getenv("HOME");
-		std::string mesenHome = std::string(home ? home : "/tmp") + "/.mesen-dap";
-		FolderUtilities::SetHomeFolder(mesenHome);
-	}
+	InitHomeFolder();
 
 	// Create and initialize emulator
 	std::unique_ptr<Emulator> emu(new Emulator());
@@ -261,16 +464,27 @@ static int RunDapMode(CliArgs& args)
 	return 0;
 }
 
+// --- Movie verification mode ---
+static int RunMovieVerification(CliArgs& args)
+{
+	// Needed before the workers load the ROM (e.g battery saves are loaded from the home folder)
+	InitHomeFolder();
+
+	// Each worker creates its own headless emulator, nothing is shared with the CLI/DAP modes
+	MovieVerifier verifier(args.romPath, args.verifyMoviesDir);
+	verifier.SetThreadCount(args.verifyThreads > 0 ? args.verifyThreads : std::max(1u, std::thread::hardware_concurrency()));
+	verifier.SetCheckpointInterval(args.checkpointInterval);
+	verifier.SetTimeout(args.movieTimeoutMs);
+	verifier.SetUpdateExpectations(args.updateExpectations);
+	verifier.SetReportFile(args.reportFile);
+	return verifier.Run();
+}
+
 // --- CLI/Batch mode ---
 static int RunCliMode(CliArgs& args)
 {
-	// 0. Set home folder (Mesen needs this for save states, settings, etc.)
-	{
-		const char* home = getenv("MESEN_HOME");
-		if(!home) home = getenv("HOME");
-		std::string mesenHome = std::string(home ? home : "/tmp") + "/.mesen-dap";
-		FolderUtilities::SetHomeFolder(mesenHome);
-	}
+	// 0. Set home folder
+	InitHomeFolder();
 
 	// 1. Create and initialize emulator
 	std::unique_ptr<Emulator> emu(new Emulator());
@@ -357,34 +571,10 @@ static int RunCliMode(CliArgs& args)
 	CpuType primaryCpu = emu->GetCpuTypes()[0];
 	ConsoleType consoleType = emu->GetConsoleType();
 
-	// 8. Resolve --dump type names now that we know the console
-	for(auto& d : args.dumps) {
-		if(d.memType == -1) {
-			// Parse "type\tfile" stored during arg parsing
-			size_t tab = d.filename.find('\t');
-			std::string typeName = d.filename.substr(0, tab);
-			std::string fileName = d.filename.substr(tab + 1);
-			d.filename = fileName;
-
-			auto regions = ConsoleInfo::GetMemoryRegions(consoleType);
-			bool found = false;
-			for(auto& r : regions) {
-				if(typeName == r.shortName) {
-					d.memType = (int)r.type;
-					found = true;
-					break;
-				}
-			}
-			if(!found) {
-				fprintf(stderr, "Unknown dump type '%s' for %s. Valid types:",
-					typeName.c_str(), ConsoleInfo::GetConsoleName(consoleType));
-				for(auto& r : regions) {
-					fprintf(stderr, " %s", r.shortName);
-				}
-				fprintf(stderr, "\n");
-			}
-		}
-	}
+	// 8. Resolve --dump/--load-mem/--diff type names now that we know the console
+	ResolveMemoryTypes(args.dumps, consoleType);
+	ResolveMemoryTypes(args.memLoads, consoleType);
+	ResolveMemoryTypes(args.diffs, consoleType);
 
 	// 9. Start movie playback if requested (before breakpoints, since PowerCycle resets debugger)
 
@@ -394,7 +584,11 @@ static int RunCliMode(CliArgs& args)
 			fprintf(stderr, "Movie file not found: %s\n", args.moviePath.c_str());
 		} else {
 			fprintf(stderr, "[Movie] Loading: %s\n", args.moviePath.c_str());
-			emu->GetMovieManager()->Play(movieFile, true);
+			MoviePlaybackOptions movieOptions;
+			movieOptions.StartFrame = args.movieStartFrame;
+			movieOptions.ConvertTo = args.convertMoviePath;
+			movieOptions.KeyframeInterval = args.keyframeInterval;
+			emu->GetMovieManager()->Play(movieFile, true, movieOptions);
 			if(emu->GetMovieManager()->Playing()) {
 				fprintf(stderr, "[Movie] Playback started\n");
 			} else {
@@ -447,6 +641,38 @@ static int RunCliMode(CliArgs& args)
 		}
 	}
 
+	// Audio/video streams (the frame rate is known once the ROM is loaded)
+	std::unique_ptr<AvStreamWriter> avWriter;
+	if(!args.avOutFile.empty() || !args.wavOutFile.empty()) {
+		// A reader closing its end of a FIFO shouldn't kill the process
+		signal(SIGPIPE, SIG_IGN);
+		avWriter.reset(new AvStreamWriter());
+		if(avWriter->Start(args.avOutFile, args.wavOutFile, emu->GetFps(), args.avBackPressure)) {
+			emu->GetVideoDecoder()->SetStreamWriter(avWriter.get());
+			emu->GetSoundMixer()->SetStreamWriter(avWriter.get());
+		} else {
+			fprintf(stderr, "Could not open AV output: %s %s\n", args.avOutFile.c_str(), args.wavOutFile.c_str());
+			avWriter.reset();
+		}
+	}
+
+	// Event log (after movie start, since movie PowerCycle resets debugger)
+	if(!args.eventLogFile.empty()) {
+		DebuggerRequest req = emu->GetDebugger(false);
+		Debugger* dbg = req.GetDebugger();
+		BaseEventManager* evtMgr = dbg ? dbg->GetEventManager(primaryCpu) : nullptr;
+		if(!evtMgr || !evtMgr->StartEventLog(args.eventLogFile)) {
+			fprintf(stderr, "Could not start event log: %s\n", args.eventLogFile.c_str());
+		}
+	}
+
+	// Load memory images (single bulk write per file)
+	for(auto& m : args.memLoads) {
+		if(m.memType >= 0) {
+			LoadMemoryFile(emu.get(), (MemoryType)m.memType, m.filename);
+		}
+	}
+
 	// Apply turbo mode if requested
 	if(args.turbo) {
 		emu->GetSettings()->SetFlag(EmulationFlags::MaximumSpeed);
@@ -454,7 +680,9 @@ static int RunCliMode(CliArgs& args)
 
 	// 11. Dispatch to batch or interactive mode
 	int exitCode = 0;
-	if(args.batchMode) {
+	if(!args.convertMoviePath.empty()) {
+		exitCode = RunMovieConversion(emu.get(), listener, args.convertMoviePath);
+	} else if(args.batchMode) {
 		BatchRunner runner(emu.get(), listener, primaryCpu, consoleType,
 		                   args.jsonOutput, args.timeoutMs);
 		for(auto& a : args.assertions) {
@@ -465,9 +693,24 @@ static int RunCliMode(CliArgs& args)
 				runner.AddDump(d.memType, d.filename);
 			}
 		}
+		for(auto& d : args.diffs) {
+			if(d.memType >= 0) {
+				runner.AddDiff(d.memType);
+			}
+		}
 		if(!args.screenshotFile.empty()) {
 			runner.SetScreenshotFile(args.screenshotFile);
 		}
+		if(!args.coverageFile.empty()) {
+			runner.SetCoverageFile(args.coverageFile, args.dbgFile);
+		}
+		if(!args.frameHashFile.empty()) {
+			runner.SetFrameHashFile(args.frameHashFile);
+		}
+		runner.SetHashInterval(args.hashInterval);
+		if(!args.checkFrame.empty()) {
+			runner.SetCheckFrame(args.checkFrame, args.frameTolerance);
+		}
 		exitCode = runner.Run();
 	} else {
 		DebuggerCli cli(emu.get(), listener, primaryCpu, consoleType, args.jsonOutput);
@@ -480,6 +723,16 @@ static int RunCliMode(CliArgs& args)
 	// 11. Teardown
 	g_listener.reset();
 	emu->Stop(false);
+
+	if(avWriter) {
+		emu->GetVideoDecoder()->SetStreamWriter(nullptr);
+		emu->GetSoundMixer()->SetStreamWriter(nullptr);
+		avWriter->Stop();
+		if(avWriter->GetDroppedFrames() || avWriter->GetDroppedSamples()) {
+			fprintf(stderr, "[AV] Dropped %u frames and %u audio samples (see --av-backpressure)\n",
+			        avWriter->GetDroppedFrames(), avWriter->GetDroppedSamples());
+		}
+	}
 	emu->Release();
 
 	delete renderer;
@@ -523,5 +776,8 @@ int main(int argc, char* argv[])
 		PrintUsage(argv[0]);
 		return 2;
 	}
+	if(!args.verifyMoviesDir.empty()) {
+		return RunMovieVerification(args);
+	}
 	return RunCliMode(args);
 }
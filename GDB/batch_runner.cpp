@@ -3,12 +3,17 @@
 #include "cli_notification.h"
 #include "formatter.h"
 #include "console_info.h"
+#include "coverage_export.h"
+#include "frame_hash.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/Video/VideoDecoder.h"
+#include "Shared/RenderedFrame.h"
+#include "Utilities/PNGHelper.h"
 #include "Shared/DebuggerRequest.h"
 #include "Debugger/Debugger.h"
 #include "Debugger/MemoryDumper.h"
+#include "Debugger/MemorySnapshotManager.h"
 #include "NES/NesTypes.h"
 #include "SNES/SnesCpuTypes.h"
 #include "Gameboy/GbTypes.h"
@@ -21,6 +26,7 @@
 #include <fstream>
 #include <cstring>
 #include <algorithm>
+#include <cinttypes>
 
 BatchRunner::BatchRunner(Emulator* emu, std::shared_ptr<CliNotificationListener> listener,
                          CpuType primaryCpu, ConsoleType consoleType,
@@ -155,11 +161,122 @@ uint16_t BatchRunner::GetRegisterValue(const std::string& name, const uint8_t* s
 	return 0;
 }
 
+static bool IsPngFile(const std::string& filename)
+{
+	return filename.size() > 4 && iequals(filename.substr(filename.size() - 4), ".png");
+}
+
+int BatchRunner::CheckFrame(FrameHashRecorder& recorder)
+{
+	std::vector<FrameHash> golden;
+	std::vector<FrameHash> actual;
+	uint64_t expectedHash;
+	if(FrameHashes::ParseHash(_checkFrame, expectedHash)) {
+		// Single hash: compare the last frame rendered before the break
+		FrameHash last;
+		if(!recorder.GetLastHash(last)) {
+			std::cerr << "Error: no frame was rendered\n";
+			return 2;
+		}
+		golden.push_back({ last.frame, expectedHash });
+		actual.push_back(last);
+	} else {
+		if(!FrameHashes::Load(_checkFrame, golden)) {
+			std::cerr << "Error: could not read frame hashes from " << _checkFrame << "\n";
+			return 2;
+		}
+		actual = recorder.GetHashes();
+	}
+
+	std::vector<FrameHashMismatch> mismatches = FrameHashes::Compare(golden, actual);
+	for(const FrameHashMismatch& m : mismatches) {
+		if(_jsonOutput) {
+			if(m.missing) {
+				fprintf(stderr, "{\"frame_check_failed\":%u,\"expected\":\"%016" PRIX64 "\",\"actual\":null}\n",
+					m.frame, m.expected);
+			} else {
+				fprintf(stderr, "{\"frame_check_failed\":%u,\"expected\":\"%016" PRIX64 "\",\"actual\":\"%016" PRIX64 "\"}\n",
+					m.frame, m.expected, m.actual);
+			}
+		} else if(m.missing) {
+			fprintf(stderr, "FAIL: frame %u was not rendered (expected %016" PRIX64 ")\n", m.frame, m.expected);
+		} else {
+			fprintf(stderr, "FAIL: frame %u = %016" PRIX64 " (expected %016" PRIX64 ")\n", m.frame, m.actual, m.expected);
+		}
+	}
+
+	if(mismatches.empty() && !_jsonOutput) {
+		if(golden.size() == 1) {
+			fprintf(stdout, "PASS: frame %u = %016" PRIX64 "\n", actual[0].frame, actual[0].hash);
+		} else {
+			fprintf(stdout, "PASS: %zu frame hashes match\n", golden.size());
+		}
+	}
+	return mismatches.empty() ? 0 : 1;
+}
+
+int BatchRunner::CheckFrameImage()
+{
+	std::vector<uint8_t> pngData;
+	uint32_t pngWidth, pngHeight;
+	if(!PNGHelper::ReadPNG(_checkFrame, pngData, pngWidth, pngHeight)) {
+		std::cerr << "Error: could not read " << _checkFrame << "\n";
+		return 2;
+	}
+
+	// Same image as --screenshot, without the PNG encoding
+	VideoDecoder* decoder = _emu->GetVideoDecoder();
+	decoder->WaitForAsyncFrameDecode();
+	std::vector<uint32_t> pixels;
+	FrameInfo frameInfo;
+	if(!decoder->GetScreenshot(pixels, frameInfo)) {
+		std::cerr << "Error: no frame was rendered\n";
+		return 2;
+	}
+
+	bool sizeMatches = frameInfo.Width == pngWidth && frameInfo.Height == pngHeight;
+	FrameImageDiff diff;
+	if(sizeMatches) {
+		diff = FrameHashes::CompareImages(pixels.data(), (uint32_t*)pngData.data(), (uint32_t)pixels.size(), _frameTolerance);
+	}
+
+	bool passed = sizeMatches && diff.differentPixels == 0;
+	if(_jsonOutput) {
+		if(!passed) {
+			fprintf(stderr, "{\"frame_check_failed\":\"%s\",\"width\":%u,\"height\":%u,\"different_pixels\":%u,\"max_delta\":%u}\n",
+				_checkFrame.c_str(), frameInfo.Width, frameInfo.Height, diff.differentPixels, diff.maxDelta);
+		}
+	} else if(!sizeMatches) {
+		fprintf(stderr, "FAIL: frame is %ux%u (expected %ux%u from %s)\n",
+			frameInfo.Width, frameInfo.Height, pngWidth, pngHeight, _checkFrame.c_str());
+	} else if(!passed) {
+		fprintf(stderr, "FAIL: %u pixels differ from %s (max channel delta %u, tolerance %u)\n",
+			diff.differentPixels, _checkFrame.c_str(), diff.maxDelta, _frameTolerance);
+	} else {
+		fprintf(stdout, "PASS: frame matches %s (max channel delta %u)\n", _checkFrame.c_str(), diff.maxDelta);
+	}
+	return passed ? 0 : 1;
+}
+
 int BatchRunner::Run()
 {
 	// Enable max speed in batch mode (no frame limiter)
 	_emu->GetSettings()->SetFlag(EmulationFlags::MaximumSpeed);
 
+	// Hash the raw PPU output of each frame for --frame-hashes/--check-frame.
+	// The recorder is shared with the handler, which stays set if the run times out.
+	std::shared_ptr<FrameHashRecorder> recorder;
+	bool checkImage = IsPngFile(_checkFrame);
+	if(!_frameHashFile.empty() || (!_checkFrame.empty() && !checkImage)) {
+		uint64_t hash;
+		bool keepAll = !_frameHashFile.empty() || !FrameHashes::ParseHash(_checkFrame, hash);
+		recorder = std::make_shared<FrameHashRecorder>();
+		recorder->SetInterval(keepAll ? _hashInterval : 0);
+		_emu->GetVideoDecoder()->SetRawFrameHandler([recorder](const RenderedFrame& frame) {
+			recorder->OnFrame(frame.FrameNumber, (uint16_t*)frame.FrameBuffer, frame.Width, frame.Height);
+		});
+	}
+
 	// Resume execution -- the debugger paused on initial step
 	{
 		DebuggerRequest req = _emu->GetDebugger(false);
@@ -168,6 +285,9 @@ int BatchRunner::Run()
 			std::cerr << "Error: debugger not initialized\n";
 			return 2;
 		}
+		if(!_diffs.empty()) {
+			dbg->GetMemorySnapshotManager()->TakeSnapshot("batch-start");
+		}
 		_listener->Reset();
 		dbg->Run();
 	}
@@ -180,6 +300,10 @@ int BatchRunner::Run()
 		return 2;
 	}
 
+	if(recorder) {
+		_emu->GetVideoDecoder()->SetRawFrameHandler(nullptr);
+	}
+
 	// Read CPU state
 	uint8_t stateBuffer[512] = {};
 	BaseState& state = *reinterpret_cast<BaseState*>(stateBuffer);
@@ -227,6 +351,22 @@ int BatchRunner::Run()
 		}
 	}
 
+	// Print memory changed since the start if requested
+	if(!_diffs.empty()) {
+		DebuggerRequest req = _emu->GetDebugger(false);
+		Debugger* dbg = req.GetDebugger();
+		if(dbg) {
+			MemorySnapshotManager* snapshots = dbg->GetMemorySnapshotManager();
+			snapshots->TakeSnapshot("batch-end");
+
+			std::vector<MemoryDiffEntry> entries;
+			for(int memType : _diffs) {
+				snapshots->Diff("batch-start", "batch-end", (MemoryType)memType, entries);
+			}
+			std::cout << Formatter::FormatMemoryDiff(_consoleType, snapshots, "batch-start", "batch-end", entries);
+		}
+	}
+
 	// Screenshot if requested
 	if(!_screenshotFile.empty()) {
 		VideoDecoder* decoder = _emu->GetVideoDecoder();
@@ -247,9 +387,32 @@ int BatchRunner::Run()
 		}
 	}
 
+	// Code coverage if requested
+	if(!_coverageFile.empty()) {
+		CoverageExport::Write(_emu, _consoleType, _coverageFile, _dbgFile);
+	}
+
+	// Frame hashes and golden frame checks
+	int frameResult = 0;
+	if(!_frameHashFile.empty()) {
+		if(FrameHashes::Save(_frameHashFile, recorder->GetHashes())) {
+			if(!_jsonOutput) {
+				fprintf(stderr, "Frame hashes saved to %s\n", _frameHashFile.c_str());
+			}
+		} else {
+			std::cerr << "Error: could not open " << _frameHashFile << " for writing\n";
+		}
+	}
+	if(!_checkFrame.empty()) {
+		frameResult = checkImage ? CheckFrameImage() : CheckFrame(*recorder);
+		if(frameResult == 2) {
+			return 2;
+		}
+	}
+
 	// Run assertions
 	if(_assertions.empty()) {
-		return 0;
+		return frameResult;
 	}
 
 	MemoryType cpuMemType = ConsoleInfo::GetCpuMemoryType(_primaryCpu);
@@ -299,5 +462,5 @@ int BatchRunner::Run()
 		}
 	}
 
-	return allPassed ? 0 : 1;
+	return allPassed && frameResult == 0 ? 0 : 1;
 }
@@ -8,6 +8,7 @@
 
 class Emulator;
 class CliNotificationListener;
+class FrameHashRecorder;
 
 struct BatchAssertion {
 	enum class Type { Reg, Mem };
@@ -33,9 +34,18 @@ private:
 	int _timeoutMs;
 	std::vector<BatchAssertion> _assertions;
 	std::vector<MemoryDump> _dumps;
+	std::vector<int> _diffs;
 	std::string _screenshotFile;
+	std::string _coverageFile;
+	std::string _dbgFile;
+	std::string _frameHashFile;
+	std::string _checkFrame;     // hash, golden .png or golden hash list
+	uint32_t _hashInterval = 1;
+	uint8_t _frameTolerance = 0;
 
 	uint16_t GetRegisterValue(const std::string& name, const uint8_t* stateBuffer, bool& found);
+	int CheckFrame(FrameHashRecorder& recorder);
+	int CheckFrameImage();
 
 public:
 	BatchRunner(Emulator* emu, std::shared_ptr<CliNotificationListener> listener,
@@ -44,6 +54,11 @@ public:
 
 	void AddAssertion(const BatchAssertion& assertion);
 	void AddDump(int memType, const std::string& filename);
+	void AddDiff(int memType) { _diffs.push_back(memType); }
 	void SetScreenshotFile(const std::string& filename) { _screenshotFile = filename; }
+	void SetCoverageFile(const std::string& filename, const std::string& dbgFile) { _coverageFile = filename; _dbgFile = dbgFile; }
+	void SetFrameHashFile(const std::string& filename) { _frameHashFile = filename; }
+	void SetHashInterval(uint32_t interval) { _hashInterval = interval; }
+	void SetCheckFrame(const std::string& golden, uint8_t tolerance) { _checkFrame = golden; _frameTolerance = tolerance; }
 	int Run();  // returns exit code: 0 = pass, 1 = fail, 2 = error/timeout
 };
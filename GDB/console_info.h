@@ -66,6 +66,37 @@ inline MemoryType GetCpuMemoryType(CpuType cpu)
 	return DebugUtilities::GetCpuMemoryType(cpu);
 }
 
+inline MemoryType GetPrgRomMemoryType(ConsoleType console)
+{
+	switch(console) {
+		case ConsoleType::Snes: return MemoryType::SnesPrgRom;
+		case ConsoleType::Gameboy: return MemoryType::GbPrgRom;
+		case ConsoleType::Nes: return MemoryType::NesPrgRom;
+		case ConsoleType::PcEngine: return MemoryType::PcePrgRom;
+		case ConsoleType::Sms: return MemoryType::SmsPrgRom;
+		case ConsoleType::Gba: return MemoryType::GbaPrgRom;
+		case ConsoleType::Ws: return MemoryType::WsPrgRom;
+	}
+	return MemoryType::None;
+}
+
+// Offset of the PRG ROM data in the linker's output file (.dbg ROM offsets include the iNES header)
+inline uint32_t GetRomFileHeaderSize(ConsoleType console)
+{
+	return console == ConsoleType::Nes ? 16 : 0;
+}
+
+// Bank size used to summarize PRG ROM coverage
+inline uint32_t GetDefaultBankSize(ConsoleType console)
+{
+	switch(console) {
+		case ConsoleType::Snes: return 0x8000;
+		case ConsoleType::PcEngine: return 0x2000;
+		case ConsoleType::Gba: case ConsoleType::Ws: return 0x10000;
+		default: return 0x4000;
+	}
+}
+
 struct MemoryRegion {
 	MemoryType type;
 	const char* name;
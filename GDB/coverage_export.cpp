@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "coverage_export.h"
+#include "console_info.h"
+#include "Shared/Emulator.h"
+#include "Shared/DebuggerRequest.h"
+#include "Shared/RomInfo.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/CdlManager.h"
+#include "Debugger/CodeDataLogger.h"
+#include "Core/Debugger/DAP/SourceMapper.h"
+#include "Core/Debugger/DAP/CoverageReport.h"
+#include <fstream>
+
+namespace CoverageExport {
+
+std::string FindDbgFile(const std::string& romPath)
+{
+	std::string candidates[2];
+	size_t dot = romPath.find_last_of('.');
+	size_t slash = romPath.find_last_of("/\\");
+	if(dot != std::string::npos && (slash == std::string::npos || dot > slash)) {
+		candidates[0] = romPath.substr(0, dot) + ".dbg";
+	}
+	candidates[1] = (slash != std::string::npos ? romPath.substr(0, slash + 1) : std::string()) + "main.dbg";
+
+	for(const std::string& path : candidates) {
+		if(!path.empty() && std::ifstream(path).good()) {
+			return path;
+		}
+	}
+	return {};
+}
+
+bool Write(Emulator* emu, ConsoleType console, const std::string& outFile, const std::string& dbgFile)
+{
+	DebuggerRequest req = emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	CodeDataLogger* cdl = dbg ? dbg->GetCdlManager()->GetCodeDataLogger(ConsoleInfo::GetPrgRomMemoryType(console)) : nullptr;
+	if(!cdl) {
+		fprintf(stderr, "Coverage: no code/data log available for this ROM\n");
+		return false;
+	}
+
+	std::string dbgPath = dbgFile.empty() ? FindDbgFile(emu->GetRomInfo().RomFile.GetFilePath()) : dbgFile;
+	SourceMapper mapper;
+	if(dbgPath.empty() || !mapper.LoadDbgFile(dbgPath)) {
+		fprintf(stderr, "Coverage: no .dbg file found, source lines will not be reported\n");
+	}
+
+	CoverageReport report;
+	report.Build(mapper, cdl->GetRawData(), cdl->GetSize(), ConsoleInfo::GetRomFileHeaderSize(console));
+
+	bool json = outFile.size() >= 5 && outFile.compare(outFile.size() - 5, 5, ".json") == 0;
+	std::string content;
+	if(json) {
+		CdlStatistics stats = cdl->GetStatistics();
+		JsonValue result = report.ToJson();
+		result.Set("codeBytes", JsonValue::MakeNumber(stats.CodeBytes));
+		result.Set("dataBytes", JsonValue::MakeNumber(stats.DataBytes));
+		result.Set("totalBytes", JsonValue::MakeNumber(stats.TotalBytes));
+
+		auto banks = JsonValue::MakeArray();
+		for(const CdlBankCoverage& bank : cdl->GetBankCoverage(ConsoleInfo::GetDefaultBankSize(console))) {
+			auto entry = JsonValue::MakeObject();
+			entry.Set("start", JsonValue::MakeNumber(bank.Start));
+			entry.Set("size", JsonValue::MakeNumber(bank.Size));
+			entry.Set("codeBytes", JsonValue::MakeNumber(bank.CodeBytes));
+			entry.Set("dataBytes", JsonValue::MakeNumber(bank.DataBytes));
+			banks.Push(std::move(entry));
+		}
+		result.Set("banks", std::move(banks));
+		content = result.Serialize() + "\n";
+	} else {
+		content = report.ToLcov();
+	}
+
+	std::ofstream out(outFile, std::ios::binary);
+	if(!out) {
+		fprintf(stderr, "Coverage: could not open %s for writing\n", outFile.c_str());
+		return false;
+	}
+	out.write(content.data(), content.size());
+
+	fprintf(stderr, "Coverage written to %s (%u/%u source lines hit)\n", outFile.c_str(), report.GetHitLineCount(), report.GetLineCount());
+	return true;
+}
+
+} // namespace CoverageExport
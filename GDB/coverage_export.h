@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include "Shared/SettingTypes.h"
+
+class Emulator;
+
+namespace CoverageExport {
+	// .dbg file next to the ROM (same name, or main.dbg in the same folder), empty if none exists
+	std::string FindDbgFile(const std::string& romPath);
+
+	// Writes the PRG ROM coverage as an lcov tracefile, or as JSON (with per-bank byte counts)
+	// when the file name ends with .json. Source lines come from the ca65 .dbg file.
+	bool Write(Emulator* emu, ConsoleType console, const std::string& outFile, const std::string& dbgFile);
+}
@@ -3,19 +3,28 @@
 #include "cli_notification.h"
 #include "formatter.h"
 #include "console_info.h"
+#include "coverage_export.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/DebuggerRequest.h"
 #include "Debugger/Debugger.h"
 #include "Debugger/Breakpoint.h"
 #include "Debugger/MemoryDumper.h"
+#include "Debugger/MemorySnapshotManager.h"
 #include "Debugger/Disassembler.h"
+#include "Debugger/DisassemblySearch.h"
 #include "Debugger/CallstackManager.h"
+#include "Debugger/Profiler.h"
 #include "Debugger/TraceLogFileSaver.h"
 #include "Debugger/DebugUtilities.h"
+#include "Debugger/CdlManager.h"
+#include "Debugger/CodeDataLogger.h"
+#include "Debugger/ReverseJournal.h"
 #include "Shared/MemoryType.h"
 #include "Shared/Video/VideoDecoder.h"
 #include "Utilities/PNGHelper.h"
+#include "Utilities/Timer.h"
+#include "Utilities/miniz.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -196,6 +205,85 @@ void DebuggerCli::CmdFinish()
 	PrintState();
 }
 
+void DebuggerCli::CmdReverseStep(int count)
+{
+	uint32_t stepCount = 0;
+	{
+		DebuggerRequest req = _emu->GetDebugger(false);
+		Debugger* dbg = req.GetDebugger();
+		if(!dbg) return;
+		if(!dbg->GetReverseJournal(_primaryCpu)) {
+			std::cout << "Reverse execution journal is off (use 'journal on').\n";
+			return;
+		}
+		std::string error = dbg->GetReverseStepError(_primaryCpu);
+		if(!error.empty()) {
+			std::cout << error << ".\n";
+			return;
+		}
+		stepCount = dbg->ReverseStep(_primaryCpu, (uint32_t)std::max(1, count));
+	}
+	if(stepCount == 0) {
+		std::cout << "No recorded history to step back into.\n";
+		return;
+	}
+	PrintState();
+}
+
+void DebuggerCli::CmdReverseContinue()
+{
+	int32_t bpId = -1;
+	uint32_t stepCount = 0;
+	{
+		DebuggerRequest req = _emu->GetDebugger(false);
+		Debugger* dbg = req.GetDebugger();
+		if(!dbg) return;
+		if(!dbg->GetReverseJournal(_primaryCpu)) {
+			std::cout << "Reverse execution journal is off (use 'journal on').\n";
+			return;
+		}
+		std::string error = dbg->GetReverseStepError(_primaryCpu);
+		if(!error.empty()) {
+			std::cout << error << ".\n";
+			return;
+		}
+		bpId = dbg->ReverseContinue(_primaryCpu, stepCount);
+	}
+	if(stepCount == 0) {
+		std::cout << "No recorded history to step back into.\n";
+		return;
+	}
+	if(bpId >= 0) {
+		std::cout << "Breakpoint " << bpId << " hit " << stepCount << " instruction(s) back.\n";
+	} else {
+		std::cout << "Reached the start of the recorded history (" << stepCount << " instruction(s) back).\n";
+	}
+	PrintState();
+}
+
+void DebuggerCli::CmdJournal(const std::vector<std::string>& tokens)
+{
+	DebuggerRequest req = _emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	if(!dbg) return;
+
+	if(tokens.size() > 1 && (tokens[1] == "on" || tokens[1] == "off")) {
+		uint64_t capacity = tokens.size() > 2 ? std::stoull(tokens[2]) : ReverseJournal::DefaultCapacity;
+		if(!ReverseJournal::IsValidCapacity(capacity)) {
+			printf("Invalid journal size, must be between 1 and %u instructions.\n", ReverseJournal::MaxCapacity);
+			return;
+		}
+		dbg->SetReverseJournalEnabled(_primaryCpu, tokens[1] == "on", (uint32_t)capacity);
+	}
+
+	ReverseJournal* journal = dbg->GetReverseJournal(_primaryCpu);
+	if(journal) {
+		std::cout << "Reverse execution journal: on, " << journal->GetInstructionCount() << "/" << journal->GetCapacity() << " instructions recorded\n";
+	} else {
+		std::cout << "Reverse execution journal: off\n";
+	}
+}
+
 void DebuggerCli::CmdRun()
 {
 	_listener->Reset();
@@ -418,15 +506,19 @@ void DebuggerCli::CmdScreenshot(const std::string& filename)
 	}
 }
 
-void DebuggerCli::CmdSet(uint32_t addr, uint8_t val)
+void DebuggerCli::CmdSet(uint32_t addr, std::vector<uint8_t>& values)
 {
 	MemoryType cpuMemType = ConsoleInfo::GetCpuMemoryType(_primaryCpu);
 	DebuggerRequest req = _emu->GetDebugger(false);
 	Debugger* dbg = req.GetDebugger();
 	if(!dbg) return;
 
-	dbg->GetMemoryDumper()->SetMemoryValue(cpuMemType, addr, val);
-	printf("[$%06X] = $%02X\n", addr, val);
+	dbg->GetMemoryDumper()->SetMemoryValues(cpuMemType, addr, values.data(), (uint32_t)values.size());
+	if(values.size() == 1) {
+		printf("[$%06X] = $%02X\n", addr, values[0]);
+	} else {
+		printf("[$%06X-$%06X] = %u bytes\n", addr, addr + (uint32_t)values.size() - 1, (uint32_t)values.size());
+	}
 }
 
 void DebuggerCli::CmdDisasm(uint32_t addr, int count)
@@ -441,6 +533,44 @@ void DebuggerCli::CmdDisasm(uint32_t addr, int count)
 	std::cout << Formatter::FormatDisassembly(output.data(), actual);
 }
 
+void DebuggerCli::CmdSearch(const std::string& args)
+{
+	DebuggerRequest req = _emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	if(!dbg) return;
+
+	DisassemblySearchOptions options = {};
+	std::istringstream iss(args);
+	std::string text;
+	std::string token;
+	while(iss >> token) {
+		if(text.empty() && token == "-c") {
+			options.MatchCase = true;
+		} else if(text.empty() && token == "-w") {
+			options.MatchWholeWord = true;
+		} else {
+			text += text.empty() ? token : " " + token;
+		}
+	}
+
+	if(text.empty()) {
+		std::cout << "Usage: search [-c] [-w] <text>\n";
+		return;
+	}
+	if(!options.MatchCase) {
+		std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+	}
+
+	constexpr uint32_t maxResults = 1000;
+	std::vector<CodeLineData> output(maxResults);
+	Timer timer;
+	uint32_t count = dbg->GetDisassemblySearch()->FindOccurrences(_primaryCpu, text.c_str(), options, output.data(), maxResults);
+	double ms = timer.GetElapsedMS();
+
+	std::cout << Formatter::FormatDisassembly(output.data(), count);
+	printf("%u match%s%s (%.1f ms)\n", count, count == 1 ? "" : "es", count == maxResults ? " (limit reached)" : "", ms);
+}
+
 void DebuggerCli::CmdBacktrace()
 {
 	DebuggerRequest req = _emu->GetDebugger(false);
@@ -455,7 +585,7 @@ void DebuggerCli::CmdBacktrace()
 
 	StackFrameInfo frames[64];
 	uint32_t count = 0;
-	csm->GetCallstack(frames, count);
+	csm->GetCallstack(frames, count, 64);
 	if(count == 0) {
 		std::cout << "Empty callstack.\n";
 		return;
@@ -499,6 +629,41 @@ void DebuggerCli::CmdTrace(const std::string& filename)
 	}
 }
 
+void DebuggerCli::CmdProfile(const std::string& action, const std::string& filename)
+{
+	DebuggerRequest req = _emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	if(!dbg) return;
+
+	CallstackManager* csm = dbg->GetCallstackManager(_primaryCpu);
+	if(!csm) {
+		std::cout << "Profiler not available.\n";
+		return;
+	}
+
+	Profiler* profiler = csm->GetProfiler();
+	if(action == "start") {
+		profiler->Start();
+		std::cout << "Profiler started.\n";
+	} else if(action == "stop") {
+		profiler->Stop();
+		printf("Profiler stopped (%u functions).\n", profiler->GetFunctionCount());
+	} else if(action == "dump") {
+		// .json -> JSON (functions + call edges), anything else -> folded stacks (flamegraph)
+		bool json = filename.size() >= 5 && filename.compare(filename.size() - 5, 5, ".json") == 0;
+		std::ofstream out(filename, std::ios::binary);
+		if(!out) {
+			printf("Failed to open %s for writing.\n", filename.c_str());
+			return;
+		}
+		profiler->Export(out, json ? ProfilerExportFormat::Json : ProfilerExportFormat::FoldedStacks, _primaryCpu);
+		out.close();
+		printf("Profile (%s) written to %s\n", json ? "json" : "folded stacks", filename.c_str());
+	} else {
+		std::cout << "Usage: profile start|stop|dump <file>\n";
+	}
+}
+
 uint16_t DebuggerCli::GetRegisterValue(const std::string& name, const uint8_t* stateBuffer)
 {
 	auto iequals = [](const std::string& a, const std::string& b) {
@@ -652,6 +817,185 @@ void DebuggerCli::CmdRunUntil(const RegCondition& cond)
 	printf("\nAborted.\n");
 }
 
+void DebuggerCli::CmdSnap(const std::string& name)
+{
+	DebuggerRequest req = _emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	if(!dbg) return;
+
+	MemorySnapshotManager* snapshots = dbg->GetMemorySnapshotManager();
+	if(name.empty()) {
+		auto names = snapshots->GetSnapshotNames();
+		if(names.empty()) {
+			std::cout << "No snapshots.\n";
+		}
+		for(auto& n : names) {
+			std::cout << "  " << n << "\n";
+		}
+		return;
+	}
+
+	snapshots->TakeSnapshot(name);
+	std::cout << "Snapshot '" << name << "' saved.\n";
+}
+
+void DebuggerCli::CmdDiff(const std::string& from, const std::string& to, const std::string& type)
+{
+	DebuggerRequest req = _emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	if(!dbg) return;
+
+	MemorySnapshotManager* snapshots = dbg->GetMemorySnapshotManager();
+	for(const std::string& name : { from, to }) {
+		if(!snapshots->HasSnapshot(name)) {
+			std::cout << "Unknown snapshot: " << name << "\n";
+			return;
+		}
+	}
+
+	// Compare every memory region of the console, unless a type is given
+	auto regions = ConsoleInfo::GetMemoryRegions(_consoleType);
+	std::vector<MemoryType> types;
+	for(auto& r : regions) {
+		if(type.empty() || type == r.shortName) {
+			types.push_back(r.type);
+		}
+	}
+	if(types.empty()) {
+		printf("Unknown memory type: %s\nValid types for %s:", type.c_str(), ConsoleInfo::GetConsoleName(_consoleType));
+		for(auto& r : regions) {
+			printf(" %s", r.shortName);
+		}
+		printf("\n");
+		return;
+	}
+
+	std::vector<MemoryDiffEntry> entries;
+	for(MemoryType memType : types) {
+		snapshots->Diff(from, to, memType, entries);
+	}
+	std::cout << Formatter::FormatMemoryDiff(_consoleType, snapshots, from, to, entries);
+}
+
+void DebuggerCli::CmdCoverage(const std::vector<std::string>& tokens)
+{
+	if(tokens.size() > 1 && tokens[1] == "export") {
+		if(tokens.size() < 3) {
+			std::cout << "Usage: coverage export <file.info|file.json> [file.dbg]\n";
+			return;
+		}
+		CoverageExport::Write(_emu, _consoleType, tokens[2], tokens.size() > 3 ? tokens[3] : "");
+		return;
+	}
+
+	DebuggerRequest req = _emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	if(!dbg) return;
+
+	CodeDataLogger* cdl = dbg->GetCdlManager()->GetCodeDataLogger(ConsoleInfo::GetPrgRomMemoryType(_consoleType));
+	if(!cdl) {
+		std::cout << "Code/data log not available.\n";
+		return;
+	}
+
+	uint32_t bankSize = tokens.size() > 1 ? ParseAddress(tokens[1]) : ConsoleInfo::GetDefaultBankSize(_consoleType);
+	std::cout << Formatter::FormatCoverage(cdl->GetStatistics(), cdl->GetBankCoverage(bankSize));
+}
+
+void DebuggerCli::CmdBenchDump(int iterations)
+{
+	DebuggerRequest req = _emu->GetDebugger(false);
+	Debugger* dbg = req.GetDebugger();
+	if(!dbg) return;
+
+	// CPU address spaces (every CPU of the console) first, then the console's memory regions
+	std::vector<std::pair<MemoryType, std::string>> types;
+	for(CpuType cpu : _emu->GetCpuTypes()) {
+		types.push_back({ DebugUtilities::GetCpuMemoryType(cpu), std::string(ConsoleInfo::GetCpuName(cpu)) + " memory" });
+	}
+	for(auto& r : ConsoleInfo::GetMemoryRegions(_consoleType)) {
+		types.push_back({ r.type, r.name });
+	}
+
+	MemoryDumper* dumper = dbg->GetMemoryDumper();
+	std::vector<uint8_t> buf;
+	for(auto& t : types) {
+		uint32_t size = dumper->GetMemorySize(t.first);
+		if(size == 0) {
+			continue;
+		}
+
+		buf.resize(size);
+		Timer timer;
+		for(int i = 0; i < iterations; i++) {
+			dumper->GetMemoryState(t.first, buf.data());
+		}
+		double ms = timer.GetElapsedMS() / iterations;
+		printf("  %-24s %10u bytes %10.3f ms %10.1f MB/s\n", t.second.c_str(), size, ms,
+			ms > 0 ? (size / (1024.0 * 1024.0)) / (ms / 1000.0) : 0.0);
+	}
+}
+
+void DebuggerCli::CmdBenchFrames(int count)
+{
+	// Runs without the frame limiter, the result is the emulation speed of the loaded ROM
+	// (e.g. to compare builds on SuperFX/Cx4/ST018 games)
+	EmuSettings* settings = _emu->GetSettings();
+	bool maxSpeed = settings->CheckFlag(EmulationFlags::MaximumSpeed);
+	settings->SetFlag(EmulationFlags::MaximumSpeed);
+
+	_listener->Reset();
+	Timer timer;
+	{
+		DebuggerRequest req = _emu->GetDebugger(false);
+		Debugger* dbg = req.GetDebugger();
+		if(dbg) dbg->Step(_primaryCpu, count, StepType::PpuFrame);
+	}
+	bool done = _listener->WaitForBreak(count * 100 + 10000);
+	double ms = timer.GetElapsedMS();
+	settings->SetFlagState(EmulationFlags::MaximumSpeed, maxSpeed);
+
+	if(!done) {
+		std::cout << "Timed out.\n";
+		return;
+	}
+	printf("  %d frames in %.1f ms: %.3f ms/frame, %.1f fps\n", count, ms, ms / count, ms > 0 ? count * 1000.0 / ms : 0.0);
+}
+
+void DebuggerCli::CmdBenchPng(int iterations)
+{
+	// Encodes the current frame: plain miniz RGB encoding (the previous screenshot code) vs PNGHelper at each compression level
+	vector<uint32_t> frame;
+	FrameInfo frameInfo;
+	if(!_emu->GetVideoDecoder()->GetScreenshot(frame, frameInfo) || frame.empty()) {
+		std::cout << "No frame data available (emulation may not have rendered a frame yet).\n";
+		return;
+	}
+
+	auto printResult = [&](const char* name, Timer& timer, size_t size) {
+		printf("  %-24s %4ux%-4u %10.3f ms %10zu bytes\n", name, frameInfo.Width, frameInfo.Height, timer.GetElapsedMS() / iterations, size);
+	};
+
+	std::vector<uint8_t> rgb(frame.size() * 3 + 4);
+	size_t size = 0;
+	Timer timer;
+	for(int i = 0; i < iterations; i++) {
+		PNGHelper::ConvertToRgb(rgb.data(), frame.data(), (uint32_t)frame.size());
+		void* data = tdefl_write_image_to_png_file_in_memory_ex(rgb.data(), frameInfo.Width, frameInfo.Height, 3, &size, MZ_DEFAULT_LEVEL, MZ_FALSE);
+		mz_free(data);
+	}
+	printResult("miniz RGB", timer, size);
+
+	std::vector<uint8_t> png;
+	for(uint32_t level : { PNGHelper::FastCompression, PNGHelper::DefaultCompression }) {
+		timer.Reset();
+		for(int i = 0; i < iterations; i++) {
+			PNGHelper::WritePNG(png, frame.data(), frameInfo.Width, frameInfo.Height, 24, level);
+		}
+		printResult(level == PNGHelper::FastCompression ? "PNGHelper (fast)" : "PNGHelper (default)", timer, png.size());
+	}
+}
+
 void DebuggerCli::CmdHelp()
 {
 	std::cout <<
@@ -663,6 +1007,9 @@ void DebuggerCli::CmdHelp()
 		"  finish            Step out (run to return)\n"
 		"  run               Resume execution until breakpoint\n"
 		"  c                 Alias for run (continue)\n"
+		"  journal [on [N]|off] Record the last N instructions for reverse execution\n"
+		"  reverse-step [N]  Undo N instructions (default 1), alias: rs\n"
+		"  reverse-continue  Undo instructions until a breakpoint, alias: rc\n"
 		"  break <addr>      Set execution breakpoint\n"
 		"  b <addr>          Alias for break\n"
 		"  watch <addr>      Set write watchpoint\n"
@@ -690,15 +1037,31 @@ void DebuggerCli::CmdHelp()
 	std::cout << ")\n"
 		"  screenshot [file] Capture frame to PNG\n"
 		"  ss [file]         Alias for screenshot\n"
-		"  set <addr> <val>  Set CPU memory byte\n"
+		"  set <addr> <val> [val...]\n"
+		"                    Set CPU memory byte(s), starting at addr\n"
 		"  disasm [addr] [n] Disassemble (default: at PC, 10 lines)\n"
 		"  d [addr] [n]      Alias for disasm\n"
+		"  search [-c] [-w] <text>\n"
+		"                    Find disassembly lines containing text (e.g. STA $2118)\n"
+		"                    -c: match case, -w: whole words\n"
 		"  bt                Show callstack\n"
 		"  frames <N>        Run N PPU frames\n"
 		"  reset             Reset emulator\n"
 		"  rwatch <cond>     Run until register condition is true\n"
 		"                    Examples: SP>$1FF, D!=0, A=$42, S<$100\n"
 		"  trace <file|off>  Start/stop trace logging\n"
+		"  profile start|stop  Start (clears data) or stop the profiler\n"
+		"  profile dump <file> Write profile (.json: functions + call edges,\n"
+		"                    otherwise: folded stacks for flamegraphs)\n"
+		"  snap [name]       Snapshot all RAM (no name: list snapshots)\n"
+		"  diff <a> <b> [type] Show bytes changed between 2 snapshots\n"
+		"                    and the instruction that last wrote them\n"
+		"  coverage [bank size] PRG ROM code/data coverage per bank\n"
+		"  coverage export <file> [file.dbg]\n"
+		"                    Write source line coverage (lcov, or JSON for .json)\n"
+		"  bench dump [N]    Time N (default 10) full dumps of each memory type\n"
+		"  bench frames [N]  Time N (default 600) frames at maximum speed\n"
+		"  bench png [N]     Time N (default 20) PNG encodings of the current frame\n"
 		"  help              Show this help\n"
 		"  quit              Exit debugger\n"
 		"\n"
@@ -763,6 +1126,13 @@ void DebuggerCli::Run()
 				CmdFinish();
 			} else if(cmd == "run" || cmd == "c" || cmd == "continue") {
 				CmdRun();
+			} else if(cmd == "reverse-step" || cmd == "rs") {
+				int count = (tokens.size() > 1) ? std::stoi(tokens[1]) : 1;
+				CmdReverseStep(count);
+			} else if(cmd == "reverse-continue" || cmd == "rc") {
+				CmdReverseContinue();
+			} else if(cmd == "journal") {
+				CmdJournal(tokens);
 			} else if(cmd == "break" || cmd == "b") {
 				if(tokens.size() < 2) { std::cout << "Usage: break <addr>\n"; continue; }
 				CmdBreak(ParseAddress(tokens[1]));
@@ -801,10 +1171,13 @@ void DebuggerCli::Run()
 				std::string fname = (tokens.size() > 1) ? tokens[1] : "";
 				CmdScreenshot(fname);
 			} else if(cmd == "set") {
-				if(tokens.size() < 3) { std::cout << "Usage: set <addr> <val>\n"; continue; }
+				if(tokens.size() < 3) { std::cout << "Usage: set <addr> <val> [val...]\n"; continue; }
 				uint32_t addr = ParseAddress(tokens[1]);
-				uint8_t val = (uint8_t)std::stoul(tokens[2], nullptr, 16);
-				CmdSet(addr, val);
+				std::vector<uint8_t> values;
+				for(size_t i = 2; i < tokens.size(); i++) {
+					values.push_back((uint8_t)std::stoul(tokens[i], nullptr, 16));
+				}
+				CmdSet(addr, values);
 			} else if(cmd == "disasm" || cmd == "d") {
 				uint32_t addr = 0;
 				int count = 10;
@@ -817,6 +1190,9 @@ void DebuggerCli::Run()
 					if(dbg) addr = dbg->GetProgramCounter(_primaryCpu, true);
 				}
 				CmdDisasm(addr, count);
+			} else if(cmd == "search" || cmd == "find") {
+				if(tokens.size() < 2) { std::cout << "Usage: search [-c] [-w] <text>\n"; continue; }
+				CmdSearch(line.substr(line.find(cmd) + cmd.size()));
 			} else if(cmd == "bt" || cmd == "backtrace") {
 				CmdBacktrace();
 			} else if(cmd == "frames") {
@@ -835,6 +1211,31 @@ void DebuggerCli::Run()
 			} else if(cmd == "trace") {
 				if(tokens.size() < 2) { std::cout << "Usage: trace <file|off>\n"; continue; }
 				CmdTrace(tokens[1]);
+			} else if(cmd == "profile") {
+				if(tokens.size() < 2 || (tokens[1] == "dump" && tokens.size() < 3)) {
+					std::cout << "Usage: profile start|stop|dump <file>\n";
+					continue;
+				}
+				CmdProfile(tokens[1], tokens.size() > 2 ? tokens[2] : "");
+			} else if(cmd == "snap") {
+				CmdSnap(tokens.size() > 1 ? tokens[1] : "");
+			} else if(cmd == "diff") {
+				if(tokens.size() < 3) { std::cout << "Usage: diff <a> <b> [type]\n"; continue; }
+				CmdDiff(tokens[1], tokens[2], tokens.size() > 3 ? tokens[3] : "");
+			} else if(cmd == "coverage" || cmd == "cov") {
+				CmdCoverage(tokens);
+			} else if(cmd == "bench") {
+				if(tokens.size() < 2 || (tokens[1] != "dump" && tokens[1] != "frames" && tokens[1] != "png")) {
+					std::cout << "Usage: bench dump|frames|png [N]\n";
+					continue;
+				}
+				if(tokens[1] == "frames") {
+					CmdBenchFrames(tokens.size() > 2 ? std::max(1, std::stoi(tokens[2])) : 600);
+				} else if(tokens[1] == "png") {
+					CmdBenchPng(tokens.size() > 2 ? std::max(1, std::stoi(tokens[2])) : 20);
+				} else {
+					CmdBenchDump(tokens.size() > 2 ? std::max(1, std::stoi(tokens[2])) : 10);
+				}
 			} else if(cmd == "help" || cmd == "h" || cmd == "?") {
 				CmdHelp();
 			} else if(cmd == "quit" || cmd == "q" || cmd == "exit") {
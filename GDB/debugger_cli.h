@@ -45,6 +45,9 @@ private:
 	void CmdNext();
 	void CmdFinish();
 	void CmdRun();
+	void CmdReverseStep(int count);
+	void CmdReverseContinue();
+	void CmdJournal(const std::vector<std::string>& tokens);
 	void CmdBreak(uint32_t addr);
 	void CmdWatch(uint32_t addr);
 	void CmdDelete(uint32_t id);
@@ -54,8 +57,9 @@ private:
 	void CmdRegs();
 	void CmdMem(uint32_t addr, uint32_t len);
 	void CmdMemTyped(uint32_t addr, uint32_t len, int memType, const char* label);
-	void CmdSet(uint32_t addr, uint8_t val);
+	void CmdSet(uint32_t addr, std::vector<uint8_t>& values);
 	void CmdDisasm(uint32_t addr, int count);
+	void CmdSearch(const std::string& args);
 	void CmdBacktrace();
 	void CmdFrames(int count);
 	void CmdReset();
@@ -63,6 +67,13 @@ private:
 	void CmdDump(const std::string& type, const std::string& filename);
 	void CmdScreenshot(const std::string& filename);
 	void CmdRunUntil(const RegCondition& cond);
+	void CmdProfile(const std::string& action, const std::string& filename);
+	void CmdBenchDump(int iterations);
+	void CmdBenchFrames(int count);
+	void CmdBenchPng(int iterations);
+	void CmdSnap(const std::string& name);
+	void CmdDiff(const std::string& from, const std::string& to, const std::string& type);
+	void CmdCoverage(const std::vector<std::string>& tokens);
 	void CmdHelp();
 
 	uint16_t GetRegisterValue(const std::string& name, const uint8_t* stateBuffer);
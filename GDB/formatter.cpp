@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "formatter.h"
+#include "console_info.h"
 #include "NES/NesTypes.h"
 #include "SNES/SnesCpuTypes.h"
 #include "Gameboy/GbTypes.h"
@@ -577,4 +578,75 @@ std::string FormatCallstack(StackFrameInfo* frames, uint32_t count)
 	return oss.str();
 }
 
+std::string FormatMemoryDiff(ConsoleType console, MemorySnapshotManager* snapshots, const std::string& from, const std::string& to, const std::vector<MemoryDiffEntry>& entries)
+{
+	auto regions = ConsoleInfo::GetMemoryRegions(console);
+	std::ostringstream oss;
+	uint32_t changedBytes = 0;
+	for(const MemoryDiffEntry& entry : entries) {
+		const char* typeName = "?";
+		for(auto& r : regions) {
+			if(r.type == entry.Type) {
+				typeName = r.shortName;
+				break;
+			}
+		}
+
+		char buf[64];
+		if(entry.Length == 1) {
+			snprintf(buf, sizeof(buf), "%-8s $%06X          ", typeName, entry.Start);
+		} else {
+			snprintf(buf, sizeof(buf), "%-8s $%06X-$%06X  ", typeName, entry.Start, entry.Start + entry.Length - 1);
+		}
+		oss << buf;
+
+		// Show the values for short ranges
+		if(entry.Length <= 8) {
+			std::string before, after;
+			for(uint32_t i = 0; i < entry.Length; i++) {
+				uint8_t a = 0, b = 0;
+				snapshots->GetSnapshotValue(from, entry.Type, entry.Start + i, a);
+				snapshots->GetSnapshotValue(to, entry.Type, entry.Start + i, b);
+				snprintf(buf, sizeof(buf), "%02X ", a);
+				before += buf;
+				snprintf(buf, sizeof(buf), "%02X ", b);
+				after += buf;
+			}
+			oss << before << "-> " << after;
+		} else {
+			oss << entry.Length << " bytes ";
+		}
+
+		if(entry.WriterAddress >= 0) {
+			oss << " by " << ConsoleInfo::GetCpuName(entry.WriterCpu) << " $" << DebugUtilities::AddressToHex(entry.WriterCpu, entry.WriterAddress);
+		}
+		oss << "\n";
+		changedBytes += entry.Length;
+	}
+
+	oss << entries.size() << " range(s), " << changedBytes << " byte(s) changed\n";
+	return oss.str();
+}
+
+std::string FormatCoverage(const CdlStatistics& stats, const std::vector<CdlBankCoverage>& banks)
+{
+	auto percent = [](uint32_t value, uint32_t total) { return total ? value * 100.0 / total : 0.0; };
+
+	std::ostringstream oss;
+	char buf[128];
+	for(const CdlBankCoverage& bank : banks) {
+		snprintf(buf, sizeof(buf), "$%06X-$%06X  code %6u (%5.1f%%)  data %6u (%5.1f%%)\n",
+			bank.Start, bank.Start + bank.Size - 1,
+			bank.CodeBytes, percent(bank.CodeBytes, bank.Size), bank.DataBytes, percent(bank.DataBytes, bank.Size));
+		oss << buf;
+	}
+
+	uint32_t unused = stats.TotalBytes - stats.CodeBytes - stats.DataBytes;
+	snprintf(buf, sizeof(buf), "Total: code %u (%.1f%%), data %u (%.1f%%), unused %u (%.1f%%) of %u bytes\n",
+		stats.CodeBytes, percent(stats.CodeBytes, stats.TotalBytes), stats.DataBytes, percent(stats.DataBytes, stats.TotalBytes),
+		unused, percent(unused, stats.TotalBytes), stats.TotalBytes);
+	oss << buf;
+	return oss.str();
+}
+
 } // namespace Formatter
@@ -1,9 +1,12 @@
 #pragma once
 #include <string>
 #include <cstdint>
+#include <vector>
 #include "Shared/CpuType.h"
 #include "Shared/BaseState.h"
 #include "Debugger/DebugTypes.h"
+#include "Debugger/MemorySnapshotManager.h"
+#include "Shared/SettingTypes.h"
 
 namespace Formatter {
 	std::string FormatRegisters(CpuType cpu, const BaseState& state);
@@ -11,4 +14,6 @@ namespace Formatter {
 	std::string FormatMemoryHex(const uint8_t* data, uint32_t len, uint32_t startAddr);
 	std::string FormatDisassembly(CodeLineData* lines, uint32_t count);
 	std::string FormatCallstack(StackFrameInfo* frames, uint32_t count);
+	std::string FormatMemoryDiff(ConsoleType console, MemorySnapshotManager* snapshots, const std::string& from, const std::string& to, const std::vector<MemoryDiffEntry>& entries);
+	std::string FormatCoverage(const CdlStatistics& stats, const std::vector<CdlBankCoverage>& banks);
 }
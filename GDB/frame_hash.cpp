@@ -0,0 +1,152 @@
+#include "pch.h"
+#include "frame_hash.h"
+#include "Utilities/XxHash.h"
+#include <fstream>
+#include <sstream>
+#include <cinttypes>
+
+namespace FrameHashes {
+
+uint64_t Compute(const uint16_t* buffer, uint32_t width, uint32_t height)
+{
+	return XxHash::GetHash(buffer, (size_t)width * height * sizeof(uint16_t));
+}
+
+bool ParseHash(const std::string& str, uint64_t& hash)
+{
+	size_t start = (str.size() > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) ? 2 : 0;
+	if(str.size() - start != 16) {
+		return false;
+	}
+
+	hash = 0;
+	for(size_t i = start; i < str.size(); i++) {
+		char c = str[i];
+		uint64_t digit;
+		if(c >= '0' && c <= '9') {
+			digit = c - '0';
+		} else if(c >= 'a' && c <= 'f') {
+			digit = c - 'a' + 10;
+		} else if(c >= 'A' && c <= 'F') {
+			digit = c - 'A' + 10;
+		} else {
+			return false;
+		}
+		hash = (hash << 4) | digit;
+	}
+	return true;
+}
+
+bool Load(const std::string& filename, std::vector<FrameHash>& hashes)
+{
+	std::ifstream in(filename);
+	if(!in) {
+		return false;
+	}
+
+	std::string line;
+	while(std::getline(in, line)) {
+		size_t start = line.find_first_not_of(" \t\r");
+		if(start == std::string::npos || line[start] == '#') {
+			continue;
+		}
+
+		std::istringstream ss(line);
+		std::string frameStr, hashStr;
+		FrameHash entry;
+		ss >> frameStr >> hashStr;
+		try {
+			entry.frame = (uint32_t)std::stoul(frameStr);
+		} catch(...) {
+			return false;
+		}
+		if(!ParseHash(hashStr, entry.hash)) {
+			return false;
+		}
+		hashes.push_back(entry);
+	}
+	return true;
+}
+
+bool Save(const std::string& filename, const std::vector<FrameHash>& hashes)
+{
+	FILE* out = fopen(filename.c_str(), "w");
+	if(!out) {
+		return false;
+	}
+	fprintf(out, "# frame hash (xxh64 of the raw PPU output)\n");
+	for(const FrameHash& entry : hashes) {
+		fprintf(out, "%u %016" PRIX64 "\n", entry.frame, entry.hash);
+	}
+	fclose(out);
+	return true;
+}
+
+std::vector<FrameHashMismatch> Compare(const std::vector<FrameHash>& golden, const std::vector<FrameHash>& actual)
+{
+	std::vector<FrameHashMismatch> mismatches;
+	for(const FrameHash& expected : golden) {
+		auto it = std::lower_bound(actual.begin(), actual.end(), expected.frame, [](const FrameHash& entry, uint32_t frame) {
+			return entry.frame < frame;
+		});
+
+		if(it == actual.end() || it->frame != expected.frame) {
+			mismatches.push_back({ expected.frame, expected.hash, 0, true });
+		} else if(it->hash != expected.hash) {
+			mismatches.push_back({ expected.frame, expected.hash, it->hash, false });
+		}
+	}
+	return mismatches;
+}
+
+FrameImageDiff CompareImages(const uint32_t* a, const uint32_t* b, uint32_t pixelCount, uint8_t tolerance)
+{
+	FrameImageDiff diff;
+	for(uint32_t i = 0; i < pixelCount; i++) {
+		if(((a[i] ^ b[i]) & 0xFFFFFF) == 0) {
+			continue;
+		}
+
+		uint8_t pixelDelta = 0;
+		for(int shift = 0; shift < 24; shift += 8) {
+			int delta = std::abs((int)((a[i] >> shift) & 0xFF) - (int)((b[i] >> shift) & 0xFF));
+			pixelDelta = std::max(pixelDelta, (uint8_t)delta);
+		}
+		diff.maxDelta = std::max(diff.maxDelta, pixelDelta);
+		if(pixelDelta > tolerance) {
+			diff.differentPixels++;
+		}
+	}
+	return diff;
+}
+
+}
+
+void FrameHashRecorder::OnFrame(uint32_t frameNumber, const uint16_t* buffer, uint32_t width, uint32_t height)
+{
+	FrameHash entry = { frameNumber, FrameHashes::Compute(buffer, width, height) };
+
+	std::lock_guard<std::mutex> lock(_lock);
+	_last = entry;
+	_hasLast = true;
+	if(_interval && frameNumber % _interval == 0) {
+		//Frame counter went back (e.g power cycle when a movie starts), drop the frames that will be rendered again
+		while(!_hashes.empty() && _hashes.back().frame >= frameNumber) {
+			_hashes.pop_back();
+		}
+		_hashes.push_back(entry);
+	}
+}
+
+std::vector<FrameHash> FrameHashRecorder::GetHashes()
+{
+	std::lock_guard<std::mutex> lock(_lock);
+	return _hashes;
+}
+
+bool FrameHashRecorder::GetLastHash(FrameHash& hash)
+{
+	std::lock_guard<std::mutex> lock(_lock);
+	hash = _last;
+	return _hasLast;
+}
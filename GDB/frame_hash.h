@@ -0,0 +1,59 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+struct FrameHash {
+	uint32_t frame;
+	uint64_t hash;
+};
+
+struct FrameHashMismatch {
+	uint32_t frame;
+	uint64_t expected;
+	uint64_t actual;
+	bool missing;         // frame was never rendered (or not recorded)
+};
+
+struct FrameImageDiff {
+	uint32_t differentPixels = 0;  // pixels with a channel outside the tolerance
+	uint8_t maxDelta = 0;          // largest channel difference over the whole image
+};
+
+namespace FrameHashes {
+	// XXH64 of the raw 16-bit PPU output (before any filter, so it doesn't depend on video settings)
+	uint64_t Compute(const uint16_t* buffer, uint32_t width, uint32_t height);
+
+	// 16 hex digits, with an optional 0x prefix
+	bool ParseHash(const std::string& str, uint64_t& hash);
+
+	// One "<frame> <hash>" pair per line, blank lines and lines starting with # are ignored
+	bool Load(const std::string& filename, std::vector<FrameHash>& hashes);
+	bool Save(const std::string& filename, const std::vector<FrameHash>& hashes);
+
+	// Golden frames that are missing from actual or have a different hash, actual must be sorted by frame
+	std::vector<FrameHashMismatch> Compare(const std::vector<FrameHash>& golden, const std::vector<FrameHash>& actual);
+
+	// Compares two ARGB images (alpha is ignored), a pixel matches when all channels are within tolerance
+	FrameImageDiff CompareImages(const uint32_t* a, const uint32_t* b, uint32_t pixelCount, uint8_t tolerance);
+}
+
+// Hashes the frames sent by the PPU, called on the emulation thread
+class FrameHashRecorder {
+private:
+	std::mutex _lock;
+	uint32_t _interval = 0;
+	std::vector<FrameHash> _hashes;
+	FrameHash _last = {};
+	bool _hasLast = false;
+
+public:
+	// Keep the hash of every Nth frame (0 = only keep the last frame's hash)
+	void SetInterval(uint32_t interval) { _interval = interval; }
+
+	void OnFrame(uint32_t frameNumber, const uint16_t* buffer, uint32_t width, uint32_t height);
+
+	std::vector<FrameHash> GetHashes();
+	bool GetLastHash(FrameHash& hash);
+};
@@ -0,0 +1,147 @@
+#include "pch.h"
+#include "movie_checkpoints.h"
+#include "Core/Debugger/DAP/DapJson.h"
+#include <fstream>
+#include <sstream>
+
+namespace MovieCheckpoints {
+
+std::string GetExpectationFile(const std::string& moviePath)
+{
+	size_t dot = moviePath.find_last_of('.');
+	size_t slash = moviePath.find_last_of("/\\");
+	if(dot != std::string::npos && (slash == std::string::npos || dot > slash)) {
+		return moviePath.substr(0, dot) + ".hashes";
+	}
+	return moviePath + ".hashes";
+}
+
+bool Load(const std::string& filename, std::vector<MovieCheckpoint>& checkpoints)
+{
+	std::ifstream in(filename);
+	if(!in) {
+		return false;
+	}
+
+	std::string line;
+	while(std::getline(in, line)) {
+		size_t start = line.find_first_not_of(" \t\r");
+		if(start == std::string::npos || line[start] == '#') {
+			continue;
+		}
+
+		std::istringstream ss(line);
+		std::string frameStr;
+		MovieCheckpoint entry;
+		ss >> frameStr >> entry.ramHash >> entry.frameHash;
+		try {
+			entry.frame = (uint32_t)std::stoul(frameStr);
+		} catch(...) {
+			return false;
+		}
+		if(entry.ramHash.size() != 32 || entry.frameHash.size() != 32) {
+			return false;
+		}
+		checkpoints.push_back(entry);
+	}
+	return true;
+}
+
+bool Save(const std::string& filename, const std::vector<MovieCheckpoint>& checkpoints)
+{
+	FILE* out = fopen(filename.c_str(), "w");
+	if(!out) {
+		return false;
+	}
+	fprintf(out, "# frame ram_md5 frame_md5 (the last line is the end of the movie)\n");
+	for(const MovieCheckpoint& entry : checkpoints) {
+		fprintf(out, "%u %s %s\n", entry.frame, entry.ramHash.c_str(), entry.frameHash.c_str());
+	}
+	fclose(out);
+	return true;
+}
+
+std::vector<MovieCheckpointMismatch> Compare(const std::vector<MovieCheckpoint>& expected, const std::vector<MovieCheckpoint>& actual)
+{
+	std::vector<MovieCheckpointMismatch> mismatches;
+	size_t i = 0, j = 0;
+	while(i < expected.size() || j < actual.size()) {
+		if(j == actual.size() || (i < expected.size() && expected[i].frame < actual[j].frame)) {
+			mismatches.push_back({ expected[i].frame, false, false, true, false });
+			i++;
+		} else if(i == expected.size() || actual[j].frame < expected[i].frame) {
+			mismatches.push_back({ actual[j].frame, false, false, false, true });
+			j++;
+		} else {
+			bool ram = expected[i].ramHash != actual[j].ramHash;
+			bool video = expected[i].frameHash != actual[j].frameHash;
+			if(ram || video) {
+				mismatches.push_back({ expected[i].frame, ram, video, false, false });
+			}
+			i++;
+			j++;
+		}
+	}
+	return mismatches;
+}
+
+JsonValue BuildReport(const std::vector<MovieVerifyResult>& results, uint32_t threadCount, double totalMs)
+{
+	uint32_t passed = 0, failed = 0, recorded = 0, errors = 0;
+	JsonValue movies = JsonValue::MakeArray();
+	for(const MovieVerifyResult& result : results) {
+		if(result.status == "passed") {
+			passed++;
+		} else if(result.status == "failed") {
+			failed++;
+		} else if(result.status == "recorded") {
+			recorded++;
+		} else {
+			errors++;
+		}
+
+		JsonValue entry = JsonValue::MakeObject();
+		entry.Set("movie", JsonValue::MakeString(result.movie));
+		entry.Set("status", JsonValue::MakeString(result.status));
+		if(!result.error.empty()) {
+			entry.Set("error", JsonValue::MakeString(result.error));
+		}
+		entry.Set("frames", JsonValue::MakeNumber(result.frames));
+		entry.Set("checkpoints", JsonValue::MakeNumber((double)result.checkpoints.size()));
+		entry.Set("loadMs", JsonValue::MakeNumber(result.loadMs));
+		entry.Set("runMs", JsonValue::MakeNumber(result.runMs));
+		entry.Set("fps", JsonValue::MakeNumber(result.runMs > 0 ? result.frames * 1000.0 / result.runMs : 0));
+
+		JsonValue mismatches = JsonValue::MakeArray();
+		for(const MovieCheckpointMismatch& mismatch : result.mismatches) {
+			JsonValue item = JsonValue::MakeObject();
+			item.Set("frame", JsonValue::MakeNumber(mismatch.frame));
+			if(mismatch.missing) {
+				item.Set("reason", JsonValue::MakeString("missing"));
+			} else if(mismatch.unexpected) {
+				item.Set("reason", JsonValue::MakeString("unexpected"));
+			} else {
+				item.Set("reason", JsonValue::MakeString(mismatch.ram && mismatch.video ? "ram+frame" : (mismatch.ram ? "ram" : "frame")));
+			}
+			mismatches.Push(std::move(item));
+		}
+		entry.Set("mismatches", std::move(mismatches));
+
+		if(!result.log.empty()) {
+			entry.Set("log", JsonValue::MakeString(result.log));
+		}
+		movies.Push(std::move(entry));
+	}
+
+	JsonValue report = JsonValue::MakeObject();
+	report.Set("threads", JsonValue::MakeNumber(threadCount));
+	report.Set("totalMs", JsonValue::MakeNumber(totalMs));
+	report.Set("passed", JsonValue::MakeNumber(passed));
+	report.Set("failed", JsonValue::MakeNumber(failed));
+	report.Set("recorded", JsonValue::MakeNumber(recorded));
+	report.Set("errors", JsonValue::MakeNumber(errors));
+	report.Set("movies", std::move(movies));
+	return report;
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class JsonValue;
+
+struct MovieCheckpoint {
+	uint32_t frame;
+	std::string ramHash;     // MD5 of every RAM region of the console (hex)
+	std::string frameHash;   // MD5 of the raw PPU frame buffer (hex)
+};
+
+struct MovieCheckpointMismatch {
+	uint32_t frame;
+	bool ram;                // RAM hash differs
+	bool video;              // frame hash differs
+	bool missing;            // expected checkpoint wasn't reached (e.g the movie ended earlier)
+	bool unexpected;         // checkpoint isn't in the expectations (e.g the movie ran longer)
+};
+
+struct MovieVerifyResult {
+	std::string movie;
+	std::string status;      // passed, failed, recorded or error
+	std::string error;
+	uint32_t frames = 0;
+	std::vector<MovieCheckpoint> checkpoints;
+	std::vector<MovieCheckpointMismatch> mismatches;
+	double loadMs = 0;
+	double runMs = 0;
+	std::string log;         // messages logged by this movie's emulator
+};
+
+namespace MovieCheckpoints {
+	// <movie without extension>.hashes, next to the movie
+	std::string GetExpectationFile(const std::string& moviePath);
+
+	// One "<frame> <ram md5> <frame md5>" line per checkpoint, blank lines and lines starting with # are ignored
+	bool Load(const std::string& filename, std::vector<MovieCheckpoint>& checkpoints);
+	bool Save(const std::string& filename, const std::vector<MovieCheckpoint>& checkpoints);
+
+	// Both lists must be sorted by frame
+	std::vector<MovieCheckpointMismatch> Compare(const std::vector<MovieCheckpoint>& expected, const std::vector<MovieCheckpoint>& actual);
+
+	JsonValue BuildReport(const std::vector<MovieVerifyResult>& results, uint32_t threadCount, double totalMs);
+}
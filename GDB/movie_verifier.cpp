@@ -0,0 +1,259 @@
+#include "pch.h"
+#include "movie_verifier.h"
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/SettingTypes.h"
+#include "Shared/MessageManager.h"
+#include "Shared/NotificationManager.h"
+#include "Shared/Interfaces/INotificationListener.h"
+#include "Shared/Movies/MovieManager.h"
+#include "Debugger/DebugUtilities.h"
+#include "Core/Debugger/DAP/DapJson.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/FolderUtilities.h"
+#include "Utilities/Timer.h"
+#include "Utilities/md5.h"
+#include <condition_variable>
+#include <mutex>
+#include <fstream>
+
+// Takes the checkpoint hashes on the emulation thread, when the PPU finishes a frame
+class MovieCheckpointRecorder : public INotificationListener {
+private:
+	Emulator* _emu;
+	uint32_t _interval;
+	std::mutex _mutex;
+	std::condition_variable _endSignal;
+	std::vector<MovieCheckpoint> _checkpoints;
+	uint32_t _frameCount = 0;
+	bool _active = false;
+	bool _ended = false;
+
+	MovieCheckpoint TakeCheckpoint(uint32_t frame)
+	{
+		MovieCheckpoint checkpoint;
+		checkpoint.frame = frame;
+
+		// Same MD5 logic as RecordedRomTest, applied to the raw frame and to every RAM region
+		PpuFrameInfo ppuFrame = _emu->GetPpuFrame();
+		checkpoint.frameHash = GetMd5Sum(ppuFrame.FrameBuffer, ppuFrame.FrameBufferSize);
+
+		MD5_CTX ctx;
+		MD5_Init(&ctx);
+		for(int i = 0; i < DebugUtilities::GetMemoryTypeCount(); i++) {
+			MemoryType type = (MemoryType)i;
+			if(DebugUtilities::IsRelativeMemory(type) || DebugUtilities::IsRom(type)) {
+				continue;
+			}
+			ConsoleMemoryInfo memory = _emu->GetMemory(type);
+			if(memory.Memory && memory.Size > 0) {
+				MD5_Update(&ctx, memory.Memory, memory.Size);
+			}
+		}
+		uint8_t md5[16];
+		MD5_Final(md5, &ctx);
+
+		char hex[33];
+		for(int i = 0; i < 16; i++) {
+			snprintf(hex + i * 2, 3, "%02X", md5[i]);
+		}
+		checkpoint.ramHash = hex;
+		return checkpoint;
+	}
+
+public:
+	MovieCheckpointRecorder(Emulator* emu, uint32_t interval) : _emu(emu), _interval(interval) {}
+
+	void Start()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_active = true;
+	}
+
+	void ProcessNotification(ConsoleNotificationType type, void* parameter) override
+	{
+		if(type != ConsoleNotificationType::PpuFrameDone) {
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if(!_active || _ended) {
+				return;
+			}
+			_frameCount++;
+		}
+
+		// The movie stops itself once its input runs out, the first frame after that is the final checkpoint
+		uint32_t frame = _emu->GetFrameCount();
+		bool ended = !_emu->GetMovieManager()->Playing();
+		if(ended || (_interval > 0 && frame > 0 && frame % _interval == 0)) {
+			MovieCheckpoint checkpoint = TakeCheckpoint(frame);
+			std::lock_guard<std::mutex> lock(_mutex);
+			_checkpoints.push_back(checkpoint);
+		}
+
+		if(ended) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			_ended = true;
+			_endSignal.notify_all();
+		}
+	}
+
+	bool WaitForEnd(int timeoutMs)
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		return _endSignal.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return _ended; });
+	}
+
+	std::vector<MovieCheckpoint> GetCheckpoints()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _checkpoints;
+	}
+
+	uint32_t GetFrameCount()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _frameCount;
+	}
+};
+
+MovieVerifier::MovieVerifier(const std::string& romPath, const std::string& movieFolder)
+	: _romPath(romPath), _movieFolder(movieFolder), _nextMovie(0)
+{
+}
+
+MovieVerifyResult MovieVerifier::VerifyMovie(Emulator* emu, const std::string& moviePath)
+{
+	MovieVerifyResult result;
+	result.movie = moviePath;
+
+	// Keep the messages of this movie (ROM load, movie errors, etc.) apart from the other workers'
+	MessageLog log;
+	MessageManager::SetThreadLog(&log);
+
+	Timer timer;
+	auto recorder = std::make_shared<MovieCheckpointRecorder>(emu, _checkpointInterval);
+	bool started = false;
+	if(emu->LoadRom((VirtualFile)_romPath, VirtualFile())) {
+		emu->GetNotificationManager()->RegisterNotificationListener(recorder);
+
+		// Hold the lock so no frame runs between the start of the movie and the start of the recorder
+		auto lock = emu->AcquireLock();
+		emu->GetMovieManager()->Play((VirtualFile)moviePath, true);
+		started = emu->GetMovieManager()->Playing();
+		if(started) {
+			recorder->Start();
+		} else {
+			result.error = "could not start movie playback";
+		}
+	} else {
+		result.error = "could not load ROM: " + _romPath;
+	}
+	result.loadMs = timer.GetElapsedMS();
+
+	timer.Reset();
+	if(started && !recorder->WaitForEnd(_timeoutMs)) {
+		result.error = "timeout after " + std::to_string(_timeoutMs) + "ms";
+	}
+	result.runMs = timer.GetElapsedMS();
+
+	// Battery files are not saved, several workers may be playing movies for the same game
+	emu->Stop(false, true, false);
+	MessageManager::SetThreadLog(nullptr);
+
+	result.log = log.Get();
+	result.frames = recorder->GetFrameCount();
+	result.checkpoints = recorder->GetCheckpoints();
+	if(!result.error.empty()) {
+		result.status = "error";
+		return result;
+	}
+
+	std::string expectationFile = MovieCheckpoints::GetExpectationFile(moviePath);
+	if(_updateExpectations) {
+		if(MovieCheckpoints::Save(expectationFile, result.checkpoints)) {
+			result.status = "recorded";
+		} else {
+			result.status = "error";
+			result.error = "could not write " + expectationFile;
+		}
+		return result;
+	}
+
+	std::vector<MovieCheckpoint> expected;
+	if(!MovieCheckpoints::Load(expectationFile, expected)) {
+		result.status = "error";
+		result.error = "could not read " + expectationFile + " (see --update-expectations)";
+		return result;
+	}
+
+	result.mismatches = MovieCheckpoints::Compare(expected, result.checkpoints);
+	result.status = result.mismatches.empty() ? "passed" : "failed";
+	return result;
+}
+
+void MovieVerifier::WorkerLoop()
+{
+	// Each worker owns its emulator, games are reloaded for every movie
+	std::unique_ptr<Emulator> emu(new Emulator());
+	emu->Initialize(false);
+	emu->GetSettings()->SetFlag(EmulationFlags::MaximumSpeed);
+	emu->GetSettings()->SetFlag(EmulationFlags::TestMode);
+
+	uint32_t index;
+	while((index = _nextMovie++) < _movies.size()) {
+		_results[index] = VerifyMovie(emu.get(), _movies[index]);
+	}
+
+	emu->Release();
+}
+
+int MovieVerifier::Run()
+{
+	_movies = FolderUtilities::GetFilesInFolder(_movieFolder, { ".mmo" }, false);
+	std::sort(_movies.begin(), _movies.end());
+	if(_movies.empty()) {
+		fprintf(stderr, "No movies (.mmo) found in %s\n", _movieFolder.c_str());
+		return 2;
+	}
+
+	_results.assign(_movies.size(), MovieVerifyResult());
+	_nextMovie = 0;
+	uint32_t threadCount = std::max<uint32_t>(1, std::min<uint32_t>(_threadCount, (uint32_t)_movies.size()));
+
+	Timer timer;
+	std::vector<std::thread> workers;
+	for(uint32_t i = 0; i < threadCount; i++) {
+		workers.emplace_back(&MovieVerifier::WorkerLoop, this);
+	}
+	for(std::thread& worker : workers) {
+		worker.join();
+	}
+	double totalMs = timer.GetElapsedMS();
+
+	int exitCode = 0;
+	for(MovieVerifyResult& result : _results) {
+		fprintf(stderr, "[%s] %s (%u frames, %.0f ms)%s%s\n", result.status.c_str(), result.movie.c_str(), result.frames, result.runMs,
+		        result.error.empty() ? "" : " - ", result.error.c_str());
+		if(result.status == "error") {
+			exitCode = 2;
+		} else if(result.status == "failed" && exitCode == 0) {
+			exitCode = 1;
+		}
+	}
+
+	std::string json = MovieCheckpoints::BuildReport(_results, threadCount, totalMs).Serialize();
+	if(_reportFile.empty()) {
+		std::cout << json << std::endl;
+	} else {
+		std::ofstream out(_reportFile);
+		if(!out) {
+			fprintf(stderr, "Error: could not open %s for writing\n", _reportFile.c_str());
+			return 2;
+		}
+		out << json << "\n";
+	}
+	return exitCode;
+}
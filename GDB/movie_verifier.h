@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "movie_checkpoints.h"
+
+class Emulator;
+
+// Plays every .mmo file of a folder with one emulator per worker thread (no video/audio output)
+// and compares RAM/frame hashes taken every N frames with the expectations stored next to each movie
+class MovieVerifier {
+private:
+	std::string _romPath;
+	std::string _movieFolder;
+	std::string _reportFile;
+	uint32_t _threadCount = 1;
+	uint32_t _checkpointInterval = 600;
+	int _timeoutMs = 600000;
+	bool _updateExpectations = false;
+
+	std::vector<std::string> _movies;
+	std::vector<MovieVerifyResult> _results;
+	std::atomic<uint32_t> _nextMovie;
+
+	void WorkerLoop();
+	MovieVerifyResult VerifyMovie(Emulator* emu, const std::string& moviePath);
+
+public:
+	MovieVerifier(const std::string& romPath, const std::string& movieFolder);
+
+	void SetThreadCount(uint32_t count) { _threadCount = count; }
+	void SetCheckpointInterval(uint32_t interval) { _checkpointInterval = interval; }
+	void SetTimeout(int timeoutMs) { _timeoutMs = timeoutMs; }
+	void SetUpdateExpectations(bool update) { _updateExpectations = update; }
+	void SetReportFile(const std::string& filename) { _reportFile = filename; }
+
+	int Run();  // returns exit code: 0 = all passed/recorded, 1 = mismatches, 2 = errors
+};
@@ -0,0 +1,94 @@
+#include "test_harness.h"
+#include "Core/Shared/AvStreamWriter.h"
+#include <fstream>
+#include <iterator>
+
+static std::vector<uint8_t> ReadFile(const std::string& path)
+{
+	std::ifstream in(path, std::ios::binary);
+	return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static uint32_t Read32(const std::vector<uint8_t>& data, size_t offset)
+{
+	return data[offset] | (data[offset + 1] << 8) | (data[offset + 2] << 16) | ((uint32_t)data[offset + 3] << 24);
+}
+
+TEST(av_stream_yuv_conversion)
+{
+	uint32_t argb[3] = { 0xFF000000, 0xFFFFFFFF, 0xFFFF0000 };
+	uint8_t y[3], u[3], v[3];
+	AvStreamWriter::ConvertToYuv444(argb, 3, y, u, v);
+	ASSERT_EQ(y[0], (uint8_t)16);
+	ASSERT_EQ(u[0], (uint8_t)128);
+	ASSERT_EQ(v[0], (uint8_t)128);
+	ASSERT_EQ(y[1], (uint8_t)235);
+	ASSERT_EQ(u[1], (uint8_t)128);
+	ASSERT_EQ(v[1], (uint8_t)128);
+	ASSERT_EQ(y[2], (uint8_t)82);
+	ASSERT_EQ(v[2], (uint8_t)240);
+}
+
+TEST(av_stream_writes_y4m_and_wav)
+{
+	std::string videoPath = "/tmp/mesen_test_av.y4m";
+	std::string audioPath = "/tmp/mesen_test_av.wav";
+
+	AvStreamWriter writer;
+	ASSERT_TRUE(writer.Start(videoPath, audioPath, 60.0988, true));
+
+	// Back-pressure keeps every frame even when the pool is smaller than the frame count
+	std::vector<uint32_t> frame(8 * 4, 0xFFFFFFFF);
+	std::vector<uint32_t> wideFrame(16 * 4, 0xFF000000);
+	for(int i = 0; i < 20; i++) {
+		writer.AddFrame(frame.data(), 8, 4);
+	}
+	writer.AddFrame(wideFrame.data(), 16, 4);
+
+	std::vector<int16_t> samples(800 * 2, 1000);
+	for(int i = 0; i < 10; i++) {
+		writer.AddAudio(samples.data(), 800, 48000);
+	}
+	writer.Stop();
+
+	ASSERT_EQ(writer.GetDroppedFrames(), 0u);
+	ASSERT_EQ(writer.GetDroppedSamples(), 0u);
+
+	std::vector<uint8_t> video = ReadFile(videoPath);
+	std::string header = "YUV4MPEG2 W8 H4 F60099:1000 Ip A1:1 C444\n";
+	ASSERT_TRUE(video.size() == header.size() + 21 * (6 + 8 * 4 * 3));
+	ASSERT_TRUE(std::string(video.begin(), video.begin() + header.size()) == header);
+	ASSERT_EQ(video[header.size() + 6], (uint8_t)235);
+	// The wider frame is scaled to the stream's size
+	ASSERT_EQ(video.back(), (uint8_t)128);
+	ASSERT_EQ(video[video.size() - 8 * 4 * 3], (uint8_t)16);
+
+	std::vector<uint8_t> audio = ReadFile(audioPath);
+	uint32_t dataSize = 10 * 800 * 4;
+	ASSERT_TRUE(audio.size() == 44 + dataSize);
+	ASSERT_EQ(Read32(audio, 4), dataSize + 36);
+	ASSERT_EQ(Read32(audio, 24), 48000u);
+	ASSERT_EQ(Read32(audio, 40), dataSize);
+
+	remove(videoPath.c_str());
+	remove(audioPath.c_str());
+}
+
+TEST(av_stream_raw_rgba)
+{
+	std::string videoPath = "/tmp/mesen_test_av.rgba";
+
+	AvStreamWriter writer;
+	ASSERT_TRUE(writer.Start(videoPath, "", 60.0, false));
+	uint32_t pixels[2] = { 0xFF112233, 0xFF445566 };
+	writer.AddFrame(pixels, 2, 1);
+	writer.Stop();
+
+	std::vector<uint8_t> video = ReadFile(videoPath);
+	ASSERT_EQ(video.size(), (size_t)8);
+	ASSERT_EQ(video[0], (uint8_t)0x11);
+	ASSERT_EQ(video[2], (uint8_t)0x33);
+	ASSERT_EQ(video[3], (uint8_t)0xFF);
+	ASSERT_EQ(video[4], (uint8_t)0x44);
+	remove(videoPath.c_str());
+}
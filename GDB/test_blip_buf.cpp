@@ -0,0 +1,95 @@
+#include "test_harness.h"
+#include "Utilities/Audio/blip_buf.h"
+#include "Utilities/Audio/BlipDeltaBuffer.h"
+#include "Utilities/SimdUtilities.h"
+#include <vector>
+
+namespace {
+	// Same random deltas added one at a time and as batches, over several frames
+	bool CompareBlip(double clockRate, uint32_t frameLength, uint32_t seed)
+	{
+		blip_t* ref = blip_new(4000);
+		blip_t* blk = blip_new(4000);
+		blip_set_rates(ref, clockRate, 96000);
+		blip_set_rates(blk, clockRate, 96000);
+		BlipDeltaBuffer deltas;
+
+		uint32_t state = seed;
+		auto next = [&state]() {
+			state = state * 1664525 + 1013904223;
+			return state >> 8;
+		};
+
+		bool match = true;
+		for(int frame = 0; frame < 20; frame++) {
+			uint32_t time = 0;
+			while(true) {
+				time += next() % 40;
+				if(time >= frameLength) {
+					break;
+				}
+				int delta = (int)(next() % 8000) - 4000;
+				blip_add_delta(ref, time, delta);
+				deltas.Add(time, delta);
+			}
+
+			deltas.Flush(blk);
+			blip_end_frame(ref, frameLength);
+			blip_end_frame(blk, frameLength);
+
+			std::vector<int16_t> expected(8000), actual(8000);
+			int count = blip_read_samples(ref, expected.data(), 4000, 1);
+			match &= blip_read_samples(blk, actual.data(), 4000, 1) == count && count > 0;
+			match &= expected == actual;
+		}
+
+		blip_delete(ref);
+		blip_delete(blk);
+		return match;
+	}
+}
+
+TEST(blip_add_deltas_matches_single_deltas)
+{
+	// Scalar and every SIMD implementation supported by the host
+	std::vector<SimdLevel> levels = { SimdLevel::None };
+	SimdLevel detected = SimdUtilities::DetectLevel();
+	if(detected == SimdLevel::Avx2) {
+		levels.push_back(SimdLevel::Sse41);
+	}
+	if(detected != SimdLevel::None) {
+		levels.push_back(detected);
+	}
+
+	int failures = 0;
+	for(SimdLevel level : levels) {
+		SimdUtilities::SetLevel(level);
+		failures += CompareBlip(1789773, 29780, 1) ? 0 : 1;         // NES
+		failures += CompareBlip(1024 * 1024 * 4, 20000, 2) ? 0 : 1; // Game Boy
+		failures += CompareBlip(3579545, 20000, 3) ? 0 : 1;         // PC Engine PSG
+	}
+	SimdUtilities::SetLevel(detected);
+	ASSERT_EQ(failures, 0);
+}
+
+TEST(blip_delta_buffer_clear)
+{
+	blip_t* blip = blip_new(4000);
+	blip_set_rates(blip, 1789773, 96000);
+
+	BlipDeltaBuffer deltas;
+	deltas.Add(100, 5000);
+	deltas.Clear();
+	deltas.Flush(blip);
+	blip_end_frame(blip, 29780);
+
+	std::vector<int16_t> out(4000);
+	int count = blip_read_samples(blip, out.data(), 4000, 0);
+	ASSERT_TRUE(count > 0);
+	bool silent = true;
+	for(int i = 0; i < count; i++) {
+		silent &= out[i] == 0;
+	}
+	ASSERT_TRUE(silent);
+	blip_delete(blip);
+}
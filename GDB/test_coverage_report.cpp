@@ -0,0 +1,67 @@
+#include "test_harness.h"
+#include "Core/Debugger/DAP/SourceMapper.h"
+#include "Core/Debugger/DAP/CoverageReport.h"
+#include <cstdio>
+#include <fstream>
+
+// iNES header segment + one 16-byte code segment with 3 lines and a data table
+static const char* CoverageDbg =
+	"version\tmajor=2,minor=0\n"
+	"file\tid=0,name=\"src/main.s\",size=100,mtime=0x00000000,mod=0\n"
+	"seg\tid=0,name=\"HEADER\",start=0x000000,size=0x0010,addrsize=absolute,type=ro,oname=\"game.nes\",ooffs=0\n"
+	"seg\tid=1,name=\"CODE\",start=0x008000,size=0x0010,addrsize=absolute,type=ro,oname=\"game.nes\",ooffs=16\n"
+	"span\tid=0,seg=0,start=0,size=16\n"
+	"span\tid=1,seg=1,start=0,size=2\n"
+	"span\tid=2,seg=1,start=2,size=3\n"
+	"span\tid=3,seg=1,start=5,size=1\n"
+	"span\tid=4,seg=1,start=8,size=4\n"
+	"line\tid=0,file=0,line=1,span=0\n"
+	"line\tid=1,file=0,line=10,span=1\n"
+	"line\tid=2,file=0,line=11,span=2\n"
+	"line\tid=3,file=0,line=12,span=3\n"
+	"line\tid=4,file=0,line=20,span=4\n";
+
+TEST(coverage_report_maps_cdl_to_lines)
+{
+	std::string path = "/tmp/mesen_test_coverage.dbg";
+	std::remove((path + ".idx").c_str());
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out << CoverageDbg;
+	}
+
+	SourceMapper mapper;
+	ASSERT_TRUE(mapper.LoadDbgFile(path));
+
+	// Lines 10 and 11 executed (only the first byte of line 11), table at line 20 read as data
+	uint8_t cdl[16] = {};
+	cdl[0] = cdl[1] = 0x01;
+	cdl[2] = 0x01;
+	cdl[9] = 0x02;
+
+	CoverageReport report;
+	report.Build(mapper, cdl, sizeof(cdl), 16);
+
+	// The header line is outside of the PRG ROM and isn't reported
+	ASSERT_EQ(report.GetFiles().size(), 1u);
+	const CoverageFile& file = report.GetFiles()[0];
+	ASSERT_EQ(file.lines.size(), 4u);
+	ASSERT_EQ(file.lines[0].line, 10);
+	ASSERT_TRUE(file.lines[0].code);
+	ASSERT_TRUE(file.lines[1].code);
+	ASSERT_FALSE(file.lines[2].code);
+	ASSERT_FALSE(file.lines[2].data);
+	ASSERT_TRUE(file.lines[3].data);
+	ASSERT_EQ(report.GetLineCount(), 4u);
+	ASSERT_EQ(report.GetHitLineCount(), 3u);
+
+	std::string lcov = report.ToLcov();
+	ASSERT_TRUE(lcov.find("SF:src/main.s\nDA:10,1\nDA:11,1\nDA:12,0\nDA:20,1\nLF:4\nLH:3\nend_of_record\n") != std::string::npos);
+
+	JsonValue json = report.ToJson();
+	ASSERT_EQ(json["linesHit"].GetUint(), 3u);
+	ASSERT_STR_EQ(json["files"][0]["name"].GetString(), "src/main.s");
+
+	std::remove(path.c_str());
+	std::remove((path + ".idx").c_str());
+}
@@ -0,0 +1,175 @@
+#include "test_harness.h"
+#include "Core/Debugger/DebugEventStore.h"
+#include "Core/Debugger/DebugEventLog.h"
+#include "Core/Debugger/BaseEventManager.h"
+#include <cstdio>
+#include <fstream>
+
+static DebugEventInfo MakeEvent(uint32_t i)
+{
+	DebugEventInfo evt = {};
+	evt.Type = DebugEventType::Register;
+	evt.Operation.Address = 0x2100 + (i & 0xFF);
+	evt.Operation.Value = (int32_t)i;
+	evt.Operation.Type = MemoryOperationType::Write;
+	evt.ProgramCounter = 0x8000 + i;
+	evt.Scanline = (int16_t)(i % 262);
+	evt.Cycle = (uint16_t)(i % 341);
+	evt.Flags = i & 0x3F;
+	evt.DmaChannel = -1;
+	return evt;
+}
+
+namespace {
+	class TestEventManager : public BaseEventManager
+	{
+	protected:
+		bool ShowPreviousFrameEvents() override { return false; }
+		void ConvertScanlineCycleToRowColumn(int32_t& x, int32_t& y) override {}
+		void DrawScreen(uint32_t* buffer) override {}
+
+	public:
+		void SetConfiguration(BaseEventViewerConfig& config) override {}
+		void AddEvent(DebugEventType type, MemoryOperationInfo& operation, int32_t breakpointId = -1) override {}
+		void AddEvent(DebugEventType type) override
+		{
+			DebugEventInfo evt = MakeEvent(0);
+			evt.Type = type;
+			AddDebugEvent(evt);
+		}
+		EventViewerCategoryCfg GetEventConfig(DebugEventInfo& evt) override { return { true, 0 }; }
+		uint32_t TakeEventSnapshot(bool forAutoRefresh) override { return 0; }
+		FrameInfo GetDisplayBufferSize() override { return { 0, 0 }; }
+		DebugEventInfo GetEvent(uint16_t scanline, uint16_t cycle) override { return {}; }
+	};
+
+	//Returns the (frame number, event count) of each frame block in an event log file
+	std::vector<std::pair<uint32_t, uint32_t>> ReadLogFrames(const std::string& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		std::vector<std::pair<uint32_t, uint32_t>> frames;
+		size_t pos = 8;
+		while(pos + 8 <= data.size()) {
+			uint32_t frame = data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16) | (data[pos + 3] << 24);
+			uint32_t count = data[pos + 4] | (data[pos + 5] << 8) | (data[pos + 6] << 16) | (data[pos + 7] << 24);
+			frames.push_back({ frame, count });
+			pos += 8 + count * DebugEventLog::RecordSize;
+		}
+		return frames;
+	}
+}
+
+TEST(debug_event_store_round_trip)
+{
+	DebugEventStore store;
+	for(uint32_t i = 0; i < 10000; i++) {
+		DebugEventInfo evt = MakeEvent(i);
+		ASSERT_TRUE(store.Add(evt));
+	}
+	ASSERT_EQ(store.GetCount(), 10000u);
+
+	int mismatches = 0;
+	for(uint32_t i = 0; i < 10000; i++) {
+		DebugEventInfo expected = MakeEvent(i);
+		DebugEventInfo evt = store.Get(i);
+		if(evt.Operation.Address != expected.Operation.Address || evt.Operation.Value != expected.Operation.Value ||
+			evt.ProgramCounter != expected.ProgramCounter || evt.Scanline != expected.Scanline ||
+			evt.Cycle != expected.Cycle || evt.Flags != expected.Flags || evt.DmaChannel != -1 ||
+			store.GetScanline(i) != expected.Scanline || store.GetCycle(i) != expected.Cycle
+		) {
+			mismatches++;
+		}
+	}
+	ASSERT_EQ(mismatches, 0);
+
+	store.Clear();
+	ASSERT_EQ(store.GetCount(), 0u);
+}
+
+TEST(debug_event_store_dma_configs)
+{
+	DebugEventStore store;
+	for(uint32_t i = 0; i < 300; i++) {
+		DebugEventInfo evt = MakeEvent(i);
+		evt.DmaChannel = (int8_t)(i & 0x07);
+		evt.DmaChannelInfo.SrcAddress = (uint16_t)(0x1000 + (i % 3));
+		evt.DmaChannelInfo.DestAddress = 0x18;
+		evt.DmaChannelInfo.TransferMode = 1;
+		store.Add(evt);
+	}
+
+	DebugEventInfo evt = store.Get(298);
+	ASSERT_EQ(evt.DmaChannel, 2);
+	ASSERT_EQ(evt.DmaChannelInfo.SrcAddress, 0x1001);
+	ASSERT_EQ(evt.DmaChannelInfo.DestAddress, 0x18);
+	ASSERT_EQ(evt.DmaChannelInfo.TransferMode, 1);
+}
+
+TEST(debug_event_log_records)
+{
+	DebugEventStore store;
+	for(uint32_t i = 0; i < 3; i++) {
+		DebugEventInfo evt = MakeEvent(i);
+		store.Add(evt);
+	}
+
+	std::string path = "/tmp/mesen_test_event_log.bin";
+	{
+		DebugEventLog log;
+		ASSERT_TRUE(log.Open(path));
+		log.WriteFrame(7, store, store.GetCount());
+	}
+
+	std::ifstream in(path, std::ios::binary);
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	std::remove(path.c_str());
+
+	ASSERT_EQ(data.size(), 8u + 8u + 3u * DebugEventLog::RecordSize);
+	ASSERT_TRUE(memcmp(data.data(), "MEVL", 4) == 0);
+	ASSERT_EQ(data[8], 7);
+	ASSERT_EQ(data[12], 3);
+
+	//2nd record: PC at offset 8, address at offset 12
+	uint8_t* rec = data.data() + 16 + DebugEventLog::RecordSize;
+	ASSERT_EQ(rec[8] | (rec[9] << 8), 0x8001);
+	ASSERT_EQ(rec[12] | (rec[13] << 8), 0x2101);
+}
+
+TEST(debug_event_log_reset_and_close)
+{
+	std::string path = "/tmp/mesen_test_event_log_frames.bin";
+	{
+		TestEventManager evtMgr;
+		ASSERT_TRUE(evtMgr.StartEventLog(path));
+
+		evtMgr.AddEvent(DebugEventType::Register);
+		evtMgr.ClearFrameEvents();
+
+		//A reset drops the unfinished frame without logging it or counting a frame
+		evtMgr.AddEvent(DebugEventType::Register);
+		evtMgr.ResetEvents();
+
+		evtMgr.AddEvent(DebugEventType::Register);
+		evtMgr.AddEvent(DebugEventType::Register);
+		evtMgr.ClearFrameEvents();
+
+		//The unfinished frame is written when the log is closed
+		evtMgr.AddEvent(DebugEventType::Register);
+		evtMgr.StopEventLog();
+		evtMgr.ClearFrameEvents();
+	}
+
+	std::vector<std::pair<uint32_t, uint32_t>> frames = ReadLogFrames(path);
+	std::remove(path.c_str());
+
+	ASSERT_EQ(frames.size(), (size_t)3);
+	if(frames.size() == 3) {
+		ASSERT_EQ(frames[0].first, 0u);
+		ASSERT_EQ(frames[0].second, 1u);
+		ASSERT_EQ(frames[1].first, 1u);
+		ASSERT_EQ(frames[1].second, 2u);
+		ASSERT_EQ(frames[2].first, 2u);
+		ASSERT_EQ(frames[2].second, 1u);
+	}
+}
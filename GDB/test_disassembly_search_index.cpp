@@ -0,0 +1,83 @@
+#include "test_harness.h"
+#include "Core/Debugger/DisassemblySearchIndex.h"
+
+static uint32_t CountCandidates(std::vector<uint8_t>& candidates)
+{
+	uint32_t count = 0;
+	for(uint8_t c : candidates) {
+		count += c;
+	}
+	return count;
+}
+
+TEST(disassembly_search_index_candidates)
+{
+	DisassemblySearchIndex index;
+	index.AddPending(MemoryType::SnesPrgRom, 0x10);
+	index.AddPending(MemoryType::SnesWorkRam, 0x20);
+
+	auto pending = index.TakePending();
+	ASSERT_EQ(pending.size(), 2u);
+	ASSERT_TRUE(index.TakePending().empty());
+
+	index.Add(MemoryType::SnesPrgRom, 0x10, "STA");
+	index.Add(MemoryType::SnesPrgRom, 0x13, "LDA");
+	index.Add(MemoryType::SnesWorkRam, 0x20, "STA");
+	index.Add(MemoryType::GbPrgRom, 0x05, "LDH");
+
+	ASSERT_TRUE(index.HasMnemonic("sta", false));
+	ASSERT_FALSE(index.HasMnemonic("sta", true));
+	ASSERT_FALSE(index.HasMnemonic("st", false));
+
+	std::vector<uint8_t> candidates[(int)MemoryType::None + 1];
+	index.GetCandidates("sta", false, candidates);
+	ASSERT_EQ(CountCandidates(candidates[(int)MemoryType::SnesPrgRom]), 1u);
+	ASSERT_EQ(candidates[(int)MemoryType::SnesPrgRom][0x10], 1);
+	ASSERT_EQ(CountCandidates(candidates[(int)MemoryType::SnesWorkRam]), 1u);
+	ASSERT_TRUE(candidates[(int)MemoryType::GbPrgRom].empty());
+}
+
+TEST(disassembly_search_index_suffix_and_reset)
+{
+	DisassemblySearchIndex index;
+	index.Add(MemoryType::NesPrgRom, 1, "LDA");
+	index.Add(MemoryType::NesPrgRom, 2, "DA");
+	index.Add(MemoryType::NesWorkRam, 3, "LDA");
+
+	//Search text can start in the middle of the mnemonic
+	std::vector<uint8_t> candidates[(int)MemoryType::None + 1];
+	index.GetCandidates("DA", true, candidates);
+	ASSERT_EQ(CountCandidates(candidates[(int)MemoryType::NesPrgRom]), 2u);
+
+	index.Reset(MemoryType::NesPrgRom, 0);
+	std::vector<uint8_t> afterReset[(int)MemoryType::None + 1];
+	index.GetCandidates("LDA", true, afterReset);
+	ASSERT_TRUE(afterReset[(int)MemoryType::NesPrgRom].empty());
+	ASSERT_EQ(CountCandidates(afterReset[(int)MemoryType::NesWorkRam]), 1u);
+}
+
+TEST(disassembly_search_index_queues_each_address_once)
+{
+	DisassemblySearchIndex index;
+	index.Reset(MemoryType::SnesPrgRom, 0x100);
+
+	//Re-initializing an address (e.g after an M/X flag change) doesn't queue it again
+	index.AddPending(MemoryType::SnesPrgRom, 0x10);
+	index.AddPending(MemoryType::SnesPrgRom, 0x10);
+	index.AddPending(MemoryType::SnesPrgRom, 0x11);
+	ASSERT_EQ(index.TakePending().size(), 2u);
+
+	index.AddPending(MemoryType::SnesPrgRom, 0x10);
+	ASSERT_TRUE(index.TakePending().empty());
+
+	//Once its instruction is invalidated, the address is queued again
+	index.Invalidate(MemoryType::SnesPrgRom, 0x10);
+	index.AddPending(MemoryType::SnesPrgRom, 0x10);
+	index.AddPending(MemoryType::SnesPrgRom, 0x11);
+	ASSERT_EQ(index.TakePending().size(), 1u);
+
+	//Reset forgets which addresses were queued
+	index.Reset(MemoryType::SnesPrgRom, 0x100);
+	index.AddPending(MemoryType::SnesPrgRom, 0x11);
+	ASSERT_EQ(index.TakePending().size(), 1u);
+}
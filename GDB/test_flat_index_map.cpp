@@ -0,0 +1,69 @@
+#include "test_harness.h"
+#include "Utilities/FlatIndexMap.h"
+#include <random>
+
+TEST(flat_index_map_assigns_dense_indexes)
+{
+	FlatIndexMap map(4);
+	bool added = false;
+
+	ASSERT_EQ(map.GetOrAdd(100, added), 0u);
+	ASSERT_TRUE(added);
+	ASSERT_EQ(map.GetOrAdd(200, added), 1u);
+	ASSERT_TRUE(added);
+	ASSERT_EQ(map.GetOrAdd(100, added), 0u);
+	ASSERT_FALSE(added);
+
+	ASSERT_EQ(map.Find(200), 1);
+	ASSERT_EQ(map.Find(300), -1);
+	ASSERT_EQ(map.GetCount(), 2u);
+}
+
+TEST(flat_index_map_survives_growth)
+{
+	//Start small to force several rehashes, and compare against unordered_map
+	FlatIndexMap map(2);
+	std::unordered_map<uint64_t, uint32_t> ref;
+	std::mt19937_64 rng(42);
+
+	int mismatches = 0;
+	for(int i = 0; i < 50000; i++) {
+		//Small key range so that many lookups hit existing keys
+		uint64_t key = rng() % 20000 | ((rng() & 1) << 40);
+		bool added = false;
+		uint32_t index = map.GetOrAdd(key, added);
+
+		auto result = ref.find(key);
+		if(result == ref.end()) {
+			if(!added || index != ref.size()) {
+				mismatches++;
+			}
+			ref[key] = index;
+		} else if(added || result->second != index) {
+			mismatches++;
+		}
+	}
+	ASSERT_EQ(mismatches, 0);
+	ASSERT_EQ((size_t)map.GetCount(), ref.size());
+
+	for(auto& entry : ref) {
+		if(map.Find(entry.first) != (int32_t)entry.second) {
+			mismatches++;
+		}
+	}
+	ASSERT_EQ(mismatches, 0);
+}
+
+TEST(flat_index_map_clear)
+{
+	FlatIndexMap map;
+	bool added = false;
+	map.GetOrAdd(5, added);
+	map.GetOrAdd(6, added);
+	map.Clear();
+
+	ASSERT_EQ(map.GetCount(), 0u);
+	ASSERT_EQ(map.Find(5), -1);
+	ASSERT_EQ(map.GetOrAdd(6, added), 0u);
+	ASSERT_TRUE(added);
+}
@@ -0,0 +1,167 @@
+#include "test_harness.h"
+#include "Core/Shared/Utilities/emu2413.h"
+#include "Utilities/Audio/ymfm/ymfm_opn.h"
+#include <vector>
+
+namespace {
+	struct RegWrite {
+		uint32_t sample;
+		uint8_t reg;
+		uint8_t value;
+	};
+
+	// Random register writes at random sample positions, with enough key-ons to produce sound
+	std::vector<RegWrite> MakeWrites(uint32_t seed, uint32_t sampleCount, uint8_t regMask, bool rhythm)
+	{
+		std::vector<RegWrite> writes;
+		uint32_t state = seed;
+		auto next = [&state]() {
+			state = state * 1664525 + 1013904223;
+			return state >> 8;
+		};
+
+		uint32_t sample = 0;
+		while(sample < sampleCount) {
+			sample += next() % 700;
+			uint8_t reg = (uint8_t)(next() & regMask);
+			uint8_t value = (uint8_t)next();
+			if(reg == 0x0E && !rhythm) {
+				value &= ~0x20;
+			} else if(reg == 0x0F) {
+				// Test register, only enable it rarely
+				value = (next() % 8) == 0 ? value : 0;
+			} else if(reg >= 0x20 && reg <= 0x28) {
+				value |= 0x10;
+			}
+			writes.push_back({ sample, reg, value });
+		}
+		return writes;
+	}
+
+	// Renders the same sequence of writes with OPLL_calc and with OPLL_calcBlock (flushed at each write)
+	bool CompareOpll(uint32_t clk, uint32_t rate, uint8_t chipType, uint32_t mask, bool rhythm, uint32_t seed)
+	{
+		constexpr uint32_t sampleCount = 40000;
+		std::vector<RegWrite> writes = MakeWrites(seed, sampleCount, 0x3F, rhythm);
+
+		OPLL* ref = OPLL_new(clk, rate);
+		OPLL* blk = OPLL_new(clk, rate);
+		for(OPLL* opll : { ref, blk }) {
+			OPLL_setChipType(opll, chipType);
+			OPLL_resetPatch(opll, chipType);
+			OPLL_reset(opll);
+			OPLL_setMask(opll, mask);
+		}
+
+		std::vector<int16_t> expected(sampleCount);
+		std::vector<int16_t> actual(sampleCount);
+		size_t w = 0;
+		for(uint32_t i = 0; i < sampleCount; i++) {
+			for(; w < writes.size() && writes[w].sample == i; w++) {
+				OPLL_writeReg(ref, writes[w].reg, writes[w].value);
+			}
+			expected[i] = OPLL_calc(ref);
+		}
+
+		uint32_t pos = 0;
+		for(w = 0; w <= writes.size(); w++) {
+			uint32_t end = w < writes.size() ? std::min(writes[w].sample, sampleCount) : sampleCount;
+			if(end > pos) {
+				OPLL_calcBlock(blk, actual.data() + pos, end - pos);
+				pos = end;
+			}
+			if(w < writes.size() && writes[w].sample < sampleCount) {
+				OPLL_writeReg(blk, writes[w].reg, writes[w].value);
+			}
+		}
+
+		bool match = expected == actual;
+		bool hasSound = false;
+		for(int16_t sample : expected) {
+			hasSound |= sample != 0;
+		}
+		match &= hasSound;
+		for(int i = 0; i < 14; i++) {
+			match &= ref->ch_out[i] == blk->ch_out[i];
+		}
+		match &= ref->eg_counter == blk->eg_counter && ref->noise == blk->noise && ref->out_time == blk->out_time;
+
+		OPLL_delete(ref);
+		OPLL_delete(blk);
+		return match;
+	}
+
+	class TestOpnInterface : public ymfm::ymfm_interface {
+	};
+}
+
+TEST(fm_block_opll_matches_per_sample_ym2413)
+{
+	// SMS setup: the internal rate doesn't exactly match the output rate (some output samples need 2 updates)
+	uint32_t smsClock = 53693175;
+	ASSERT_TRUE(CompareOpll(smsClock, smsClock / 72, 0, 0, false, 1));
+	ASSERT_TRUE(CompareOpll(smsClock, smsClock / 72, 0, 0, true, 2));
+	ASSERT_TRUE(CompareOpll(smsClock, smsClock / 72, 0, OPLL_MASK_CH(1) | OPLL_MASK_CH(4) | OPLL_MASK_HH, true, 3));
+}
+
+TEST(fm_block_opll_matches_per_sample_vrc7)
+{
+	ASSERT_TRUE(CompareOpll(49716 * 72, 49716, 1, 0, false, 4));
+	ASSERT_TRUE(CompareOpll(49716 * 72, 49716, 1, OPLL_MASK_CH(0), false, 5));
+}
+
+TEST(fm_block_opll_matches_per_sample_rate_conversion)
+{
+	ASSERT_TRUE(CompareOpll(3579545, 44100, 0, 0, true, 6));
+}
+
+TEST(fm_block_opn_generate_block_matches_single_samples)
+{
+	constexpr uint32_t sampleCount = 20000;
+	std::vector<RegWrite> writes = MakeWrites(7, sampleCount, 0xFF, false);
+
+	TestOpnInterface refIntf, blkIntf;
+	ymfm::ymf288 ref(refIntf), blk(blkIntf);
+	for(ymfm::ymf288* opn : { &ref, &blk }) {
+		opn->set_fidelity(ymfm::OPN_FIDELITY_MED);
+		opn->reset();
+	}
+
+	auto write = [](ymfm::ymf288& opn, const RegWrite& entry) {
+		// Alternates between both register banks, all channels keyed on with some of the writes
+		uint8_t bank = (entry.value & 0x01) ? 2 : 0;
+		opn.write(bank, entry.reg);
+		opn.write(bank + 1, entry.reg == 0x28 ? (entry.value | 0xF0) : entry.value);
+	};
+
+	std::vector<int32_t> expected, actual;
+	size_t w = 0;
+	for(uint32_t i = 0; i < sampleCount; i++) {
+		for(; w < writes.size() && writes[w].sample == i; w++) {
+			write(ref, writes[w]);
+		}
+		ymfm::ymf288::output_data output;
+		ref.generate(&output, 1);
+		expected.insert(expected.end(), { output.data[0], output.data[1], output.data[2] });
+	}
+
+	uint32_t pos = 0;
+	for(w = 0; w <= writes.size(); w++) {
+		uint32_t end = w < writes.size() ? std::min(writes[w].sample, sampleCount) : sampleCount;
+		while(pos < end) {
+			ymfm::ymf288::output_data output[64];
+			uint32_t count = std::min<uint32_t>(end - pos, 64);
+			blk.generate(output, count);
+			for(uint32_t i = 0; i < count; i++) {
+				actual.insert(actual.end(), { output[i].data[0], output[i].data[1], output[i].data[2] });
+			}
+			pos += count;
+		}
+		if(w < writes.size() && writes[w].sample < sampleCount) {
+			write(blk, writes[w]);
+		}
+	}
+
+	ASSERT_EQ(expected.size(), actual.size());
+	ASSERT_TRUE(expected == actual);
+}
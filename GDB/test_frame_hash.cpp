@@ -0,0 +1,119 @@
+#include "test_harness.h"
+#include "GDB/frame_hash.h"
+#include "Utilities/XxHash.h"
+#include <cstdio>
+
+TEST(frame_hash_xxh64_reference_values)
+{
+	ASSERT_TRUE(XxHash::GetHash("", 0) == 0xEF46DB3751D8E999ULL);
+	ASSERT_TRUE(XxHash::GetHash("abc", 3) == 0x44BC2CF5AD770999ULL);
+
+	// Covers the 32-byte stripes and the 8/4/1 byte tails
+	std::vector<uint8_t> data(1000);
+	for(size_t i = 0; i < data.size(); i++) {
+		data[i] = (uint8_t)(i * 7 + 3);
+	}
+	ASSERT_TRUE(XxHash::GetHash(data.data(), data.size()) == 0x5F235FA033F1A3FBULL);
+	ASSERT_TRUE(XxHash::GetHash(data.data(), 101, 12345) == 0x046DCCA647FF92A6ULL);
+}
+
+TEST(frame_hash_parse)
+{
+	uint64_t hash = 0;
+	ASSERT_TRUE(FrameHashes::ParseHash("0123456789abcdef", hash));
+	ASSERT_TRUE(hash == 0x0123456789ABCDEFULL);
+	ASSERT_TRUE(FrameHashes::ParseHash("0xFEDCBA9876543210", hash));
+	ASSERT_TRUE(hash == 0xFEDCBA9876543210ULL);
+	ASSERT_FALSE(FrameHashes::ParseHash("1234", hash));
+	ASSERT_FALSE(FrameHashes::ParseHash("golden.png", hash));
+	ASSERT_FALSE(FrameHashes::ParseHash("0123456789abcdeg", hash));
+}
+
+TEST(frame_hash_save_load_roundtrip)
+{
+	std::string path = "/tmp/mesen_test_frame_hashes.txt";
+	std::vector<FrameHash> hashes = { { 60, 0x1122334455667788ULL }, { 120, 0x00000000000000FFULL } };
+	ASSERT_TRUE(FrameHashes::Save(path, hashes));
+
+	std::vector<FrameHash> loaded;
+	ASSERT_TRUE(FrameHashes::Load(path, loaded));
+	ASSERT_EQ(loaded.size(), (size_t)2);
+	ASSERT_EQ(loaded[0].frame, 60u);
+	ASSERT_TRUE(loaded[0].hash == hashes[0].hash);
+	ASSERT_EQ(loaded[1].frame, 120u);
+	ASSERT_TRUE(loaded[1].hash == hashes[1].hash);
+	remove(path.c_str());
+}
+
+TEST(frame_hash_compare_reports_mismatches)
+{
+	std::vector<FrameHash> golden = { { 1, 0xA }, { 2, 0xB }, { 5, 0xC } };
+	std::vector<FrameHash> actual = { { 1, 0xA }, { 2, 0xD }, { 3, 0xE } };
+
+	std::vector<FrameHashMismatch> mismatches = FrameHashes::Compare(golden, actual);
+	ASSERT_EQ(mismatches.size(), (size_t)2);
+	ASSERT_EQ(mismatches[0].frame, 2u);
+	ASSERT_FALSE(mismatches[0].missing);
+	ASSERT_TRUE(mismatches[0].actual == 0xD);
+	ASSERT_EQ(mismatches[1].frame, 5u);
+	ASSERT_TRUE(mismatches[1].missing);
+
+	ASSERT_TRUE(FrameHashes::Compare(actual, actual).empty());
+}
+
+TEST(frame_hash_compare_images_tolerance)
+{
+	uint32_t a[4] = { 0xFF102030, 0xFF000000, 0xFFFFFFFF, 0x00808080 };
+	uint32_t b[4] = { 0x00102030, 0xFF000003, 0xFFFFF0FF, 0xFF808080 };
+
+	FrameImageDiff diff = FrameHashes::CompareImages(a, b, 4, 0);
+	ASSERT_EQ(diff.differentPixels, 2u);
+	ASSERT_EQ(diff.maxDelta, (uint8_t)0x0F);
+
+	diff = FrameHashes::CompareImages(a, b, 4, 3);
+	ASSERT_EQ(diff.differentPixels, 1u);
+
+	diff = FrameHashes::CompareImages(a, b, 4, 15);
+	ASSERT_EQ(diff.differentPixels, 0u);
+}
+
+TEST(frame_hash_recorder_interval)
+{
+	std::vector<uint16_t> buffer(256 * 240, 0x7FFF);
+	FrameHashRecorder recorder;
+	recorder.SetInterval(2);
+	for(uint32_t frame = 1; frame <= 6; frame++) {
+		buffer[frame] = (uint16_t)frame;
+		recorder.OnFrame(frame, buffer.data(), 256, 240);
+	}
+
+	std::vector<FrameHash> hashes = recorder.GetHashes();
+	ASSERT_EQ(hashes.size(), (size_t)3);
+	ASSERT_EQ(hashes[0].frame, 2u);
+	ASSERT_EQ(hashes[2].frame, 6u);
+	ASSERT_TRUE(hashes[0].hash != hashes[1].hash);
+
+	FrameHash last;
+	ASSERT_TRUE(recorder.GetLastHash(last));
+	ASSERT_EQ(last.frame, 6u);
+	ASSERT_TRUE(last.hash == FrameHashes::Compute(buffer.data(), 256, 240));
+
+	// Frame counter reset (power cycle) replaces the frames rendered again
+	recorder.OnFrame(4, buffer.data(), 256, 240);
+	hashes = recorder.GetHashes();
+	ASSERT_EQ(hashes.size(), (size_t)2);
+	ASSERT_EQ(hashes[1].frame, 4u);
+}
+
+TEST(frame_hash_recorder_last_only)
+{
+	std::vector<uint16_t> buffer(16, 0);
+	FrameHashRecorder recorder;
+	FrameHash last;
+	ASSERT_FALSE(recorder.GetLastHash(last));
+
+	recorder.OnFrame(10, buffer.data(), 4, 4);
+	ASSERT_TRUE(recorder.GetHashes().empty());
+	ASSERT_TRUE(recorder.GetLastHash(last));
+	ASSERT_EQ(last.frame, 10u);
+}
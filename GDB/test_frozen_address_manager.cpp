@@ -0,0 +1,67 @@
+#include "test_harness.h"
+#include "Core/Debugger/FrozenAddressManager.h"
+#include <random>
+#include <unordered_set>
+
+TEST(frozen_address_manager_ranges)
+{
+	FrozenAddressManager mgr;
+	ASSERT_FALSE(mgr.IsFrozenAddress(0));
+	ASSERT_FALSE(mgr.IsFrozenAddress(0xFFFFFFFF));
+
+	//Range that spans several pages, with unaligned bounds
+	mgr.UpdateFrozenAddresses(0x0FF3, 0x3005, true);
+	ASSERT_FALSE(mgr.IsFrozenAddress(0x0FF2));
+	ASSERT_TRUE(mgr.IsFrozenAddress(0x0FF3));
+	ASSERT_TRUE(mgr.IsFrozenAddress(0x2000));
+	ASSERT_TRUE(mgr.IsFrozenAddress(0x3005));
+	ASSERT_FALSE(mgr.IsFrozenAddress(0x3006));
+
+	mgr.UpdateFrozenAddresses(0x1000, 0x2FFF, false);
+	ASSERT_TRUE(mgr.IsFrozenAddress(0x0FFF));
+	ASSERT_FALSE(mgr.IsFrozenAddress(0x1000));
+	ASSERT_FALSE(mgr.IsFrozenAddress(0x2FFF));
+	ASSERT_TRUE(mgr.IsFrozenAddress(0x3000));
+
+	//Unfreezing past the end of the allocated pages is allowed
+	mgr.UpdateFrozenAddresses(0, 0xFFFFFFFF, false);
+	ASSERT_FALSE(mgr.IsFrozenAddress(0x0FFF));
+	ASSERT_FALSE(mgr.IsFrozenAddress(0x3000));
+
+	mgr.UpdateFrozenAddresses(0xFFFFFFF0, 0xFFFFFFFF, true);
+	ASSERT_TRUE(mgr.IsFrozenAddress(0xFFFFFFFF));
+	ASSERT_FALSE(mgr.IsFrozenAddress(0xFFFFFFEF));
+}
+
+TEST(frozen_address_manager_matches_reference)
+{
+	FrozenAddressManager mgr;
+	std::unordered_set<uint32_t> ref;
+	std::mt19937 rng(99);
+
+	for(int n = 0; n < 300; n++) {
+		uint32_t start = rng() % 0x20000;
+		uint32_t end = start + ((rng() % 4) ? rng() % 16 : rng() % 0x3000);
+		bool freeze = (rng() % 3) != 0;
+		mgr.UpdateFrozenAddresses(start, end, freeze);
+		for(uint32_t i = start; i <= end; i++) {
+			if(freeze) {
+				ref.insert(i);
+			} else {
+				ref.erase(i);
+			}
+		}
+	}
+
+	static bool state[0x24000];
+	mgr.GetFrozenState(0, 0x23FFF, state);
+
+	int mismatches = 0;
+	for(uint32_t i = 0; i < 0x24000; i++) {
+		bool expected = ref.find(i) != ref.end();
+		if(mgr.IsFrozenAddress(i) != expected || state[i] != expected) {
+			mismatches++;
+		}
+	}
+	ASSERT_EQ(mismatches, 0);
+}
@@ -0,0 +1,102 @@
+#include "test_harness.h"
+#include "Core/Debugger/MemoryDiff.h"
+#include "Utilities/SimdUtilities.h"
+#include <random>
+
+static std::vector<MemoryDiffRange> ReferenceDiff(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b)
+{
+	std::vector<MemoryDiffRange> ranges;
+	for(uint32_t i = 0; i < a.size(); i++) {
+		if(a[i] != b[i]) {
+			if(!ranges.empty() && ranges.back().Start + ranges.back().Length == i) {
+				ranges.back().Length++;
+			} else {
+				ranges.push_back({ i, 1 });
+			}
+		}
+	}
+	return ranges;
+}
+
+static bool SameRanges(const std::vector<MemoryDiffRange>& a, const std::vector<MemoryDiffRange>& b)
+{
+	if(a.size() != b.size()) {
+		return false;
+	}
+	for(size_t i = 0; i < a.size(); i++) {
+		if(a[i].Start != b[i].Start || a[i].Length != b[i].Length) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST(memory_diff_finds_ranges)
+{
+	std::vector<uint8_t> a(100, 0), b(100, 0);
+	b[0] = 1;
+	b[10] = 1; b[11] = 1; b[12] = 1;
+	b[99] = 1;
+
+	std::vector<MemoryDiffRange> ranges;
+	MemoryDiff::FindChangedRanges(a.data(), b.data(), 100, 0x1000, ranges);
+	ASSERT_EQ(ranges.size(), 3u);
+	ASSERT_EQ(ranges[0].Start, 0x1000u);
+	ASSERT_EQ(ranges[0].Length, 1u);
+	ASSERT_EQ(ranges[1].Start, 0x100Au);
+	ASSERT_EQ(ranges[1].Length, 3u);
+	ASSERT_EQ(ranges[2].Start, 0x1063u);
+	ASSERT_EQ(ranges[2].Length, 1u);
+}
+
+TEST(memory_diff_merges_across_calls)
+{
+	//A range that spans 2 pages is reported once
+	std::vector<uint8_t> a(64, 0), b(64, 0);
+	b[30] = b[31] = b[32] = b[33] = 5;
+
+	std::vector<MemoryDiffRange> ranges;
+	MemoryDiff::FindChangedRanges(a.data(), b.data(), 32, 0, ranges);
+	MemoryDiff::FindChangedRanges(a.data() + 32, b.data() + 32, 32, 32, ranges);
+	ASSERT_EQ(ranges.size(), 1u);
+	ASSERT_EQ(ranges[0].Start, 30u);
+	ASSERT_EQ(ranges[0].Length, 4u);
+}
+
+TEST(memory_diff_matches_reference)
+{
+	SimdLevel level = SimdUtilities::DetectLevel();
+	std::mt19937 rng(4321);
+
+	int mismatches = 0;
+	for(int n = 0; n < 500; n++) {
+		uint32_t size = rng() % 5000;
+		std::vector<uint8_t> a(size), b(size);
+		for(uint32_t i = 0; i < size; i++) {
+			a[i] = b[i] = (uint8_t)rng();
+		}
+
+		//Mix of isolated bytes and long runs
+		int changes = rng() % 20;
+		for(int i = 0; i < changes && size > 0; i++) {
+			uint32_t start = rng() % size;
+			uint32_t len = (rng() % 4) ? 1 : std::min<uint32_t>(size - start, rng() % 300);
+			for(uint32_t j = start; j < start + len; j++) {
+				b[j] ^= (uint8_t)(1 + rng() % 255);
+			}
+		}
+
+		std::vector<MemoryDiffRange> expected = ReferenceDiff(a, b);
+		std::vector<MemoryDiffRange> scalar, simd;
+
+		SimdUtilities::SetLevel(SimdLevel::None);
+		MemoryDiff::FindChangedRanges(a.data(), b.data(), size, 0, scalar);
+		SimdUtilities::SetLevel(level);
+		MemoryDiff::FindChangedRanges(a.data(), b.data(), size, 0, simd);
+
+		if(!SameRanges(expected, scalar) || !SameRanges(expected, simd)) {
+			mismatches++;
+		}
+	}
+	ASSERT_EQ(mismatches, 0);
+}
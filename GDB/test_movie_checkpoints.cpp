@@ -0,0 +1,72 @@
+#include "test_harness.h"
+#include "GDB/movie_checkpoints.h"
+#include "Core/Debugger/DAP/DapJson.h"
+#include <cstdio>
+
+static MovieCheckpoint MakeCheckpoint(uint32_t frame, char ram, char video)
+{
+	return { frame, std::string(32, ram), std::string(32, video) };
+}
+
+TEST(movie_checkpoints_expectation_file)
+{
+	ASSERT_EQ(MovieCheckpoints::GetExpectationFile("/movies/run.mmo"), std::string("/movies/run.hashes"));
+	ASSERT_EQ(MovieCheckpoints::GetExpectationFile("/movies.v2/run"), std::string("/movies.v2/run.hashes"));
+}
+
+TEST(movie_checkpoints_save_load_roundtrip)
+{
+	std::string path = "/tmp/mesen_test_movie.hashes";
+	std::vector<MovieCheckpoint> checkpoints = { MakeCheckpoint(600, 'A', 'B'), MakeCheckpoint(1034, '0', 'F') };
+	ASSERT_TRUE(MovieCheckpoints::Save(path, checkpoints));
+
+	std::vector<MovieCheckpoint> loaded;
+	ASSERT_TRUE(MovieCheckpoints::Load(path, loaded));
+	ASSERT_EQ(loaded.size(), (size_t)2);
+	ASSERT_EQ(loaded[0].frame, 600u);
+	ASSERT_EQ(loaded[0].ramHash, checkpoints[0].ramHash);
+	ASSERT_EQ(loaded[1].frameHash, checkpoints[1].frameHash);
+	remove(path.c_str());
+
+	ASSERT_FALSE(MovieCheckpoints::Load("/tmp/mesen_test_missing.hashes", loaded));
+}
+
+TEST(movie_checkpoints_compare)
+{
+	std::vector<MovieCheckpoint> expected = { MakeCheckpoint(600, 'A', 'A'), MakeCheckpoint(1200, 'B', 'B'), MakeCheckpoint(1500, 'C', 'C') };
+	std::vector<MovieCheckpoint> actual = { MakeCheckpoint(600, 'A', 'A'), MakeCheckpoint(1200, 'B', 'X'), MakeCheckpoint(1800, 'D', 'D') };
+
+	ASSERT_TRUE(MovieCheckpoints::Compare(expected, expected).empty());
+
+	std::vector<MovieCheckpointMismatch> mismatches = MovieCheckpoints::Compare(expected, actual);
+	ASSERT_EQ(mismatches.size(), (size_t)3);
+	ASSERT_EQ(mismatches[0].frame, 1200u);
+	ASSERT_FALSE(mismatches[0].ram);
+	ASSERT_TRUE(mismatches[0].video);
+	ASSERT_EQ(mismatches[1].frame, 1500u);
+	ASSERT_TRUE(mismatches[1].missing);
+	ASSERT_EQ(mismatches[2].frame, 1800u);
+	ASSERT_TRUE(mismatches[2].unexpected);
+}
+
+TEST(movie_checkpoints_report)
+{
+	MovieVerifyResult passed;
+	passed.movie = "a.mmo";
+	passed.status = "passed";
+	passed.frames = 1200;
+	passed.runMs = 400;
+
+	MovieVerifyResult failed;
+	failed.movie = "b.mmo";
+	failed.status = "failed";
+	failed.mismatches.push_back({ 600, true, false, false, false });
+
+	JsonValue report = MovieCheckpoints::BuildReport({ passed, failed }, 4, 1000);
+	ASSERT_EQ(report["threads"].GetUint(), 4u);
+	ASSERT_EQ(report["passed"].GetUint(), 1u);
+	ASSERT_EQ(report["failed"].GetUint(), 1u);
+	ASSERT_EQ(report["movies"].GetArray().size(), (size_t)2);
+	ASSERT_EQ(report["movies"][0]["fps"].GetUint(), 3000u);
+	ASSERT_EQ(report["movies"][1]["mismatches"][0]["reason"].GetString(), std::string("ram"));
+}
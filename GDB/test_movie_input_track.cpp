@@ -0,0 +1,119 @@
+#include "test_harness.h"
+#include "Core/Shared/Movies/MovieInputTrack.h"
+
+static std::vector<std::vector<std::string>> SampleRows()
+{
+	// SNES controller + a mouse-like pointer device, and a multitap-style port with colons
+	return {
+		{ "............", "10 20 ..", "....:...." },
+		{ "UD..........", "-5 300 L.", "U...:...." },
+		{ "....BYSsA...", "0 0 .R", "....:.D.." },
+	};
+}
+
+TEST(movie_input_track_text_roundtrip)
+{
+	auto rows = SampleRows();
+	MovieInputTrack track;
+	ASSERT_TRUE(track.FromText(rows));
+	ASSERT_EQ(track.GetFrameCount(), 3u);
+	ASSERT_EQ(track.GetPortCount(), 3u);
+	// 12 bits -> 2 bytes, 4 coordinate bytes + 2 bits -> 5 bytes, 8 bits -> 1 byte
+	ASSERT_EQ(track.GetFrameSize(), 8u);
+
+	std::string text;
+	for(uint32_t row = 0; row < rows.size(); row++) {
+		for(uint32_t port = 0; port < 3; port++) {
+			track.GetTextState(row, port, text);
+			ASSERT_EQ(text, rows[row][port]);
+		}
+	}
+}
+
+TEST(movie_input_track_port_state)
+{
+	MovieInputTrack track;
+	ASSERT_TRUE(track.FromText(SampleRows()));
+
+	// "....BYSsA..." -> bits 4-8
+	MovieInputTrack::PortState state = track.GetPortState(2, 0);
+	ASSERT_FALSE(state.HasCoordinates);
+	ASSERT_EQ(state.BitCount, 12u);
+	ASSERT_EQ(state.Bits[0], 0xF0);
+	ASSERT_EQ(state.Bits[1], 0x01);
+
+	// "-5 300 L."
+	state = track.GetPortState(1, 1);
+	ASSERT_TRUE(state.HasCoordinates);
+	ASSERT_EQ(state.X, -5);
+	ASSERT_EQ(state.Y, 300);
+	ASSERT_EQ(state.BitCount, 2u);
+	ASSERT_EQ(state.Bits[0] & 0x03, 0x01);
+
+	// "....:.D.." -> colons are skipped, D is the 6th key
+	state = track.GetPortState(2, 2);
+	ASSERT_EQ(state.BitCount, 8u);
+	ASSERT_EQ(state.Bits[0], 0x20);
+}
+
+TEST(movie_input_track_save_load)
+{
+	MovieInputTrack track;
+	ASSERT_TRUE(track.FromText(SampleRows()));
+	track.AddKeyframe(2);
+	track.AddKeyframe(1);
+	track.AddKeyframe(2);
+
+	std::vector<uint8_t> data;
+	track.Save(data);
+
+	MovieInputTrack loaded;
+	ASSERT_TRUE(loaded.Load(data));
+	ASSERT_EQ(loaded.GetFrameCount(), 3u);
+	ASSERT_EQ(loaded.GetKeyframes().size(), (size_t)2);
+
+	std::string text;
+	loaded.GetTextState(1, 1, text);
+	ASSERT_EQ(text, std::string("-5 300 L."));
+	loaded.GetTextState(2, 2, text);
+	ASSERT_EQ(text, std::string("....:.D.."));
+
+	// Truncated or corrupted data is rejected
+	std::vector<uint8_t> truncated(data.begin(), data.end() - 1);
+	ASSERT_FALSE(loaded.Load(truncated));
+	data[0] = 'X';
+	ASSERT_FALSE(loaded.Load(data));
+}
+
+TEST(movie_input_track_find_keyframe)
+{
+	MovieInputTrack track;
+	ASSERT_EQ(track.FindKeyframe(100), (int64_t)-1);
+	track.AddKeyframe(600);
+	track.AddKeyframe(1200);
+	ASSERT_EQ(track.FindKeyframe(599), (int64_t)-1);
+	ASSERT_EQ(track.FindKeyframe(600), (int64_t)600);
+	ASSERT_EQ(track.FindKeyframe(1199), (int64_t)600);
+	ASSERT_EQ(track.FindKeyframe(5000), (int64_t)1200);
+	ASSERT_EQ(MovieInputTrack::GetKeyframeName(600), std::string("Keyframes/600.mss"));
+}
+
+TEST(movie_input_track_rejects_variable_width_input)
+{
+	MovieInputTrack track;
+
+	// Raw string devices (e.g barcode readers) don't have a fixed width
+	ASSERT_FALSE(track.FromText({ { "0123" }, { "012345" } }));
+
+	// Two different key names for the same bit
+	ASSERT_FALSE(track.FromText({ { "A." }, { "B." } }));
+
+	// Port count changes between rows
+	ASSERT_FALSE(track.FromText({ { "..", ".." }, { ".." } }));
+
+	// Coordinates that wouldn't be rebuilt identically
+	ASSERT_FALSE(track.FromText({ { "010 20 ." } }));
+
+	ASSERT_TRUE(track.FromText({}));
+	ASSERT_EQ(track.GetFrameCount(), 0u);
+}
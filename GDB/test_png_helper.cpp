@@ -0,0 +1,102 @@
+#include "test_harness.h"
+#include "Utilities/PNGHelper.h"
+#include "Utilities/SimdUtilities.h"
+#include <random>
+
+// Console-like frame: large areas of a few colors (fewer than 256)
+static std::vector<uint32_t> MakeConsoleFrame(uint32_t width, uint32_t height)
+{
+	std::vector<uint32_t> frame(width * height);
+	for(uint32_t y = 0; y < height; y++) {
+		for(uint32_t x = 0; x < width; x++) {
+			uint32_t color = ((x / 8) * 7 + (y / 8) * 13) % 48;
+			frame[y * width + x] = 0xFF000000 | (color * 0x050301);
+		}
+	}
+	return frame;
+}
+
+static std::vector<uint32_t> MakeRandomFrame(uint32_t width, uint32_t height, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	std::vector<uint32_t> frame(width * height);
+	for(uint32_t& pixel : frame) {
+		pixel = rng();
+	}
+	return frame;
+}
+
+static bool DecodesTo(const std::vector<uint8_t>& png, const std::vector<uint32_t>& expected, uint32_t width, uint32_t height, bool compareAlpha)
+{
+	std::vector<uint32_t> decoded;
+	uint32_t pngWidth, pngHeight;
+	if(!PNGHelper::ReadPNG(png, decoded, pngWidth, pngHeight) || pngWidth != width || pngHeight != height) {
+		return false;
+	}
+	uint32_t mask = compareAlpha ? 0xFFFFFFFF : 0xFFFFFF;
+	for(size_t i = 0; i < expected.size(); i++) {
+		if((decoded[i] & mask) != (expected[i] & mask)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST(png_convert_simd_matches_scalar)
+{
+	std::vector<uint32_t> src = MakeRandomFrame(1, 259, 1);
+	for(uint32_t count : { 0u, 1u, 3u, 4u, 15u, 16u, 17u, 259u }) {
+		std::vector<uint8_t> expectedRgb(count * 3 + 4), expectedRgba(count * 4 + 4);
+		SimdUtilities::SetLevel(SimdLevel::None);
+		PNGHelper::ConvertToRgb(expectedRgb.data(), src.data(), count);
+		PNGHelper::ConvertToRgba(expectedRgba.data(), src.data(), count);
+		SimdUtilities::SetLevel(SimdUtilities::DetectLevel());
+
+		std::vector<uint8_t> rgb(count * 3 + 4), rgba(count * 4 + 4);
+		PNGHelper::ConvertToRgb(rgb.data(), src.data(), count);
+		PNGHelper::ConvertToRgba(rgba.data(), src.data(), count);
+		ASSERT_TRUE(memcmp(rgb.data(), expectedRgb.data(), count * 3) == 0);
+		ASSERT_TRUE(memcmp(rgba.data(), expectedRgba.data(), count * 4) == 0);
+	}
+
+	uint8_t bytes[8];
+	uint32_t pixel = 0x80112233;
+	PNGHelper::ConvertToRgba(bytes, &pixel, 1);
+	ASSERT_EQ(bytes[0], (uint8_t)0x11);
+	ASSERT_EQ(bytes[2], (uint8_t)0x33);
+	ASSERT_EQ(bytes[3], (uint8_t)0x80);
+}
+
+TEST(png_palette_roundtrip)
+{
+	std::vector<uint32_t> frame = MakeConsoleFrame(256, 240);
+	std::vector<uint8_t> png;
+	ASSERT_TRUE(PNGHelper::WritePNG(png, frame.data(), 256, 240));
+	ASSERT_EQ(png[25], (uint8_t)3); // IHDR color type: indexed
+	ASSERT_TRUE(DecodesTo(png, frame, 256, 240, false));
+}
+
+TEST(png_truecolor_roundtrip)
+{
+	// More than 256 colors falls back to RGB
+	std::vector<uint32_t> frame = MakeRandomFrame(33, 17, 2);
+	std::vector<uint8_t> png;
+	ASSERT_TRUE(PNGHelper::WritePNG(png, frame.data(), 33, 17));
+	ASSERT_EQ(png[25], (uint8_t)2);
+	ASSERT_TRUE(DecodesTo(png, frame, 33, 17, false));
+
+	ASSERT_TRUE(PNGHelper::WritePNG(png, frame.data(), 33, 17, 32));
+	ASSERT_EQ(png[25], (uint8_t)6);
+	ASSERT_TRUE(DecodesTo(png, frame, 33, 17, true));
+}
+
+TEST(png_full_frame_roundtrip)
+{
+	// Full-size frames, one per encoding (timings are in the CLI's "bench png" command)
+	std::vector<uint32_t> frames[] = { MakeConsoleFrame(256, 240), MakeRandomFrame(256, 240, 3) };
+	for(std::vector<uint32_t>& frame : frames) {
+		std::vector<uint8_t> png;
+		ASSERT_TRUE(PNGHelper::WritePNG(png, frame.data(), 256, 240));
+		ASSERT_TRUE(DecodesTo(png, frame, 256, 240, false));
+	}
+}
@@ -0,0 +1,51 @@
+#include "test_harness.h"
+#include "Core/Debugger/Profiler.h"
+
+namespace {
+	//Returns the functions that get inclusive cycles, frames are listed from the most recent one
+	std::vector<uint32_t> GetInclusiveFunctions(std::vector<ProfilerFrame>& frames, uint32_t generation)
+	{
+		std::vector<uint32_t> functions;
+		Profiler::ForEachInclusiveFrame((uint32_t)frames.size(), generation,
+			[&](uint32_t i) -> ProfilerFrame& { return frames[i]; },
+			[&](uint32_t function) { functions.push_back(function); }
+		);
+		return functions;
+	}
+}
+
+TEST(profiler_inclusive_skips_unresolved_frame)
+{
+	std::vector<ProfilerFrame> frames = {
+		{ 3, 0, 0, StackFrameFlags::None, 5, 0 },
+		{ Profiler::UnresolvedFunction, 0, 0, StackFrameFlags::None, 5, 0 },
+		{ 2, 0, 0, StackFrameFlags::None, 5, 0 },
+		{ 1, 0, 0, StackFrameFlags::None, 5, 0 },
+	};
+
+	std::vector<uint32_t> functions = GetInclusiveFunctions(frames, 5);
+	ASSERT_EQ(functions.size(), (size_t)3);
+	ASSERT_EQ(functions[0], 3u);
+	ASSERT_EQ(functions[1], 2u);
+	ASSERT_EQ(functions[2], 1u);
+}
+
+TEST(profiler_inclusive_stops_at_irq_and_old_frames)
+{
+	std::vector<ProfilerFrame> frames = {
+		{ 3, 0, 0, StackFrameFlags::None, 5, 0 },
+		{ Profiler::UnresolvedFunction, 0, 0, StackFrameFlags::Irq, 5, 0 },
+		{ 2, 0, 0, StackFrameFlags::None, 5, 0 },
+	};
+
+	//The unresolved IRQ frame still keeps the interrupted code from getting the handler's cycles
+	std::vector<uint32_t> functions = GetInclusiveFunctions(frames, 5);
+	ASSERT_EQ(functions.size(), (size_t)1);
+	ASSERT_EQ(functions[0], 3u);
+
+	//Frames from before the profiler was started are ignored
+	frames[1] = { 4, 0, 0, StackFrameFlags::None, 4, 0 };
+	functions = GetInclusiveFunctions(frames, 5);
+	ASSERT_EQ(functions.size(), (size_t)1);
+	ASSERT_EQ(functions[0], 3u);
+}
@@ -0,0 +1,228 @@
+#include "test_harness.h"
+#include "Core/Debugger/ReverseJournalBuffer.h"
+#include <random>
+
+namespace {
+	//Small fake CPU: a 13-byte state (not a multiple of 8) and 256 bytes of RAM
+	struct FakeCpu
+	{
+		uint8_t State[13] = {};
+		uint8_t Ram[256] = {};
+		uint64_t Clock = 0;
+	};
+
+	//Records the start of an instruction, like ReverseJournal::RecordInstruction
+	void Record(ReverseJournalBuffer& journal, FakeCpu& cpu)
+	{
+		if(journal.IsOpen()) {
+			journal.CloseEntry(cpu.State, (uint32_t)cpu.Clock);
+		}
+		journal.OpenEntry(cpu.State, cpu.Clock);
+	}
+
+	void Write(ReverseJournalBuffer& journal, FakeCpu& cpu, uint8_t addr, uint8_t value)
+	{
+		journal.AddWrite({ addr, addr, MemoryType::SnesWorkRam, cpu.Ram[addr], value });
+		cpu.Ram[addr] = value;
+	}
+
+	//Runs one instruction that changes a few state bytes and does writeCount RAM writes
+	void Exec(ReverseJournalBuffer& journal, FakeCpu& cpu, std::mt19937& rng, uint32_t writeCount)
+	{
+		Record(journal, cpu);
+		for(int i = rng() % 4; i >= 0; i--) {
+			cpu.State[rng() % sizeof(cpu.State)] = (uint8_t)rng();
+		}
+		for(uint32_t i = 0; i < writeCount; i++) {
+			Write(journal, cpu, (uint8_t)rng(), (uint8_t)rng());
+		}
+		cpu.Clock += 2 + rng() % 6;
+	}
+
+	void Undo(ReverseJournalBuffer& journal, FakeCpu& cpu)
+	{
+		journal.UndoInstruction([&](ReverseJournalBuffer::WriteRecord& write) {
+			cpu.Ram[write.AbsAddress] = write.OldValue;
+		});
+		memcpy(cpu.State, journal.GetState(), sizeof(cpu.State));
+		cpu.Clock = journal.GetCurrentEntry().Clock;
+	}
+
+	bool SameState(FakeCpu& a, FakeCpu& b)
+	{
+		return memcmp(a.State, b.State, sizeof(a.State)) == 0 && memcmp(a.Ram, b.Ram, sizeof(a.Ram)) == 0 && a.Clock == b.Clock;
+	}
+}
+
+TEST(reverse_journal_undo_after_wraparound)
+{
+	ReverseJournalBuffer journal(sizeof(FakeCpu::State), 0x400);
+	ASSERT_EQ(journal.GetCapacity(), 0x400u);
+
+	FakeCpu cpu;
+	std::mt19937 rng(1);
+	std::vector<FakeCpu> history;
+
+	//Several times the capacity, so every ring buffer wraps around
+	for(int i = 0; i < 0x1234; i++) {
+		history.push_back(cpu);
+		Exec(journal, cpu, rng, rng() % 2);
+	}
+	history.push_back(cpu);
+	Record(journal, cpu);
+
+	//The oldest instructions were dropped, the journal is full (the current instruction uses the last entry)
+	ASSERT_EQ(journal.GetInstructionCount(), 0x3FFu);
+
+	int mismatches = 0;
+	uint32_t undoneCount = 0;
+	while(journal.CanUndo()) {
+		Undo(journal, cpu);
+		history.pop_back();
+		undoneCount++;
+		mismatches += SameState(cpu, history.back()) ? 0 : 1;
+	}
+	ASSERT_EQ(mismatches, 0);
+	ASSERT_EQ(undoneCount, 0x3FFu);
+}
+
+TEST(reverse_journal_write_buffer_evicts_oldest_instructions)
+{
+	ReverseJournalBuffer journal(sizeof(FakeCpu::State), 0x400);
+	uint32_t writeCapacity = journal.GetWriteCapacity();
+
+	FakeCpu cpu;
+	std::mt19937 rng(2);
+	std::vector<FakeCpu> history;
+
+	//8 writes per instruction: the write buffer fills up before the instruction buffer
+	for(int i = 0; i < 1000; i++) {
+		history.push_back(cpu);
+		Exec(journal, cpu, rng, 8);
+	}
+	history.push_back(cpu);
+	Record(journal, cpu);
+
+	ASSERT_EQ(journal.GetInstructionCount(), writeCapacity / 8);
+
+	int mismatches = 0;
+	while(journal.CanUndo()) {
+		Undo(journal, cpu);
+		history.pop_back();
+		mismatches += SameState(cpu, history.back()) ? 0 : 1;
+	}
+	ASSERT_EQ(mismatches, 0);
+	ASSERT_EQ(history.size(), 1000u - writeCapacity / 8 + 1);
+}
+
+TEST(reverse_journal_undo_partial_instruction)
+{
+	ReverseJournalBuffer journal(sizeof(FakeCpu::State), 0x400);
+	FakeCpu cpu;
+	std::mt19937 rng(3);
+
+	Exec(journal, cpu, rng, 2);
+	FakeCpu start = cpu;
+	Record(journal, cpu);
+
+	//Paused in the middle of an instruction (e.g write breakpoint): its writes are reverted too
+	Write(journal, cpu, 0x10, 0x55);
+	Write(journal, cpu, 0x10, 0x66);
+	cpu.State[0] ^= 0xFF;
+
+	Undo(journal, cpu);
+	ASSERT_EQ(journal.GetInstructionCount(), 0u);
+	ASSERT_FALSE(journal.CanUndo());
+
+	FakeCpu expected;
+	ASSERT_TRUE(SameState(cpu, expected));
+	ASSERT_FALSE(SameState(cpu, start));
+}
+
+TEST(reverse_journal_undo_stops_at_keyframe)
+{
+	ReverseJournalBuffer journal(sizeof(FakeCpu::State), 0x400);
+	FakeCpu cpu;
+	std::mt19937 rng(5);
+
+	for(int i = 0; i < 20; i++) {
+		Exec(journal, cpu, rng, 1);
+	}
+
+	//Keyframe saved before the 21st instruction
+	Record(journal, cpu);
+	journal.MarkKeyframe();
+	FakeCpu keyframe = cpu;
+	cpu.Clock += 4;
+
+	for(int i = 0; i < 5; i++) {
+		Exec(journal, cpu, rng, 1);
+	}
+	Record(journal, cpu);
+	ASSERT_EQ(journal.GetInstructionCount(), 6u);
+
+	uint32_t undoneCount = 0;
+	while(journal.CanUndo()) {
+		Undo(journal, cpu);
+		undoneCount++;
+	}
+	ASSERT_EQ(undoneCount, 6u);
+	ASSERT_TRUE(SameState(cpu, keyframe));
+}
+
+TEST(reverse_journal_keyframe_is_evicted_with_oldest_entries)
+{
+	ReverseJournalBuffer journal(sizeof(FakeCpu::State), 0x400);
+	FakeCpu cpu;
+	std::mt19937 rng(6);
+
+	Record(journal, cpu);
+	journal.MarkKeyframe();
+	for(int i = 0; i < 0x500; i++) {
+		Exec(journal, cpu, rng, 0);
+	}
+	Record(journal, cpu);
+
+	//The keyframe's instruction was dropped, every remaining instruction can be undone
+	ASSERT_EQ(journal.GetInstructionCount(), 0x3FFu);
+}
+
+TEST(reverse_journal_oversized_instruction_and_clear)
+{
+	ReverseJournalBuffer journal(sizeof(FakeCpu::State), 0x400);
+	FakeCpu cpu;
+	std::mt19937 rng(4);
+
+	for(int i = 0; i < 10; i++) {
+		Exec(journal, cpu, rng, 1);
+	}
+	Record(journal, cpu);
+	ASSERT_EQ(journal.GetInstructionCount(), 10u);
+
+	//A single instruction that writes more bytes than the write buffer holds can't be undone, the journal is cleared
+	bool added = true;
+	for(uint32_t i = 0; i <= journal.GetWriteCapacity() && added; i++) {
+		added = journal.AddWrite({ i & 0xFF, (int32_t)(i & 0xFF), MemoryType::SnesWorkRam, 0, 0 });
+	}
+	ASSERT_FALSE(added);
+	ASSERT_FALSE(journal.IsOpen());
+	ASSERT_FALSE(journal.CanUndo());
+	ASSERT_EQ(journal.GetInstructionCount(), 0u);
+
+	//Recording starts over
+	Exec(journal, cpu, rng, 1);
+	Exec(journal, cpu, rng, 1);
+	Record(journal, cpu);
+	ASSERT_EQ(journal.GetInstructionCount(), 2u);
+
+	journal.Clear();
+	ASSERT_FALSE(journal.IsOpen());
+	ASSERT_FALSE(journal.CanUndo());
+	ASSERT_EQ(journal.GetInstructionCount(), 0u);
+}
+
+TEST(reverse_journal_capacity_is_clamped)
+{
+	ASSERT_EQ(ReverseJournalBuffer(8, 0).GetCapacity(), ReverseJournalBuffer::MinCapacity);
+	ASSERT_EQ(ReverseJournalBuffer(8, 0x401).GetCapacity(), 0x800u);
+}
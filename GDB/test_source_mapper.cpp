@@ -0,0 +1,107 @@
+#include "test_harness.h"
+#include "Core/Debugger/DAP/SourceMapper.h"
+#include <cstdio>
+#include <fstream>
+
+// Two 16KB banks mapped at $8000 (after a 16-byte iNES header) and a RAM segment that isn't written to the ROM
+static const char* TestDbg =
+	"version\tmajor=2,minor=0\n"
+	"file\tid=0,name=\"src/main.s\",size=100,mtime=0x00000000,mod=0\n"
+	"file\tid=1,name=\"src/bank1.s\",size=100,mtime=0x00000000,mod=0\n"
+	"seg\tid=0,name=\"BANK0\",start=0x008000,size=0x4000,addrsize=absolute,type=ro,oname=\"game.nes\",ooffs=16\n"
+	"seg\tid=1,name=\"BANK1\",start=0x008000,size=0x4000,addrsize=absolute,type=ro,oname=\"game.nes\",ooffs=16400\n"
+	"seg\tid=2,name=\"BSS\",start=0x000300,size=0x0100,addrsize=absolute,type=rw\n"
+	"span\tid=0,seg=0,start=0,size=3\n"
+	"span\tid=1,seg=1,start=0,size=3\n"
+	"span\tid=2,seg=0,start=0,size=4096\n"
+	"span\tid=3,seg=2,start=0,size=2\n"
+	"line\tid=0,file=0,line=10,span=0\n"
+	"line\tid=1,file=1,line=20,span=1\n"
+	"line\tid=2,file=0,line=5,span=2\n"
+	"line\tid=3,file=0,line=30,span=3\n"
+	"sym\tid=0,name=\"reset\",addrsize=absolute,scope=0,def=0,val=0x8000,seg=0,type=lab\n";
+
+static std::string WriteTestDbg(const char* name, const std::string& extra = "")
+{
+	std::string path = std::string("/tmp/") + name;
+	std::remove((path + ".idx").c_str());
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out << TestDbg << extra;
+	return path;
+}
+
+TEST(sourcemapper_rom_offset_distinguishes_banks)
+{
+	std::string path = WriteTestDbg("mesen_test_banks.dbg");
+	SourceMapper mapper;
+	ASSERT_TRUE(mapper.LoadDbgFile(path));
+
+	SourceLocation loc = mapper.GetSourceLocationByRomOffset(16);
+	ASSERT_TRUE(loc.valid);
+	ASSERT_STR_EQ(loc.file, "src/main.s");
+	ASSERT_EQ(loc.line, 10);
+
+	loc = mapper.GetSourceLocationByRomOffset(16400 + 1);
+	ASSERT_TRUE(loc.valid);
+	ASSERT_STR_EQ(loc.file, "src/bank1.s");
+	ASSERT_EQ(loc.line, 20);
+
+	ASSERT_EQ(mapper.GetRomOffset("bank1.s", 20), 16400u);
+	ASSERT_EQ(mapper.GetRomOffset("src/main.s", 10), 16u);
+
+	// Lines in segments that aren't part of the ROM only have a CPU address
+	ASSERT_EQ(mapper.GetRomOffset("main.s", 30), SourceMapper::InvalidAddress);
+	ASSERT_TRUE(mapper.GetAddress("main.s", 30) != SourceMapper::InvalidAddress);
+
+	std::remove(path.c_str());
+	std::remove((path + ".idx").c_str());
+}
+
+TEST(sourcemapper_interval_lookup_is_exact)
+{
+	std::string path = WriteTestDbg("mesen_test_interval.dbg");
+	SourceMapper mapper;
+	ASSERT_TRUE(mapper.LoadDbgFile(path));
+
+	// Far from the start of the enclosing 4KB span, past any short scan window
+	SourceLocation loc = mapper.GetSourceLocationByRomOffset(16 + 0x800);
+	ASSERT_TRUE(loc.valid);
+	ASSERT_EQ(loc.line, 5);
+
+	loc = mapper.GetSourceLocation(mapper.GetAddress("main.s", 5) + 0x800);
+	ASSERT_TRUE(loc.valid);
+	ASSERT_EQ(loc.line, 5);
+
+	ASSERT_FALSE(mapper.GetSourceLocationByRomOffset(16 + 0x1000).valid);
+	ASSERT_FALSE(mapper.GetSourceLocationByRomOffset(0).valid);
+
+	std::remove(path.c_str());
+	std::remove((path + ".idx").c_str());
+}
+
+TEST(sourcemapper_cache_round_trip)
+{
+	std::string path = WriteTestDbg("mesen_test_cache.dbg");
+	{
+		SourceMapper mapper;
+		ASSERT_TRUE(mapper.LoadDbgFile(path));
+		ASSERT_FALSE(mapper.IsLoadedFromCache());
+	}
+
+	SourceMapper cached;
+	ASSERT_TRUE(cached.LoadDbgFile(path));
+	ASSERT_TRUE(cached.IsLoadedFromCache());
+	ASSERT_EQ(cached.GetSourceFiles().size(), 2u);
+	ASSERT_EQ(cached.GetRomOffset("bank1.s", 20), 16400u);
+	ASSERT_EQ(cached.GetSourceLocationByRomOffset(16 + 0x800).line, 5);
+	ASSERT_STR_EQ(cached.GetSymbolName(0x8000), "reset");
+
+	// A modified .dbg file invalidates the cache
+	WriteTestDbg("mesen_test_cache.dbg", "line\tid=4,file=1,line=21,span=1\n");
+	SourceMapper reparsed;
+	ASSERT_TRUE(reparsed.LoadDbgFile(path));
+	ASSERT_FALSE(reparsed.IsLoadedFromCache());
+
+	std::remove(path.c_str());
+	std::remove((path + ".idx").c_str());
+}
@@ -0,0 +1,89 @@
+#include "test_harness.h"
+#include "Core/Shared/Video/VideoFilterThreadPool.h"
+#include "Utilities/Scale2x/scalebit.h"
+#include "Utilities/KreedSaiEagle/SaiEagle.h"
+#include <random>
+
+// The video decoder splits the scale filters in horizontal bands processed in parallel,
+// the output must match the output of a single pass over the whole image.
+
+static vector<uint32_t> GenerateImage(uint32_t width, uint32_t height, uint32_t seed)
+{
+	//Use a small palette so the scalers' edge detection finds matching neighbours
+	std::mt19937 rng(seed);
+	uint32_t palette[4] = { 0xFF000000, 0xFFFFFFFF, 0xFF2080F0, 0xFFF08020 };
+	vector<uint32_t> image(width * height);
+	for(uint32_t& px : image) {
+		px = palette[rng() % 4];
+	}
+	return image;
+}
+
+static vector<uint32_t> ScaleInBands(unsigned scale, vector<uint32_t>& src, uint32_t width, uint32_t height, const vector<uint32_t>& bands)
+{
+	vector<uint32_t> out(width * height * scale * scale);
+	for(size_t i = 0; i + 1 < bands.size(); i++) {
+		scale_rows(scale, out.data(), width * scale * 4, src.data(), width * 4, 4, width, height, bands[i], bands[i + 1]);
+	}
+	return out;
+}
+
+TEST(scale_rows_bands_match_full_image)
+{
+	uint32_t width = 37;
+	uint32_t height = 23;
+	vector<uint32_t> src = GenerateImage(width, height, 1);
+	vector<uint32_t> bands[] = { { 0, 23 }, { 0, 1, 23 }, { 0, 5, 6, 17, 22, 23 }, { 0, 11, 12, 13, 23 } };
+
+	for(unsigned scaleFactor : { 2u, 3u, 4u }) {
+		vector<uint32_t> expected(width * height * scaleFactor * scaleFactor);
+		scale(scaleFactor, expected.data(), width * scaleFactor * 4, src.data(), width * 4, 4, width, height);
+
+		for(vector<uint32_t>& rows : bands) {
+			ASSERT_TRUE(ScaleInBands(scaleFactor, src, width, height, rows) == expected);
+		}
+	}
+}
+
+TEST(sai_eagle_bands_match_full_image)
+{
+	uint32_t width = 29;
+	uint32_t height = 19;
+	vector<uint32_t> src = GenerateImage(width, height, 2);
+	vector<uint32_t> bands = { 0, 1, 2, 9, 17, 18, 19 };
+
+	typedef void (*SaiFunc)(unsigned, unsigned, uint32_t*, unsigned, uint32_t*, unsigned, unsigned, unsigned);
+	for(SaiFunc func : { twoxsai_generic_xrgb8888, supertwoxsai_generic_xrgb8888, supereagle_generic_xrgb8888 }) {
+		vector<uint32_t> expected(width * height * 4);
+		func(width, height, src.data(), width, expected.data(), width * 2, 0, height);
+
+		vector<uint32_t> out(width * height * 4);
+		for(size_t i = bands.size() - 1; i > 0; i--) {
+			func(width, height, src.data(), width, out.data(), width * 2, bands[i - 1], bands[i]);
+		}
+		ASSERT_TRUE(out == expected);
+	}
+}
+
+TEST(video_filter_thread_pool_covers_all_rows)
+{
+	VideoFilterThreadPool pool;
+	for(uint32_t rowCount : { 0u, 1u, 15u, 16u, 100u, 240u, 481u }) {
+		for(int run = 0; run < 20; run++) {
+			vector<atomic<uint32_t>> counts(rowCount);
+			for(atomic<uint32_t>& count : counts) {
+				count = 0;
+			}
+
+			pool.Run(rowCount, [&](uint32_t startRow, uint32_t endRow) {
+				for(uint32_t i = startRow; i < endRow; i++) {
+					counts[i]++;
+				}
+			});
+
+			for(atomic<uint32_t>& count : counts) {
+				ASSERT_EQ(count.load(), 1u);
+			}
+		}
+	}
+}
@@ -0,0 +1,119 @@
+#include "test_harness.h"
+#include "Core/Shared/Video/VideoFilterKernels.h"
+#include "Core/Shared/ColorUtilities.h"
+#include "Utilities/SimdUtilities.h"
+#include <random>
+
+// Each test runs the kernels with every SIMD level available on this CPU
+// and compares the output with the per-pixel code the video filters used before.
+
+static uint32_t BlendPixel(uint32_t a, uint32_t b)
+{
+	return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
+}
+
+static vector<SimdLevel> GetSimdLevels()
+{
+	vector<SimdLevel> levels = { SimdLevel::None };
+	SimdLevel detected = SimdUtilities::DetectLevel();
+	if(detected == SimdLevel::Avx2) {
+		levels.push_back(SimdLevel::Sse41);
+	}
+	if(detected != SimdLevel::None) {
+		levels.push_back(detected);
+	}
+	return levels;
+}
+
+TEST(video_kernels_convert_rgb555)
+{
+	std::mt19937 rng(1234);
+	int mismatches = 0;
+	for(SimdLevel level : GetSimdLevels()) {
+		SimdUtilities::SetLevel(level);
+		for(int n = 0; n < 200; n++) {
+			uint32_t count = rng() % 600;
+			vector<uint16_t> src(count);
+			for(uint16_t& color : src) {
+				color = (uint16_t)rng();
+			}
+
+			vector<uint32_t> out(count);
+			VideoFilterKernels::ConvertRgb555(out.data(), src.data(), count);
+			for(uint32_t i = 0; i < count; i++) {
+				if(out[i] != ColorUtilities::Rgb555ToArgb(src[i] & 0x7FFF)) {
+					mismatches++;
+				}
+			}
+		}
+	}
+	SimdUtilities::SetLevel(SimdUtilities::DetectLevel());
+	ASSERT_EQ(mismatches, 0);
+}
+
+TEST(video_kernels_blend_and_double)
+{
+	std::mt19937 rng(5678);
+	int mismatches = 0;
+	for(SimdLevel level : GetSimdLevels()) {
+		SimdUtilities::SetLevel(level);
+		for(int n = 0; n < 200; n++) {
+			uint32_t count = rng() % 600 + 1;
+			vector<uint32_t> a(count), b(count);
+			for(uint32_t i = 0; i < count; i++) {
+				a[i] = rng() | 0xFF000000;
+				b[i] = rng() | 0xFF000000;
+			}
+
+			vector<uint32_t> blended(count);
+			VideoFilterKernels::BlendPixels(blended.data(), a.data(), b.data(), count);
+
+			//In place, with each pixel blended with the next one (SNES hi-res blend)
+			vector<uint32_t> inPlace = a;
+			VideoFilterKernels::BlendPixels(inPlace.data(), inPlace.data(), inPlace.data() + 1, count - 1);
+
+			vector<uint32_t> doubled(count * 2);
+			VideoFilterKernels::DoublePixels(doubled.data(), a.data(), count);
+
+			for(uint32_t i = 0; i < count; i++) {
+				mismatches += blended[i] != BlendPixel(a[i], b[i]);
+				mismatches += inPlace[i] != (i + 1 < count ? BlendPixel(a[i], a[i + 1]) : a[i]);
+				mismatches += doubled[i * 2] != a[i] || doubled[i * 2 + 1] != a[i];
+			}
+		}
+	}
+	SimdUtilities::SetLevel(SimdUtilities::DetectLevel());
+	ASSERT_EQ(mismatches, 0);
+}
+
+TEST(video_kernels_convert_row_blends_previous_frame)
+{
+	vector<uint32_t> palette(0x8000);
+	for(uint32_t i = 0; i < 0x8000; i++) {
+		palette[i] = ColorUtilities::Rgb555ToArgb((uint16_t)i);
+	}
+	ASSERT_TRUE(VideoFilterKernels::IsRgb555Palette(palette.data()));
+
+	std::mt19937 rng(42);
+	uint32_t count = 700;
+	vector<uint16_t> src(count), prev(count);
+	for(uint32_t i = 0; i < count; i++) {
+		src[i] = rng() & 0x7FFF;
+		prev[i] = rng() & 0x7FFF;
+	}
+
+	//Direct conversion and palette lookups must give the same result when the palette has no color adjustments
+	vector<uint32_t> direct(count), lookup(count);
+	VideoFilterKernels::ConvertRow(direct.data(), src.data(), prev.data(), nullptr, 0x7FFF, count);
+	VideoFilterKernels::ConvertRow(lookup.data(), src.data(), prev.data(), palette.data(), 0x7FFF, count);
+	ASSERT_TRUE(direct == lookup);
+
+	int mismatches = 0;
+	for(uint32_t i = 0; i < count; i++) {
+		mismatches += direct[i] != BlendPixel(palette[prev[i]], palette[src[i]]);
+	}
+	ASSERT_EQ(mismatches, 0);
+
+	palette[0x1234] ^= 0x10;
+	ASSERT_FALSE(VideoFilterKernels::IsRgb555Palette(palette.data()));
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "pch.h"
+#include "Utilities/Audio/blip_buf.h"
+
+//Stages the deltas of a blip buffer during a frame and adds them in a single batch (blip_add_deltas)
+//Flush must be called before blip_end_frame, and Clear along with blip_clear
+class BlipDeltaBuffer
+{
+private:
+	vector<unsigned int> _times;
+	vector<int> _deltas;
+
+public:
+	BlipDeltaBuffer()
+	{
+		_times.reserve(4096);
+		_deltas.reserve(4096);
+	}
+
+	void Add(uint32_t time, int delta)
+	{
+		_times.push_back(time);
+		_deltas.push_back(delta);
+	}
+
+	void Flush(blip_t* blip)
+	{
+		if(!_times.empty()) {
+			blip_add_deltas(blip, _times.data(), _deltas.data(), (int)_times.size());
+			Clear();
+		}
+	}
+
+	void Clear()
+	{
+		_times.clear();
+		_deltas.clear();
+	}
+};
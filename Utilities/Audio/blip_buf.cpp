@@ -2,6 +2,7 @@
 
 #include "pch.h"
 #include "blip_buf.h"
+#include "Utilities/SimdUtilities.h"
 
 #include <assert.h>
 #include <limits.h>
@@ -329,6 +330,144 @@ void blip_add_delta( blip_t* m, unsigned time, int delta )
 	out [15] += in[0]*delta + in[0-half_width]*delta2;
 }
 
+/* bl_step as two 16-tap kernels per phase (the second half being the reversed
+step of the opposite phase), so that blip_add_deltas can add a delta with
+vector operations: out [i] += a [i]*delta + b [i]*delta2 */
+struct blip_kernels
+{
+	int a [phase_count] [half_width * 2];
+	int b [phase_count] [half_width * 2];
+};
+
+static blip_kernels make_kernels( void )
+{
+	blip_kernels k;
+	int phase, i;
+	for ( phase = 0; phase < phase_count; phase++ )
+	{
+		short const* in  = bl_step [phase];
+		short const* rev = bl_step [phase_count - phase];
+		for ( i = 0; i < half_width; i++ )
+		{
+			k.a [phase] [i] = in [i];
+			k.b [phase] [i] = in [half_width + i];
+			k.a [phase] [half_width * 2 - 1 - i] = rev [i];
+			k.b [phase] [half_width * 2 - 1 - i] = rev [i - half_width];
+		}
+	}
+	return k;
+}
+
+static blip_kernels const bl_kernels = make_kernels();
+
+/* Same position/phase/interpolation math as blip_add_delta */
+static __forceinline buf_t* prepare_delta( blip_t* m, unsigned time, int* delta, int* delta2, int* phase )
+{
+	int const phase_shift = frac_bits - phase_bits;
+	unsigned fixed = (unsigned) ((time * m->factor + m->offset) >> pre_shift);
+	buf_t* out = SAMPLES( m ) + m->avail + (fixed >> frac_bits);
+	int interp = fixed >> (phase_shift - delta_bits) & (delta_unit - 1);
+	
+	*phase = fixed >> phase_shift & (phase_count - 1);
+	*delta2 = (*delta * interp) >> delta_bits;
+	*delta -= *delta2;
+	
+	/* Fails if buffer size was exceeded */
+	assert( out <= &SAMPLES( m ) [m->size + end_frame_extra] );
+	return out;
+}
+
+static void add_deltas_scalar( blip_t* m, unsigned const times [], int const deltas [], int count )
+{
+	int n, i;
+	for ( n = 0; n < count; n++ )
+	{
+		int delta = deltas [n], delta2, phase;
+		buf_t* out = prepare_delta( m, times [n], &delta, &delta2, &phase );
+		int const* a = bl_kernels.a [phase];
+		int const* b = bl_kernels.b [phase];
+		for ( i = 0; i < half_width * 2; i++ )
+			out [i] += a [i]*delta + b [i]*delta2;
+	}
+}
+
+#if defined(MESEN_SIMD_X86)
+SIMD_TARGET_SSE41 static void add_deltas_sse41( blip_t* m, unsigned const times [], int const deltas [], int count )
+{
+	int n, i;
+	for ( n = 0; n < count; n++ )
+	{
+		int delta = deltas [n], delta2, phase;
+		buf_t* out = prepare_delta( m, times [n], &delta, &delta2, &phase );
+		__m128i d  = _mm_set1_epi32( delta );
+		__m128i d2 = _mm_set1_epi32( delta2 );
+		for ( i = 0; i < half_width * 2; i += 4 )
+		{
+			__m128i a = _mm_loadu_si128( (__m128i const*) &bl_kernels.a [phase] [i] );
+			__m128i b = _mm_loadu_si128( (__m128i const*) &bl_kernels.b [phase] [i] );
+			__m128i sum = _mm_add_epi32( _mm_mullo_epi32( a, d ), _mm_mullo_epi32( b, d2 ) );
+			_mm_storeu_si128( (__m128i*) &out [i], _mm_add_epi32( _mm_loadu_si128( (__m128i const*) &out [i] ), sum ) );
+		}
+	}
+}
+
+SIMD_TARGET_AVX2 static void add_deltas_avx2( blip_t* m, unsigned const times [], int const deltas [], int count )
+{
+	int n, i;
+	for ( n = 0; n < count; n++ )
+	{
+		int delta = deltas [n], delta2, phase;
+		buf_t* out = prepare_delta( m, times [n], &delta, &delta2, &phase );
+		__m256i d  = _mm256_set1_epi32( delta );
+		__m256i d2 = _mm256_set1_epi32( delta2 );
+		for ( i = 0; i < half_width * 2; i += 8 )
+		{
+			__m256i a = _mm256_loadu_si256( (__m256i const*) &bl_kernels.a [phase] [i] );
+			__m256i b = _mm256_loadu_si256( (__m256i const*) &bl_kernels.b [phase] [i] );
+			__m256i sum = _mm256_add_epi32( _mm256_mullo_epi32( a, d ), _mm256_mullo_epi32( b, d2 ) );
+			_mm256_storeu_si256( (__m256i*) &out [i], _mm256_add_epi32( _mm256_loadu_si256( (__m256i const*) &out [i] ), sum ) );
+		}
+	}
+}
+#elif defined(MESEN_SIMD_NEON)
+static void add_deltas_neon( blip_t* m, unsigned const times [], int const deltas [], int count )
+{
+	int n, i;
+	for ( n = 0; n < count; n++ )
+	{
+		int delta = deltas [n], delta2, phase;
+		buf_t* out = prepare_delta( m, times [n], &delta, &delta2, &phase );
+		for ( i = 0; i < half_width * 2; i += 4 )
+		{
+			int32x4_t sum = vld1q_s32( &out [i] );
+			sum = vmlaq_n_s32( sum, vld1q_s32( &bl_kernels.a [phase] [i] ), delta );
+			sum = vmlaq_n_s32( sum, vld1q_s32( &bl_kernels.b [phase] [i] ), delta2 );
+			vst1q_s32( &out [i], sum );
+		}
+	}
+}
+#endif
+
+void blip_add_deltas( blip_t* m, unsigned const times [], int const deltas [], int count )
+{
+	/* Integer sums, every implementation gives the same result as blip_add_delta */
+#if defined(MESEN_SIMD_X86)
+	if ( SimdUtilities::HasAvx2() )
+		add_deltas_avx2( m, times, deltas, count );
+	else if ( SimdUtilities::HasSse41() )
+		add_deltas_sse41( m, times, deltas, count );
+	else
+		add_deltas_scalar( m, times, deltas, count );
+#elif defined(MESEN_SIMD_NEON)
+	if ( SimdUtilities::HasNeon() )
+		add_deltas_neon( m, times, deltas, count );
+	else
+		add_deltas_scalar( m, times, deltas, count );
+#else
+	add_deltas_scalar( m, times, deltas, count );
+#endif
+}
+
 void blip_add_delta_fast( blip_t* m, unsigned time, int delta )
 {
 	unsigned fixed = (unsigned) ((time * m->factor + m->offset) >> pre_shift);
@@ -41,6 +41,10 @@ EXPORT void blip_clear( blip_t* );
 /** Adds positive/negative delta into buffer at specified clock time. */
 EXPORT void blip_add_delta( blip_t*, unsigned int clock_time, int delta );
 
+/** Same as calling blip_add_delta() for each of the 'count' deltas, in a single
+batch. Times don't need to be sorted. */
+EXPORT void blip_add_deltas( blip_t*, unsigned int const clock_times [], int const deltas [], int count );
+
 /** Same as blip_add_delta(), but uses faster, lower-quality synthesis. */
 void blip_add_delta_fast( blip_t*, unsigned int clock_time, int delta );
 
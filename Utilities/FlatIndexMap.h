@@ -0,0 +1,98 @@
+#pragma once
+#include "pch.h"
+
+//Open-addressed (linear probing) hash table that maps 64-bit keys to dense indexes (0, 1, 2, etc.)
+//assigned in insertion order. The values themselves are meant to be stored by the caller in a
+//vector, at the returned index - this keeps lookups to a single probe sequence over a flat array.
+class FlatIndexMap
+{
+private:
+	static constexpr uint32_t EmptySlot = UINT32_MAX;
+
+	vector<uint64_t> _keys;
+	vector<uint32_t> _indexes;
+	uint32_t _mask = 0;
+	uint32_t _count = 0;
+
+	__forceinline uint32_t GetSlot(uint64_t key) const
+	{
+		//Fibonacci hashing
+		return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & _mask;
+	}
+
+	void Grow()
+	{
+		vector<uint64_t> keys = std::move(_keys);
+		vector<uint32_t> indexes = std::move(_indexes);
+
+		uint32_t capacity = (_mask + 1) * 2;
+		_keys.assign(capacity, 0);
+		_indexes.assign(capacity, EmptySlot);
+		_mask = capacity - 1;
+
+		for(size_t i = 0; i < indexes.size(); i++) {
+			if(indexes[i] != EmptySlot) {
+				uint32_t slot = GetSlot(keys[i]);
+				while(_indexes[slot] != EmptySlot) {
+					slot = (slot + 1) & _mask;
+				}
+				_keys[slot] = keys[i];
+				_indexes[slot] = indexes[i];
+			}
+		}
+	}
+
+public:
+	//capacity must be a power of 2
+	FlatIndexMap(uint32_t capacity = 256)
+	{
+		_keys.assign(capacity, 0);
+		_indexes.assign(capacity, EmptySlot);
+		_mask = capacity - 1;
+	}
+
+	//Returns the key's index, or -1 if the key isn't in the table
+	int32_t Find(uint64_t key) const
+	{
+		uint32_t slot = GetSlot(key);
+		while(_indexes[slot] != EmptySlot) {
+			if(_keys[slot] == key) {
+				return (int32_t)_indexes[slot];
+			}
+			slot = (slot + 1) & _mask;
+		}
+		return -1;
+	}
+
+	//Returns the key's index, adding the key to the table (with index = GetCount()) if needed
+	uint32_t GetOrAdd(uint64_t key, bool& added)
+	{
+		uint32_t slot = GetSlot(key);
+		while(_indexes[slot] != EmptySlot) {
+			if(_keys[slot] == key) {
+				added = false;
+				return _indexes[slot];
+			}
+			slot = (slot + 1) & _mask;
+		}
+
+		added = true;
+		_keys[slot] = key;
+		_indexes[slot] = _count;
+		_count++;
+
+		if(_count * 2 > _mask + 1) {
+			//Keep the load factor under 50%
+			Grow();
+		}
+		return _count - 1;
+	}
+
+	uint32_t GetCount() const { return _count; }
+
+	void Clear()
+	{
+		std::fill(_indexes.begin(), _indexes.end(), EmptySlot);
+		_count = 0;
+	}
+};
@@ -2,53 +2,262 @@
 #include <sstream>
 #include "PNGHelper.h"
 #include "miniz.h"
+#include "SimdUtilities.h"
 
 #define SPNG_USE_MINIZ
 #include "spng.h"
 
-bool PNGHelper::WritePNG(std::stringstream &stream, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel)
+static void ConvertToRgbScalar(uint8_t* dst, const uint32_t* src, uint32_t i, uint32_t count)
 {
-	size_t pngSize = 0;
-
-	uint32_t size = xSize * ySize * bitsPerPixel / 8;
-	vector<uint8_t> convertedData(size, 0);
-	if(bitsPerPixel == 32) {
-		//ARGB -> ABGR
-		for(uint32_t i = 0; i < size / 4; i++) {
-			convertedData[i * 4] = (buffer[i] & 0xFF0000) >> 16;
-			convertedData[i * 4 + 1] = (buffer[i] & 0xFF00) >> 8;
-			convertedData[i * 4 + 2] = (buffer[i] & 0xFF);
-			convertedData[i * 4 + 3] = (buffer[i] & 0xFF000000) >> 24;
-		}
-	} else if(bitsPerPixel == 24) {
-		//ARGB -> BGR
-		for(uint32_t i = 0; i < size / 3; i++) {
-			convertedData[i * 3] = (buffer[i] & 0xFF0000) >> 16;
-			convertedData[i * 3 + 1] = (buffer[i] & 0xFF00) >> 8;
-			convertedData[i * 3 + 2] = (buffer[i] & 0xFF);
+	for(; i < count; i++) {
+		dst[i * 3] = (src[i] >> 16) & 0xFF;
+		dst[i * 3 + 1] = (src[i] >> 8) & 0xFF;
+		dst[i * 3 + 2] = src[i] & 0xFF;
+	}
+}
+
+static void ConvertToRgbaScalar(uint8_t* dst, const uint32_t* src, uint32_t i, uint32_t count)
+{
+	for(; i < count; i++) {
+		dst[i * 4] = (src[i] >> 16) & 0xFF;
+		dst[i * 4 + 1] = (src[i] >> 8) & 0xFF;
+		dst[i * 4 + 2] = src[i] & 0xFF;
+		dst[i * 4 + 3] = src[i] >> 24;
+	}
+}
+
+#if defined(MESEN_SIMD_X86)
+//4 pixels per shuffle, each 16-byte store writes 4 bytes past the 12 bytes of RGB data (overwritten by the next store)
+SIMD_TARGET_SSE41 static uint32_t ConvertToRgbSse41(uint8_t* dst, const uint32_t* src, uint32_t count)
+{
+	const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	uint32_t i = 0;
+	for(; i + 4 <= count; i += 4) {
+		__m128i pixels = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + i * 3), _mm_shuffle_epi8(pixels, shuffle));
+	}
+	return i;
+}
+
+SIMD_TARGET_SSE41 static uint32_t ConvertToRgbaSse41(uint8_t* dst, const uint32_t* src, uint32_t count)
+{
+	const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+	uint32_t i = 0;
+	for(; i + 4 <= count; i += 4) {
+		__m128i pixels = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_shuffle_epi8(pixels, shuffle));
+	}
+	return i;
+}
+#elif defined(MESEN_SIMD_NEON)
+static uint32_t ConvertToRgbNeon(uint8_t* dst, const uint32_t* src, uint32_t count)
+{
+	uint32_t i = 0;
+	for(; i + 16 <= count; i += 16) {
+		//Deinterleaves the B, G, R and A bytes of 16 pixels
+		uint8x16x4_t pixels = vld4q_u8((const uint8_t*)(src + i));
+		uint8x16x3_t rgb;
+		rgb.val[0] = pixels.val[2];
+		rgb.val[1] = pixels.val[1];
+		rgb.val[2] = pixels.val[0];
+		vst3q_u8(dst + i * 3, rgb);
+	}
+	return i;
+}
+
+static uint32_t ConvertToRgbaNeon(uint8_t* dst, const uint32_t* src, uint32_t count)
+{
+	uint32_t i = 0;
+	for(; i + 16 <= count; i += 16) {
+		uint8x16x4_t pixels = vld4q_u8((const uint8_t*)(src + i));
+		std::swap(pixels.val[0], pixels.val[2]);
+		vst4q_u8(dst + i * 4, pixels);
+	}
+	return i;
+}
+#endif
+
+void PNGHelper::ConvertToRgb(uint8_t* dst, const uint32_t* src, uint32_t pixelCount)
+{
+	uint32_t i = 0;
+#if defined(MESEN_SIMD_X86)
+	if(SimdUtilities::HasSse41()) {
+		i = ConvertToRgbSse41(dst, src, pixelCount);
+	}
+#elif defined(MESEN_SIMD_NEON)
+	if(SimdUtilities::HasNeon()) {
+		i = ConvertToRgbNeon(dst, src, pixelCount);
+	}
+#endif
+	ConvertToRgbScalar(dst, src, i, pixelCount);
+}
+
+void PNGHelper::ConvertToRgba(uint8_t* dst, const uint32_t* src, uint32_t pixelCount)
+{
+	uint32_t i = 0;
+#if defined(MESEN_SIMD_X86)
+	if(SimdUtilities::HasSse41()) {
+		i = ConvertToRgbaSse41(dst, src, pixelCount);
+	}
+#elif defined(MESEN_SIMD_NEON)
+	if(SimdUtilities::HasNeon()) {
+		i = ConvertToRgbaNeon(dst, src, pixelCount);
+	}
+#endif
+	ConvertToRgbaScalar(dst, src, i, pixelCount);
+}
+
+bool PNGHelper::BuildPalette(uint32_t* buffer, uint32_t xSize, uint32_t ySize, vector<uint8_t>& rowData, vector<uint32_t>& palette)
+{
+	//Open addressing hash table (RGB -> palette index), 4 times larger than the max color count to keep probe sequences short
+	constexpr uint32_t TableSize = 1024;
+	constexpr uint32_t EmptySlot = 0xFFFFFFFF;
+	uint32_t keys[TableSize];
+	uint8_t indexes[TableSize];
+	memset(keys, 0xFF, sizeof(keys));
+
+	palette.clear();
+	rowData.resize((xSize + 1) * ySize);
+	uint8_t* out = rowData.data();
+
+	uint32_t lastColor = EmptySlot;
+	uint8_t lastIndex = 0;
+	for(uint32_t y = 0; y < ySize; y++) {
+		*out++ = 0; //Filter type: none
+		uint32_t* row = buffer + y * xSize;
+		for(uint32_t x = 0; x < xSize; x++) {
+			uint32_t color = row[x] & 0xFFFFFF;
+			if(color != lastColor) {
+				uint32_t slot = (color * 0x9E3779B1) >> 22;
+				while(keys[slot] != color && keys[slot] != EmptySlot) {
+					slot = (slot + 1) & (TableSize - 1);
+				}
+				if(keys[slot] == EmptySlot) {
+					if(palette.size() == 256) {
+						return false;
+					}
+					keys[slot] = color;
+					indexes[slot] = (uint8_t)palette.size();
+					palette.push_back(color);
+				}
+				lastColor = color;
+				lastIndex = indexes[slot];
+			}
+			*out++ = lastIndex;
 		}
+	}
+	return true;
+}
+
+static void WriteUint32(vector<uint8_t>& output, uint32_t value)
+{
+	uint8_t bytes[4] = { (uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value };
+	output.insert(output.end(), bytes, bytes + 4);
+}
+
+void PNGHelper::WriteChunk(vector<uint8_t>& output, const char* type, const uint8_t* data, uint32_t size)
+{
+	WriteUint32(output, size);
+	output.insert(output.end(), (const uint8_t*)type, (const uint8_t*)type + 4);
+	output.insert(output.end(), data, data + size);
+	WriteUint32(output, (uint32_t)mz_crc32(MZ_CRC32_INIT, output.data() + output.size() - size - 4, size + 4));
+}
+
+bool PNGHelper::WritePNG(vector<uint8_t>& output, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel, uint32_t compressionLevel)
+{
+	if(bitsPerPixel != 24 && bitsPerPixel != 32) {
+		return false;
+	}
+
+	vector<uint8_t> rowData;
+	vector<uint32_t> palette;
+	uint8_t colorType;
+	if(bitsPerPixel == 24 && BuildPalette(buffer, xSize, ySize, rowData, palette)) {
+		colorType = 3; //Indexed
 	} else {
+		uint32_t rowSize = xSize * bitsPerPixel / 8 + 1;
+		rowData.resize(rowSize * ySize + 4); //Padding for the last store of the SIMD conversion
+		for(uint32_t y = 0; y < ySize; y++) {
+			uint8_t* row = rowData.data() + y * rowSize;
+			if(bitsPerPixel == 32) {
+				ConvertToRgba(row + 1, buffer + y * xSize, xSize);
+			} else {
+				ConvertToRgb(row + 1, buffer + y * xSize, xSize);
+			}
+			//Set after the conversion, the previous row's padding overlaps this byte
+			row[0] = 0;
+		}
+		rowData.resize(rowSize * ySize);
+		colorType = bitsPerPixel == 32 ? 6 : 2;
+	}
+
+	output.clear();
+	output.reserve(rowData.size() / 2 + 1024);
+
+	static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	output.insert(output.end(), signature, signature + 8);
+
+	uint8_t header[13] = {
+		(uint8_t)(xSize >> 24), (uint8_t)(xSize >> 16), (uint8_t)(xSize >> 8), (uint8_t)xSize,
+		(uint8_t)(ySize >> 24), (uint8_t)(ySize >> 16), (uint8_t)(ySize >> 8), (uint8_t)ySize,
+		8, colorType, 0, 0, 0
+	};
+	WriteChunk(output, "IHDR", header, sizeof(header));
+
+	if(colorType == 3) {
+		vector<uint8_t> paletteData;
+		for(uint32_t color : palette) {
+			paletteData.push_back((color >> 16) & 0xFF);
+			paletteData.push_back((color >> 8) & 0xFF);
+			paletteData.push_back(color & 0xFF);
+		}
+		WriteChunk(output, "PLTE", paletteData.data(), (uint32_t)paletteData.size());
+	}
+
+	//Compress directly after the IDAT chunk's header, the length is filled in once the compressed size is known
+	size_t idatStart = output.size();
+	WriteUint32(output, 0);
+	output.insert(output.end(), { 'I', 'D', 'A', 'T' });
+
+	int flags = tdefl_create_comp_flags_from_zip_params(compressionLevel, 15, MZ_DEFAULT_STRATEGY) | TDEFL_WRITE_ZLIB_HEADER;
+	auto appendData = [](const void* data, int len, void* user) -> mz_bool {
+		vector<uint8_t>* out = (vector<uint8_t>*)user;
+		out->insert(out->end(), (const uint8_t*)data, (const uint8_t*)data + len);
+		return MZ_TRUE;
+	};
+	if(!tdefl_compress_mem_to_output(rowData.data(), rowData.size(), appendData, &output, flags)) {
+		std::cout << "tdefl_compress_mem_to_output() failed!" << std::endl;
+		output.clear();
 		return false;
 	}
 
-	void* pngData = tdefl_write_image_to_png_file_in_memory_ex(convertedData.data(), xSize, ySize, bitsPerPixel / 8, &pngSize, MZ_DEFAULT_LEVEL, MZ_FALSE);
-	if(!pngData) {
-		std::cout << "tdefl_write_image_to_png_file_in_memory_ex() failed!" << std::endl;
+	uint32_t idatSize = (uint32_t)(output.size() - idatStart - 8);
+	for(int i = 0; i < 4; i++) {
+		output[idatStart + i] = (uint8_t)(idatSize >> (24 - i * 8));
+	}
+	WriteUint32(output, (uint32_t)mz_crc32(MZ_CRC32_INIT, output.data() + idatStart + 4, idatSize + 4));
+
+	WriteChunk(output, "IEND", nullptr, 0);
+	return true;
+}
+
+bool PNGHelper::WritePNG(std::stringstream &stream, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel)
+{
+	vector<uint8_t> pngData;
+	if(!WritePNG(pngData, buffer, xSize, ySize, bitsPerPixel)) {
 		return false;
-	} else {
-		stream.write((char*)pngData, pngSize);
-		mz_free(pngData);
-		return true;
 	}
+	stream.write((char*)pngData.data(), pngData.size());
+	return true;
 }
 
 bool PNGHelper::WritePNG(string filename, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel)
 {
-	std::stringstream stream;
-	if(WritePNG(stream, buffer, xSize, ySize, bitsPerPixel)) {
+	vector<uint8_t> pngData;
+	if(WritePNG(pngData, buffer, xSize, ySize, bitsPerPixel)) {
 		ofstream file(filename, std::ios::out | std::ios::binary);
 		if(file.good()) {
-			file << stream.rdbuf();
+			file.write((char*)pngData.data(), pngData.size());
 		}
 		file.close();
 		return true;
@@ -7,11 +7,23 @@ private:
 	template<typename T>
 	static int DecodePNG(vector<T>& out_image, unsigned long& image_width, unsigned long& image_height, const unsigned char* in_png, size_t in_size, bool convert_to_rgba32 = true);
 
+	static bool BuildPalette(uint32_t* buffer, uint32_t xSize, uint32_t ySize, vector<uint8_t>& rowData, vector<uint32_t>& palette);
+	static void WriteChunk(vector<uint8_t>& output, const char* type, const uint8_t* data, uint32_t size);
+
 public:
+	static constexpr uint32_t FastCompression = 1;
+	static constexpr uint32_t DefaultCompression = 6;
+
+	//ARGB -> RGB (24-bit) or RGBA (32-bit) byte order, dst must have room for 4 extra bytes
+	static void ConvertToRgb(uint8_t* dst, const uint32_t* src, uint32_t pixelCount);
+	static void ConvertToRgba(uint8_t* dst, const uint32_t* src, uint32_t pixelCount);
+
+	//Encodes into output (replacing its content). 24-bit images with up to 256 colors (most console frames) are saved as palette images.
+	static bool WritePNG(vector<uint8_t>& output, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel = 24, uint32_t compressionLevel = PNGHelper::FastCompression);
 	static bool WritePNG(std::stringstream &stream, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel = 24);
 	static bool WritePNG(string filename, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel = 24);
 	static bool ReadPNG(string filename, vector<uint8_t> &pngData, uint32_t &pngWidth, uint32_t &pngHeight);
 
 	template<typename T>
 	static bool ReadPNG(vector<uint8_t> input, vector<T> &output, uint32_t &pngWidth, uint32_t &pngHeight);
-};
\ No newline at end of file
+};
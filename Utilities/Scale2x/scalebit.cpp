@@ -471,3 +471,86 @@ void scale(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_
 	}
 }
 
+
+/**
+ * Return the source row at the given index, clamped to the bitmap like the scale functions do at the edges.
+ */
+static inline const unsigned char* scale_clamped_row(const unsigned char* src, unsigned src_slice, int y, unsigned height)
+{
+	if (y < 0)
+		y = 0;
+	else if (y >= (int)height)
+		y = height - 1;
+	return src + y * src_slice;
+}
+
+/**
+ * Apply the Scale effect on a range of rows of a bitmap.
+ * The output is identical to the rows produced by ::scale() for the same bitmap, which
+ * allows a bitmap to be split in horizontal bands processed in parallel.
+ * The rows adjacent to the range are read from the source bitmap but only the destination rows
+ * of the range are written.
+ * \param scale Scale factor. 2, 3 or 4.
+ * \param void_dst Pointer at the first pixel of the destination bitmap (not of the range).
+ * \param dst_slice Size in bytes of a destination bitmap row.
+ * \param void_src Pointer at the first pixel of the source bitmap (not of the range).
+ * \param src_slice Size in bytes of a source bitmap row.
+ * \param pixel Bytes per pixel of the source and destination bitmap.
+ * \param width Horizontal size in pixels of the source bitmap.
+ * \param height Vertical size in pixels of the source bitmap.
+ * \param first_row First source row to process.
+ * \param last_row Source row after the last one to process.
+ */
+void scale_rows(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height, unsigned first_row, unsigned last_row)
+{
+	unsigned char* dst = (unsigned char*)void_dst;
+	const unsigned char* src = (const unsigned char*)void_src;
+	int y;
+
+	switch (scale) {
+	case 202 :
+	case 2 :
+		for (y = first_row; y < (int)last_row; y++) {
+			unsigned char* row = dst + 2 * y * dst_slice;
+			stage_scale2x(row, row + dst_slice, scale_clamped_row(src, src_slice, y - 1, height), scale_clamped_row(src, src_slice, y, height), scale_clamped_row(src, src_slice, y + 1, height), pixel, width);
+		}
+		break;
+	case 303 :
+	case 3 :
+		for (y = first_row; y < (int)last_row; y++) {
+			unsigned char* row = dst + 3 * y * dst_slice;
+			stage_scale3x(row, row + dst_slice, row + 2 * dst_slice, scale_clamped_row(src, src_slice, y - 1, height), scale_clamped_row(src, src_slice, y, height), scale_clamped_row(src, src_slice, y + 1, height), pixel, width);
+		}
+		break;
+	case 404 :
+	case 4 : {
+		/* the 2x intermediate rows are built for the source rows of the range and one row on each side */
+		int mid_first = first_row > 0 ? first_row - 1 : 0;
+		int mid_last = last_row < height ? last_row + 1 : height;
+		unsigned mid_slice = (2 * pixel * width + 0x7) & ~0x7;
+		unsigned char* mid = (unsigned char*)malloc(2 * (mid_last - mid_first) * mid_slice);
+		int mid_count = 2 * (mid_last - mid_first);
+		int i;
+
+		if (!mid)
+			return;
+
+		for (y = mid_first; y < mid_last; y++) {
+			unsigned char* row = mid + 2 * (y - mid_first) * mid_slice;
+			stage_scale2x(row, row + mid_slice, scale_clamped_row(src, src_slice, y - 1, height), scale_clamped_row(src, src_slice, y, height), scale_clamped_row(src, src_slice, y + 1, height), pixel, width);
+		}
+
+		/* the 4 destination rows of source row y are built from the intermediate rows 2y-1 to 2y+2 */
+		for (y = first_row; y < (int)last_row; y++) {
+			const unsigned char* mid_rows[4];
+			unsigned char* row = dst + 4 * y * dst_slice;
+			for (i = 0; i < 4; i++)
+				mid_rows[i] = scale_clamped_row(mid, mid_slice, 2 * (y - mid_first) - 1 + i, mid_count);
+			stage_scale4x(row, row + dst_slice, row + 2 * dst_slice, row + 3 * dst_slice, mid_rows[0], mid_rows[1], mid_rows[2], mid_rows[3], pixel, width);
+		}
+
+		free(mid);
+		break;
+	}
+	}
+}
@@ -0,0 +1,54 @@
+#include "pch.h"
+#include "SimdUtilities.h"
+
+SimdLevel SimdUtilities::_level = SimdUtilities::DetectLevel();
+
+SimdLevel SimdUtilities::DetectLevel()
+{
+#if defined(MESEN_SIMD_X86)
+	#ifdef _MSC_VER
+		int info[4] = {};
+		__cpuid(info, 0);
+		int maxId = info[0];
+		if(maxId < 1) {
+			return SimdLevel::None;
+		}
+
+		__cpuid(info, 1);
+		bool sse41 = (info[2] & (1 << 19)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		bool avx2 = false;
+		if(maxId >= 7 && osxsave && avx && (_xgetbv(0) & 0x06) == 0x06) {
+			__cpuidex(info, 7, 0);
+			avx2 = (info[1] & (1 << 5)) != 0;
+		}
+	#else
+		__builtin_cpu_init();
+		bool sse41 = __builtin_cpu_supports("sse4.1");
+		bool avx2 = __builtin_cpu_supports("avx2");
+	#endif
+
+	if(avx2 && sse41) {
+		return SimdLevel::Avx2;
+	} else if(sse41) {
+		return SimdLevel::Sse41;
+	}
+	return SimdLevel::None;
+#elif defined(MESEN_SIMD_NEON)
+	//NEON is mandatory on arm64
+	return SimdLevel::Neon;
+#else
+	return SimdLevel::None;
+#endif
+}
+
+void SimdUtilities::SetLevel(SimdLevel level)
+{
+	SimdLevel supported = DetectLevel();
+	if(level == SimdLevel::None || level == supported) {
+		_level = level;
+	} else if(level == SimdLevel::Sse41 && supported == SimdLevel::Avx2) {
+		_level = level;
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "pch.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+	#define MESEN_SIMD_X86 1
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#endif
+	#include <immintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__) || defined(__ARM_NEON)
+	#define MESEN_SIMD_NEON 1
+	#include <arm_neon.h>
+#endif
+
+//Functions tagged with these are compiled for the given instruction set regardless of
+//the compiler flags used for the rest of the file - they must only be called after
+//checking the matching SimdUtilities::HasXxx() function.
+#if defined(MESEN_SIMD_X86) && !defined(_MSC_VER)
+	#define SIMD_TARGET_SSE41 __attribute__((target("sse4.1")))
+	#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+	#define SIMD_TARGET_SSE41
+	#define SIMD_TARGET_AVX2
+#endif
+
+enum class SimdLevel
+{
+	None,
+	Sse41,
+	Avx2,
+	Neon
+};
+
+class SimdUtilities
+{
+private:
+	static SimdLevel _level;
+
+public:
+	static SimdLevel DetectLevel();
+
+	static SimdLevel GetLevel() { return _level; }
+	static bool HasSse41() { return _level == SimdLevel::Sse41 || _level == SimdLevel::Avx2; }
+	static bool HasAvx2() { return _level == SimdLevel::Avx2; }
+	static bool HasNeon() { return _level == SimdLevel::Neon; }
+
+	//Restricts the code paths that can be used (e.g to compare the SIMD and scalar implementations)
+	//Levels that are not supported by the host CPU are ignored.
+	static void SetLevel(SimdLevel level);
+};
@@ -0,0 +1,104 @@
+//Implementation of the XXH64 algorithm from https://github.com/Cyan4973/xxHash
+//BSD 2-clause license
+
+#include "pch.h"
+#include "XxHash.h"
+
+static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+static __forceinline uint64_t RotateLeft(uint64_t value, uint32_t count)
+{
+	return (value << count) | (value >> (64 - count));
+}
+
+static __forceinline uint64_t Read64(const uint8_t* ptr)
+{
+	//Input is read as little endian, same as the reference implementation on x86/ARM
+	uint64_t value;
+	memcpy(&value, ptr, sizeof(value));
+	return value;
+}
+
+static __forceinline uint32_t Read32(const uint8_t* ptr)
+{
+	uint32_t value;
+	memcpy(&value, ptr, sizeof(value));
+	return value;
+}
+
+uint64_t XxHash::Round(uint64_t acc, uint64_t input)
+{
+	acc += input * Prime2;
+	acc = RotateLeft(acc, 31);
+	return acc * Prime1;
+}
+
+uint64_t XxHash::MergeRound(uint64_t acc, uint64_t value)
+{
+	acc ^= Round(0, value);
+	return acc * Prime1 + Prime4;
+}
+
+uint64_t XxHash::GetHash(const void* data, size_t length, uint64_t seed)
+{
+	const uint8_t* ptr = (const uint8_t*)data;
+	const uint8_t* end = ptr + length;
+	uint64_t hash;
+
+	if(length >= 32) {
+		//4 independent lanes, 32 bytes per iteration
+		uint64_t v1 = seed + Prime1 + Prime2;
+		uint64_t v2 = seed + Prime2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - Prime1;
+
+		const uint8_t* limit = end - 32;
+		do {
+			v1 = Round(v1, Read64(ptr));
+			v2 = Round(v2, Read64(ptr + 8));
+			v3 = Round(v3, Read64(ptr + 16));
+			v4 = Round(v4, Read64(ptr + 24));
+			ptr += 32;
+		} while(ptr <= limit);
+
+		hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+		hash = MergeRound(hash, v1);
+		hash = MergeRound(hash, v2);
+		hash = MergeRound(hash, v3);
+		hash = MergeRound(hash, v4);
+	} else {
+		hash = seed + Prime5;
+	}
+
+	hash += (uint64_t)length;
+
+	while(ptr + 8 <= end) {
+		hash ^= Round(0, Read64(ptr));
+		hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+		ptr += 8;
+	}
+
+	if(ptr + 4 <= end) {
+		hash ^= (uint64_t)Read32(ptr) * Prime1;
+		hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+		ptr += 4;
+	}
+
+	while(ptr < end) {
+		hash ^= (*ptr) * Prime5;
+		hash = RotateLeft(hash, 11) * Prime1;
+		ptr++;
+	}
+
+	//Final avalanche
+	hash ^= hash >> 33;
+	hash *= Prime2;
+	hash ^= hash >> 29;
+	hash *= Prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
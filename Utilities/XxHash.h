@@ -0,0 +1,13 @@
+#pragma once
+#include "pch.h"
+
+//XXH64 (xxHash, 64-bit variant) - fast non-cryptographic hash, e.g to compare frame buffers
+class XxHash
+{
+private:
+	static uint64_t Round(uint64_t acc, uint64_t input);
+	static uint64_t MergeRound(uint64_t acc, uint64_t value);
+
+public:
+	static uint64_t GetHash(const void* data, size_t length, uint64_t seed = 0);
+};